@@ -1,5 +1,4 @@
 #include <cassert>
-#include <fstream>
 
 #include "D3DSample.h"
 #include "D3DUtil.h"
@@ -7,7 +6,8 @@
 #include "GeometryGenerator.h"
 #include "RenderStates.h"
 #include "D3DSample.h"
-#include "Octree.h"
+#include "AmbientOcclusionBaker.h"
+#include "MeshCache.h"
 
 namespace ambientOcclusion
 {
@@ -181,117 +181,93 @@ namespace ambientOcclusion
 
 	void D3DSample::buildVertexAmbientOcclusion(
 		std::vector<AmbientOcclusion>& vertices,
-		const std::vector<UINT>& indices)
+		const std::vector<UINT>& indices,
+		JobSystem* jobSystem,
+		Bvh* outBvh)
 	{
 		UINT vcount = vertices.size();
-		UINT tcount = indices.size() / 3;
 
 		std::vector<Vector3> positions(vcount);
 		for (UINT i = 0; i < vcount; ++i)
 			positions[i] = vertices[i].Pos;
 
-		// Ʈ 
-		Octree octree;
-		octree.Build(positions, indices);
+		// ﰢ NUM_SAMPLE_RAYS ݱ ̸    ´.
+		//  ﰢ ȣ Ƿ      ´.
+		AmbientOcclusionBaker baker;
+		baker.Init(positions, indices, AMBIENT_SEED);
+		baker.Accumulate(NUM_SAMPLE_RAYS, jobSystem);
 
-		std::vector<int> vertexSharedCount(vcount);
-		for (UINT i = 0; i < tcount; ++i)
+		//  ֺ ޵  ϴ ﰢ ̴.
+		std::vector<float> ambientAccess;
+		baker.GetVertexAmbientAccess(&ambientAccess);
+		for (UINT i = 0; i < vcount; ++i)
 		{
-			UINT i0 = indices[i * 3 + 0];
-			UINT i1 = indices[i * 3 + 1];
-			UINT i2 = indices[i * 3 + 2];
-
-			XMVECTOR v0 = XMLoadFloat3(&vertices[i0].Pos);
-			XMVECTOR v1 = XMLoadFloat3(&vertices[i1].Pos);
-			XMVECTOR v2 = XMLoadFloat3(&vertices[i2].Pos);
-
-			XMVECTOR edge0 = v1 - v0;
-			XMVECTOR edge1 = v2 - v0;
-
-			XMVECTOR normal = XMVector3Normalize(XMVector3Cross(edge0, edge1));
-
-			XMVECTOR centroid = (v0 + v1 + v2) / 3.0f; // 
-
-
-			// ü  ϱ  ߽ɿ 븻  ణ δ.
-			centroid += 0.001f * normal;
-
-			const int NumSampleRays = 32;
-			float numUnoccluded = 0;
-
-			// 32 븻  ݱ ͸ Ѵ.
-			for (int j = 0; j < NumSampleRays; ++j)
-			{
-				XMVECTOR randomDir = MathHelper::RandHemisphereUnitVec3(normal);
-
-				// Ʈ ȸϸ  浹Ǿ Ǹ un䵵 == ޵ Ų.
-				if (!octree.RayOctreeIntersect(centroid, randomDir))
-				{
-					numUnoccluded++;
-				}
-			}
-
-			// ֺ ޵    / ýõ  
-			float ambientAccess = numUnoccluded / NumSampleRays;
-
-			// ﰢ  ֺ ޵ Ų.
-			vertices[i0].AmbientAccess += ambientAccess;
-			vertices[i1].AmbientAccess += ambientAccess;
-			vertices[i2].AmbientAccess += ambientAccess;
-
-			// ߿  Ƚ Ų.
-			vertexSharedCount[i0]++;
-			vertexSharedCount[i1]++;
-			vertexSharedCount[i2]++;
+			vertices[i].AmbientAccess = ambientAccess[i];
 		}
 
-		//  ֺ ޵ .
-		for (UINT i = 0; i < vcount; ++i)
+		if (outBvh != nullptr)
 		{
-			vertices[i].AmbientAccess /= vertexSharedCount[i];
+			*outBvh = baker.GetBvh();
 		}
 	}
 
 	void D3DSample::buildSkullGeometryBuffers()
 	{
-		std::ifstream fin("../Resource/Models/skull.txt");
+		const std::string fileName = "../Resource/Models/skull.txt";
+		JobSystem jobSystem; // ؽƮ Ľ̰ ֺ Ⱑ Բ .
+		MeshCache mesh;
 
-		if (!fin)
+		if (!mesh.Load(fileName, &jobSystem))
 		{
 			MessageBox(0, L"Models/skull.txt not found.", 0, 0);
 			return;
 		}
 
-		UINT vcount = 0;
-		UINT tcount = 0;
-		std::string ignore;
-
-		fin >> ignore >> vcount;
-		fin >> ignore >> tcount;
-		fin >> ignore >> ignore >> ignore >> ignore;
+		UINT vcount = mesh.GetVertexCount();
+		mSkullIndexCount = mesh.GetIndexCount();
 
+		const MeshVertex* meshVertices = mesh.GetVertices();
 		std::vector<AmbientOcclusion> vertices(vcount);
 		for (UINT i = 0; i < vcount; ++i)
 		{
-			fin >> vertices[i].Pos.x >> vertices[i].Pos.y >> vertices[i].Pos.z;
-			fin >> vertices[i].Normal.x >> vertices[i].Normal.y >> vertices[i].Normal.z;
+			vertices[i].Pos = meshVertices[i].Pos;
+			vertices[i].Normal = meshVertices[i].Normal;
+			vertices[i].Tex = meshVertices[i].Tex;
 		}
 
-		fin >> ignore;
-		fin >> ignore;
-		fin >> ignore;
+		const UINT* meshIndices = mesh.GetIndices();
+		std::vector<UINT> indices(meshIndices, meshIndices + mSkullIndexCount);
 
-		mSkullIndexCount = 3 * tcount;
-		std::vector<UINT> indices(mSkullIndexCount);
-		for (UINT i = 0; i < tcount; ++i)
+		// ĳÿ   , õ, ˰  ֺ ޵  ״ .
+		const MeshCache::AmbientBakeKey ambientKey = { NUM_SAMPLE_RAYS, AMBIENT_SEED, AmbientOcclusionBaker::ALGORITHM_VERSION };
+		const MeshCache::AmbientBakeKey& cachedKey = mesh.GetAmbientKey();
+		const float* ambientAccess = mesh.GetAmbientAccess();
+		if (ambientAccess != nullptr && cachedKey.SampleCount == ambientKey.SampleCount
+			&& cachedKey.Seed == ambientKey.Seed && cachedKey.Algorithm == ambientKey.Algorithm)
 		{
-			fin >> indices[i * 3 + 0] >> indices[i * 3 + 1] >> indices[i * 3 + 2];
+			for (UINT i = 0; i < vcount; ++i)
+			{
+				vertices[i].AmbientAccess = ambientAccess[i];
+			}
 		}
+		else
+		{
+			//  ֺ  ϱ, ĳÿ BVH     BVH Բ Ѵ.
+			Bvh bvh;
+			const bool bCachedBvh = mesh.GetBvh(&bvh);
+			buildVertexAmbientOcclusion(vertices, indices, &jobSystem, bCachedBvh ? nullptr : &bvh);
+
+			//   ⸦ ǳʶٵ  ĳÿ ٽ .
+			std::vector<MeshVertex> cacheVertices(meshVertices, meshVertices + vcount);
+			std::vector<float> cacheAmbientAccess(vcount);
+			for (UINT i = 0; i < vcount; ++i)
+			{
+				cacheAmbientAccess[i] = vertices[i].AmbientAccess;
+			}
 
-		fin.close();
-
-		//  ֺ  ϱ
-		buildVertexAmbientOcclusion(vertices, indices);
+			mesh.Close();
+			MeshCache::Write(MeshCache::GetCacheFileName(fileName), cacheVertices, indices, &cacheAmbientAccess, &ambientKey, &bvh);
+		}
 
 		D3D11_BUFFER_DESC vbd;
 		vbd.Usage = D3D11_USAGE_IMMUTABLE;
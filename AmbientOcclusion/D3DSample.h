@@ -3,7 +3,9 @@
 #include <directxtk/SimpleMath.h>
 #include <vector>
 
+#include "Bvh.h"
 #include "D3dProcessor.h"
+#include "JobSystem.h"
 #include "Camera.h"
 #include "LightHelper.h"
 
@@ -41,11 +43,18 @@ namespace ambientOcclusion
 		void OnMouseUp(WPARAM btnState, int x, int y);
 		void OnMouseMove(WPARAM btnState, int x, int y);
 
+	private:
+		enum { NUM_SAMPLE_RAYS = 32 };
+		enum { AMBIENT_SEED = 0 };
+
 	private:
 		void buildInit();
+		// outBvh     BVH  ش.
 		void buildVertexAmbientOcclusion(
 			std::vector<AmbientOcclusion>& vertices,
-			const std::vector<UINT>& indices);
+			const std::vector<UINT>& indices,
+			JobSystem* jobSystem,
+			Bvh* outBvh);
 		void buildSkullGeometryBuffers();
 
 	private:
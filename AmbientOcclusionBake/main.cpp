@@ -0,0 +1,221 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AmbientOcclusionBaker.h"
+#include "JobSystem.h"
+#include "TextMeshParser.h"
+
+using namespace common;
+using namespace DirectX::SimpleMath;
+
+namespace
+{
+	struct BakeOptions
+	{
+		const char* ModelFileName = nullptr;
+		const char* OutputFileName = nullptr;
+		uint32_t SampleCount = 32;
+		uint32_t PassCount = 1;
+		uint32_t ThreadCount = 0; // 0̸ ھ 
+		uint32_t Seed = 0;
+		bool bVerify = false;
+	};
+
+	void printUsage()
+	{
+		std::cout << "usage: AmbientOcclusionBake <model.txt> [-o output.txt] [-samples N] [-passes N] [-threads N] [-seed N] [-verify]" << std::endl;
+		std::cout << "  -passes  accumulate the samples progressively in N passes" << std::endl;
+		std::cout << "  -verify  rebake on one thread in one pass and require bit-identical output" << std::endl;
+	}
+
+	bool parseOptions(int argc, char* argv[], BakeOptions* outOptions)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const char* arg = argv[i];
+			const bool bHasValue = i + 1 < argc;
+
+			if (strcmp(arg, "-o") == 0 && bHasValue)
+			{
+				outOptions->OutputFileName = argv[++i];
+			}
+			else if (strcmp(arg, "-samples") == 0 && bHasValue)
+			{
+				outOptions->SampleCount = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+			}
+			else if (strcmp(arg, "-passes") == 0 && bHasValue)
+			{
+				outOptions->PassCount = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+			}
+			else if (strcmp(arg, "-threads") == 0 && bHasValue)
+			{
+				outOptions->ThreadCount = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+			}
+			else if (strcmp(arg, "-seed") == 0 && bHasValue)
+			{
+				outOptions->Seed = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+			}
+			else if (strcmp(arg, "-verify") == 0)
+			{
+				outOptions->bVerify = true;
+			}
+			else if (arg[0] != '-' && outOptions->ModelFileName == nullptr)
+			{
+				outOptions->ModelFileName = arg;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		return outOptions->ModelFileName != nullptr && outOptions->SampleCount > 0 && outOptions->PassCount > 0;
+	}
+
+	bool loadTextMesh(const char* fileName, std::vector<Vector3>* outPositions, std::vector<uint32_t>* outIndices)
+	{
+		std::vector<MeshVertex> vertices;
+
+		if (!TextMeshParser::Load(fileName, &vertices, outIndices))
+		{
+			return false;
+		}
+
+		outPositions->resize(vertices.size());
+		for (size_t i = 0; i < vertices.size(); ++i)
+		{
+			(*outPositions)[i] = vertices[i].Pos;
+		}
+
+		return true;
+	}
+
+	//  񱳿 FNV-1a ؽ, εҼ Ʈ ״ ´.
+	uint64_t hashAmbientAccess(const std::vector<float>& ambientAccess)
+	{
+		uint64_t hash = 14695981039346656037ull;
+
+		for (float value : ambientAccess)
+		{
+			uint32_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+
+			for (int i = 0; i < 4; ++i)
+			{
+				hash ^= (bits >> (i * 8)) & 0xff;
+				hash *= 1099511628211ull;
+			}
+		}
+
+		return hash;
+	}
+}
+
+//  ֺ ޵   ٿ ϳ Ѵ.
+//  ڵ: 0 , 1  Ǵ  , 2 -verify ġ
+int main(int argc, char* argv[])
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	BakeOptions options;
+
+	if (!parseOptions(argc, argv, &options))
+	{
+		printUsage();
+		return 1;
+	}
+
+	std::vector<Vector3> positions;
+	std::vector<uint32_t> indices;
+
+	if (!loadTextMesh(options.ModelFileName, &positions, &indices))
+	{
+		std::cout << "failed to load " << options.ModelFileName << std::endl;
+		return 1;
+	}
+
+	JobSystem jobSystem(options.ThreadCount > 0 ? options.ThreadCount - 1 : 0);
+	JobSystem* jobSystemPtr = jobSystem.GetThreadCount() > 1 ? &jobSystem : nullptr;
+
+	Clock::time_point start = Clock::now();
+
+	AmbientOcclusionBaker baker;
+	baker.Init(positions, indices, options.Seed);
+
+	std::cout << options.ModelFileName << ": " << positions.size() << " vertices, " << indices.size() / 3 << " triangles, "
+		<< jobSystem.GetThreadCount() << " threads, bvh "
+		<< std::chrono::duration<double, std::milli>(Clock::now() - start).count() << " ms" << std::endl;
+
+	// н  ʿ  ־  Ȯ SampleCount ǰ Ѵ.
+	for (uint32_t pass = 0; pass < options.PassCount; ++pass)
+	{
+		uint32_t passSampleCount = options.SampleCount / options.PassCount + (pass < options.SampleCount % options.PassCount ? 1 : 0);
+
+		if (passSampleCount == 0)
+		{
+			continue;
+		}
+
+		Clock::time_point passStart = Clock::now();
+		baker.Accumulate(passSampleCount, jobSystemPtr);
+
+		double passMs = std::chrono::duration<double, std::milli>(Clock::now() - passStart).count();
+		double rayCount = static_cast<double>(passSampleCount) * (indices.size() / 3);
+		std::cout << "  pass " << pass + 1 << "/" << options.PassCount << ": " << baker.GetSampleCount() << " samples, "
+			<< passMs << " ms, " << rayCount / (passMs * 1000.0) << " Mrays/s" << std::endl;
+	}
+
+	std::vector<float> ambientAccess;
+	baker.GetVertexAmbientAccess(&ambientAccess);
+
+	const uint64_t hash = hashAmbientAccess(ambientAccess);
+	std::cout << "  total " << std::chrono::duration<double, std::milli>(Clock::now() - start).count() << " ms, hash "
+		<< std::hex << hash << std::dec << std::endl;
+
+	if (options.OutputFileName != nullptr)
+	{
+		std::ofstream fout(options.OutputFileName);
+
+		if (!fout)
+		{
+			std::cout << "failed to open " << options.OutputFileName << std::endl;
+			return 1;
+		}
+
+		// ȿ  9ڸ float Ʈ ս  ٽ   ִ.
+		fout << std::setprecision(9);
+		for (float value : ambientAccess)
+		{
+			fout << value << '\n';
+		}
+	}
+
+	if (options.bVerify)
+	{
+		baker.Reset();
+		baker.Accumulate(options.SampleCount);
+
+		std::vector<float> reference;
+		baker.GetVertexAmbientAccess(&reference);
+
+		const uint64_t referenceHash = hashAmbientAccess(reference);
+		const bool bIdentical = memcmp(reference.data(), ambientAccess.data(), reference.size() * sizeof(float)) == 0;
+
+		std::cout << "  verify 1 thread, 1 pass: hash " << std::hex << referenceHash << std::dec
+			<< (bIdentical ? ", identical" : ", MISMATCH") << std::endl;
+
+		if (!bIdentical)
+		{
+			return 2;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+#include <thread>
+
+namespace benchmark
+{
+	// â  ֿܼ   ,  ǥ  .
+	// ũ⸦ ϴ ø ڽ ø ,   İ  true
+	bool RunCullingBenchmark();
+	// Ʈ BVH, Ŷ      true
+	bool RunRayBenchmark();
+	// Ʈ, ,  Ľ   , Ͽ     źϰ, ޽ ĳð պǸ  ε BVH źϸ true
+	bool RunParseBenchmark();
+	// ŬͰ  ﰢ   ,  ī޶ ϴ ﰢ Ÿ  true
+	bool RunClusterBenchmark();
+	//  LOD ǥ Ÿ  ޽  5% ̸ true
+	bool RunLodBenchmark();
+	// ȭ պ  ġ ̸ true
+	bool RunPackBenchmark();
+	//     ̰ ,    true
+	bool RunWeldBenchmark();
+	//  Ŭ    ̰  ø  Ŭ   true
+	bool RunCompressionBenchmark();
+	//   İ ,   Ȯ ð  ȷƮ   ȿ  true
+	bool RunCrowdBenchmark();
+	// SIMD  Ⱑ     ȿ  true
+	bool RunBlendBenchmark();
+	// ִϸ̼  Ʈ  Ű ڸ ׻  true
+	bool RunBoundsBenchmark();
+	//  LOD  ,  ̷  ٷ CrowdAnimator::Update  true
+	bool RunScheduleBenchmark();
+	//    Űװ ȭ  ȿ ,    պ  true
+	bool RunVatBenchmark();
+	// SIMD Ű Į ذ   ȿ ,      true
+	bool RunSkinBenchmark();
+	// Ŀ Ž  Ž  Ű  Ŀ  򰡿 Ʈ  , slerp     ̸ true
+	bool RunSamplingBenchmark();
+	// ε   ȷƮ ¸ ̸ ã  ٽ ϴ İ   ȿ  true
+	bool RunPoseBenchmark();
+
+	// func iterationCount   ð(ms)
+	template <typename Func>
+	double MeasureMs(int iterationCount, const Func& func)
+	{
+		using Clock = std::chrono::high_resolution_clock;
+
+		Clock::time_point start = Clock::now();
+		for (int i = 0; i < iterationCount; ++i)
+		{
+			func();
+		}
+
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / iterationCount;
+	}
+
+	inline UINT GetHardwareThreadCount()
+	{
+		UINT count = std::thread::hardware_concurrency();
+		return count > 0 ? count : 1;
+	}
+}
@@ -0,0 +1,374 @@
+#include <windows.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "JobSystem.h"
+#include "SyntheticRig.h"
+#include "../ResourceManager/PoseBlender.h"
+
+namespace benchmark
+{
+	using namespace common;
+	using namespace DirectX::SimpleMath;
+	using namespace resourceManager;
+
+	namespace
+	{
+		enum { NODE_COUNT = 64, CLIP_COUNT = 3, CHARACTER_COUNT = 5000, POOL_SIZE = 64, FRAME_COUNT = 10, REPEAT_COUNT = 5, GRAIN_SIZE = 16 };
+
+		const float FRAME_TIME = 1.f / 60.f;
+		const float TOLERANCE = 1e-4f;
+		const float BLEND_WEIGHTS[CLIP_COUNT] = { 0.5f, 0.3f, 0.2f };
+		const float LAYER_WEIGHT = 0.7f;
+		const float ADDITIVE_WEIGHT = 0.5f;
+
+		const char* result(bool bPassed)
+		{
+			return bPassed ? "ok" : "FAILED";
+		}
+
+		// ع  a * b
+		Quaternion multiply(const Quaternion& a, const Quaternion& b)
+		{
+			return Quaternion(a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+				a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+				a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+				a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z);
+		}
+
+		Quaternion alignTo(const Quaternion& reference, const Quaternion& rotation)
+		{
+			return reference.Dot(rotation) < 0.f ? -rotation : rotation;
+		}
+
+		// Ʒ    ϳ SimpleMath Ѵ. PoseBlender  ð ϴ  .
+		void referenceBlend(const LocalPose* const* poses, const float* weights, unsigned int poseCount, LocalPose* outPose)
+		{
+			float totalWeight = 0.f;
+			for (unsigned int k = 0; k < poseCount; ++k)
+			{
+				totalWeight += weights[k];
+			}
+
+			for (unsigned int i = 0; i < outPose->GetNodeCount(); ++i)
+			{
+				const Quaternion& reference = poses[0]->Rotations[i];
+				Vector3 translation = Vector3::Zero;
+				Vector3 scale = Vector3::Zero;
+				Quaternion rotation(0.f, 0.f, 0.f, 0.f);
+
+				for (unsigned int k = 0; k < poseCount; ++k)
+				{
+					const float weight = weights[k] / totalWeight;
+					translation += poses[k]->Translations[i] * weight;
+					scale += poses[k]->Scales[i] * weight;
+					rotation += alignTo(reference, poses[k]->Rotations[i]) * weight;
+				}
+				rotation.Normalize();
+
+				outPose->Translations[i] = translation;
+				outPose->Scales[i] = scale;
+				outPose->Rotations[i] = rotation;
+			}
+		}
+
+		void referenceBlendLayer(const LocalPose& base, const LocalPose& layer, const float* jointWeights, float weight, LocalPose* outPose)
+		{
+			for (unsigned int i = 0; i < outPose->GetNodeCount(); ++i)
+			{
+				const float w = jointWeights[i] * weight;
+				Quaternion rotation = base.Rotations[i] * (1.f - w) + alignTo(base.Rotations[i], layer.Rotations[i]) * w;
+				rotation.Normalize();
+
+				outPose->Translations[i] = Vector3::Lerp(base.Translations[i], layer.Translations[i], w);
+				outPose->Scales[i] = Vector3::Lerp(base.Scales[i], layer.Scales[i], w);
+				outPose->Rotations[i] = rotation;
+			}
+		}
+
+		void referenceApplyAdditive(const LocalPose& base, const LocalPose& delta, const float* jointWeights, float weight, LocalPose* outPose)
+		{
+			for (unsigned int i = 0; i < outPose->GetNodeCount(); ++i)
+			{
+				const float w = jointWeights[i] * weight;
+				Quaternion partial = Quaternion::Identity * (1.f - w) + alignTo(Quaternion::Identity, delta.Rotations[i]) * w;
+				partial.Normalize();
+
+				outPose->Translations[i] = base.Translations[i] + delta.Translations[i] * w;
+				outPose->Scales[i] = base.Scales[i] * (Vector3::One + (delta.Scales[i] - Vector3::One) * w);
+				outPose->Rotations[i] = multiply(base.Rotations[i], partial);
+			}
+		}
+
+		//   к ִ , ȸ q -q   .
+		float measureError(const LocalPose& lhs, const LocalPose& rhs)
+		{
+			float maxError = 0.f;
+			for (unsigned int i = 0; i < lhs.GetNodeCount(); ++i)
+			{
+				const Vector3 translation = lhs.Translations[i] - rhs.Translations[i];
+				const Vector3 scale = lhs.Scales[i] - rhs.Scales[i];
+				const Quaternion rotation = lhs.Rotations[i] - alignTo(lhs.Rotations[i], rhs.Rotations[i]);
+
+				const float errors[] =
+				{
+					fabsf(translation.x), fabsf(translation.y), fabsf(translation.z),
+					fabsf(scale.x), fabsf(scale.y), fabsf(scale.z),
+					fabsf(rotation.x), fabsf(rotation.y), fabsf(rotation.z), fabsf(rotation.w)
+				};
+				maxError = std::max<float>(maxError, *std::max_element(std::begin(errors), std::end(errors)));
+			}
+
+			return maxError;
+		}
+
+		// Լ ϳ REPEAT_COUNT 缭  ª ð(ms)
+		template <typename Func>
+		double measureMinMs(const Func& func)
+		{
+			double minMs = DBL_MAX;
+			for (int repeat = 0; repeat < REPEAT_COUNT; ++repeat)
+			{
+				minMs = std::min<double>(minMs, MeasureMs(1, func));
+			}
+
+			return minMs;
+		}
+
+		// ĳ ϳ Ŭ  , Ŭ Ŀ  д.
+		struct Character
+		{
+			float TimePos;
+			std::vector<AnimationCursor> Cursors[CLIP_COUNT + 1];
+			LocalPose Pose;
+		};
+
+		struct FrameScratch
+		{
+			LocalPose Poses[CLIP_COUNT];
+			LocalPose Delta;
+		};
+
+		//  : Ŭ 3 ø  ü ũ  Ŭ ´.
+		void updateCharacter(const Skeleton& skeleton, const std::vector<AnimationClip>& clips, const AnimationClip& additiveClip,
+			const std::vector<float>& mask, Character* character, FrameScratch* scratch)
+		{
+			if (scratch->Delta.GetNodeCount() != skeleton.GetNodeCount())
+			{
+				for (LocalPose& pose : scratch->Poses)
+				{
+					pose.Resize(skeleton.GetNodeCount());
+				}
+				scratch->Delta.Resize(skeleton.GetNodeCount());
+			}
+
+			character->TimePos += FRAME_TIME;
+
+			const LocalPose* poses[CLIP_COUNT];
+			for (UINT k = 0; k < CLIP_COUNT; ++k)
+			{
+				const float clipTime = fmodf(character->TimePos, static_cast<float>(clips[k].Duration));
+				clips[k].SamplePose(skeleton, clipTime, character->Cursors[k].data(), &scratch->Poses[k]);
+				poses[k] = &scratch->Poses[k];
+			}
+			PoseBlender::Blend(poses, BLEND_WEIGHTS, CLIP_COUNT, &character->Pose);
+
+			const float additiveTime = fmodf(character->TimePos, static_cast<float>(additiveClip.Duration));
+			additiveClip.SamplePose(skeleton, additiveTime, character->Cursors[CLIP_COUNT].data(), &scratch->Delta);
+			PoseBlender::ApplyAdditive(character->Pose, scratch->Delta, mask.data(), ADDITIVE_WEIGHT, &character->Pose);
+		}
+	}
+
+	bool RunBlendBenchmark()
+	{
+		Skeleton skeleton;
+		std::vector<AnimationClip> clips;
+		SyntheticRig::Build(NODE_COUNT, CLIP_COUNT, 17, &skeleton, &clips);
+
+		// Ʈ ù ڽ 罽 ü  ̾  Ŭ ű⿡ Ǵ.
+		std::vector<float> mask;
+		PoseBlender::BuildSubtreeMask(skeleton, 1, &mask);
+
+		LocalPose referencePose;
+		referencePose.Resize(NODE_COUNT);
+		std::vector<AnimationCursor> cursors(NODE_COUNT);
+		clips[2].SamplePose(skeleton, 0.f, cursors.data(), &referencePose);
+
+		AnimationClip additiveClip;
+		PoseBlender::MakeAdditiveClip(clips[2], skeleton, referencePose, &additiveClip);
+
+		// ð ѷ ø  , ⸸    Է  .
+		std::mt19937 random(9);
+		std::uniform_real_distribution<float> startTime(0.f, 4.f);
+		std::vector<LocalPose> pool(POOL_SIZE * CLIP_COUNT);
+		std::vector<LocalPose> additivePool(POOL_SIZE);
+		std::vector<LocalPose> sourcePool(POOL_SIZE);
+		for (UINT i = 0; i < POOL_SIZE; ++i)
+		{
+			const float time = startTime(random);
+			for (UINT k = 0; k < CLIP_COUNT; ++k)
+			{
+				LocalPose& pose = pool[i * CLIP_COUNT + k];
+				pose.Resize(NODE_COUNT);
+				std::fill(cursors.begin(), cursors.end(), AnimationCursor());
+				clips[k].SamplePose(skeleton, fmodf(time, static_cast<float>(clips[k].Duration)), cursors.data(), &pose);
+			}
+
+			const float additiveTime = fmodf(time, static_cast<float>(additiveClip.Duration));
+			additivePool[i].Resize(NODE_COUNT);
+			std::fill(cursors.begin(), cursors.end(), AnimationCursor());
+			additiveClip.SamplePose(skeleton, additiveTime, cursors.data(), &additivePool[i]);
+
+			sourcePool[i].Resize(NODE_COUNT);
+			std::fill(cursors.begin(), cursors.end(), AnimationCursor());
+			clips[2].SamplePose(skeleton, additiveTime, cursors.data(), &sourcePool[i]);
+		}
+
+		auto getPoses = [&pool](UINT character, const LocalPose** outPoses)
+			{
+				const UINT first = character % POOL_SIZE * CLIP_COUNT;
+				for (UINT k = 0; k < CLIP_COUNT; ++k)
+				{
+					outPoses[k] = &pool[first + k];
+				}
+			};
+
+		// Ȯ:   ϰ,  Ŭ reference  ϸ  Ŭ  .
+		float blendError = 0.f;
+		float layerError = 0.f;
+		float additiveError = 0.f;
+		float roundTripError = 0.f;
+		{
+			LocalPose simd;
+			LocalPose reference;
+			simd.Resize(NODE_COUNT);
+			reference.Resize(NODE_COUNT);
+
+			for (UINT i = 0; i < POOL_SIZE; ++i)
+			{
+				const LocalPose* poses[CLIP_COUNT];
+				getPoses(i, poses);
+
+				PoseBlender::Blend(poses, BLEND_WEIGHTS, CLIP_COUNT, &simd);
+				referenceBlend(poses, BLEND_WEIGHTS, CLIP_COUNT, &reference);
+				blendError = std::max<float>(blendError, measureError(simd, reference));
+
+				PoseBlender::BlendLayer(*poses[0], *poses[1], mask.data(), LAYER_WEIGHT, &simd);
+				referenceBlendLayer(*poses[0], *poses[1], mask.data(), LAYER_WEIGHT, &reference);
+				layerError = std::max<float>(layerError, measureError(simd, reference));
+
+				PoseBlender::ApplyAdditive(*poses[0], additivePool[i], mask.data(), ADDITIVE_WEIGHT, &simd);
+				referenceApplyAdditive(*poses[0], additivePool[i], mask.data(), ADDITIVE_WEIGHT, &reference);
+				additiveError = std::max<float>(additiveError, measureError(simd, reference));
+
+				PoseBlender::ApplyAdditive(referencePose, additivePool[i], nullptr, 1.f, &simd);
+				roundTripError = std::max<float>(roundTripError, measureError(simd, sourcePool[i]));
+			}
+		}
+
+		const bool bBlendValid = blendError <= TOLERANCE;
+		const bool bLayerValid = layerError <= TOLERANCE;
+		const bool bAdditiveValid = additiveError <= TOLERANCE;
+		const bool bRoundTripValid = roundTripError <= TOLERANCE;
+
+		std::cout << std::fixed << std::setprecision(3);
+		std::cout << "[blend] characters " << static_cast<UINT>(CHARACTER_COUNT) << ", nodes " << static_cast<UINT>(NODE_COUNT)
+			<< ", clips " << static_cast<UINT>(CLIP_COUNT) << ", upper body mask " << std::count(mask.begin(), mask.end(), 1.f) << " nodes" << std::endl;
+		std::cout << std::scientific << std::setprecision(2)
+			<< "  max error vs scalar: blend " << blendError << " " << result(bBlendValid)
+			<< ", layer " << layerError << " " << result(bLayerValid)
+			<< ", additive " << additiveError << " " << result(bAdditiveValid) << std::endl
+			<< "  additive clip round trip " << roundTripError << " " << result(bRoundTripValid) << std::endl;
+
+		// ⸸: ̸ ø  ĳ͸  ĳͺ   .
+		std::vector<LocalPose> outputs(CHARACTER_COUNT);
+		for (LocalPose& pose : outputs)
+		{
+			pose.Resize(NODE_COUNT);
+		}
+
+		auto measureBlendMs = [&](auto blendFunc)
+			{
+				return measureMinMs([&]()
+					{
+						for (UINT i = 0; i < CHARACTER_COUNT; ++i)
+						{
+							const LocalPose* poses[CLIP_COUNT];
+							getPoses(i, poses);
+							blendFunc(poses, i, &outputs[i]);
+						}
+					});
+			};
+
+		const double blendScalarMs = measureBlendMs([&](const LocalPose* const* poses, UINT, LocalPose* out) { referenceBlend(poses, BLEND_WEIGHTS, CLIP_COUNT, out); });
+		const double blendSimdMs = measureBlendMs([&](const LocalPose* const* poses, UINT, LocalPose* out) { PoseBlender::Blend(poses, BLEND_WEIGHTS, CLIP_COUNT, out); });
+		const double layerScalarMs = measureBlendMs([&](const LocalPose* const* poses, UINT, LocalPose* out) { referenceBlendLayer(*poses[0], *poses[1], mask.data(), LAYER_WEIGHT, out); });
+		const double layerSimdMs = measureBlendMs([&](const LocalPose* const* poses, UINT, LocalPose* out) { PoseBlender::BlendLayer(*poses[0], *poses[1], mask.data(), LAYER_WEIGHT, out); });
+		const double additiveScalarMs = measureBlendMs([&](const LocalPose* const* poses, UINT i, LocalPose* out)
+			{
+				referenceApplyAdditive(*poses[0], additivePool[i % POOL_SIZE], mask.data(), ADDITIVE_WEIGHT, out);
+			});
+		const double additiveSimdMs = measureBlendMs([&](const LocalPose* const* poses, UINT i, LocalPose* out)
+			{
+				PoseBlender::ApplyAdditive(*poses[0], additivePool[i % POOL_SIZE], mask.data(), ADDITIVE_WEIGHT, out);
+			});
+
+		std::cout << std::fixed << std::setprecision(3);
+		std::cout << "  per frame, all characters   scalar ms  simd ms  speedup" << std::endl;
+		std::cout << "  3-way blend                 " << std::setw(9) << blendScalarMs << "  " << std::setw(7) << blendSimdMs << "  " << std::setw(7) << blendScalarMs / blendSimdMs << std::endl;
+		std::cout << "  masked layer                " << std::setw(9) << layerScalarMs << "  " << std::setw(7) << layerSimdMs << "  " << std::setw(7) << layerScalarMs / layerSimdMs << std::endl;
+		std::cout << "  masked additive             " << std::setw(9) << additiveScalarMs << "  " << std::setw(7) << additiveSimdMs << "  " << std::setw(7) << additiveScalarMs / additiveSimdMs << std::endl;
+
+		// ü : ĳ͸ Ŭ 3 +  Ŭ ø, 3 ,  ̾
+		std::vector<Character> characters(CHARACTER_COUNT);
+		for (Character& character : characters)
+		{
+			character.TimePos = startTime(random);
+			for (std::vector<AnimationCursor>& characterCursors : character.Cursors)
+			{
+				characterCursors.resize(NODE_COUNT);
+			}
+			character.Pose.Resize(NODE_COUNT);
+		}
+
+		auto updateRange = [&](UINT begin, UINT end)
+			{
+				thread_local FrameScratch scratch;
+				for (UINT i = begin; i < end; ++i)
+				{
+					updateCharacter(skeleton, clips, additiveClip, mask, &characters[i], &scratch);
+				}
+			};
+
+		std::cout << "  full frame (sample 3 clips + additive, blend, layer)" << std::endl;
+		std::cout << "  threads  ms/frame  characters/ms" << std::endl;
+
+		const UINT maxThreadCount = GetHardwareThreadCount();
+		for (UINT threadCount = 1; threadCount <= maxThreadCount; ++threadCount)
+		{
+			double frameMs = 0.0;
+
+			// Ŀ  0 ھ  ߶ ̹Ƿ 1 ķ .
+			if (threadCount == 1)
+			{
+				frameMs = MeasureMs(FRAME_COUNT, [&]() { updateRange(0, CHARACTER_COUNT); });
+			}
+			else
+			{
+				JobSystem jobSystem(threadCount - 1);
+				frameMs = MeasureMs(FRAME_COUNT, [&]() { jobSystem.ParallelFor(CHARACTER_COUNT, GRAIN_SIZE, updateRange); });
+			}
+
+			std::cout << "  " << std::left << std::setw(9) << threadCount << std::right
+				<< std::setw(8) << frameMs << "  " << std::setw(13) << CHARACTER_COUNT / frameMs << std::endl;
+		}
+
+		return bBlendValid && bLayerValid && bAdditiveValid && bRoundTripValid;
+	}
+}
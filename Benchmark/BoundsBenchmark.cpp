@@ -0,0 +1,271 @@
+#include <windows.h>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Camera.h"
+#include "D3DUtil.h"
+#include "FrustumCuller.h"
+#include "SyntheticRig.h"
+#include "../ResourceManager/AnimatedBounds.h"
+
+namespace benchmark
+{
+	using namespace common;
+	using namespace DirectX;
+	using namespace DirectX::SimpleMath;
+	using namespace resourceManager;
+
+	namespace
+	{
+		enum { NODE_COUNT = 64, CLIP_COUNT = 3, VERTICES_PER_BONE = 16, CHECK_COUNT = 2000, INSTANCE_COUNT = 16384, ITERATION_COUNT = 20 };
+
+		const float HALF = 500.f;
+		const float FRAME_TIME = 1.f / 60.f;
+
+		// Ų ޽ Ŭ ϳ     Ű Ȯ   
+		class ExactSkinner
+		{
+		public:
+			ExactSkinner(const Skeleton& skeleton, const PaletteLayout& layout, const std::vector<vertex::PosNormalTexTanSkinned>& vertices,
+				const std::vector<unsigned int>& subsetStarts)
+				: mSkeleton(skeleton)
+				, mLayout(layout)
+				, mVertices(vertices)
+				, mSubsetStarts(subsetStarts)
+				, mCursors(skeleton.GetNodeCount())
+				, mToRootMatrices(skeleton.GetNodeCount())
+				, mSkinMatrices(layout.GetBoneCount())
+			{
+				mPose.Resize(skeleton.GetNodeCount());
+			}
+
+			MinMaxBox ComputeBox(const AnimationClip& clip, float clipTime)
+			{
+				clip.SamplePose(mSkeleton, clipTime, mCursors.data(), &mPose);
+				mSkeleton.ComputeToRootMatrices(mPose, mToRootMatrices.data());
+				for (unsigned int bone = 0; bone < mLayout.GetBoneCount(); ++bone)
+				{
+					mSkinMatrices[bone] = mLayout.OffsetMatrices[bone] * mToRootMatrices[mLayout.NodeIndices[bone]];
+				}
+
+				MinMaxBox box;
+				for (size_t subset = 0; subset + 1 < mSubsetStarts.size(); ++subset)
+				{
+					const unsigned int boneOffset = mLayout.SubsetOffsets[subset];
+					for (unsigned int i = mSubsetStarts[subset]; i < mSubsetStarts[subset + 1]; ++i)
+					{
+						const vertex::PosNormalTexTanSkinned& vertex = mVertices[i];
+						Vector3 position = Vector3::Zero;
+						for (int k = 0; k < 4 && vertex.Indices[k] != vertex::PosNormalTexTanSkinned::INVALID_INDEX; ++k)
+						{
+							position += Vector3::Transform(vertex.Pos, mSkinMatrices[boneOffset + vertex.Indices[k]]) * vertex.Weights[k];
+						}
+
+						box.Min = Vector3::Min(box.Min, position);
+						box.Max = Vector3::Max(box.Max, position);
+					}
+				}
+
+				return box;
+			}
+
+		private:
+			const Skeleton& mSkeleton;
+			const PaletteLayout& mLayout;
+			const std::vector<vertex::PosNormalTexTanSkinned>& mVertices;
+			const std::vector<unsigned int>& mSubsetStarts;
+			LocalPose mPose;
+			std::vector<AnimationCursor> mCursors;
+			std::vector<Matrix> mToRootMatrices;
+			std::vector<Matrix> mSkinMatrices;
+		};
+
+		// inner outer   ū Ÿ, ȿ  0
+		float measureEscape(const MinMaxBox& inner, const BoundingBox& outer)
+		{
+			const Vector3 outerMin = Vector3(outer.Center) - Vector3(outer.Extents);
+			const Vector3 outerMax = Vector3(outer.Center) + Vector3(outer.Extents);
+			const Vector3 below = outerMin - inner.Min;
+			const Vector3 above = inner.Max - outerMax;
+
+			return std::max<float>(0.f, std::max<float>({ below.x, below.y, below.z, above.x, above.y, above.z }));
+		}
+
+		float getVolume(const BoundingBox& box)
+		{
+			return 8.f * box.Extents.x * box.Extents.y * box.Extents.z;
+		}
+
+		// ึ Ŭ  ũ 1e-5ŭ εҼ ݿø .
+		float getTolerance(const AnimatedBounds& bounds)
+		{
+			const Vector3 size = bounds.GetClipBox().Max - bounds.GetClipBox().Min;
+			return 1e-5f * std::max<float>({ size.x, size.y, size.z });
+		}
+	}
+
+	bool RunBoundsBenchmark()
+	{
+		Skeleton skeleton;
+		std::vector<AnimationClip> clips;
+		PaletteLayout layout;
+		std::vector<vertex::PosNormalTexTanSkinned> vertices;
+		std::vector<unsigned int> subsetStarts;
+		SyntheticRig::Build(NODE_COUNT, CLIP_COUNT, 21, &skeleton, &clips);
+		SyntheticRig::BuildPaletteLayout(skeleton, &layout);
+		SyntheticRig::BuildSkinnedVertices(skeleton, layout, VERTICES_PER_BONE, 5, &vertices, &subsetStarts);
+
+		std::vector<MinMaxBox> boneBoxes(layout.GetBoneCount());
+		for (size_t subset = 0; subset + 1 < subsetStarts.size(); ++subset)
+		{
+			AnimatedBounds::AddBoneBoxes(&vertices[subsetStarts[subset]], subsetStarts[subset + 1] - subsetStarts[subset],
+				layout.SubsetOffsets[subset], &boneBoxes);
+		}
+
+		std::cout << std::fixed << std::setprecision(3);
+		std::cout << "[bounds] nodes " << static_cast<UINT>(NODE_COUNT) << ", vertices " << vertices.size() << ", "
+			<< static_cast<UINT>(AnimatedBounds::DEFAULT_SAMPLE_RATE) << " intervals/s x " << static_cast<UINT>(AnimatedBounds::SUBSTEP_COUNT) << " substeps" << std::endl;
+
+		// Ŭ Ʈ ,   Ȯ Ű ڰ Ʈ  ȿ  .
+		ExactSkinner skinner(skeleton, layout, vertices, subsetStarts);
+		std::vector<AnimatedBounds> tracks(CLIP_COUNT);
+		std::mt19937 random(77);
+		bool bPassed = true;
+
+		for (UINT clipIndex = 0; clipIndex < CLIP_COUNT; ++clipIndex)
+		{
+			const AnimationClip& clip = clips[clipIndex];
+			AnimatedBounds& track = tracks[clipIndex];
+			const double buildMs = MeasureMs(1, [&]() { AnimatedBounds::Build(clip, skeleton, layout, boneBoxes, AnimatedBounds::DEFAULT_SAMPLE_RATE, &track); });
+
+			const float duration = static_cast<float>(clip.Duration);
+			const float tolerance = getTolerance(track);
+			std::uniform_real_distribution<float> time(0.f, duration);
+			float maxEscape = 0.f;
+			float maxRangeEscape = 0.f;
+			double trackVolume = 0.0;
+			double exactVolume = 0.0;
+
+			for (UINT i = 0; i < CHECK_COUNT; ++i)
+			{
+				const float clipTime = time(random);
+				const MinMaxBox exactBox = skinner.ComputeBox(clip, clipTime);
+				const BoundingBox trackBox = track.GetBounds(clipTime);
+				maxEscape = std::max<float>(maxEscape, measureEscape(exactBox, trackBox));
+				trackVolume += getVolume(trackBox);
+				exactVolume += getVolume(exactBox.ToBoundingBox());
+
+				//  Ǵ ۰ ,       Ѵ. Ŭ  Ѿ  쵵 δ.
+				const float rangeEnd = clipTime + 0.25f;
+				const BoundingBox rangeBox = track.GetBounds(clipTime, rangeEnd);
+				const float samples[] = { clipTime, clipTime + 0.125f, rangeEnd };
+				for (float sample : samples)
+				{
+					maxRangeEscape = std::max<float>(maxRangeEscape, measureEscape(skinner.ComputeBox(clip, fmodf(sample, duration)), rangeBox));
+				}
+			}
+
+			const bool bContained = maxEscape <= tolerance && maxRangeEscape <= tolerance;
+			bPassed = bPassed && bContained;
+
+			const BoundingBox clipBox = track.GetClipBox().ToBoundingBox();
+			std::cout << "  " << clip.Name << " (" << std::setprecision(1) << duration << " s): " << track.GetIntervalCount() << " intervals, "
+				<< track.GetByteSize() << " bytes, build " << std::setprecision(3) << buildMs << " ms" << std::endl
+				<< "    volume vs exact: track " << trackVolume / exactVolume << "x, whole clip " << getVolume(clipBox) * CHECK_COUNT / exactVolume
+				<< "x, max escape " << std::scientific << std::setprecision(2) << std::max<float>(maxEscape, maxRangeEscape) << std::fixed
+				<< std::setprecision(3) << " " << (bContained ? "ok" : "FAILED") << std::endl;
+		}
+
+		// ø:   νϽ Ʈ , Ŭ ü ڷ  øϰ Ȯ ڷ   Ѵ.
+		std::uniform_real_distribution<float> position(-HALF, HALF);
+		std::vector<Matrix> worlds(INSTANCE_COUNT);
+		std::vector<UINT> clipIndices(INSTANCE_COUNT);
+		std::vector<float> timePositions(INSTANCE_COUNT);
+		for (UINT i = 0; i < INSTANCE_COUNT; ++i)
+		{
+			worlds[i] = Matrix::CreateScale(0.2f) * Matrix::CreateTranslation(position(random), position(random), position(random));
+			clipIndices[i] = random() % CLIP_COUNT;
+			timePositions[i] = std::uniform_real_distribution<float>(0.f, 4.f)(random);
+		}
+
+		Camera camera;
+		camera.SetLens(0.25f * XM_PI, 16.f / 9.f, 1.f, 1000.f);
+		camera.LookAt(Vector3(0.f, 0.f, -HALF), Vector3(0.f, 0.f, 0.f), Vector3(0.f, 1.f, 0.f));
+		camera.UpdateViewMatrix();
+
+		Vector4 worldPlanes[6];
+		D3DHelper::ExtractFrustumPlanes(worldPlanes, camera.GetViewProj());
+
+		FrustumPlanes planes;
+		planes.Set(worldPlanes);
+
+		FrustumCuller culler;
+		culler.Resize(INSTANCE_COUNT);
+		std::vector<UINT> visibleIndices(INSTANCE_COUNT);
+
+		auto cull = [&](auto getLocalBox, std::vector<bool>* outVisible)
+			{
+				for (UINT i = 0; i < INSTANCE_COUNT; ++i)
+				{
+					BoundingBox worldBox;
+					getLocalBox(i).Transform(worldBox, worlds[i]);
+					culler.SetBounds(i, worldBox);
+				}
+
+				const UINT visibleCount = culler.Cull(planes, 0, INSTANCE_COUNT, visibleIndices.data());
+				if (outVisible != nullptr)
+				{
+					outVisible->assign(INSTANCE_COUNT, false);
+					for (UINT i = 0; i < visibleCount; ++i)
+					{
+						(*outVisible)[visibleIndices[i]] = true;
+					}
+				}
+
+				return visibleCount;
+			};
+
+		auto getTrackBox = [&](UINT i)
+			{
+				return tracks[clipIndices[i]].GetBounds(timePositions[i]);
+			};
+
+		std::vector<bool> exactVisible;
+		std::vector<bool> trackVisible;
+		std::vector<bool> clipVisible;
+		const UINT exactCount = cull([&](UINT i)
+			{
+				const AnimationClip& clip = clips[clipIndices[i]];
+				return skinner.ComputeBox(clip, fmodf(timePositions[i], static_cast<float>(clip.Duration))).ToBoundingBox();
+			}, &exactVisible);
+		const UINT trackCount = cull(getTrackBox, &trackVisible);
+		const UINT clipCount = cull([&](UINT i) { return tracks[clipIndices[i]].GetClipBox().ToBoundingBox(); }, &clipVisible);
+
+		UINT missedCount = 0;
+		for (UINT i = 0; i < INSTANCE_COUNT; ++i)
+		{
+			missedCount += exactVisible[i] && !trackVisible[i] ? 1 : 0;
+		}
+		bPassed = bPassed && missedCount == 0;
+
+		const double trackMs = MeasureMs(ITERATION_COUNT, [&]()
+			{
+				for (float& timePos : timePositions)
+				{
+					timePos += FRAME_TIME;
+				}
+				cull(getTrackBox, nullptr);
+			});
+
+		std::cout << "  culling " << static_cast<UINT>(INSTANCE_COUNT) << " instances: visible exact " << exactCount << ", track " << trackCount
+			<< ", whole clip " << clipCount << ", missed by track " << missedCount << " " << (missedCount == 0 ? "ok" : "FAILED") << std::endl
+			<< "  track query + transform + SIMD cull " << trackMs << " ms/frame" << std::endl;
+
+		return bPassed;
+	}
+}
@@ -0,0 +1,258 @@
+#include <windows.h>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Camera.h"
+#include "ClusterMesh.h"
+#include "D3DUtil.h"
+#include "FrustumCuller.h"
+#include "MeshOptimizer.h"
+#include "TextMeshParser.h"
+
+namespace benchmark
+{
+	using namespace common;
+	using namespace DirectX;
+	using namespace DirectX::SimpleMath;
+
+	namespace
+	{
+		// ŬͰ    ﰢ   Ű ȮѴ.
+		bool validateClusters(const ClusterMesh& clusters, std::vector<UINT> sourceIndices, std::vector<UINT> clusterIndices)
+		{
+			for (const MeshCluster& cluster : clusters.GetClusters())
+			{
+				if (cluster.VertexCount > ClusterMesh::MAX_VERTICES || cluster.IndexCount > ClusterMesh::MAX_TRIANGLES * 3)
+				{
+					return false;
+				}
+			}
+
+			// ﰢ  ؼ Ѵ. (  ٲ ʴ´)
+			auto sortTriangles = [](std::vector<UINT>* indices)
+				{
+					struct Triangle { UINT Index[3]; };
+					Triangle* begin = reinterpret_cast<Triangle*>(indices->data());
+					std::sort(begin, begin + indices->size() / 3, [](const Triangle& a, const Triangle& b)
+						{
+							return std::lexicographical_compare(a.Index, a.Index + 3, b.Index, b.Index + 3);
+						});
+				};
+
+			sortTriangles(&sourceIndices);
+			sortTriangles(&clusterIndices);
+
+			return sourceIndices == clusterIndices;
+		}
+
+		// Է ɷ ŬͿ ī޶ ϴ ﰢ ϳ  Ʋ ø̴.
+		UINT countWronglyCulled(const ClusterMesh& clusters, const std::vector<MeshVertex>& vertices,
+			const std::vector<UINT>& indices, const Vector3& eye)
+		{
+			UINT count = 0;
+
+			for (const MeshCluster& cluster : clusters.GetClusters())
+			{
+				Vector3 toApex = cluster.ConeApex - eye;
+				toApex.Normalize();
+				if (toApex.Dot(cluster.ConeAxis) < cluster.ConeCutoff)
+				{
+					continue;
+				}
+
+				for (UINT i = cluster.IndexStart; i < cluster.IndexStart + cluster.IndexCount; i += 3)
+				{
+					const Vector3& p0 = vertices[indices[i + 0]].Pos;
+					const Vector3& p1 = vertices[indices[i + 1]].Pos;
+					const Vector3& p2 = vertices[indices[i + 2]].Pos;
+					const Vector3 normal = (p1 - p0).Cross(p2 - p0);
+
+					if (normal.Dot(eye - p0) > 1e-6f * normal.Length() * (eye - p0).Length())
+					{
+						++count;
+					}
+				}
+			}
+
+			return count;
+		}
+
+		//   ϳ Ŭͷ     Ʋ ø  .
+		//    (+y) ϹǷ   ( Ʒ)      ո ɷ.
+		bool runConcaveCluster()
+		{
+			enum { GRID_SIZE = 7 };
+			const float CURVATURE = 0.3f;
+
+			std::vector<MeshVertex> vertices(GRID_SIZE * GRID_SIZE);
+			for (UINT z = 0; z < GRID_SIZE; ++z)
+			{
+				for (UINT x = 0; x < GRID_SIZE; ++x)
+				{
+					const float px = 2.f * x / (GRID_SIZE - 1) - 1.f;
+					const float pz = 2.f * z / (GRID_SIZE - 1) - 1.f;
+					vertices[z * GRID_SIZE + x].Pos = Vector3(px, CURVATURE * (px * px + pz * pz), pz);
+				}
+			}
+
+			// (p1 - p0) x (p2 - p0) +y Ǵ 
+			std::vector<UINT> indices;
+			for (UINT z = 0; z + 1 < GRID_SIZE; ++z)
+			{
+				for (UINT x = 0; x + 1 < GRID_SIZE; ++x)
+				{
+					const UINT v00 = z * GRID_SIZE + x;
+					const UINT v10 = v00 + 1;
+					const UINT v01 = v00 + GRID_SIZE;
+					const UINT v11 = v01 + 1;
+					indices.insert(indices.end(), { v00, v01, v10, v10, v01, v11 });
+				}
+			}
+
+			ClusterMesh clusters;
+			clusters.Build(vertices.data(), static_cast<UINT>(vertices.size()), indices.data(), indices.size(), &MeshVertex::Pos);
+
+			const std::vector<MeshCluster>& clusterList = clusters.GetClusters();
+			if (clusterList.size() != 1 || clusterList[0].ConeCutoff > 1.f)
+			{
+				std::cout << "  concave cluster: " << clusterList.size() << " clusters, expected one with a cone FAILED" << std::endl;
+				return false;
+			}
+
+			//  ٷ ( Ʋ ɷ ) ָ , Ʒ
+			const float heights[] = { -2.f, -0.5f, 0.05f, 0.1f, 0.2f, 0.3f, 0.5f, 1.f, 3.f };
+			const float offsets[] = { -0.5f, 0.f, 0.5f };
+			UINT wrongCount = 0;
+			for (float height : heights)
+			{
+				for (float offset : offsets)
+				{
+					wrongCount += countWronglyCulled(clusters, vertices, indices, Vector3(offset, height, offset * 0.5f));
+				}
+			}
+
+			//  Ʒ   ɷ ˻簡 ǹ̰ ִ.
+			const MeshCluster& cluster = clusterList[0];
+			Vector3 toApex = cluster.ConeApex - Vector3(0.f, -2.f, 0.f);
+			toApex.Normalize();
+			const bool bCulledBelow = toApex.Dot(cluster.ConeAxis) >= cluster.ConeCutoff;
+
+			const bool bPassed = bCulledBelow && wrongCount == 0;
+			std::cout << "  concave cluster: cone apex y " << cluster.ConeApex.y
+				<< ", culled from below " << (bCulledBelow ? "yes" : "no") << ", front-facing triangles culled " << wrongCount
+				<< " " << (bPassed ? "ok" : "FAILED") << std::endl;
+
+			return bPassed;
+		}
+
+		bool runModel(const char* fileName)
+		{
+			enum { VIEW_COUNT = 32 };
+
+			std::vector<MeshVertex> vertices;
+			std::vector<UINT> indices;
+
+			if (!TextMeshParser::Load(fileName, &vertices, &indices))
+			{
+				std::cout << "  " << fileName << " not found FAILED" << std::endl;
+				return false;
+			}
+
+			const UINT vertexCount = static_cast<UINT>(vertices.size());
+			MeshOptimizer::Optimize(vertices.data(), vertexCount, indices.data(), indices.size(), &MeshVertex::Pos);
+
+			std::vector<UINT> clusterIndices = indices;
+			ClusterMesh clusters;
+			const double buildMs = MeasureMs(1, [&]()
+				{
+					clusterIndices = indices;
+					clusters.Build(vertices.data(), vertexCount, clusterIndices.data(), clusterIndices.size(), &MeshVertex::Pos);
+				});
+
+			const std::vector<MeshCluster>& clusterList = clusters.GetClusters();
+			UINT coneCount = 0;
+			double vertexSum = 0.0;
+			for (const MeshCluster& cluster : clusterList)
+			{
+				coneCount += cluster.ConeCutoff <= 1.f ? 1 : 0;
+				vertexSum += cluster.VertexCount;
+			}
+
+			const UINT triangleCount = static_cast<UINT>(indices.size() / 3);
+			const bool bValid = validateClusters(clusters, indices, clusterIndices);
+			std::cout << "  " << fileName << ": " << triangleCount << " triangles -> " << clusterList.size() << " clusters, avg "
+				<< vertexSum / clusterList.size() << " vertices, " << static_cast<double>(triangleCount) / clusterList.size() << " triangles, "
+				<< coneCount << " with cones, build " << buildMs << " ms"
+				<< (bValid ? "" : ", INVALID") << std::endl;
+
+			//    ָ ü  , ̼ Ϻθ    .
+			BoundingSphere bounds;
+			BoundingSphere::CreateFromPoints(bounds, vertices.size(), &vertices[0].Pos, sizeof(MeshVertex));
+			const Vector3 center = bounds.Center;
+
+			ClusterCullStatistics total = {};
+			UINT wrongCount = 0;
+			double cullMs = 0.0;
+			std::vector<IndexRange> ranges;
+
+			for (UINT view = 0; view < VIEW_COUNT; ++view)
+			{
+				const float angle = XM_2PI * view / VIEW_COUNT;
+				const float distance = bounds.Radius * (view % 2 == 0 ? 3.f : 1.2f);
+				const Vector3 eye = center + Vector3(cosf(angle) * distance, bounds.Radius * 0.5f * sinf(angle * 3.f), sinf(angle) * distance);
+
+				Camera camera;
+				camera.SetLens(0.25f * XM_PI, 16.f / 9.f, bounds.Radius * 0.01f, bounds.Radius * 10.f);
+				camera.LookAt(eye, center, Vector3(0.f, 1.f, 0.f));
+				camera.UpdateViewMatrix();
+
+				Vector4 planeArray[6];
+				D3DHelper::ExtractFrustumPlanes(planeArray, camera.GetViewProj());
+				FrustumPlanes planes;
+				planes.Set(planeArray);
+
+				ClusterCullStatistics statistics;
+				cullMs += MeasureMs(10, [&]()
+					{
+						clusters.Cull(planes, eye, &ranges, &statistics);
+					});
+
+				total.VisibleClusterCount += statistics.VisibleClusterCount;
+				total.TriangleCount += statistics.TriangleCount;
+				total.FrustumCulledTriangleCount += statistics.FrustumCulledTriangleCount;
+				total.BackfaceCulledTriangleCount += statistics.BackfaceCulledTriangleCount;
+				total.RangeCount += statistics.RangeCount;
+
+				wrongCount += countWronglyCulled(clusters, vertices, clusterIndices, eye);
+			}
+
+			const double toPercent = 100.0 / total.TriangleCount;
+			std::cout << "    " << VIEW_COUNT << " views: frustum rejects " << total.FrustumCulledTriangleCount * toPercent
+				<< "%, backface cone rejects " << total.BackfaceCulledTriangleCount * toPercent << "% of triangles" << std::endl;
+			std::cout << "    per view: " << static_cast<double>(total.VisibleClusterCount) / VIEW_COUNT << " visible clusters in "
+				<< static_cast<double>(total.RangeCount) / VIEW_COUNT << " draw ranges, cull " << cullMs / VIEW_COUNT * 1000.0 << " us"
+				<< ", front-facing triangles culled " << wrongCount << std::endl;
+
+			const bool bPassed = bValid && wrongCount == 0;
+			std::cout << "    " << (bPassed ? "ok" : "FAILED") << std::endl;
+
+			return bPassed;
+		}
+	}
+
+	bool RunClusterBenchmark()
+	{
+		std::cout << std::fixed << std::setprecision(3);
+		std::cout << "[cluster] meshlets of " << static_cast<UINT>(ClusterMesh::MAX_VERTICES) << " vertices / "
+			<< static_cast<UINT>(ClusterMesh::MAX_TRIANGLES) << " triangles, frustum + normal cone culling" << std::endl;
+
+		bool bPassed = runConcaveCluster();
+		bPassed = runModel("../Resource/Models/skull.txt") && bPassed;
+		bPassed = runModel("../Resource/Models/car.txt") && bPassed;
+
+		return bPassed;
+	}
+}
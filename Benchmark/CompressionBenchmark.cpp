@@ -0,0 +1,103 @@
+#include <windows.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "Benchmark.h"
+#include "SyntheticRig.h"
+#include "../ResourceManager/AnimationCompression.h"
+
+namespace benchmark
+{
+	using namespace DirectX::SimpleMath;
+	using namespace resourceManager;
+
+	namespace
+	{
+		enum { NODE_COUNT = 96, CLIP_COUNT = 3, POSE_COUNT = 4000, REPEAT_COUNT = 15, ROUND_COUNT = 3 };
+
+		const char* result(bool bPassed)
+		{
+			return bPassed ? "ok" : "FAILED";
+		}
+
+		// 60Hz POSE_COUNT   ϸ ø   ð(us)
+		template <typename Clip>
+		double measurePoseUs(const Clip& clip, const Skeleton& skeleton, float* sink)
+		{
+			LocalPose pose;
+			pose.Resize(skeleton.GetNodeCount());
+			std::vector<AnimationCursor> cursors(skeleton.GetNodeCount());
+
+			return MeasureMs(1, [&]()
+				{
+					for (int i = 0; i < POSE_COUNT; ++i)
+					{
+						const float time = fmodf(i / 60.f, static_cast<float>(clip.Duration));
+						clip.SamplePose(skeleton, time, cursors.data(), &pose);
+						*sink += pose.Rotations[1].x;
+					}
+				}) * 1000.0 / POSE_COUNT;
+		}
+	}
+
+	bool RunCompressionBenchmark()
+	{
+		std::cout << std::fixed << std::setprecision(3);
+		std::cout << "[compress] quantized clips with key reduction, " << NODE_COUNT << " nodes, "
+			<< SyntheticRig::KEYS_PER_SECOND << " keys/s on every track" << std::endl;
+
+		Skeleton skeleton;
+		std::vector<AnimationClip> clips;
+		SyntheticRig::Build(NODE_COUNT, CLIP_COUNT, 11, &skeleton, &clips);
+
+		const CompressionSettings settings;
+		bool bPassed = true;
+		float sink = 0.f;
+
+		for (const AnimationClip& clip : clips)
+		{
+			CompressedClip compressed;
+			CompressionStats stats;
+			const double compressMs = MeasureMs(1, [&]() { CompressedClip::Compress(clip, skeleton, settings, &compressed, &stats); });
+
+			//  ʿ  ʵ  REPEAT_COUNT   ּڰ .
+			//  ٸ Ź Ƿ ROUND_COUNT    з .
+			double sourceUs = 0.0;
+			double compressedUs = 0.0;
+			for (int round = 0; round < ROUND_COUNT && (round == 0 || compressedUs > sourceUs); ++round)
+			{
+				sourceUs = DBL_MAX;
+				compressedUs = DBL_MAX;
+				for (int repeat = 0; repeat < REPEAT_COUNT; ++repeat)
+				{
+					sourceUs = std::min<double>(sourceUs, measurePoseUs(clip, skeleton, &sink));
+					compressedUs = std::min<double>(compressedUs, measurePoseUs(compressed, skeleton, &sink));
+				}
+			}
+
+			// Ű     ð  Ƿ   ״  ʾƾ Ѵ.
+			const bool bClipValid = stats.MaxTranslationError <= settings.TranslationTolerance
+				&& stats.MaxRotationError <= settings.RotationTolerance
+				&& stats.MaxScaleError <= settings.ScaleTolerance;
+			// Ű ٰ ȭ  ۾ ĳø  Ƿ Ǯ   ־  Ŭ   ȴ.
+			const bool bFastEnough = compressedUs <= sourceUs;
+			bPassed = bPassed && bClipValid && bFastEnough;
+
+			std::cout << "  " << clip.Name << " (" << std::setprecision(1) << clip.Duration << " s): keys " << stats.SourceKeyCount
+				<< " -> " << stats.CompressedKeyCount << ", bytes " << stats.SourceBytes << " -> " << stats.CompressedBytes
+				<< " (" << static_cast<double>(stats.SourceBytes) / stats.CompressedBytes << "x), compress " << std::setprecision(3)
+				<< compressMs << " ms" << std::endl
+				<< std::setprecision(5) << "    max error: translation " << stats.MaxTranslationError << ", rotation "
+				<< stats.MaxRotationError * 57.29578f << " deg, scale " << stats.MaxScaleError << " " << result(bClipValid) << std::endl
+				<< std::setprecision(3) << "    sample pose: source " << sourceUs << " us, compressed " << compressedUs << " us "
+				<< result(bFastEnough) << std::endl;
+		}
+
+		std::cout << "  (sink " << sink << ")" << std::endl;
+		return bPassed;
+	}
+}
@@ -0,0 +1,166 @@
+#include <windows.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "JobSystem.h"
+#include "SyntheticRig.h"
+#include "../ResourceManager/CrowdAnimator.h"
+
+namespace benchmark
+{
+	using namespace common;
+	using namespace DirectX::SimpleMath;
+	using namespace resourceManager;
+
+	namespace
+	{
+		enum { NODE_COUNT = 64, CLIP_COUNT = 3, INSTANCE_COUNT = 4096, FRAME_COUNT = 20 };
+		enum { PHASE_COUNT = 8, MIN_SHARED_INSTANCE_COUNT = 1024, MAX_SHARED_INSTANCE_COUNT = 16384 };
+
+		const float FRAME_TIME = 1.f / 60.f;
+		//     ð ȭ  ̹Ƿ  ȷƮ ð ϴ ݿø ŭ ޶ Ѵ.
+		const float SHARED_POSE_TOLERANCE = 1e-3f;
+
+		//  õ  Ŭ  ð  ֹǷ ũ峢  ٷ   ִ.
+		void fillCrowd(const Skeleton& skeleton, const PaletteLayout& layout, const std::vector<AnimationClip>& clips, CrowdAnimator* crowd)
+		{
+			std::mt19937 random(5);
+			std::uniform_real_distribution<float> startTime(0.f, 4.f);
+
+			crowd->Clear();
+			for (UINT i = 0; i < INSTANCE_COUNT; ++i)
+			{
+				crowd->AddInstance(&skeleton, &layout, &clips[random() % clips.size()], startTime(random));
+			}
+		}
+
+		// Ŭ PHASE_COUNT  ðθ ϴ ,  Ŭ 󳢸  .
+		void fillLockstepCrowd(const Skeleton& skeleton, const PaletteLayout& layout, const std::vector<AnimationClip>& clips,
+			UINT instanceCount, CrowdAnimator* crowd)
+		{
+			std::mt19937 random(7);
+
+			crowd->Clear();
+			for (UINT i = 0; i < instanceCount; ++i)
+			{
+				const UINT phase = random() % PHASE_COUNT;
+				crowd->AddInstance(&skeleton, &layout, &clips[random() % clips.size()], phase * 15 * FRAME_TIME);
+			}
+		}
+
+		float getMaxPaletteDifference(const CrowdAnimator& lhs, const CrowdAnimator& rhs, UINT boneCount)
+		{
+			float maxDifference = 0.f;
+			for (UINT i = 0; i < lhs.GetInstanceCount(); ++i)
+			{
+				const float* lhsFloats = &lhs.GetPalette(i)->_11;
+				const float* rhsFloats = &rhs.GetPalette(i)->_11;
+				for (UINT k = 0; k < boneCount * 16; ++k)
+				{
+					maxDifference = std::max<float>(maxDifference, fabsf(lhsFloats[k] - rhsFloats[k]));
+				}
+			}
+
+			return maxDifference;
+		}
+
+		// νϽ  ÷ Ű  Ŭ  x   ̹Ƿ ϸ    ״ο Ѵ.
+		//  ȷƮ Ȯ ð  ȷƮ   ȿ  true
+		bool runSharedPoseBenchmark(const Skeleton& skeleton, const PaletteLayout& layout, const std::vector<AnimationClip>& clips)
+		{
+			std::cout << "[crowd] shared poses, " << static_cast<UINT>(CLIP_COUNT) << " clips x " << static_cast<UINT>(PHASE_COUNT)
+				<< " phases, time quantum " << FRAME_TIME * 1000.f << " ms, single thread" << std::endl;
+			std::cout << "  instances  exact ms  shared ms  entries  created/frame  speedup  max error (tolerance " << SHARED_POSE_TOLERANCE << ")" << std::endl;
+
+			bool bPassed = true;
+
+			for (UINT instanceCount = MIN_SHARED_INSTANCE_COUNT; instanceCount <= MAX_SHARED_INSTANCE_COUNT; instanceCount *= 2)
+			{
+				CrowdAnimator exact;
+				fillLockstepCrowd(skeleton, layout, clips, instanceCount, &exact);
+				const double exactMs = MeasureMs(FRAME_COUNT, [&]() { exact.Update(FRAME_TIME, nullptr); });
+
+				CrowdAnimator shared;
+				fillLockstepCrowd(skeleton, layout, clips, instanceCount, &shared);
+				shared.SetPoseSharing(FRAME_TIME);
+				const double sharedMs = MeasureMs(FRAME_COUNT, [&]() { shared.Update(FRAME_TIME, nullptr); });
+
+				const PoseCache::Stats& stats = shared.GetPoseCache().GetStats();
+				const float maxError = getMaxPaletteDifference(exact, shared, layout.GetBoneCount());
+				const bool bWithinTolerance = maxError <= SHARED_POSE_TOLERANCE;
+				bPassed = bPassed && bWithinTolerance;
+
+				std::cout << "  " << std::left << std::setw(9) << instanceCount << std::right
+					<< std::setw(10) << exactMs << std::setw(11) << sharedMs << std::setw(9) << stats.EntryCount
+					<< std::setw(15) << stats.CreatedCount << std::setw(9) << exactMs / sharedMs
+					<< std::setw(11) << maxError << " " << (bWithinTolerance ? "ok" : "FAILED") << std::endl;
+			}
+
+			return bPassed;
+		}
+
+		bool isPaletteEqual(const CrowdAnimator& lhs, const CrowdAnimator& rhs, UINT boneCount)
+		{
+			for (UINT i = 0; i < lhs.GetInstanceCount(); ++i)
+			{
+				if (memcmp(lhs.GetPalette(i), rhs.GetPalette(i), sizeof(Matrix) * boneCount) != 0)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+	}
+
+	bool RunCrowdBenchmark()
+	{
+		Skeleton skeleton;
+		std::vector<AnimationClip> clips;
+		PaletteLayout layout;
+		SyntheticRig::Build(NODE_COUNT, CLIP_COUNT, 3, &skeleton, &clips);
+		SyntheticRig::BuildPaletteLayout(skeleton, &layout);
+
+		CrowdAnimator reference;
+		fillCrowd(skeleton, layout, clips, &reference);
+		const double serialMs = MeasureMs(FRAME_COUNT, [&]() { reference.Update(FRAME_TIME, nullptr); });
+
+		std::cout << std::fixed << std::setprecision(3);
+		std::cout << "[crowd] instances " << static_cast<UINT>(INSTANCE_COUNT) << ", nodes " << static_cast<UINT>(NODE_COUNT)
+			<< ", clips " << static_cast<UINT>(CLIP_COUNT) << ", pose + palette per instance per frame" << std::endl;
+		std::cout << "  threads  ms/frame  instances/ms  speedup  identical" << std::endl;
+
+		// ھ ϳ̾   İ  ˻ؾ ϹǷ ּ 2 .
+		const UINT maxThreadCount = std::max<UINT>(GetHardwareThreadCount(), 2);
+		bool bPassed = true;
+		for (UINT threadCount = 1; threadCount <= maxThreadCount; ++threadCount)
+		{
+			double frameMs = serialMs;
+			bool bIdentical = true;
+
+			// Ŀ  0 ھ  ߶ ̹Ƿ 1   Ѵ.
+			if (threadCount > 1)
+			{
+				JobSystem jobSystem(threadCount - 1);
+				CrowdAnimator crowd;
+				fillCrowd(skeleton, layout, clips, &crowd);
+
+				frameMs = MeasureMs(FRAME_COUNT, [&]() { crowd.Update(FRAME_TIME, &jobSystem); });
+				bIdentical = isPaletteEqual(reference, crowd, layout.GetBoneCount());
+				bPassed = bPassed && bIdentical;
+			}
+
+			std::cout << "  " << std::left << std::setw(9) << threadCount << std::right
+				<< std::setw(8) << frameMs << "  " << std::setw(12) << INSTANCE_COUNT / frameMs << "  "
+				<< std::setw(7) << serialMs / frameMs << "  " << (bIdentical ? "yes" : "NO") << std::endl;
+		}
+
+		return runSharedPoseBenchmark(skeleton, layout, clips) && bPassed;
+	}
+}
@@ -0,0 +1,175 @@
+#include <windows.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Camera.h"
+#include "D3DUtil.h"
+#include "FrustumCuller.h"
+#include "JobSystem.h"
+
+namespace benchmark
+{
+	using namespace common;
+	using namespace DirectX;
+	using namespace DirectX::SimpleMath;
+
+	namespace
+	{
+		// InstancingAndCulling  νϽ ۿ  ũ
+		struct InstancedData
+		{
+			Matrix World;
+			Color Color;
+		};
+	}
+
+	bool RunCullingBenchmark()
+	{
+		enum { INSTANCE_COUNT = 1 << 20 };
+		enum { ITERATION_COUNT = 20 };
+		const float HALF = 500.f;
+		const double BOUNDARY_TOLERANCE = 1e-3;
+
+		//       õ带 Ѵ.
+		std::mt19937 random(1234);
+		std::uniform_real_distribution<float> position(-HALF, HALF);
+
+		std::vector<InstancedData> source(INSTANCE_COUNT);
+		std::vector<InstancedData> reference(INSTANCE_COUNT);
+		std::vector<InstancedData> dest(INSTANCE_COUNT);
+		// νϽ ̵ ϹǷ ó ũ⸦ ϴ ÷ , ڽ ũ⸦ δ ÷ Ѵ.
+		FrustumCuller culler;
+		culler.SetSharedExtents(Vector3(1.f, 1.f, 1.f));
+		culler.Resize(INSTANCE_COUNT);
+		FrustumCuller boxCuller;
+		boxCuller.Resize(INSTANCE_COUNT);
+
+		const BoundingBox localBox(Vector3(0.f, 0.f, 0.f), Vector3(1.f, 1.f, 1.f));
+		for (UINT i = 0; i < INSTANCE_COUNT; ++i)
+		{
+			source[i].World = Matrix::CreateTranslation(position(random), position(random), position(random));
+			source[i].Color = Color(1.f, 1.f, 1.f, 1.f);
+
+			BoundingBox worldBox;
+			localBox.Transform(worldBox, source[i].World);
+			culler.SetCenter(i, worldBox.Center);
+			boxCuller.SetBounds(i, worldBox);
+		}
+
+		Camera camera;
+		camera.SetLens(0.25f * XM_PI, 16.f / 9.f, 1.f, 1000.f);
+		camera.LookAt(Vector3(0.f, 0.f, -HALF), Vector3(0.f, 0.f, 0.f), Vector3(0.f, 1.f, 0.f));
+		camera.UpdateViewMatrix();
+
+		Vector4 worldPlanes[6];
+		D3DHelper::ExtractFrustumPlanes(worldPlanes, camera.GetViewProj());
+
+		FrustumPlanes planes;
+		planes.Set(worldPlanes);
+
+		//  ˻縸  , ̴ ε .
+		std::vector<UINT> boxIndices(INSTANCE_COUNT);
+		std::vector<UINT> sharedIndices(INSTANCE_COUNT);
+		UINT boxVisibleCount = 0;
+		UINT sharedVisibleCount = 0;
+		const double boxCullMs = MeasureMs(ITERATION_COUNT, [&]()
+			{
+				boxVisibleCount = boxCuller.Cull(planes, 0, INSTANCE_COUNT, &boxIndices[0]);
+			});
+		const double sharedCullMs = MeasureMs(ITERATION_COUNT, [&]()
+			{
+				sharedVisibleCount = culler.Cull(planes, 0, INSTANCE_COUNT, &sharedIndices[0]);
+			});
+		//  W ̸ ϸ   ٲǷ 鿡  ģ νϽ    ִ.
+		std::vector<UINT> differentIndices;
+		std::set_symmetric_difference(boxIndices.begin(), boxIndices.begin() + boxVisibleCount,
+			sharedIndices.begin(), sharedIndices.begin() + sharedVisibleCount, std::back_inserter(differentIndices));
+
+		UINT offPlaneCount = 0;
+		for (UINT index : differentIndices)
+		{
+			const Vector3 center = source[index].World.Translation();
+			double minMargin = DBL_MAX;
+			for (int i = 0; i < 6; ++i)
+			{
+				const Vector4& plane = worldPlanes[i];
+				const double margin = static_cast<double>(plane.x) * center.x + static_cast<double>(plane.y) * center.y
+					+ static_cast<double>(plane.z) * center.z + plane.w
+					+ fabs(plane.x) * localBox.Extents.x + fabs(plane.y) * localBox.Extents.y + fabs(plane.z) * localBox.Extents.z;
+				minMargin = std::min<double>(minMargin, fabs(margin));
+			}
+			offPlaneCount += minMargin > BOUNDARY_TOLERANCE ? 1 : 0;
+		}
+		bool bPassed = offPlaneCount == 0;
+
+		UINT referenceCount = 0;
+		double serialMs = MeasureMs(ITERATION_COUNT, [&]()
+			{
+				referenceCount = culler.CullCopy(planes, &source[0], &reference[0]);
+			});
+
+		const double megabyte = 1024.0 * 1024.0;
+		std::cout << std::fixed << std::setprecision(3);
+		std::cout << "[culling] instances " << static_cast<UINT>(INSTANCE_COUNT) << ", visible " << referenceCount << ", batch "
+			<< static_cast<UINT>(FrustumCuller::BATCH_SIZE) <<
+#if defined(__AVX__)
+			" (AVX)"
+#else
+			" (SSE x2)"
+#endif
+			<< std::endl;
+		std::cout << "  cull per-instance box  " << boxCuller.GetBoundsByteSize() / megabyte << " MB  " << boxCullMs << " ms" << std::endl;
+		std::cout << "  cull shared extents    " << culler.GetBoundsByteSize() / megabyte << " MB  " << sharedCullMs << " ms  differs on "
+			<< differentIndices.size() << " instances touching a plane " << (bPassed ? "ok" : "FAILED") << std::endl;
+		std::cout << "  cull + copy " << sizeof(InstancedData) << " byte instances, identical also checks the parallel indices" << std::endl;
+		std::cout << "  threads  ms       speedup  steals  identical" << std::endl;
+
+		// ھ ϳ̾  ΰ İ  ˻ؾ ϹǷ ּ 2 .
+		const UINT maxThreadCount = std::max<UINT>(GetHardwareThreadCount(), 2);
+		for (UINT threadCount = 1; threadCount <= maxThreadCount; ++threadCount)
+		{
+			// Ŀ  0 ھ  ߶ ̹Ƿ 1   Ѵ.
+			if (threadCount == 1)
+			{
+				std::cout << "  1        " << serialMs << "    1.000    0       yes" << std::endl;
+				continue;
+			}
+
+			JobSystem jobSystem(threadCount - 1);
+			UINT visibleCount = 0;
+			UINT stealCount = 0;
+
+			double parallelMs = MeasureMs(ITERATION_COUNT, [&]()
+				{
+					visibleCount = culler.CullCopy(planes, &source[0], &dest[0], &jobSystem);
+					stealCount += jobSystem.GetStealCount();
+				});
+
+			// LOD ΰ   ε ø  Cull  ε    Ѵ.
+			std::vector<UINT> parallelIndices(INSTANCE_COUNT);
+			const UINT parallelIndexCount = culler.Cull(planes, &parallelIndices[0], &jobSystem);
+
+			//   ޶   ƾ Ѵ.
+			bool bIdentical = visibleCount == referenceCount
+				&& memcmp(&dest[0], &reference[0], sizeof(InstancedData) * visibleCount) == 0
+				&& parallelIndexCount == sharedVisibleCount
+				&& memcmp(&parallelIndices[0], &sharedIndices[0], sizeof(UINT) * parallelIndexCount) == 0;
+			bPassed = bPassed && bIdentical;
+
+			std::cout << "  " << std::left << std::setw(9) << threadCount << std::right
+				<< parallelMs << "    " << serialMs / parallelMs << "    "
+				<< std::left << std::setw(8) << stealCount / ITERATION_COUNT << std::right
+				<< (bIdentical ? "yes" : "NO") << std::endl;
+		}
+
+		return bPassed;
+	}
+}
@@ -0,0 +1,161 @@
+#include <windows.h>
+#include <algorithm>
+#include <cfloat>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Camera.h"
+#include "LodSelector.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "TextMeshParser.h"
+
+namespace benchmark
+{
+	using namespace common;
+	using namespace DirectX;
+	using namespace DirectX::SimpleMath;
+
+	namespace
+	{
+		enum { SAMPLE_COUNT = 512 };
+
+		// ǥ Ÿ  ѵ,     
+		const float MAX_SAMPLED_ERROR_RATIO = 0.05f;
+
+		//  ﰢ ִ Ÿ  (Ericson, Real-Time Collision Detection 5.1.5)
+		float distanceSquaredToTriangle(const Vector3& p, const Vector3& a, const Vector3& b, const Vector3& c)
+		{
+			const Vector3 ab = b - a;
+			const Vector3 ac = c - a;
+			const Vector3 ap = p - a;
+			const float d1 = ab.Dot(ap);
+			const float d2 = ac.Dot(ap);
+			if (d1 <= 0.f && d2 <= 0.f) return ap.LengthSquared();
+
+			const Vector3 bp = p - b;
+			const float d3 = ab.Dot(bp);
+			const float d4 = ac.Dot(bp);
+			if (d3 >= 0.f && d4 <= d3) return bp.LengthSquared();
+
+			const float vc = d1 * d4 - d3 * d2;
+			if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f)
+			{
+				return (p - (a + ab * (d1 / (d1 - d3)))).LengthSquared();
+			}
+
+			const Vector3 cp = p - c;
+			const float d5 = ab.Dot(cp);
+			const float d6 = ac.Dot(cp);
+			if (d6 >= 0.f && d5 <= d6) return cp.LengthSquared();
+
+			const float vb = d5 * d2 - d1 * d6;
+			if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f)
+			{
+				return (p - (a + ac * (d2 / (d2 - d6)))).LengthSquared();
+			}
+
+			const float va = d3 * d6 - d5 * d4;
+			if (va <= 0.f && (d4 - d3) >= 0.f && (d5 - d6) >= 0.f)
+			{
+				return (p - (b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6))))).LengthSquared();
+			}
+
+			const float denom = 1.f / (va + vb + vc);
+			return (p - (a + ab * (vb * denom) + ac * (vc * denom))).LengthSquared();
+		}
+
+		//   Ϻο LOD ǥ   Ÿ, ܼȭ  ġ ϱ  ǥ 
+		float measureDistance(const std::vector<MeshVertex>& vertices, const std::vector<UINT>& sourceIndices,
+			const UINT* lodIndices, UINT lodIndexCount)
+		{
+			const size_t step = std::max<size_t>(sourceIndices.size() / SAMPLE_COUNT, 1);
+			float maxDistanceSquared = 0.f;
+
+			for (size_t i = 0; i < sourceIndices.size(); i += step)
+			{
+				const Vector3& p = vertices[sourceIndices[i]].Pos;
+				float best = FLT_MAX;
+
+				for (UINT j = 0; j < lodIndexCount; j += 3)
+				{
+					best = std::min<float>(best, distanceSquaredToTriangle(p,
+						vertices[lodIndices[j + 0]].Pos, vertices[lodIndices[j + 1]].Pos, vertices[lodIndices[j + 2]].Pos));
+				}
+
+				maxDistanceSquared = std::max<float>(maxDistanceSquared, best);
+			}
+
+			return sqrtf(maxDistanceSquared);
+		}
+
+		bool runModel(const char* fileName)
+		{
+			std::vector<MeshVertex> vertices;
+			std::vector<UINT> indices;
+
+			if (!TextMeshParser::Load(fileName, &vertices, &indices))
+			{
+				std::cout << "  " << fileName << " not found" << std::endl;
+				return true;
+			}
+
+			const UINT vertexCount = static_cast<UINT>(vertices.size());
+			MeshOptimizer::Optimize(vertices.data(), vertexCount, indices.data(), indices.size(), &MeshVertex::Pos);
+
+			//   1 ޽ ũ 1% Ÿ .
+			const float normalWeights[3] = { 0.01f, 0.01f, 0.01f };
+			std::vector<UINT> lodIndices;
+			std::vector<MeshLod> lods;
+			const double buildMs = MeasureMs(1, [&]()
+				{
+					MeshSimplifier::BuildLodChain(indices.data(), indices.size(), &vertices[0].Pos.x, sizeof(MeshVertex), vertexCount,
+						&lodIndices, &lods, MeshSimplifier::DEFAULT_LOD_COUNT,
+						&vertices[0].Normal.x, sizeof(MeshVertex), normalWeights, 3);
+				});
+
+			BoundingSphere bounds;
+			BoundingSphere::CreateFromPoints(bounds, vertices.size(), &vertices[0].Pos, sizeof(MeshVertex));
+
+			std::cout << "  " << fileName << ": " << lods.size() << " levels, radius " << bounds.Radius
+				<< ", build " << buildMs << " ms" << std::endl;
+
+			// 1080p,  þ߰ 45 1ȼ   LOD  ϴ Ÿ
+			Camera camera;
+			camera.SetLens(0.25f * XM_PI, 16.f / 9.f, 1.f, 1000.f);
+			LodSelector selector;
+			selector.SetCamera(camera, 1080.f);
+
+			float maxMeasured = 0.f;
+			for (size_t i = 0; i < lods.size(); ++i)
+			{
+				const MeshLod& lod = lods[i];
+				const float measured = i == 0 ? 0.f : measureDistance(vertices, indices, &lodIndices[lod.IndexStart], lod.IndexCount);
+				const float switchDistance = selector.GetPixelError(lod.Error, 1.f);
+				maxMeasured = std::max<float>(maxMeasured, measured);
+
+				std::cout << "    LOD " << i << ": " << std::setw(6) << lod.IndexCount / 3 << " triangles, error " << lod.Error
+					<< " (sampled " << measured << "), 1px at distance " << switchDistance << std::endl;
+			}
+
+			const float maxAllowed = bounds.Radius * MAX_SAMPLED_ERROR_RATIO;
+			const bool bPassed = maxMeasured <= maxAllowed;
+			std::cout << "    max sampled error " << maxMeasured << " (limit " << maxAllowed << ") " << (bPassed ? "ok" : "FAILED") << std::endl;
+
+			return bPassed;
+		}
+	}
+
+	bool RunLodBenchmark()
+	{
+		std::cout << std::fixed << std::setprecision(3);
+		std::cout << "[lod] quadric edge collapse chain, screen-space error selection" << std::endl;
+
+		bool bPassed = runModel("../Resource/Models/skull.txt");
+		bPassed = runModel("../Resource/Models/car.txt") && bPassed;
+
+		return bPassed;
+	}
+}
@@ -0,0 +1,238 @@
+#include <windows.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "VertexPacking.h"
+
+namespace benchmark
+{
+	using namespace common;
+
+	namespace
+	{
+		// ڵ  ġ,  FAILED
+		const float MAX_OCTAHEDRAL_ERROR_DEGREES = 0.01f; // 32Ʈ ȸü ̷л 0.01 
+		const float MAX_HALF_RELATIVE_ERROR = 1.0f / 2048.0f; // half  10Ʈ ݿø 
+		const float MAX_WEIGHT_ERROR = 1.0f / 255.0f;
+
+		const char* result(bool bPassed)
+		{
+			return bPassed ? "ok" : "FAILED";
+		}
+
+		//     ⿡ , 밢,    Ѵ.
+		std::vector<Vector3> makeDirections(UINT count)
+		{
+			std::vector<Vector3> directions;
+			directions.reserve(count + 32);
+
+			const float goldenAngle = XM_PI * (3.0f - sqrtf(5.0f));
+			for (UINT i = 0; i < count; ++i)
+			{
+				const float y = 1.0f - 2.0f * (i + 0.5f) / count;
+				const float radius = sqrtf(std::max<float>(1.0f - y * y, 0.0f));
+				const float theta = goldenAngle * i;
+				directions.push_back(Vector3(cosf(theta) * radius, y, sinf(theta) * radius));
+			}
+
+			for (int x = -1; x <= 1; ++x)
+			{
+				for (int y = -1; y <= 1; ++y)
+				{
+					for (int z = -1; z <= 1; ++z)
+					{
+						if (x != 0 || y != 0 || z != 0)
+						{
+							Vector3 direction(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z));
+							direction.Normalize();
+							directions.push_back(direction);
+						}
+					}
+				}
+			}
+
+			return directions;
+		}
+
+		bool testOctahedral()
+		{
+			enum { DIRECTION_COUNT = 1 << 20 };
+
+			const std::vector<Vector3> directions = makeDirections(DIRECTION_COUNT);
+			std::vector<short> encoded(directions.size() * 2);
+
+			const double encodeMs = MeasureMs(1, [&]()
+				{
+					for (size_t i = 0; i < directions.size(); ++i)
+					{
+						VertexPacking::EncodeOctahedral(directions[i], &encoded[i * 2]);
+					}
+				});
+
+			double maxError = 0.0;
+			for (size_t i = 0; i < directions.size(); ++i)
+			{
+				const Vector3 decoded = VertexPacking::DecodeOctahedral(&encoded[i * 2]);
+				// float  acos 1 ó е ڶ double  ̷  .
+				const Vector3& d = directions[i];
+				const double cx = static_cast<double>(decoded.y) * d.z - static_cast<double>(decoded.z) * d.y;
+				const double cy = static_cast<double>(decoded.z) * d.x - static_cast<double>(decoded.x) * d.z;
+				const double cz = static_cast<double>(decoded.x) * d.y - static_cast<double>(decoded.y) * d.x;
+				const double dot = static_cast<double>(decoded.x) * d.x + static_cast<double>(decoded.y) * d.y + static_cast<double>(decoded.z) * d.z;
+				maxError = std::max<double>(maxError, atan2(sqrt(cx * cx + cy * cy + cz * cz), dot) * 180.0 / XM_PI);
+			}
+
+			const bool bPassed = maxError <= MAX_OCTAHEDRAL_ERROR_DEGREES;
+			std::cout << "  octahedral snorm16  " << directions.size() << " directions, max error " << std::setprecision(5) << maxError
+				<< " deg (bound " << MAX_OCTAHEDRAL_ERROR_DEGREES << "), encode " << std::setprecision(3)
+				<< directions.size() / (encodeMs * 1000.0) << " M/s  " << result(bPassed) << std::endl;
+
+			return bPassed;
+		}
+
+		bool testHalf()
+		{
+			// half -> float -> half NaN   Ʈ  ״ ƿ; Ѵ.
+			UINT roundTripMismatches = 0;
+			for (UINT bits = 0; bits <= 0xffff; ++bits)
+			{
+				const bool bNaN = (bits & 0x7c00) == 0x7c00 && (bits & 0x03ff) != 0;
+				const unsigned short half = static_cast<unsigned short>(bits);
+
+				if (!bNaN && VertexPacking::FloatToHalf(VertexPacking::HalfToFloat(half)) != half)
+				{
+					++roundTripMismatches;
+				}
+			}
+
+			// UV    ݿø  ȿ ־ Ѵ. Ÿϸ UV  [-64, 64] .
+			std::mt19937 random(11);
+			std::uniform_real_distribution<float> distribution(-64.0f, 64.0f);
+			float maxRelativeError = 0.0f;
+			float maxUnitError = 0.0f;
+
+			for (int i = 0; i < 1 << 20; ++i)
+			{
+				const float value = i < 1 << 19 ? distribution(random) * (1.0f / 64.0f) : distribution(random);
+				const float decoded = VertexPacking::HalfToFloat(VertexPacking::FloatToHalf(value));
+				const float error = fabsf(decoded - value);
+
+				if (fabsf(value) >= 1.0f / 16384.0f)
+				{
+					maxRelativeError = std::max<float>(maxRelativeError, error / fabsf(value));
+				}
+				if (fabsf(value) <= 1.0f)
+				{
+					maxUnitError = std::max<float>(maxUnitError, error);
+				}
+			}
+
+			const bool bPassed = roundTripMismatches == 0 && maxRelativeError <= MAX_HALF_RELATIVE_ERROR;
+			std::cout << "  half                round trip mismatches " << roundTripMismatches
+				<< ", max relative error " << std::setprecision(7) << maxRelativeError
+				<< " (bound " << MAX_HALF_RELATIVE_ERROR << "), max error in [0, 1] " << maxUnitError
+				<< std::setprecision(3) << "  " << result(bPassed) << std::endl;
+
+			return bPassed;
+		}
+
+		bool testWeights()
+		{
+			std::mt19937 random(7);
+			std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+			UINT badSums = 0;
+			float maxError = 0.0f;
+
+			for (int i = 0; i < 1 << 20; ++i)
+			{
+				//   1~4,  0
+				float weights[4] = { 0.0f, };
+				const int influenceCount = 1 + (i & 3);
+				float sum = 0.0f;
+
+				for (int j = 0; j < influenceCount; ++j)
+				{
+					weights[j] = distribution(random);
+					sum += weights[j];
+				}
+
+				for (int j = 0; j < influenceCount; ++j)
+				{
+					weights[j] /= sum;
+				}
+
+				BYTE quantized[4];
+				VertexPacking::QuantizeWeights(weights, quantized);
+
+				const UINT quantizedSum = quantized[0] + quantized[1] + quantized[2] + quantized[3];
+				badSums += quantizedSum != 255 ? 1 : 0;
+
+				for (int j = 0; j < 4; ++j)
+				{
+					maxError = std::max<float>(maxError, fabsf(quantized[j] / 255.0f - weights[j]));
+				}
+			}
+
+			const bool bPassed = badSums == 0 && maxError <= MAX_WEIGHT_ERROR;
+			std::cout << "  weights unorm8      sums != 255 " << badSums << ", max error " << std::setprecision(5) << maxError
+				<< " (bound " << MAX_WEIGHT_ERROR << ")" << std::setprecision(3) << "  " << result(bPassed) << std::endl;
+
+			return bPassed;
+		}
+
+		bool testIndices()
+		{
+			// 16Ʈ  ڿ 32Ʈ  ٿ İ  Ǵ .
+			const UINT smallVertexCount = 65536;
+			const UINT largeVertexCount = 70000;
+			std::vector<UINT> smallIndices = { 0, 1, 65535 };
+			std::vector<UINT> largeIndices = { 0, 65536, 69999 };
+
+			std::vector<BYTE> buffer;
+			UINT smallOffset = 0;
+			UINT largeOffset = 0;
+			const DXGI_FORMAT smallFormat = VertexPacking::AppendIndices(smallIndices.data(), smallIndices.size(), smallVertexCount, &buffer, &smallOffset);
+			const DXGI_FORMAT largeFormat = VertexPacking::AppendIndices(largeIndices.data(), largeIndices.size(), largeVertexCount, &buffer, &largeOffset);
+
+			bool bPassed = smallFormat == DXGI_FORMAT_R16_UINT && largeFormat == DXGI_FORMAT_R32_UINT
+				&& smallOffset == 0 && largeOffset % sizeof(UINT) == 0 && buffer.size() == largeOffset + largeIndices.size() * sizeof(UINT);
+
+			for (size_t i = 0; bPassed && i < smallIndices.size(); ++i)
+			{
+				unsigned short value;
+				memcpy(&value, &buffer[smallOffset + i * sizeof(value)], sizeof(value));
+				bPassed = value == smallIndices[i];
+			}
+
+			for (size_t i = 0; bPassed && i < largeIndices.size(); ++i)
+			{
+				UINT value;
+				memcpy(&value, &buffer[largeOffset + i * sizeof(value)], sizeof(value));
+				bPassed = value == largeIndices[i];
+			}
+
+			std::cout << "  indices             16/32 bit subsets in one buffer  " << result(bPassed) << std::endl;
+
+			return bPassed;
+		}
+	}
+
+	bool RunPackBenchmark()
+	{
+		std::cout << std::fixed << std::setprecision(3);
+		std::cout << "[pack] vertex quantization round trip" << std::endl;
+
+		const bool bOctahedral = testOctahedral();
+		const bool bHalf = testHalf();
+		const bool bWeights = testWeights();
+		const bool bIndices = testIndices();
+
+		return bOctahedral && bHalf && bWeights && bIndices;
+	}
+}
@@ -0,0 +1,255 @@
+#include <windows.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Bvh.h"
+#include "JobSystem.h"
+#include "MeshCache.h"
+#include "TextMeshParser.h"
+
+namespace benchmark
+{
+	using namespace common;
+
+	namespace
+	{
+		//  õ   Ʈ δ,  
+		bool parseWithStream(const std::string& text, std::vector<MeshVertex>* outVertices, std::vector<UINT>* outIndices)
+		{
+			std::istringstream fin(text);
+
+			UINT vcount = 0;
+			UINT tcount = 0;
+			std::string ignore;
+
+			fin >> ignore >> vcount;
+			fin >> ignore >> tcount;
+			fin >> ignore >> ignore >> ignore >> ignore;
+
+			std::vector<MeshVertex>& vertices = *outVertices;
+			vertices.resize(vcount);
+			for (UINT i = 0; i < vcount; ++i)
+			{
+				fin >> vertices[i].Pos.x >> vertices[i].Pos.y >> vertices[i].Pos.z;
+				fin >> vertices[i].Normal.x >> vertices[i].Normal.y >> vertices[i].Normal.z;
+				vertices[i].Tex = Vector2(0.0f, 0.0f);
+			}
+
+			fin >> ignore;
+			fin >> ignore;
+			fin >> ignore;
+
+			std::vector<UINT>& indices = *outIndices;
+			indices.resize(tcount * 3);
+			for (UINT i = 0; i < tcount; ++i)
+			{
+				fin >> indices[i * 3 + 0] >> indices[i * 3 + 1] >> indices[i * 3 + 2];
+			}
+
+			return !fin.fail();
+		}
+
+		// Ʈ  ٸ float 
+		UINT countMismatches(const std::vector<MeshVertex>& a, const std::vector<MeshVertex>& b)
+		{
+			if (a.size() != b.size())
+			{
+				return static_cast<UINT>(a.size() > b.size() ? a.size() : b.size());
+			}
+
+			const UINT floatCount = static_cast<UINT>(a.size() * sizeof(MeshVertex) / sizeof(float));
+			const UINT* bitsA = reinterpret_cast<const UINT*>(a.data());
+			const UINT* bitsB = reinterpret_cast<const UINT*>(b.data());
+			UINT count = 0;
+
+			for (UINT i = 0; i < floatCount; ++i)
+			{
+				count += bitsA[i] != bitsB[i] ? 1 : 0;
+			}
+
+			return count;
+		}
+
+		bool writeBytes(const char* fileName, const std::vector<char>& bytes)
+		{
+			std::ofstream fout(fileName, std::ios_base::binary | std::ios_base::trunc);
+			fout.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+			return !fout.fail();
+		}
+
+		// Ľ ޽ø BVH, ֺ Ű Բ ĳ÷  ٽ . ε BVH ߸    ȴ.
+		bool checkMeshCache(const std::vector<MeshVertex>& vertices, const std::vector<UINT>& indices)
+		{
+			const char* cacheFileName = "parse_benchmark.mesh";
+
+			std::vector<Vector3> positions(vertices.size());
+			for (size_t i = 0; i < vertices.size(); ++i)
+			{
+				positions[i] = vertices[i].Pos;
+			}
+
+			Bvh bvh;
+			bvh.Build(positions, indices);
+
+			const std::vector<float> ambientAccess(vertices.size(), 0.5f);
+			const MeshCache::AmbientBakeKey ambientKey = { 32, 7, 1 };
+			if (!MeshCache::Write(cacheFileName, vertices, indices, &ambientAccess, &ambientKey, &bvh))
+			{
+				std::cout << "    mesh cache: failed to write " << cacheFileName << std::endl;
+				return false;
+			}
+
+			bool bRoundTrip = false;
+			{
+				MeshCache cache;
+				Bvh loadedBvh;
+				bRoundTrip = cache.Open(cacheFileName) && cache.GetBvh(&loadedBvh)
+					&& cache.GetAmbientKey().SampleCount == ambientKey.SampleCount && cache.GetAmbientKey().Seed == ambientKey.Seed
+					&& cache.GetAmbientKey().Algorithm == ambientKey.Algorithm
+					&& loadedBvh.GetNodes().size() == bvh.GetNodes().size() && loadedBvh.GetTriangleIndices() == bvh.GetTriangleIndices();
+			}
+
+			std::ifstream fin(cacheFileName, std::ios_base::binary);
+			const std::vector<char> image((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
+			fin.close();
+
+			const MeshCache::Header& header = *reinterpret_cast<const MeshCache::Header*>(image.data());
+
+			//   ߸    .  
+			auto isRejected = [&](auto corrupt)
+				{
+					std::vector<char> corrupted = image;
+					corrupt(&corrupted, reinterpret_cast<MeshCache::Header*>(corrupted.data()));
+
+					MeshCache cache;
+					return writeBytes(cacheFileName, corrupted) && !cache.Open(cacheFileName);
+				};
+
+			const bool bIndexRejected = isRejected([&](std::vector<char>* bytes, MeshCache::Header*)
+				{
+					UINT* cachedIndices = reinterpret_cast<UINT*>(bytes->data() + header.Sections[MeshCache::SECTION_INDICES].Offset);
+					cachedIndices[indices.size() / 2] = header.VertexCount;
+				});
+			const bool bSectionRejected = isRejected([&](std::vector<char>*, MeshCache::Header* corruptedHeader)
+				{
+					corruptedHeader->Sections[MeshCache::SECTION_BVH_TRIANGLE_INDICES].Size -= sizeof(UINT);
+				});
+			const bool bNodeRejected = isRejected([&](std::vector<char>* bytes, MeshCache::Header*)
+				{
+					BvhNode* nodes = reinterpret_cast<BvhNode*>(bytes->data() + header.Sections[MeshCache::SECTION_BVH_NODES].Offset);
+					nodes[0].TriangleCount = 0;
+					nodes[0].LeftFirst = header.BvhNodeCount;
+				});
+
+			std::remove(cacheFileName);
+
+			const bool bPassed = bRoundTrip && bIndexRejected && bSectionRejected && bNodeRejected;
+			std::cout << "    mesh cache: round trip " << (bRoundTrip ? "ok" : "FAILED")
+				<< ", bad index " << (bIndexRejected ? "rejected" : "ACCEPTED")
+				<< ", bad bvh section " << (bSectionRejected ? "rejected" : "ACCEPTED")
+				<< ", bad bvh node " << (bNodeRejected ? "rejected" : "ACCEPTED") << std::endl;
+
+			return bPassed;
+		}
+
+		//   Ͽ    ŭ ũ Ҵ  ϰ,  ڸ ּҷ    Ѵ.
+		bool checkRecordCounts()
+		{
+			const std::string oversized = "VertexCount: 4000000000\nTriangleCount: 1\nVertexList (pos, normal)\n{\n0 0 0 0 0 1\n}\nTriangleList\n{\n0 0 0\n}\n";
+			const std::string minimal = "VertexCount: 1\nTriangleCount: 1\nVertexList (pos, normal)\n{\n0 0 0 0 0 1}\nTriangleList\n{\n0 0 0}";
+
+			std::vector<MeshVertex> vertices;
+			std::vector<UINT> indices;
+			const bool bOversizedRejected = !TextMeshParser::Parse(oversized.data(), oversized.size(), &vertices, &indices);
+			const bool bMinimalAccepted = TextMeshParser::Parse(minimal.data(), minimal.size(), &vertices, &indices)
+				&& vertices.size() == 1 && indices.size() == 3;
+
+			std::cout << "  oversized counts " << (bOversizedRejected ? "rejected" : "ACCEPTED")
+				<< ", minimal records " << (bMinimalAccepted ? "ok" : "FAILED") << std::endl;
+
+			return bOversizedRejected && bMinimalAccepted;
+		}
+
+		bool runModel(const char* fileName, JobSystem* jobSystem)
+		{
+			enum { ITERATION_COUNT = 10 };
+
+			// ũ ӵ  Ľ̸ 絵  ̸ ޸𸮿 о д.
+			std::ifstream fin(fileName, std::ios_base::binary);
+			if (!fin)
+			{
+				std::cout << "  " << fileName << " not found" << std::endl;
+				return true;
+			}
+			const std::string text((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
+			const double megabytes = static_cast<double>(text.size()) / (1024.0 * 1024.0);
+
+			std::vector<MeshVertex> streamVertices;
+			std::vector<UINT> streamIndices;
+			std::vector<MeshVertex> serialVertices;
+			std::vector<UINT> serialIndices;
+			std::vector<MeshVertex> parallelVertices;
+			std::vector<UINT> parallelIndices;
+			bool bStream = false;
+			bool bSerial = false;
+			bool bParallel = false;
+
+			const double streamMs = MeasureMs(ITERATION_COUNT, [&]()
+				{
+					bStream = parseWithStream(text, &streamVertices, &streamIndices);
+				});
+			const double serialMs = MeasureMs(ITERATION_COUNT, [&]()
+				{
+					bSerial = TextMeshParser::Parse(text.data(), text.size(), &serialVertices, &serialIndices);
+				});
+			const double parallelMs = MeasureMs(ITERATION_COUNT, [&]()
+				{
+					bParallel = TextMeshParser::Parse(text.data(), text.size(), &parallelVertices, &parallelIndices, jobSystem);
+				});
+
+			std::cout << "  " << fileName << ": " << megabytes << " MB, vertices " << serialVertices.size()
+				<< ", triangles " << serialIndices.size() / 3 << std::endl;
+			std::cout << "    stream    " << std::setw(9) << megabytes * 1000.0 / streamMs << " MB/s" << (bStream ? "" : ", FAILED") << std::endl;
+			const UINT serialMismatches = countMismatches(streamVertices, serialVertices);
+			const UINT parallelMismatches = countMismatches(serialVertices, parallelVertices);
+			std::cout << "    serial    " << std::setw(9) << megabytes * 1000.0 / serialMs << " MB/s" << (bSerial ? "" : ", FAILED")
+				<< ", float mismatches " << serialMismatches
+				<< (streamIndices == serialIndices ? "" : ", INDEX MISMATCH") << std::endl;
+			std::cout << "    parallel  " << std::setw(9) << megabytes * 1000.0 / parallelMs << " MB/s" << (bParallel ? "" : ", FAILED")
+				<< ", float mismatches " << parallelMismatches
+				<< (serialIndices == parallelIndices ? "" : ", INDEX MISMATCH") << std::endl;
+
+			const bool bCacheValid = checkMeshCache(serialVertices, serialIndices);
+
+			const bool bPassed = bStream && bSerial && bParallel
+				&& serialMismatches == 0 && streamIndices == serialIndices
+				&& parallelMismatches == 0 && serialIndices == parallelIndices
+				&& bCacheValid;
+			std::cout << "    " << (bPassed ? "ok" : "FAILED") << std::endl;
+
+			return bPassed;
+		}
+	}
+
+	bool RunParseBenchmark()
+	{
+		JobSystem jobSystem;
+
+		std::cout << std::fixed << std::setprecision(3);
+		std::cout << "[parse] text model parsing, stream vs TextMeshParser (" << jobSystem.GetThreadCount() << " threads)" << std::endl;
+
+		bool bPassed = checkRecordCounts();
+		bPassed = runModel("../Resource/Models/skull.txt", &jobSystem) && bPassed;
+		bPassed = runModel("../Resource/Models/car.txt", &jobSystem) && bPassed;
+
+		return bPassed;
+	}
+}
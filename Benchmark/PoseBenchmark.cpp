@@ -0,0 +1,191 @@
+#include <windows.h>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "SyntheticRig.h"
+
+namespace benchmark
+{
+	using namespace DirectX::SimpleMath;
+	using namespace resourceManager;
+
+	namespace
+	{
+		enum { NODE_COUNT = 64, CLIP_COUNT = 3, FRAME_COUNT = 1000 };
+
+		//  δ  Ű    ϹǷ  ƾ Ѵ. Ϸ  ٸ   ϰ,
+		// Ʈ  ϼ  ĿǷ  ũ⿡  ̷ Ѵ.
+		const float TOLERANCE = 1e-4f;
+
+		const char* result(bool bPassed)
+		{
+			return bPassed ? "ok" : "FAILED";
+		}
+
+		//  : ¸  ̸ ä ã   ü ٽ Ѵ.
+		// ð ϰ ε  ȷƮ ϴ  .
+		class LegacyPosePreparation
+		{
+		public:
+			LegacyPosePreparation(const Skeleton& skeleton, const PaletteLayout& layout, const AnimationClip& clip)
+				: mSkeleton(skeleton)
+				, mLayout(layout)
+				, mToParent(skeleton.GetNodeCount())
+				, mToRoot(skeleton.GetNodeCount())
+			{
+				for (const AnimationNode& channel : clip.Channels)
+				{
+					mChannelMap.insert({ channel.Name, &channel });
+				}
+
+				for (unsigned int i = 0; i < skeleton.GetNodeCount(); ++i)
+				{
+					mToParent[i] = Matrix::CreateScale(skeleton.BindPose.Scales[i])
+						* Matrix::CreateFromQuaternion(skeleton.BindPose.Rotations[i])
+						* Matrix::CreateTranslation(skeleton.BindPose.Translations[i]);
+				}
+			}
+
+			void BuildPalette(float time, Matrix* outPalette)
+			{
+				for (size_t subset = 0; subset + 1 < mLayout.SubsetOffsets.size(); ++subset)
+				{
+					const unsigned int boneBegin = mLayout.SubsetOffsets[subset];
+					const unsigned int boneEnd = mLayout.SubsetOffsets[subset + 1];
+
+					for (unsigned int bone = boneBegin; bone < boneEnd; ++bone)
+					{
+						const unsigned int node = mLayout.NodeIndices[bone];
+						auto find = mChannelMap.find(mSkeleton.NodeNames[node]);
+						if (find != mChannelMap.end())
+						{
+							mToParent[node] = find->second->Evaluate(time);
+						}
+					}
+
+					mToRoot[0] = mToParent[0];
+					for (unsigned int i = 1; i < mSkeleton.GetNodeCount(); ++i)
+					{
+						mToRoot[i] = mToParent[i] * mToRoot[mSkeleton.ParentIndices[i]];
+					}
+
+					for (unsigned int bone = boneBegin; bone < boneEnd; ++bone)
+					{
+						outPalette[bone] = (mLayout.OffsetMatrices[bone] * mToRoot[mLayout.NodeIndices[bone]]).Transpose();
+					}
+				}
+			}
+
+		private:
+			const Skeleton& mSkeleton;
+			const PaletteLayout& mLayout;
+			std::map<std::string, const AnimationNode*> mChannelMap;
+			std::vector<Matrix> mToParent;
+			std::vector<Matrix> mToRoot;
+		};
+
+		// ε: 庰 ä ε   ϰ ȷƮ . (SkinnedModel::EvaluatePose + BuildPalette)
+		struct BoundPosePreparation
+		{
+			std::vector<AnimationCursor> Cursors;
+			LocalPose Pose;
+			std::vector<Matrix> ToRoot;
+
+			void BuildPalette(const Skeleton& skeleton, const PaletteLayout& layout, const AnimationClip& clip, float time, Matrix* outPalette)
+			{
+				clip.SamplePose(skeleton, time, Cursors.data(), &Pose);
+				skeleton.ComputeToRootMatrices(Pose, ToRoot.data());
+				layout.BuildPalette(ToRoot.data(), outPalette);
+			}
+		};
+
+		// к ̸ 1   ũ  ū   ִ밪
+		float maxRelativeDifference(const std::vector<Matrix>& lhs, const std::vector<Matrix>& rhs)
+		{
+			float result = 0.f;
+			for (size_t i = 0; i < lhs.size(); ++i)
+			{
+				for (int k = 0; k < 16; ++k)
+				{
+					const float reference = (&rhs[i]._11)[k];
+					result = std::max<float>(result, fabsf((&lhs[i]._11)[k] - reference) / std::max<float>(1.f, fabsf(reference)));
+				}
+			}
+
+			return result;
+		}
+	}
+
+	bool RunPoseBenchmark()
+	{
+		Skeleton skeleton;
+		std::vector<AnimationClip> clips;
+		PaletteLayout layout;
+		SyntheticRig::Build(NODE_COUNT, CLIP_COUNT, 29, &skeleton, &clips);
+		SyntheticRig::BuildPaletteLayout(skeleton, &layout);
+
+		std::cout << "[pose] nodes " << static_cast<UINT>(NODE_COUNT) << ", subsets " << layout.SubsetOffsets.size() - 1
+			<< ", bones " << layout.GetBoneCount() << ", " << static_cast<UINT>(FRAME_COUNT) << " frames per clip" << std::endl;
+		std::cout << std::fixed << std::setprecision(4);
+		std::cout << "  clip    name lookup ms/frame  bound ms/frame  speedup  max error" << std::endl;
+
+		std::vector<Matrix> legacyPalette(layout.GetBoneCount());
+		std::vector<Matrix> boundPalette(layout.GetBoneCount());
+		bool bPassed = true;
+
+		for (const AnimationClip& clip : clips)
+		{
+			const float step = static_cast<float>(clip.Duration) / FRAME_COUNT;
+
+			LegacyPosePreparation legacy(skeleton, layout, clip);
+			BoundPosePreparation bound;
+			bound.Cursors.resize(NODE_COUNT);
+			bound.Pose.Resize(NODE_COUNT);
+			bound.ToRoot.resize(NODE_COUNT);
+
+			// Ȯ: Ӹ   ü ȷƮ Ѵ.
+			float maxError = 0.f;
+			for (int frame = 0; frame < FRAME_COUNT; ++frame)
+			{
+				legacy.BuildPalette(frame * step, legacyPalette.data());
+				bound.BuildPalette(skeleton, layout, clip, frame * step, boundPalette.data());
+				maxError = std::max<float>(maxError, maxRelativeDifference(boundPalette, legacyPalette));
+			}
+
+			Matrix sink;
+			const double legacyMs = MeasureMs(1, [&]()
+				{
+					for (int frame = 0; frame < FRAME_COUNT; ++frame)
+					{
+						legacy.BuildPalette(frame * step, legacyPalette.data());
+						sink += legacyPalette[0];
+					}
+				}) / FRAME_COUNT;
+
+			std::fill(bound.Cursors.begin(), bound.Cursors.end(), AnimationCursor());
+			const double boundMs = MeasureMs(1, [&]()
+				{
+					for (int frame = 0; frame < FRAME_COUNT; ++frame)
+					{
+						bound.BuildPalette(skeleton, layout, clip, frame * step, boundPalette.data());
+						sink += boundPalette[0];
+					}
+				}) / FRAME_COUNT;
+
+			const bool bClipPassed = maxError <= TOLERANCE;
+			bPassed = bPassed && bClipPassed;
+
+			std::cout << "  " << std::left << std::setw(6) << clip.Name << std::right << std::setw(22) << legacyMs
+				<< std::setw(16) << boundMs << std::setw(9) << legacyMs / boundMs << "  " << std::scientific << std::setprecision(2)
+				<< maxError << " " << result(bClipPassed) << std::fixed << std::setprecision(4) << "  (sink " << sink._11 << ")" << std::endl;
+		}
+
+		return bPassed;
+	}
+}
@@ -0,0 +1,274 @@
+#include <windows.h>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Bvh.h"
+#include "D3DUtil.h"
+#include "TextMeshParser.h"
+#include "../AmbientOcclusion/Octree.h"
+
+namespace benchmark
+{
+	using namespace common;
+	using namespace DirectX;
+	using namespace DirectX::SimpleMath;
+
+	namespace
+	{
+		struct OcclusionRay
+		{
+			Vector3 Origin;
+			Vector3 Direction;
+		};
+
+		bool loadTextMesh(const char* fileName, std::vector<Vector3>* outPositions, std::vector<UINT>* outIndices)
+		{
+			std::vector<MeshVertex> vertices;
+
+			if (!TextMeshParser::Load(fileName, &vertices, outIndices))
+			{
+				return false;
+			}
+
+			outPositions->resize(vertices.size());
+			for (size_t i = 0; i < vertices.size(); ++i)
+			{
+				(*outPositions)[i] = vertices[i].Pos;
+			}
+
+			return true;
+		}
+
+		//  AO    ﰢ ߽ɿ   ݱ  
+		std::vector<OcclusionRay> buildOcclusionRays(const std::vector<Vector3>& positions, const std::vector<UINT>& indices, UINT raysPerTriangle)
+		{
+			std::mt19937 random(5678);
+			std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+			const UINT triangleCount = static_cast<UINT>(indices.size() / 3);
+			std::vector<OcclusionRay> rays;
+			rays.reserve(triangleCount * raysPerTriangle);
+
+			for (UINT i = 0; i < triangleCount; ++i)
+			{
+				const Vector3& v0 = positions[indices[i * 3 + 0]];
+				const Vector3& v1 = positions[indices[i * 3 + 1]];
+				const Vector3& v2 = positions[indices[i * 3 + 2]];
+
+				Vector3 normal = (v1 - v0).Cross(v2 - v0);
+				normal.Normalize();
+				Vector3 centroid = (v0 + v1 + v2) / 3.0f + 0.001f * normal;
+
+				for (UINT j = 0; j < raysPerTriangle; ++j)
+				{
+					Vector3 direction;
+					do
+					{
+						direction = Vector3(unit(random), unit(random), unit(random));
+					} while (direction.LengthSquared() > 1.0f || direction.LengthSquared() < 1e-6f);
+
+					direction.Normalize();
+					if (direction.Dot(normal) < 0.0f)
+					{
+						direction = -direction;
+					}
+
+					rays.push_back({ centroid, direction });
+				}
+			}
+
+			return rays;
+		}
+
+		//  迭     ̸ . (Ʈ 0)
+		UINT measureDepth(const std::vector<BvhNode>& nodes)
+		{
+			std::vector<std::pair<UINT, UINT>> stack = { { 0, 0 } };
+			UINT maxDepth = 0;
+			while (!stack.empty())
+			{
+				const std::pair<UINT, UINT> entry = stack.back();
+				stack.pop_back();
+				maxDepth = std::max<UINT>(maxDepth, entry.second);
+
+				const BvhNode& node = nodes[entry.first];
+				if (node.TriangleCount == 0)
+				{
+					stack.push_back({ node.LeftFirst, entry.second + 1 });
+					stack.push_back({ node.LeftFirst + 1, entry.second + 1 });
+				}
+			}
+
+			return maxDepth;
+		}
+
+		// ̰ 0 ﰢ()  ٷ þ SAH   0̶ Ź ù   Ƿ
+		//    Ʈ 70 Ѱ  ȸ  ģ.
+		//   ﰢ   ̰ ¾ƾ ϰ,    ̴ ƹ͵  ʾƾ Ѵ.
+		bool runDeepBuild()
+		{
+			enum { POINT_COUNT = 1000 };
+
+			std::vector<Vector3> positions = { Vector3(-1.f, 0.f, -1.f), Vector3(0.f, 0.f, 1.f), Vector3(1.f, 0.f, -1.f) };
+			std::vector<UINT> indices = { 0, 1, 2 };
+			for (UINT i = 1; i <= POINT_COUNT; ++i)
+			{
+				const Vector3 point(static_cast<float>(i), 0.f, 0.f);
+				const UINT first = static_cast<UINT>(positions.size());
+				positions.insert(positions.end(), { point, point, point });
+				indices.insert(indices.end(), { first, first + 1, first + 2 });
+			}
+
+			Bvh bvh;
+			bvh.Build(positions, indices);
+			const UINT depth = measureDepth(bvh.GetNodes());
+
+			const Vector3 down(0.f, -1.f, 0.f);
+			const Vector3 origin(0.f, 1.f, -1.f / 3.f);
+			BvhHit hit;
+			bool bCorrect = bvh.Intersect(origin, down, MathHelper::Infinity, &hit) && hit.TriangleIndex == 0
+				&& bvh.Occluded(origin, down) && bvh.OccludedPacket(origin, &down, 1) == 1;
+
+			for (UINT i = 1; i < POINT_COUNT; i += 37)
+			{
+				const Vector3 pointOrigin(i + 0.5f, 1.f, 0.f);
+				bCorrect = bCorrect && !bvh.Intersect(pointOrigin, down, MathHelper::Infinity, &hit) && !bvh.Occluded(pointOrigin, down)
+					&& bvh.OccludedPacket(pointOrigin, &down, 1) == 0;
+			}
+
+			const bool bPassed = depth <= Bvh::MAX_DEPTH && bCorrect;
+			std::cout << "  deep build: " << indices.size() / 3 << " triangles, depth " << depth << " (max "
+				<< static_cast<UINT>(Bvh::MAX_DEPTH) << ") " << (bPassed ? "ok" : "FAILED") << std::endl;
+
+			return bPassed;
+		}
+
+		bool runModel(const char* fileName)
+		{
+			enum { RAYS_PER_TRIANGLE = Bvh::MAX_PACKET_SIZE };
+
+			std::vector<Vector3> positions;
+			std::vector<UINT> indices;
+
+			if (!loadTextMesh(fileName, &positions, &indices))
+			{
+				std::cout << "  " << fileName << " not found FAILED" << std::endl;
+				return false;
+			}
+
+			const std::vector<OcclusionRay> rays = buildOcclusionRays(positions, indices, RAYS_PER_TRIANGLE);
+			const double rayCount = static_cast<double>(rays.size());
+
+			ambientOcclusion::Octree octree;
+			double octreeBuildMs = MeasureMs(1, [&]() { octree.Build(positions, indices); });
+
+			Bvh bvh;
+			double bvhBuildMs = MeasureMs(1, [&]() { bvh.Build(positions, indices); });
+
+			std::vector<char> octreeResults(rays.size());
+			std::vector<char> bvhResults(rays.size());
+			UINT closestHitCount = 0;
+
+			double octreeMs = MeasureMs(1, [&]()
+				{
+					for (size_t i = 0; i < rays.size(); ++i)
+					{
+						octreeResults[i] = octree.RayOctreeIntersect(Vector4(rays[i].Origin), Vector4(rays[i].Direction));
+					}
+				});
+			double anyHitMs = MeasureMs(1, [&]()
+				{
+					for (size_t i = 0; i < rays.size(); ++i)
+					{
+						bvhResults[i] = bvh.Occluded(rays[i].Origin, rays[i].Direction);
+					}
+				});
+			double closestHitMs = MeasureMs(1, [&]()
+				{
+					closestHitCount = 0;
+					for (size_t i = 0; i < rays.size(); ++i)
+					{
+						BvhHit hit;
+						closestHitCount += bvh.Intersect(rays[i].Origin, rays[i].Direction, MathHelper::Infinity, &hit) ? 1 : 0;
+					}
+				});
+
+			//  ﰢ ̴  Ƿ packetSize  .
+			const UINT packetSizes[3] = { 4, 8, 16 };
+			double packetMs[3];
+			UINT packetMismatchCounts[3] = {};
+			std::vector<char> packetResults(rays.size());
+			std::vector<Vector3> directions(rays.size());
+			for (size_t i = 0; i < rays.size(); ++i)
+			{
+				directions[i] = rays[i].Direction;
+			}
+
+			for (int p = 0; p < 3; ++p)
+			{
+				const UINT packetSize = packetSizes[p];
+
+				packetMs[p] = MeasureMs(1, [&]()
+					{
+						for (size_t i = 0; i < rays.size(); i += packetSize)
+						{
+							UINT occludedMask = bvh.OccludedPacket(rays[i].Origin, &directions[i], packetSize);
+
+							for (UINT k = 0; k < packetSize; ++k)
+							{
+								packetResults[i + k] = (occludedMask >> k) & 1;
+							}
+						}
+					});
+
+				for (size_t i = 0; i < rays.size(); ++i)
+				{
+					packetMismatchCounts[p] += packetResults[i] != bvhResults[i] ? 1 : 0;
+				}
+			}
+
+			UINT occludedCount = 0;
+			UINT mismatchCount = 0;
+			for (size_t i = 0; i < rays.size(); ++i)
+			{
+				occludedCount += bvhResults[i] ? 1 : 0;
+				mismatchCount += octreeResults[i] != bvhResults[i] ? 1 : 0;
+			}
+
+			std::cout << "  " << fileName << ": triangles " << indices.size() / 3 << ", rays " << rays.size()
+				<< ", occluded " << occludedCount << ", octree mismatches " << mismatchCount
+				<< ", closest hits " << closestHitCount << std::endl;
+			std::cout << "    build     octree " << octreeBuildMs << " ms, bvh " << bvhBuildMs << " ms (" << bvh.GetNodes().size() << " nodes)" << std::endl;
+			std::cout << "    octree    " << rayCount / (octreeMs * 1000.0) << " Mrays/s" << std::endl;
+			std::cout << "    bvh any   " << rayCount / (anyHitMs * 1000.0) << " Mrays/s" << std::endl;
+			std::cout << "    bvh near  " << rayCount / (closestHitMs * 1000.0) << " Mrays/s" << std::endl;
+			bool bPassed = mismatchCount == 0;
+			for (int p = 0; p < 3; ++p)
+			{
+				std::cout << "    packet " << std::setw(2) << packetSizes[p] << " " << rayCount / (packetMs[p] * 1000.0) << " Mrays/s"
+					<< ", mismatches " << packetMismatchCounts[p] << std::endl;
+				bPassed = bPassed && packetMismatchCounts[p] == 0;
+			}
+			std::cout << "    " << (bPassed ? "ok" : "FAILED") << std::endl;
+
+			return bPassed;
+		}
+	}
+
+	bool RunRayBenchmark()
+	{
+		std::cout << std::fixed << std::setprecision(3);
+		std::cout << "[ray] ambient occlusion rays, octree vs BVH vs BVH packets" << std::endl;
+
+		bool bPassed = runDeepBuild();
+		bPassed = runModel("../Resource/Models/skull.txt") && bPassed;
+		bPassed = runModel("../Resource/Models/car.txt") && bPassed;
+
+		return bPassed;
+	}
+}
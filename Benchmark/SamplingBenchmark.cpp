@@ -0,0 +1,197 @@
+#include <windows.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "SyntheticRig.h"
+
+namespace benchmark
+{
+	using namespace DirectX::SimpleMath;
+	using namespace resourceManager;
+
+	namespace
+	{
+		enum { NODE_COUNT = 64, CLIP_COUNT = 3, SAMPLE_COUNT = 10000 };
+
+		//  Ű ̴ nlerp ϹǷ slerp     ̸ŭ ٸ  ִ.
+		const float TOLERANCE = 1e-4f;
+
+		const char* result(bool bPassed)
+		{
+			return bPassed ? "ok" : "FAILED";
+		}
+
+		// Ű  ó ȴ  , Ʈ Ž  ϰ ð   .
+		template <typename T>
+		unsigned int findKeyLinear(const KeyTrack<T>& track, float time)
+		{
+			unsigned int key = 0;
+			while (key + 2 < track.Times.size() && track.Times[key + 1] <= time)
+			{
+				++key;
+			}
+
+			return key;
+		}
+
+		template <typename T, typename Interpolate>
+		T sampleLinear(const KeyTrack<T>& track, float time, const T& defaultValue, const Interpolate& interpolate)
+		{
+			if (track.Values.size() < 2)
+			{
+				return track.Values.empty() ? defaultValue : track.Values[0];
+			}
+
+			const unsigned int key = findKeyLinear(track, time);
+			const float length = track.Times[key + 1] - track.Times[key];
+			const float ratio = length > 0.f ? (time - track.Times[key]) / length : 0.f;
+
+			return interpolate(track.Values[key], track.Values[key + 1], std::min<float>(std::max<float>(ratio, 0.f), 1.f));
+		}
+
+		Matrix evaluateLinear(const AnimationNode& node, float time)
+		{
+			const Vector3 position = sampleLinear(node.PositionKeys, time, Vector3::Zero,
+				[](const Vector3& a, const Vector3& b, float t) { return Vector3::Lerp(a, b, t); });
+			const Quaternion rotation = sampleLinear(node.RotationKeys, time, Quaternion::Identity,
+				[](const Quaternion& a, const Quaternion& b, float t) { return Quaternion::Slerp(a, b, t); });
+			const Vector3 scaling = sampleLinear(node.ScalingKeys, time, Vector3::One,
+				[](const Vector3& a, const Vector3& b, float t) { return Vector3::Lerp(a, b, t); });
+
+			return Matrix::CreateScale(scaling) * Matrix::CreateFromQuaternion(rotation) * Matrix::CreateTranslation(position);
+		}
+
+		float maxDifference(const Matrix& a, const Matrix& b)
+		{
+			float result = 0.f;
+			for (int i = 0; i < 16; ++i)
+			{
+				result = std::max<float>(result, fabsf((&a._11)[i] - (&b._11)[i]));
+			}
+
+			return result;
+		}
+
+		// Ŀ  Ž  Ž  Ű  . Ű 2 ̸ Ʈ Ž ʴ´.
+		template <typename T>
+		bool isKeyEqual(const KeyTrack<T>& track, float time, unsigned int* cursor)
+		{
+			return track.Times.size() < 2 || track.FindKey(time, cursor) == findKeyLinear(track, time);
+		}
+	}
+
+	bool RunSamplingBenchmark()
+	{
+		Skeleton skeleton;
+		std::vector<AnimationClip> clips;
+		SyntheticRig::Build(NODE_COUNT, CLIP_COUNT, 23, &skeleton, &clips);
+
+		std::cout << "[sampling] nodes " << static_cast<UINT>(NODE_COUNT) << ", clips " << static_cast<UINT>(CLIP_COUNT)
+			<< ", " << static_cast<UINT>(SAMPLE_COUNT) << " time points per channel" << std::endl;
+
+		//  ϴ , ǰ ǳʶٱⰡ      øѴ.
+		std::mt19937 random(5);
+		std::uniform_real_distribution<float> unit(0.f, 1.f);
+		std::vector<float> randomRatios(SAMPLE_COUNT);
+		for (float& ratio : randomRatios)
+		{
+			ratio = unit(random) * 1.1f - 0.05f;
+		}
+
+		bool bKeysValid = true;
+		bool bCursorValid = true;
+		bool bReferenceValid = true;
+
+		std::cout << std::fixed << std::setprecision(3);
+		std::cout << "  clip    keys  linear ms  binary ms  cursor ms  speedup" << std::endl;
+
+		for (const AnimationClip& clip : clips)
+		{
+			const float step = static_cast<float>(clip.Duration) / (SAMPLE_COUNT - 1);
+			size_t keyCount = 0;
+			float maxError = 0.f;
+			bool bClipKeysValid = true;
+			bool bClipCursorValid = true;
+			Matrix sink;
+
+			for (const AnimationNode& node : clip.Channels)
+			{
+				keyCount += node.PositionKeys.Times.size() + node.RotationKeys.Times.size() + node.ScalingKeys.Times.size();
+
+				for (int order = 0; order < 2; ++order)
+				{
+					AnimationCursor keyCursor;
+					AnimationCursor cursor;
+					for (int i = 0; i < SAMPLE_COUNT; ++i)
+					{
+						const float time = order == 0 ? i * step : randomRatios[i] * static_cast<float>(clip.Duration);
+
+						bClipKeysValid = isKeyEqual(node.PositionKeys, time, &keyCursor.Position)
+							&& isKeyEqual(node.RotationKeys, time, &keyCursor.Rotation)
+							&& isKeyEqual(node.ScalingKeys, time, &keyCursor.Scaling) && bClipKeysValid;
+
+						// Ŀ Ž Ʈ ̶ Ŀ   Ž Ʈ  ƾ Ѵ.
+						const Matrix cursorMatrix = node.Evaluate(time, &cursor);
+						const Matrix binaryMatrix = node.Evaluate(time);
+						bClipCursorValid = memcmp(&cursorMatrix, &binaryMatrix, sizeof(Matrix)) == 0 && bClipCursorValid;
+
+						maxError = std::max<float>(maxError, maxDifference(evaluateLinear(node, time), cursorMatrix));
+					}
+				}
+			}
+
+			const double linearMs = MeasureMs(1, [&]()
+				{
+					for (const AnimationNode& node : clip.Channels)
+					{
+						for (int i = 0; i < SAMPLE_COUNT; ++i)
+						{
+							sink += evaluateLinear(node, i * step);
+						}
+					}
+				});
+			const double binaryMs = MeasureMs(1, [&]()
+				{
+					for (const AnimationNode& node : clip.Channels)
+					{
+						for (int i = 0; i < SAMPLE_COUNT; ++i)
+						{
+							sink += node.Evaluate(i * step);
+						}
+					}
+				});
+			const double cursorMs = MeasureMs(1, [&]()
+				{
+					for (const AnimationNode& node : clip.Channels)
+					{
+						AnimationCursor cursor;
+						for (int i = 0; i < SAMPLE_COUNT; ++i)
+						{
+							sink += node.Evaluate(i * step, &cursor);
+						}
+					}
+				});
+
+			const bool bClipReferenceValid = maxError <= TOLERANCE;
+
+			std::cout << "  " << std::left << std::setw(6) << clip.Name << std::right << std::setw(6) << keyCount
+				<< std::setw(11) << linearMs << std::setw(11) << binaryMs << std::setw(11) << cursorMs
+				<< std::setw(9) << linearMs / cursorMs << "  (sink " << sink._11 << ")" << std::endl;
+			std::cout << "    keys vs linear scan " << result(bClipKeysValid) << ", cursor vs binary search " << result(bClipCursorValid)
+				<< std::scientific << std::setprecision(2) << ", max matrix error vs slerp reference " << maxError << " "
+				<< result(bClipReferenceValid) << std::fixed << std::setprecision(3) << std::endl;
+
+			bKeysValid = bKeysValid && bClipKeysValid;
+			bCursorValid = bCursorValid && bClipCursorValid;
+			bReferenceValid = bReferenceValid && bClipReferenceValid;
+		}
+
+		return bKeysValid && bCursorValid && bReferenceValid;
+	}
+}
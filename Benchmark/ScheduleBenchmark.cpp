@@ -0,0 +1,310 @@
+#include <windows.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "JobSystem.h"
+#include "SyntheticRig.h"
+#include "../ResourceManager/AnimationScheduler.h"
+
+namespace benchmark
+{
+	using namespace common;
+	using namespace DirectX::SimpleMath;
+	using namespace resourceManager;
+
+	namespace
+	{
+		enum { NODE_COUNT = 64, CLIP_COUNT = 3, INSTANCE_COUNT = 4096, FRAME_COUNT = 120 };
+
+		const float FRAME_TIME = 1.f / 60.f;
+		const float MIN_SCREEN_HEIGHT = 4.f;
+		const float MAX_SCREEN_HEIGHT = 400.f;
+		const float VISIBLE_RATIO = 0.6f;
+		const float VISIBILITY_FLIP_RATIO = 0.02f; // Ӹ ü ٲ 
+
+		void fillCrowd(const Skeleton& skeleton, const PaletteLayout& layout, const std::vector<AnimationClip>& clips, CrowdAnimator* crowd)
+		{
+			std::mt19937 random(5);
+			std::uniform_real_distribution<float> startTime(0.f, 4.f);
+
+			crowd->Clear();
+			for (UINT i = 0; i < INSTANCE_COUNT; ++i)
+			{
+				crowd->AddInstance(&skeleton, &layout, &clips[random() % clips.size()], startTime(random));
+			}
+		}
+
+		// ȭ ̴ Ÿ ݺϹǷ α յϰ Ѹ.
+		void fillView(std::vector<float>* outScreenHeights, std::vector<bool>* outVisibilities)
+		{
+			std::mt19937 random(11);
+			std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+			outScreenHeights->resize(INSTANCE_COUNT);
+			outVisibilities->resize(INSTANCE_COUNT);
+			for (UINT i = 0; i < INSTANCE_COUNT; ++i)
+			{
+				(*outScreenHeights)[i] = MIN_SCREEN_HEIGHT * powf(MAX_SCREEN_HEIGHT / MIN_SCREEN_HEIGHT, unit(random));
+				(*outVisibilities)[i] = unit(random) < VISIBLE_RATIO;
+			}
+		}
+
+		float getMaxDifference(const Matrix* lhs, const Matrix* rhs, UINT boneCount)
+		{
+			const float* lhsFloats = &lhs->_11;
+			const float* rhsFloats = &rhs->_11;
+			float maxDifference = 0.f;
+			for (UINT i = 0; i < boneCount * 16; ++i)
+			{
+				maxDifference = std::max<float>(maxDifference, fabsf(lhsFloats[i] - rhsFloats[i]));
+			}
+
+			return maxDifference;
+		}
+
+		// ε   ϴ ,   ȭ ȼ ٲ  .
+		float getRigHeight(const Skeleton& skeleton)
+		{
+			std::vector<Matrix> toRootMatrices(skeleton.GetNodeCount());
+			skeleton.ComputeToRootMatrices(skeleton.BindPose, toRootMatrices.data());
+
+			float minY = 0.f;
+			float maxY = 0.f;
+			for (const Matrix& toRoot : toRootMatrices)
+			{
+				minY = std::min<float>(minY, toRoot._42);
+				maxY = std::max<float>(maxY, toRoot._42);
+			}
+
+			return std::max<float>(maxY - minY, 1.f);
+		}
+
+		//  LOD  ,  ̸ ϸ CrowdAnimator::Update Ʈ  ƾ Ѵ.
+		bool checkFullRate(const Skeleton& skeleton, const PaletteLayout& layout, const std::vector<AnimationClip>& clips)
+		{
+			CrowdAnimator reference;
+			CrowdAnimator crowd;
+			fillCrowd(skeleton, layout, clips, &reference);
+			fillCrowd(skeleton, layout, clips, &crowd);
+
+			AnimationScheduler scheduler;
+			scheduler.SetBudget(0.f);
+			for (UINT lod = 0; lod < AnimationScheduler::LOD_COUNT; ++lod)
+			{
+				AnimationLod animationLod = scheduler.GetLod(lod);
+				animationLod.UpdateInterval = 1;
+				animationLod.MaxBoneDepth = CrowdAnimator::MAX_BONE_DEPTH;
+				scheduler.SetLod(lod, animationLod);
+			}
+
+			scheduler.SyncInstances(crowd);
+			for (UINT i = 0; i < INSTANCE_COUNT; ++i)
+			{
+				scheduler.SetScreenHeight(i, static_cast<float>(i % 300));
+				scheduler.SetVisible(i, true);
+			}
+
+			for (UINT frame = 0; frame < 10; ++frame)
+			{
+				reference.Update(FRAME_TIME, nullptr);
+				scheduler.Update(FRAME_TIME, &crowd, nullptr);
+
+				for (UINT i = 0; i < INSTANCE_COUNT; ++i)
+				{
+					if (memcmp(reference.GetPalette(i), scheduler.GetPalette(i), sizeof(Matrix) * layout.GetBoneCount()) != 0)
+					{
+						return false;
+					}
+				}
+			}
+
+			return true;
+		}
+
+		//  8  νϽ    2 LOD ٲ 꿡 и  
+		// 迡 ̷ νϽ    Ѵ.  ӿ   νϽ  ƾ Ѵ.
+		bool checkIntervalShrink(const Skeleton& skeleton, const PaletteLayout& layout, const std::vector<AnimationClip>& clips)
+		{
+			enum { NEAR_INTERVAL = 2, FAR_INTERVAL = 8, SHRINK_FRAME = 3, SHRINK_FRAME_COUNT = 12 };
+			const float nearHeight = 200.f;
+			const float farHeight = 1.f;
+
+			CrowdAnimator crowd;
+			crowd.AddInstance(&skeleton, &layout, &clips[0], 0.f);
+			crowd.AddInstance(&skeleton, &layout, &clips[0], 0.f);
+
+			AnimationScheduler scheduler;
+			scheduler.SetBudget(1e-6f); // ó ̴    и.
+			for (UINT lod = 0; lod < AnimationScheduler::LOD_COUNT; ++lod)
+			{
+				AnimationLod animationLod = scheduler.GetLod(lod);
+				animationLod.UpdateInterval = lod == 0 ? NEAR_INTERVAL : FAR_INTERVAL;
+				scheduler.SetLod(lod, animationLod);
+			}
+			scheduler.SyncInstances(crowd);
+			scheduler.SetVisible(0, true);
+			scheduler.SetVisible(1, false);
+
+			bool bDeferredOnce = false;
+			for (UINT frame = 1; frame <= SHRINK_FRAME_COUNT; ++frame)
+			{
+				scheduler.SetScreenHeight(0, frame < SHRINK_FRAME ? farHeight : nearHeight);
+				scheduler.Update(FRAME_TIME, &crowd, nullptr);
+
+				const AnimationScheduler::Stats& stats = scheduler.GetStats();
+				const UINT total = stats.UpdatedCount + stats.InterpolatedCount + stats.HeldCount + stats.DeferredCount + stats.SkippedCount;
+				// HeldCount  ġ  2 ƿǷ  .
+				if (total != 2 || stats.HeldCount > 2 || stats.SkippedCount != 1)
+				{
+					return false;
+				}
+
+				if (frame == SHRINK_FRAME)
+				{
+					bDeferredOnce = stats.DeferredCount == 1 && stats.InterpolatedCount == 0;
+				}
+			}
+
+			return bDeferredOnce;
+		}
+	}
+
+	bool RunScheduleBenchmark()
+	{
+		using Clock = std::chrono::high_resolution_clock;
+
+		Skeleton skeleton;
+		std::vector<AnimationClip> clips;
+		PaletteLayout layout;
+		SyntheticRig::Build(NODE_COUNT, CLIP_COUNT, 3, &skeleton, &clips);
+		SyntheticRig::BuildPaletteLayout(skeleton, &layout);
+
+		std::vector<float> screenHeights;
+		std::vector<bool> visibilities;
+		fillView(&screenHeights, &visibilities);
+
+		const bool bFullRateIdentical = checkFullRate(skeleton, layout, clips);
+		const bool bIntervalShrinkCounted = checkIntervalShrink(skeleton, layout, clips);
+		const float rigHeight = getRigHeight(skeleton);
+
+		const UINT threadCount = GetHardwareThreadCount();
+		JobSystem jobSystem(threadCount > 1 ? threadCount - 1 : 1);
+		JobSystem* jobs = threadCount > 1 ? &jobSystem : nullptr;
+
+		CrowdAnimator fullRate;
+		fillCrowd(skeleton, layout, clips, &fullRate);
+		const double fullRateMs = MeasureMs(FRAME_COUNT, [&]() { fullRate.Update(FRAME_TIME, jobs); });
+
+		std::cout << std::fixed << std::setprecision(3);
+		std::cout << "[schedule] instances " << static_cast<UINT>(INSTANCE_COUNT) << ", nodes " << static_cast<UINT>(NODE_COUNT)
+			<< ", visible " << VISIBLE_RATIO * 100.f << "%, screen height " << MIN_SCREEN_HEIGHT << "-" << MAX_SCREEN_HEIGHT
+			<< " px, threads " << threadCount << std::endl;
+		std::cout << "  error is the largest palette difference scaled to screen pixels by rig height " << rigHeight << std::endl;
+		std::cout << "  full rate every instance: " << fullRateMs << " ms/frame" << std::endl;
+		std::cout << "  full rate through scheduler identical: " << (bFullRateIdentical ? "yes" : "NO") << std::endl;
+		std::cout << "  deferred while shrinking the interval counted once: " << (bIntervalShrinkCounted ? "ok" : "FAILED") << std::endl;
+		std::cout << "  budget  ms/frame  eval ms  updated  interp    held  deferred  skipped  mean px  p99 px" << std::endl;
+
+		const float budgets[] = { 0.f, 4.f, 2.f, 1.f, 0.5f };
+		for (float budget : budgets)
+		{
+			CrowdAnimator reference;
+			CrowdAnimator crowd;
+			fillCrowd(skeleton, layout, clips, &reference);
+			fillCrowd(skeleton, layout, clips, &crowd);
+
+			AnimationScheduler scheduler;
+			scheduler.SetBudget(budget);
+			scheduler.SyncInstances(crowd);
+
+			std::vector<bool> frameVisibilities = visibilities;
+			std::mt19937 random(23);
+			std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+			double totalMs = 0.0;
+			double evaluateMs = 0.0;
+			double updatedCount = 0.0;
+			double interpolatedCount = 0.0;
+			double heldCount = 0.0;
+			double deferredCount = 0.0;
+			double skippedCount = 0.0;
+			std::vector<float> errors;
+			errors.reserve(static_cast<size_t>(INSTANCE_COUNT) * FRAME_COUNT);
+
+			for (UINT frame = 0; frame < FRAME_COUNT; ++frame)
+			{
+				for (UINT i = 0; i < INSTANCE_COUNT; ++i)
+				{
+					if (unit(random) < VISIBILITY_FLIP_RATIO)
+					{
+						frameVisibilities[i] = !frameVisibilities[i];
+					}
+
+					scheduler.SetScreenHeight(i, screenHeights[i]);
+					scheduler.SetVisible(i, frameVisibilities[i]);
+				}
+
+				Clock::time_point start = Clock::now();
+				scheduler.Update(FRAME_TIME, &crowd, jobs);
+				totalMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+				const AnimationScheduler::Stats& stats = scheduler.GetStats();
+				evaluateMs += stats.EvaluateMs;
+				updatedCount += stats.UpdatedCount;
+				interpolatedCount += stats.InterpolatedCount;
+				heldCount += stats.HeldCount;
+				deferredCount += stats.DeferredCount;
+				skippedCount += stats.SkippedCount;
+
+				//      ̴ νϽ ȷƮ Ѵ.
+				reference.Update(FRAME_TIME, jobs);
+				for (UINT i = 0; i < INSTANCE_COUNT; ++i)
+				{
+					if (!frameVisibilities[i])
+					{
+						continue;
+					}
+
+					// ȷƮ    ̿   ٲ ȭ ̸  뷫 ȼ 
+					const float error = getMaxDifference(reference.GetPalette(i), scheduler.GetPalette(i), layout.GetBoneCount())
+						/ rigHeight * screenHeights[i];
+					errors.push_back(error);
+				}
+			}
+
+			//  Ŭ Ʈ ̵  ó ƢǷ  ӿ ģ  ũ ߳. ִ  99% δ.
+			double errorSum = 0.0;
+			for (float error : errors)
+			{
+				errorSum += error;
+			}
+
+			const size_t percentileIndex = errors.empty() ? 0 : errors.size() * 99 / 100;
+			std::nth_element(errors.begin(), errors.begin() + percentileIndex, errors.end());
+			const float percentileError = errors.empty() ? 0.f : errors[percentileIndex];
+
+			std::cout << "  " << std::left << std::setw(6);
+			if (budget > 0.f)
+			{
+				std::cout << budget;
+			}
+			else
+			{
+				std::cout << "none";
+			}
+
+			std::cout << std::right << std::setw(10) << totalMs / FRAME_COUNT << std::setw(9) << evaluateMs / FRAME_COUNT
+				<< std::setw(9) << updatedCount / FRAME_COUNT << std::setw(8) << interpolatedCount / FRAME_COUNT << std::setw(8) << heldCount / FRAME_COUNT
+				<< std::setw(10) << deferredCount / FRAME_COUNT << std::setw(9) << skippedCount / FRAME_COUNT
+				<< std::setw(10) << errorSum / std::max<size_t>(errors.size(), 1) << std::setw(9) << percentileError << std::endl;
+		}
+
+		return bFullRateIdentical && bIntervalShrinkCounted;
+	}
+}
@@ -0,0 +1,189 @@
+#include <windows.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "Benchmark.h"
+#include "JobSystem.h"
+#include "SyntheticRig.h"
+#include "../ResourceManager/CpuSkinner.h"
+
+namespace benchmark
+{
+	using namespace common;
+	using namespace DirectX::SimpleMath;
+	using namespace resourceManager;
+
+	namespace
+	{
+		enum { NODE_COUNT = 64, VERTICES_PER_BONE = 256, ITERATION_COUNT = 50 };
+
+		const float SAMPLE_TIME = 0.7f;
+		const float POSITION_TOLERANCE = 1e-4f; //  (80)  float   
+		const float NORMAL_TOLERANCE = 1e-5f; // 1 - cos
+
+		struct SkinError
+		{
+			float Position;
+			float Normal;
+		};
+
+		SkinError measureError(const std::vector<Vector3>& positions, const std::vector<Vector3>& normals,
+			const std::vector<Vector3>& referencePositions, const std::vector<Vector3>& referenceNormals)
+		{
+			SkinError error = { 0.f, 0.f };
+			for (size_t i = 0; i < positions.size(); ++i)
+			{
+				error.Position = std::max<float>(error.Position, Vector3::Distance(positions[i], referencePositions[i]));
+				error.Normal = std::max<float>(error.Normal, 1.f - normals[i].Dot(referenceNormals[i]));
+			}
+
+			return error;
+		}
+
+		void skinReference(const std::vector<vertex::PosNormalTexTanSkinned>& vertices, const std::vector<unsigned int>& subsetStarts,
+			const PaletteLayout& layout, const CpuSkinner::BonePalette& palette, std::vector<Vector3>* outPositions, std::vector<Vector3>* outNormals)
+		{
+			for (size_t subset = 0; subset + 1 < subsetStarts.size(); ++subset)
+			{
+				for (unsigned int i = subsetStarts[subset]; i < subsetStarts[subset + 1]; ++i)
+				{
+					CpuSkinner::SkinVertex(vertices[i], layout.SubsetOffsets[subset], palette, &(*outPositions)[i], &(*outNormals)[i]);
+				}
+			}
+		}
+
+		const char* getModeName(eSkinningMode mode)
+		{
+			return mode == eSkinningMode::LinearBlend ? "linear blend" : "dual quaternion";
+		}
+	}
+
+	bool RunSkinBenchmark()
+	{
+		Skeleton skeleton;
+		std::vector<AnimationClip> clips;
+		PaletteLayout layout;
+		std::vector<vertex::PosNormalTexTanSkinned> vertices;
+		std::vector<unsigned int> subsetStarts;
+		SyntheticRig::Build(NODE_COUNT, 1, 19, &skeleton, &clips);
+		SyntheticRig::BuildPaletteLayout(skeleton, &layout);
+		SyntheticRig::BuildSkinnedVertices(skeleton, layout, VERTICES_PER_BONE, 23, &vertices, &subsetStarts);
+
+		LocalPose pose;
+		pose.Resize(skeleton.GetNodeCount());
+		std::vector<Matrix> toRootMatrices(skeleton.GetNodeCount());
+		std::vector<Matrix> skinMatrices(layout.GetBoneCount());
+		clips[0].SamplePose(skeleton, SAMPLE_TIME, nullptr, &pose);
+		skeleton.ComputeToRootMatrices(pose, toRootMatrices.data());
+		for (unsigned int bone = 0; bone < layout.GetBoneCount(); ++bone)
+		{
+			skinMatrices[bone] = layout.OffsetMatrices[bone] * toRootMatrices[layout.NodeIndices[bone]];
+		}
+
+		CpuSkinner skinner;
+		const UINT subsetCount = static_cast<UINT>(subsetStarts.size() - 1);
+		skinner.Prepare(vertices.data(), subsetStarts.data(), subsetCount, layout);
+
+		const size_t vertexCount = vertices.size();
+		std::vector<Vector3> referencePositions(vertexCount);
+		std::vector<Vector3> referenceNormals(vertexCount);
+		std::vector<Vector3> positions(vertexCount);
+		std::vector<Vector3> normals(vertexCount);
+		std::vector<Vector3> linearPositions;
+		bool bPassed = true;
+
+		std::cout << std::fixed << std::setprecision(3);
+		std::cout << "[skin] vertices " << vertexCount << ", bones " << layout.GetBoneCount() << ", subsets " << subsetCount << ", batch "
+			<< static_cast<UINT>(CpuSkinner::BATCH_SIZE) <<
+#if defined(__AVX__)
+			" (AVX)"
+#else
+			" (SSE x2)"
+#endif
+			<< ", position + normal" << std::endl;
+
+		const eSkinningMode modes[] = { eSkinningMode::LinearBlend, eSkinningMode::DualQuaternion };
+		for (eSkinningMode mode : modes)
+		{
+			CpuSkinner::BonePalette palette;
+			const double paletteMs = MeasureMs(ITERATION_COUNT, [&]() { CpuSkinner::BuildBonePalette(skinMatrices.data(), layout.GetBoneCount(), mode, &palette); });
+
+			// :  ϳ Į
+			const double scalarMs = MeasureMs(ITERATION_COUNT, [&]() { skinReference(vertices, subsetStarts, layout, palette, &referencePositions, &referenceNormals); });
+			const double simdMs = MeasureMs(ITERATION_COUNT, [&]() { skinner.Skin(palette, nullptr, positions.data(), normals.data()); });
+			const SkinError error = measureError(positions, normals, referencePositions, referenceNormals);
+			const bool bMatch = error.Position <= POSITION_TOLERANCE && error.Normal <= NORMAL_TOLERANCE;
+			bPassed = bPassed && bMatch;
+
+			std::cout << "  " << getModeName(mode) << ": palette " << paletteMs * 1000.0 << " us" << std::endl
+				<< "    scalar " << std::setw(8) << scalarMs << " ms  " << std::setw(8) << vertexCount / scalarMs / 1000.0 << " Mverts/s" << std::endl
+				<< "    simd   " << std::setw(8) << simdMs << " ms  " << std::setw(8) << vertexCount / simdMs / 1000.0 << " Mverts/s  "
+				<< std::setw(5) << scalarMs / simdMs << "x" << std::endl
+				<< std::scientific << std::setprecision(2) << "    max error vs scalar: position " << error.Position << ", normal (1 - cos) " << error.Normal
+				<< std::fixed << std::setprecision(3) << " " << (bMatch ? "ok" : "FAILED") << std::endl;
+
+			//   ÷ ġ θ Ƿ    ƾ Ѵ.
+			std::vector<Vector3> threadedPositions(vertexCount);
+			std::vector<Vector3> threadedNormals(vertexCount);
+			const UINT maxThreadCount = GetHardwareThreadCount();
+			for (UINT threadCount = 2; threadCount <= maxThreadCount; ++threadCount)
+			{
+				JobSystem jobSystem(threadCount - 1);
+				const double threadedMs = MeasureMs(ITERATION_COUNT, [&]() { skinner.Skin(palette, &jobSystem, threadedPositions.data(), threadedNormals.data()); });
+				const bool bIdentical = memcmp(threadedPositions.data(), positions.data(), sizeof(Vector3) * vertexCount) == 0
+					&& memcmp(threadedNormals.data(), normals.data(), sizeof(Vector3) * vertexCount) == 0;
+				bPassed = bPassed && bIdentical;
+
+				std::cout << "    " << threadCount << " threads " << std::setw(6) << threadedMs << " ms  " << std::setw(8)
+					<< vertexCount / threadedMs / 1000.0 << " Mverts/s  identical " << (bIdentical ? "yes" : "NO") << std::endl;
+			}
+
+			if (mode == eSkinningMode::LinearBlend)
+			{
+				linearPositions = positions;
+			}
+		}
+
+		//   ģ   ʹϾ  庸 󸶳 ٱ  (  )
+		float maxBlendDifference = 0.f;
+		for (size_t i = 0; i < vertexCount; ++i)
+		{
+			maxBlendDifference = std::max<float>(maxBlendDifference, Vector3::Distance(linearPositions[i], positions[i]));
+		}
+		std::cout << "  dual quaternion vs linear blend on blended vertices: max " << maxBlendDifference << std::endl;
+
+		//  ϳ   ü ȯ̹Ƿ   ƾ Ѵ.  ->  ʹϾ ȯ ˻
+		std::vector<vertex::PosNormalTexTanSkinned> rigidVertices = vertices;
+		for (vertex::PosNormalTexTanSkinned& vertex : rigidVertices)
+		{
+			vertex.Weights[0] = 1.f;
+			for (int k = 1; k < CpuSkinner::MAX_INFLUENCE_COUNT; ++k)
+			{
+				vertex.Indices[k] = vertex::PosNormalTexTanSkinned::INVALID_INDEX;
+				vertex.Weights[k] = 0.f;
+			}
+		}
+
+		CpuSkinner rigidSkinner;
+		rigidSkinner.Prepare(rigidVertices.data(), subsetStarts.data(), subsetCount, layout);
+		CpuSkinner::BonePalette linearPalette;
+		CpuSkinner::BonePalette dualPalette;
+		CpuSkinner::BuildBonePalette(skinMatrices.data(), layout.GetBoneCount(), eSkinningMode::LinearBlend, &linearPalette);
+		CpuSkinner::BuildBonePalette(skinMatrices.data(), layout.GetBoneCount(), eSkinningMode::DualQuaternion, &dualPalette);
+		rigidSkinner.Skin(linearPalette, nullptr, referencePositions.data(), referenceNormals.data());
+		rigidSkinner.Skin(dualPalette, nullptr, positions.data(), normals.data());
+
+		const SkinError rigidError = measureError(positions, normals, referencePositions, referenceNormals);
+		const bool bRigidMatch = rigidError.Position <= POSITION_TOLERANCE * 10.f && rigidError.Normal <= NORMAL_TOLERANCE;
+		bPassed = bPassed && bRigidMatch;
+		std::cout << std::scientific << std::setprecision(2) << "  single bone vertices, dual quaternion vs linear blend: position "
+			<< rigidError.Position << ", normal (1 - cos) " << rigidError.Normal << std::fixed << std::setprecision(3) << " "
+			<< (bRigidMatch ? "ok" : "FAILED") << std::endl;
+
+		return bPassed;
+	}
+}
@@ -0,0 +1,157 @@
+#include <cmath>
+#include <random>
+#include <string>
+
+#include "SyntheticRig.h"
+
+namespace benchmark
+{
+	using namespace DirectX::SimpleMath;
+	using namespace resourceManager;
+
+	void SyntheticRig::Build(unsigned int nodeCount, unsigned int clipCount, unsigned int seed,
+		Skeleton* outSkeleton, std::vector<AnimationClip>* outClips)
+	{
+		std::mt19937 random(seed);
+		std::uniform_real_distribution<float> unit(-1.f, 1.f);
+
+		outSkeleton->NodeNames.resize(nodeCount);
+		outSkeleton->ParentIndices.resize(nodeCount);
+		outSkeleton->BindPose.Resize(nodeCount);
+
+		for (unsigned int i = 0; i < nodeCount; ++i)
+		{
+			outSkeleton->NodeNames[i] = "node" + std::to_string(i);
+			outSkeleton->ParentIndices[i] = i == 0 ? Skeleton::INVALID_INDEX : ((i - 1) % CHAIN_LENGTH == 0 ? 0 : static_cast<int>(i) - 1);
+			outSkeleton->BindPose.Translations[i] = i == 0 ? Vector3::Zero : Vector3(unit(random) * 2.f, 10.f, unit(random) * 2.f);
+			outSkeleton->BindPose.Rotations[i] = Quaternion::Identity;
+			outSkeleton->BindPose.Scales[i] = Vector3::One;
+		}
+
+		outClips->resize(clipCount);
+		for (unsigned int clipIndex = 0; clipIndex < clipCount; ++clipIndex)
+		{
+			AnimationClip& clip = (*outClips)[clipIndex];
+			clip.Name = "clip" + std::to_string(clipIndex);
+			clip.Duration = 2.0 + clipIndex;
+			clip.Channels.clear();
+
+			const unsigned int keyCount = static_cast<unsigned int>(clip.Duration * KEYS_PER_SECOND) + 1;
+
+			for (unsigned int i = 0; i < nodeCount; ++i)
+			{
+				if (i % 16 == 15)
+				{
+					continue;
+				}
+
+				AnimationNode channel;
+				channel.Name = outSkeleton->NodeNames[i];
+
+				Vector3 axis(unit(random), unit(random), unit(random));
+				axis.Normalize();
+				const float amplitude = 0.2f + 0.6f * fabsf(unit(random));
+				const float frequency = 0.5f + 1.5f * fabsf(unit(random));
+				const float phase = 3.f * unit(random);
+
+				for (unsigned int key = 0; key < keyCount; ++key)
+				{
+					const float time = static_cast<float>(key) / KEYS_PER_SECOND;
+					const float angle = amplitude * sinf(6.2831853f * frequency * time + phase);
+
+					Vector3 translation = outSkeleton->BindPose.Translations[i];
+					if (i == 0)
+					{
+						translation += Vector3(30.f * time, 2.f * sinf(6.2831853f * 2.f * time), 0.f);
+					}
+
+					channel.PositionKeys.Times.push_back(time);
+					channel.PositionKeys.Values.push_back(translation);
+					channel.RotationKeys.Times.push_back(time);
+					channel.RotationKeys.Values.push_back(Quaternion::CreateFromAxisAngle(axis, angle));
+					channel.ScalingKeys.Times.push_back(time);
+					channel.ScalingKeys.Values.push_back(Vector3::One);
+				}
+
+				clip.Channels.push_back(std::move(channel));
+			}
+
+			clip.Bind(*outSkeleton);
+		}
+	}
+	void SyntheticRig::BuildPaletteLayout(const Skeleton& skeleton, PaletteLayout* outLayout)
+	{
+		const unsigned int nodeCount = skeleton.GetNodeCount();
+		std::vector<Matrix> toRootMatrices(nodeCount);
+		skeleton.ComputeToRootMatrices(skeleton.BindPose, toRootMatrices.data());
+
+		outLayout->NodeIndices.resize(nodeCount);
+		outLayout->OffsetMatrices.resize(nodeCount);
+		for (unsigned int i = 0; i < nodeCount; ++i)
+		{
+			outLayout->NodeIndices[i] = i;
+			outLayout->OffsetMatrices[i] = toRootMatrices[i].Invert();
+		}
+
+		outLayout->SubsetOffsets = { 0, nodeCount / 2, nodeCount };
+	}
+	void SyntheticRig::BuildSkinnedVertices(const Skeleton& skeleton, const PaletteLayout& layout, unsigned int verticesPerBone,
+		unsigned int seed, std::vector<vertex::PosNormalTexTanSkinned>* outVertices, std::vector<unsigned int>* outSubsetStarts)
+	{
+		std::mt19937 random(seed);
+		std::uniform_real_distribution<float> unit(-1.f, 1.f);
+
+		std::vector<Matrix> toRootMatrices(skeleton.GetNodeCount());
+		skeleton.ComputeToRootMatrices(skeleton.BindPose, toRootMatrices.data());
+
+		outVertices->clear();
+		outSubsetStarts->clear();
+
+		const unsigned int subsetCount = static_cast<unsigned int>(layout.SubsetOffsets.size()) - 1;
+		for (unsigned int subset = 0; subset < subsetCount; ++subset)
+		{
+			const unsigned int boneBegin = layout.SubsetOffsets[subset];
+			const unsigned int boneEnd = layout.SubsetOffsets[subset + 1];
+			outSubsetStarts->push_back(static_cast<unsigned int>(outVertices->size()));
+
+			for (unsigned int bone = boneBegin; bone < boneEnd; ++bone)
+			{
+				const unsigned int node = layout.NodeIndices[bone];
+				const int parentNode = skeleton.ParentIndices[node];
+
+				// θ 带    ã´.
+				int parentBone = vertex::PosNormalTexTanSkinned::INVALID_INDEX;
+				for (unsigned int other = boneBegin; other < boneEnd; ++other)
+				{
+					if (static_cast<int>(layout.NodeIndices[other]) == parentNode)
+					{
+						parentBone = static_cast<int>(other - boneBegin);
+					}
+				}
+
+				for (unsigned int i = 0; i < verticesPerBone; ++i)
+				{
+					vertex::PosNormalTexTanSkinned vertex;
+					vertex.Pos = toRootMatrices[node].Translation() + Vector3(unit(random), unit(random), unit(random)) * 3.f;
+					vertex.Normal = Vector3(unit(random), unit(random), unit(random));
+					vertex.Normal.Normalize();
+					vertex.TangentU = Vector3::UnitX;
+					vertex.Tex = Vector2::Zero;
+					vertex.Indices[0] = static_cast<int>(bone - boneBegin);
+					vertex.Weights[0] = 1.f;
+
+					if (parentBone != vertex::PosNormalTexTanSkinned::INVALID_INDEX)
+					{
+						vertex.Weights[0] = 0.5f + 0.5f * fabsf(unit(random));
+						vertex.Indices[1] = parentBone;
+						vertex.Weights[1] = 1.f - vertex.Weights[0];
+					}
+
+					outVertices->push_back(vertex);
+				}
+			}
+		}
+
+		outSubsetStarts->push_back(static_cast<unsigned int>(outVertices->size()));
+	}
+}
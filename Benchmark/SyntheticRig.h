@@ -0,0 +1,32 @@
+#pragma once
+
+#include <vector>
+
+#include "../ResourceManager/Animation.h"
+#include "../ResourceManager/Vertex.h"
+
+namespace benchmark
+{
+	// FBX  ִϸ̼ Ÿ   ռ ̷ Ŭ
+	// Ʈ  CHAIN_LENGTH 罽    , ͽͰ  ó  ä
+	// Ӹ ̵, ȸ, ũ Ű . ȸ  ̰ ̵ Ʈ δ.
+	// 16° 帶 ä  ε  ε  Ѵ.
+	class SyntheticRig
+	{
+	public:
+		enum { CHAIN_LENGTH = 8, KEYS_PER_SECOND = 30 };
+
+	public:
+		// seed   ׸ . Ŭ i ̴ 2 + i
+		static void Build(unsigned int nodeCount, unsigned int clipCount, unsigned int seed,
+			resourceManager::Skeleton* outSkeleton, std::vector<resourceManager::AnimationClip>* outClips);
+		//  带   ȷƮ,      ó  Ѵ.
+		//   ε  Ʈ   ̴.
+		static void BuildPaletteLayout(const resourceManager::Skeleton& skeleton, resourceManager::PaletteLayout* outLayout);
+		//  ε   ֺ  Ѹ Ų ޽, θ   ¿  ѿ  Ǵ.
+		//  ε SkinnedModeló   ȣ,  i  [outSubsetStarts[i], outSubsetStarts[i + 1]) ִ.
+		static void BuildSkinnedVertices(const resourceManager::Skeleton& skeleton, const resourceManager::PaletteLayout& layout,
+			unsigned int verticesPerBone, unsigned int seed, std::vector<vertex::PosNormalTexTanSkinned>* outVertices,
+			std::vector<unsigned int>* outSubsetStarts);
+	};
+}
@@ -0,0 +1,258 @@
+#include <windows.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include "Benchmark.h"
+#include "JobSystem.h"
+#include "SyntheticRig.h"
+#include "../ResourceManager/RigCache.h"
+#include "../ResourceManager/VertexAnimationTexture.h"
+
+namespace benchmark
+{
+	using namespace common;
+	using namespace DirectX;
+	using namespace DirectX::SimpleMath;
+	using namespace resourceManager;
+
+	namespace
+	{
+		enum { NODE_COUNT = 64, CLIP_COUNT = 3, VERTICES_PER_BONE = 16, INSTANCE_COUNT = 4096 };
+
+		const char* TEMP_FILE_NAME = "vat_benchmark.vat";
+		const char* TEMP_RIG_FILE_NAME = "vat_benchmark.rig";
+		const float MAX_NORMAL_ERROR_DEGREES = 0.25f;
+
+		// ̴ó ġ ģ  ϳ  ű  Ű, ؽó ο  Ѵ.
+		class ReferenceSkinner
+		{
+		public:
+			ReferenceSkinner(const Skeleton& skeleton, const PaletteLayout& layout, const std::vector<vertex::PosNormalTexTanSkinned>& vertices,
+				const std::vector<unsigned int>& subsetStarts)
+				: mSkeleton(skeleton)
+				, mLayout(layout)
+				, mVertices(vertices)
+				, mSubsetStarts(subsetStarts)
+				, mToRootMatrices(skeleton.GetNodeCount())
+				, mSkinMatrices(layout.GetBoneCount())
+			{
+				mPose.Resize(skeleton.GetNodeCount());
+			}
+
+			void Skin(const AnimationClip& clip, float clipTime, std::vector<Vector3>* outPositions, std::vector<Vector3>* outNormals)
+			{
+				clip.SamplePose(mSkeleton, clipTime, nullptr, &mPose);
+				mSkeleton.ComputeToRootMatrices(mPose, mToRootMatrices.data());
+				for (unsigned int bone = 0; bone < mLayout.GetBoneCount(); ++bone)
+				{
+					mSkinMatrices[bone] = mLayout.OffsetMatrices[bone] * mToRootMatrices[mLayout.NodeIndices[bone]];
+				}
+
+				outPositions->resize(mVertices.size());
+				outNormals->resize(mVertices.size());
+				for (size_t subset = 0; subset + 1 < mSubsetStarts.size(); ++subset)
+				{
+					const unsigned int boneOffset = mLayout.SubsetOffsets[subset];
+					for (unsigned int i = mSubsetStarts[subset]; i < mSubsetStarts[subset + 1]; ++i)
+					{
+						const vertex::PosNormalTexTanSkinned& vertex = mVertices[i];
+						Matrix combined = mSkinMatrices[boneOffset + vertex.Indices[0]] * vertex.Weights[0];
+						for (int k = 1; k < 4 && vertex.Indices[k] != vertex::PosNormalTexTanSkinned::INVALID_INDEX; ++k)
+						{
+							combined += mSkinMatrices[boneOffset + vertex.Indices[k]] * vertex.Weights[k];
+						}
+
+						(*outPositions)[i] = Vector3::Transform(vertex.Pos, combined);
+						Vector3 normal = Vector3::TransformNormal(vertex.Normal, combined);
+						normal.Normalize();
+						(*outNormals)[i] = normal;
+					}
+				}
+			}
+
+		private:
+			const Skeleton& mSkeleton;
+			const PaletteLayout& mLayout;
+			const std::vector<vertex::PosNormalTexTanSkinned>& mVertices;
+			const std::vector<unsigned int>& mSubsetStarts;
+			LocalPose mPose;
+			std::vector<Matrix> mToRootMatrices;
+			std::vector<Matrix> mSkinMatrices;
+		};
+
+		float getAngleDegrees(const Vector3& lhs, const Vector3& rhs)
+		{
+			return XMConvertToDegrees(acosf(std::min<float>(std::max<float>(lhs.Dot(rhs), -1.f), 1.f)));
+		}
+
+		bool isTextureEqual(const VertexAnimationTexture& lhs, const VertexAnimationTexture& rhs)
+		{
+			if (lhs.GetPositionTexels() != rhs.GetPositionTexels() || lhs.GetNormalTexels() != rhs.GetNormalTexels()
+				|| lhs.GetClipCount() != rhs.GetClipCount() || lhs.GetTextureHeight() != rhs.GetTextureHeight()
+				|| memcmp(&lhs.GetShaderConstants(), &rhs.GetShaderConstants(), sizeof(VertexAnimationTexture::ShaderConstants)) != 0)
+			{
+				return false;
+			}
+
+			for (UINT i = 0; i < lhs.GetClipCount(); ++i)
+			{
+				const VertexAnimationTexture::ClipRange& lhsClip = lhs.GetClip(i);
+				const VertexAnimationTexture::ClipRange& rhsClip = rhs.GetClip(i);
+				if (lhsClip.Name != rhsClip.Name || lhsClip.FirstFrame != rhsClip.FirstFrame || lhsClip.FrameCount != rhsClip.FrameCount
+					|| lhsClip.FrameRate != rhsClip.FrameRate || lhsClip.Duration != rhsClip.Duration)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+	}
+
+	bool RunVatBenchmark()
+	{
+		Skeleton skeleton;
+		std::vector<AnimationClip> clips;
+		PaletteLayout layout;
+		std::vector<vertex::PosNormalTexTanSkinned> vertices;
+		std::vector<unsigned int> subsetStarts;
+		SyntheticRig::Build(NODE_COUNT, CLIP_COUNT, 13, &skeleton, &clips);
+		SyntheticRig::BuildPaletteLayout(skeleton, &layout);
+		SyntheticRig::BuildSkinnedVertices(skeleton, layout, VERTICES_PER_BONE, 9, &vertices, &subsetStarts);
+
+		std::vector<const AnimationClip*> clipPointers;
+		for (const AnimationClip& clip : clips)
+		{
+			clipPointers.push_back(&clip);
+		}
+
+		const VertexAnimationTexture::SkinnedMeshSource source = { &skeleton, &layout, vertices.data(), subsetStarts.data(),
+			static_cast<unsigned int>(subsetStarts.size() - 1) };
+		const float frameRate = static_cast<float>(VertexAnimationTexture::DEFAULT_FRAME_RATE);
+
+		// :    ý   ƾ Ѵ.
+		VertexAnimationTexture texture;
+		bool bBaked = true;
+		const double serialMs = MeasureMs(1, [&]() { bBaked = VertexAnimationTexture::Bake(source, clipPointers, frameRate, nullptr, &texture); });
+		if (!bBaked)
+		{
+			std::cout << "[vat] bake FAILED" << std::endl;
+			return false;
+		}
+
+		VertexAnimationTexture parallelTexture;
+		JobSystem jobSystem;
+		const double parallelMs = MeasureMs(1, [&]() { VertexAnimationTexture::Bake(source, clipPointers, frameRate, &jobSystem, &parallelTexture); });
+		const bool bParallelEqual = isTextureEqual(texture, parallelTexture);
+
+		const Vector3 boundsSize(texture.GetShaderConstants().BoundsSize);
+		std::cout << std::fixed << std::setprecision(3);
+		std::cout << "[vat] nodes " << static_cast<UINT>(NODE_COUNT) << ", vertices " << vertices.size() << ", clips " << static_cast<UINT>(CLIP_COUNT)
+			<< ", " << frameRate << " frames/s" << std::endl
+			<< "  texture " << texture.GetTextureWidth() << "x" << texture.GetTextureHeight() << ", frames " << texture.GetFrameCount()
+			<< ", " << texture.GetByteSize() / 1024.0 << " KB (positions RGBA16F + normals RG16F)" << std::endl
+			<< "  bake " << serialMs << " ms serial, " << parallelMs << " ms with " << jobSystem.GetThreadCount() << " threads, identical "
+			<< (bParallelEqual ? "yes" : "NO") << std::endl;
+
+		//  Ӹ  ġ   ð  Űװ Ѵ.
+		// ġ half ݿø(ȭ  2^-12)ŭ,  ȸü + half ŭ   ִ.
+		const float positionTolerance = boundsSize.Length() / 4096.f + 1e-4f;
+		ReferenceSkinner skinner(skeleton, layout, vertices, subsetStarts);
+		std::vector<Vector3> positions;
+		std::vector<Vector3> normals;
+		std::vector<Vector3> nextPositions;
+		std::vector<Vector3> nextNormals;
+		float maxPositionError = 0.f;
+		float maxNormalError = 0.f;
+		float maxMidPositionError = 0.f;
+		float maxMidNormalError = 0.f;
+		float maxFrameMotion = 0.f;
+
+		for (UINT clipIndex = 0; clipIndex < CLIP_COUNT; ++clipIndex)
+		{
+			const VertexAnimationTexture::ClipRange& range = texture.GetClip(clipIndex);
+			const int foundClip = texture.FindClip(clips[clipIndex].Name);
+			if (foundClip != static_cast<int>(clipIndex))
+			{
+				std::cout << "  clip lookup FAILED for " << clips[clipIndex].Name << std::endl;
+				return false;
+			}
+
+			for (UINT frame = 0; frame < range.FrameCount; ++frame)
+			{
+				const float frameTime = std::min<float>(frame / range.FrameRate, range.Duration);
+				skinner.Skin(clips[clipIndex], frameTime, &positions, &normals);
+
+				for (UINT i = 0; i < vertices.size(); ++i)
+				{
+					maxPositionError = std::max<float>(maxPositionError, Vector3::Distance(texture.DecodePosition(i, range.FirstFrame + frame), positions[i]));
+					maxNormalError = std::max<float>(maxNormalError, getAngleDegrees(texture.DecodeNormal(i, range.FirstFrame + frame), normals[i]));
+				}
+
+				//  : ̴   Ȯ  󸶳  (  )
+				if (frame + 1 < range.FrameCount)
+				{
+					const float midTime = (frame + 0.5f) / range.FrameRate;
+					const Vector4 instanceClip = texture.MakeInstanceClip(clipIndex, midTime);
+					skinner.Skin(clips[clipIndex], frameTime + 1.f / range.FrameRate, &nextPositions, &nextNormals);
+					skinner.Skin(clips[clipIndex], midTime, &positions, &normals);
+
+					for (UINT i = 0; i < vertices.size(); ++i)
+					{
+						maxMidPositionError = std::max<float>(maxMidPositionError, Vector3::Distance(texture.SamplePosition(i, instanceClip), positions[i]));
+						maxMidNormalError = std::max<float>(maxMidNormalError, getAngleDegrees(texture.SampleNormal(i, instanceClip), normals[i]));
+						maxFrameMotion = std::max<float>(maxFrameMotion, Vector3::Distance(nextPositions[i], positions[i]) * 2.f);
+					}
+				}
+			}
+		}
+
+		const bool bFramesMatch = maxPositionError <= positionTolerance && maxNormalError <= MAX_NORMAL_ERROR_DEGREES;
+		std::cout << std::scientific << std::setprecision(2)
+			<< "  baked frames vs reference: position " << maxPositionError << " (tolerance " << positionTolerance << "), normal "
+			<< maxNormalError << " deg (tolerance " << MAX_NORMAL_ERROR_DEGREES << ") " << (bFramesMatch ? "ok" : "FAILED") << std::endl
+			<< "  between frames: position " << maxMidPositionError << " (one frame of motion " << maxFrameMotion << "), normal "
+			<< maxMidNormalError << " deg" << std::endl
+			<< std::fixed << std::setprecision(3);
+
+		// Ϸ  ٽ  ؽó  Ͱ ƾ Ѵ.
+		VertexAnimationTexture loaded;
+		const bool bRoundTrip = texture.Write(TEMP_FILE_NAME) && loaded.Read(TEMP_FILE_NAME) && isTextureEqual(texture, loaded);
+		std::remove(TEMP_FILE_NAME);
+		std::cout << "  write / read round trip " << (bRoundTrip ? "ok" : "FAILED") << std::endl;
+
+		// 帮  Է: .rig   ׸  ؽó  ׸  Ͱ ƾ ϰ, ߸  źؾ Ѵ.
+		RigCache rig;
+		VertexAnimationTexture rigTexture;
+		const bool bRigRoundTrip = RigCache::Write(TEMP_RIG_FILE_NAME, source, clipPointers) && rig.Read(TEMP_RIG_FILE_NAME)
+			&& VertexAnimationTexture::Bake(rig.GetSource(), rig.GetClips(), frameRate, nullptr, &rigTexture) && isTextureEqual(texture, rigTexture);
+
+		std::vector<char> rigBytes;
+		{
+			std::ifstream file(TEMP_RIG_FILE_NAME, std::ios::binary);
+			rigBytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		}
+		{
+			std::ofstream file(TEMP_RIG_FILE_NAME, std::ios::binary | std::ios::trunc);
+			file.write(rigBytes.data(), rigBytes.size() / 2);
+		}
+		RigCache truncatedRig;
+		const bool bTruncatedRejected = !rigBytes.empty() && !truncatedRig.Read(TEMP_RIG_FILE_NAME);
+		std::remove(TEMP_RIG_FILE_NAME);
+		std::cout << "  rig write / read / bake " << (bRigRoundTrip ? "identical" : "MISMATCH") << ", truncated rig "
+			<< (bTruncatedRejected ? "rejected ok" : "accepted FAILED") << std::endl;
+
+		// νϽ GPU ѱ :  ȷƮ  Ŭ  float4 ϳ
+		const size_t paletteBytes = static_cast<size_t>(layout.GetBoneCount()) * sizeof(Matrix);
+		std::cout << "  per instance upload for " << static_cast<UINT>(INSTANCE_COUNT) << " instances: palette " << paletteBytes * INSTANCE_COUNT / 1024
+			<< " KB, vat " << sizeof(Vector4) * INSTANCE_COUNT / 1024 << " KB" << std::endl;
+
+		return bFramesMatch && bParallelEqual && bRoundTrip && bRigRoundTrip && bTruncatedRejected;
+	}
+}
@@ -0,0 +1,216 @@
+#include <windows.h>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "JobSystem.h"
+#include "TextMeshParser.h"
+#include "VertexWelder.h"
+
+namespace benchmark
+{
+	using namespace common;
+
+	namespace
+	{
+		enum { SUBSET_COUNT = 16 }; //  ó  ķ Ѵ.
+
+		const char* result(bool bPassed)
+		{
+			return bPassed ? "ok" : "FAILED";
+		}
+
+		// Ͱ      ó ģ. jitter ġ ϴ ִ 
+		void explode(const std::vector<MeshVertex>& vertices, const std::vector<UINT>& indices, float jitter,
+			std::vector<MeshVertex>* outVertices, std::vector<UINT>* outIndices)
+		{
+			std::mt19937 random(7);
+			std::uniform_real_distribution<float> distribution(-jitter, jitter);
+
+			outVertices->resize(indices.size());
+			outIndices->resize(indices.size());
+
+			for (size_t i = 0; i < indices.size(); ++i)
+			{
+				MeshVertex vertex = vertices[indices[i]];
+				if (jitter > 0.f)
+				{
+					vertex.Pos += Vector3(distribution(random), distribution(random), distribution(random));
+				}
+
+				(*outVertices)[i] = vertex;
+				(*outIndices)[i] = static_cast<UINT>(i);
+			}
+		}
+
+		// ģ ޽ SUBSET_COUNT ﰢ    ϰ,     ȯѴ.
+		UINT weldSubsets(std::vector<MeshVertex>* vertices, std::vector<UINT>* indices, const WeldOptions& options,
+			JobSystem* jobSystem, std::vector<UINT>* outSubsetCounts)
+		{
+			const UINT triangleCount = static_cast<UINT>(indices->size() / 3);
+			outSubsetCounts->assign(SUBSET_COUNT, 0);
+
+			auto weldRange = [&](UINT begin, UINT end)
+				{
+					for (UINT i = begin; i < end; ++i)
+					{
+						const UINT firstTriangle = triangleCount * i / SUBSET_COUNT;
+						const UINT lastTriangle = triangleCount * (i + 1) / SUBSET_COUNT;
+						const UINT cornerCount = (lastTriangle - firstTriangle) * 3;
+
+						UINT* subsetIndices = &(*indices)[firstTriangle * 3];
+						for (UINT j = 0; j < cornerCount; ++j)
+						{
+							subsetIndices[j] = j;
+						}
+
+						(*outSubsetCounts)[i] = VertexWelder::Weld(&(*vertices)[firstTriangle * 3], cornerCount, subsetIndices, cornerCount,
+							&MeshVertex::Pos, &MeshVertex::Normal, &MeshVertex::Tex, options);
+					}
+				};
+
+			if (jobSystem != nullptr)
+			{
+				jobSystem->ParallelFor(SUBSET_COUNT, 1, weldRange);
+			}
+			else
+			{
+				weldRange(0, SUBSET_COUNT);
+			}
+
+			UINT total = 0;
+			for (UINT count : *outSubsetCounts)
+			{
+				total += count;
+			}
+
+			return total;
+		}
+
+		//          .
+		bool verify(const std::vector<MeshVertex>& source, const std::vector<MeshVertex>& welded, const std::vector<UINT>& indices,
+			const std::vector<UINT>& subsetCounts, const WeldOptions& options)
+		{
+			const UINT triangleCount = static_cast<UINT>(indices.size() / 3);
+
+			for (UINT i = 0; i < SUBSET_COUNT; ++i)
+			{
+				const UINT firstTriangle = triangleCount * i / SUBSET_COUNT;
+				const UINT lastTriangle = triangleCount * (i + 1) / SUBSET_COUNT;
+
+				for (UINT j = firstTriangle * 3; j < lastTriangle * 3; ++j)
+				{
+					if (indices[j] >= subsetCounts[i])
+					{
+						return false;
+					}
+
+					const MeshVertex& a = source[j];
+					const MeshVertex& b = welded[firstTriangle * 3 + indices[j]];
+					for (int k = 0; k < 3; ++k)
+					{
+						if (fabsf((&a.Pos.x)[k] - (&b.Pos.x)[k]) > options.PositionEpsilon
+							|| fabsf((&a.Normal.x)[k] - (&b.Normal.x)[k]) > options.NormalEpsilon)
+						{
+							return false;
+						}
+					}
+					if (fabsf(a.Tex.x - b.Tex.x) > options.TexCoordEpsilon || fabsf(a.Tex.y - b.Tex.y) > options.TexCoordEpsilon)
+					{
+						return false;
+					}
+				}
+			}
+
+			return true;
+		}
+
+		bool runModel(const char* fileName, JobSystem* jobSystem)
+		{
+			std::vector<MeshVertex> vertices;
+			std::vector<UINT> indices;
+
+			if (!TextMeshParser::Load(fileName, &vertices, &indices))
+			{
+				std::cout << "  " << fileName << " not found" << std::endl;
+				return true;
+			}
+
+			bool bPassed = true;
+			std::cout << "  " << fileName << ": " << vertices.size() << " vertices, " << indices.size() << " corners" << std::endl;
+
+			WeldOptions exactOptions;
+			exactOptions.PositionEpsilon = 0.f;
+			exactOptions.NormalEpsilon = 0.f;
+			exactOptions.TexCoordEpsilon = 0.f;
+
+			// ġ epsilon 1/4       Ѵ.
+			WeldOptions jitterOptions;
+			jitterOptions.PositionEpsilon = 1e-4f;
+
+			const struct
+			{
+				const char* Name;
+				float Jitter;
+				WeldOptions Options;
+			} cases[] =
+			{
+				{ "exact ", 0.f, exactOptions },
+				{ "jitter", jitterOptions.PositionEpsilon * 0.25f, jitterOptions }
+			};
+
+			for (const auto& weldCase : cases)
+			{
+				std::vector<MeshVertex> source;
+				std::vector<UINT> sourceIndices;
+				explode(vertices, indices, weldCase.Jitter, &source, &sourceIndices);
+
+				std::vector<MeshVertex> welded;
+				std::vector<UINT> weldedIndices;
+				std::vector<UINT> subsetCounts;
+				UINT serialCount = 0;
+				UINT parallelCount = 0;
+
+				const double serialMs = MeasureMs(1, [&]()
+					{
+						welded = source;
+						weldedIndices = sourceIndices;
+						serialCount = weldSubsets(&welded, &weldedIndices, weldCase.Options, nullptr, &subsetCounts);
+					});
+				const double parallelMs = MeasureMs(1, [&]()
+					{
+						welded = source;
+						weldedIndices = sourceIndices;
+						parallelCount = weldSubsets(&welded, &weldedIndices, weldCase.Options, jobSystem, &subsetCounts);
+					});
+
+				const bool bCaseValid = serialCount == parallelCount
+					&& verify(source, welded, weldedIndices, subsetCounts, weldCase.Options);
+				bPassed = bPassed && bCaseValid;
+
+				std::cout << "    " << weldCase.Name << ": " << std::setw(7) << source.size() << " -> " << std::setw(7) << parallelCount
+					<< " (" << std::setprecision(1) << 100.0 * (source.size() - parallelCount) / source.size() << "% welded)"
+					<< std::setprecision(3) << ", serial " << serialMs << " ms, parallel(" << jobSystem->GetThreadCount() << ") "
+					<< parallelMs << " ms " << result(bCaseValid) << std::endl;
+			}
+
+			return bPassed;
+		}
+	}
+
+	bool RunWeldBenchmark()
+	{
+		std::cout << std::fixed << std::setprecision(3);
+		std::cout << "[weld] hashed vertex welding of per-corner meshes, " << SUBSET_COUNT << " subsets" << std::endl;
+
+		JobSystem jobSystem;
+		bool bPassed = runModel("../Resource/Models/skull.txt", &jobSystem);
+		bPassed = runModel("../Resource/Models/car.txt", &jobSystem) && bPassed;
+
+		return bPassed;
+	}
+}
@@ -0,0 +1,118 @@
+#include <windows.h>
+#include <cstring>
+#include <iostream>
+
+#include "Benchmark.h"
+
+// : Benchmark [culling | ray | parse | cluster | lod | pack | weld | compress | crowd | blend | bounds | schedule | vat | skin | sampling | pose]
+// ̸    ġũ Ѵ.
+int main(int argc, char* argv[])
+{
+	const char* name = argc > 1 ? argv[1] : nullptr;
+	bool bRan = false;
+	bool bPassed = true;
+
+	if (name == nullptr || strcmp(name, "culling") == 0)
+	{
+		bPassed = benchmark::RunCullingBenchmark() && bPassed;
+		bRan = true;
+	}
+
+	if (name == nullptr || strcmp(name, "ray") == 0)
+	{
+		bPassed = benchmark::RunRayBenchmark() && bPassed;
+		bRan = true;
+	}
+
+	if (name == nullptr || strcmp(name, "parse") == 0)
+	{
+		bPassed = benchmark::RunParseBenchmark() && bPassed;
+		bRan = true;
+	}
+
+	if (name == nullptr || strcmp(name, "cluster") == 0)
+	{
+		bPassed = benchmark::RunClusterBenchmark() && bPassed;
+		bRan = true;
+	}
+
+	if (name == nullptr || strcmp(name, "lod") == 0)
+	{
+		bPassed = benchmark::RunLodBenchmark() && bPassed;
+		bRan = true;
+	}
+
+	if (name == nullptr || strcmp(name, "crowd") == 0)
+	{
+		bPassed = benchmark::RunCrowdBenchmark() && bPassed;
+		bRan = true;
+	}
+
+	if (name == nullptr || strcmp(name, "pack") == 0)
+	{
+		bPassed = benchmark::RunPackBenchmark() && bPassed;
+		bRan = true;
+	}
+
+	if (name == nullptr || strcmp(name, "weld") == 0)
+	{
+		bPassed = benchmark::RunWeldBenchmark() && bPassed;
+		bRan = true;
+	}
+
+	if (name == nullptr || strcmp(name, "compress") == 0)
+	{
+		bPassed = benchmark::RunCompressionBenchmark() && bPassed;
+		bRan = true;
+	}
+
+	if (name == nullptr || strcmp(name, "blend") == 0)
+	{
+		bPassed = benchmark::RunBlendBenchmark() && bPassed;
+		bRan = true;
+	}
+
+	if (name == nullptr || strcmp(name, "bounds") == 0)
+	{
+		bPassed = benchmark::RunBoundsBenchmark() && bPassed;
+		bRan = true;
+	}
+
+	if (name == nullptr || strcmp(name, "schedule") == 0)
+	{
+		bPassed = benchmark::RunScheduleBenchmark() && bPassed;
+		bRan = true;
+	}
+
+	if (name == nullptr || strcmp(name, "vat") == 0)
+	{
+		bPassed = benchmark::RunVatBenchmark() && bPassed;
+		bRan = true;
+	}
+
+	if (name == nullptr || strcmp(name, "skin") == 0)
+	{
+		bPassed = benchmark::RunSkinBenchmark() && bPassed;
+		bRan = true;
+	}
+
+	if (name == nullptr || strcmp(name, "sampling") == 0)
+	{
+		bPassed = benchmark::RunSamplingBenchmark() && bPassed;
+		bRan = true;
+	}
+
+	if (name == nullptr || strcmp(name, "pose") == 0)
+	{
+		bPassed = benchmark::RunPoseBenchmark() && bPassed;
+		bRan = true;
+	}
+
+	if (!bRan)
+	{
+		std::cout << "unknown benchmark: " << name << std::endl;
+		return 1;
+	}
+
+	return bPassed ? 0 : 2;
+}
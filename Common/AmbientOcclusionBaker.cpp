@@ -0,0 +1,186 @@
+#include <cmath>
+
+#include "AmbientOcclusionBaker.h"
+
+namespace common
+{
+	namespace
+	{
+		// ī  ؽ,  Է̸  忡 ҷ   ش.
+		inline uint32_t hashUint(uint32_t x)
+		{
+			x ^= x >> 16;
+			x *= 0x7feb352du;
+			x ^= x >> 15;
+			x *= 0x846ca68bu;
+			x ^= x >> 16;
+			return x;
+		}
+
+		// Sobol  ù  , ù  Ʈ  van der Corput  .
+		inline uint32_t sobolFirst(uint32_t index)
+		{
+			index = (index << 16) | (index >> 16);
+			index = ((index & 0x00ff00ffu) << 8) | ((index & 0xff00ff00u) >> 8);
+			index = ((index & 0x0f0f0f0fu) << 4) | ((index & 0xf0f0f0f0u) >> 4);
+			index = ((index & 0x33333333u) << 2) | ((index & 0xccccccccu) >> 2);
+			index = ((index & 0x55555555u) << 1) | ((index & 0xaaaaaaaau) >> 1);
+			return index;
+		}
+		inline uint32_t sobolSecond(uint32_t index)
+		{
+			uint32_t result = 0;
+
+			for (uint32_t v = 1u << 31; index != 0; index >>= 1, v ^= v >> 1)
+			{
+				if (index & 1)
+				{
+					result ^= v;
+				}
+			}
+
+			return result;
+		}
+
+		//  24Ʈ Ἥ [0, 1)  Ǽ ٲ۴.
+		inline float toUnitFloat(uint32_t bits)
+		{
+			return static_cast<float>(bits >> 8) * (1.0f / 16777216.0f);
+		}
+	}
+
+	AmbientOcclusionBaker::AmbientOcclusionBaker()
+		: mVertexCount(0)
+		, mSampleCount(0)
+	{
+	}
+
+	void AmbientOcclusionBaker::Init(const std::vector<Vector3>& positions, const std::vector<uint32_t>& indices, uint32_t seed)
+	{
+		const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+		mBvh.Build(positions, indices);
+		mIndices = indices;
+		mVertexCount = static_cast<uint32_t>(positions.size());
+
+		mFrames.resize(triangleCount);
+		for (uint32_t i = 0; i < triangleCount; ++i)
+		{
+			const Vector3& v0 = positions[indices[i * 3 + 0]];
+			const Vector3& v1 = positions[indices[i * 3 + 1]];
+			const Vector3& v2 = positions[indices[i * 3 + 2]];
+
+			Vector3 normal = (v1 - v0).Cross(v2 - v0);
+			float length = normal.Length();
+			normal = length > 0.0f ? normal / length : Vector3(0.0f, 0.0f, 1.0f);
+
+			TriangleFrame& frame = mFrames[i];
+			frame.Origin = (v0 + v1 + v2) / 3.0f + 0.001f * normal;
+			frame.Normal = normal;
+
+			//  б     . (Duff et al. 2017)
+			float sign = normal.z >= 0.0f ? 1.0f : -1.0f;
+			float a = -1.0f / (sign + normal.z);
+			float b = normal.x * normal.y * a;
+			frame.Tangent = Vector3(1.0f + sign * normal.x * normal.x * a, sign * b, -sign * normal.x);
+			frame.Bitangent = Vector3(b, sign + normal.y * normal.y * a, -normal.y);
+
+			frame.Scramble[0] = hashUint(seed ^ hashUint(i * 2 + 0));
+			frame.Scramble[1] = hashUint(seed ^ hashUint(i * 2 + 1));
+		}
+
+		Reset();
+	}
+	void AmbientOcclusionBaker::Reset()
+	{
+		mUnoccludedCounts.assign(mFrames.size(), 0);
+		mSampleCount = 0;
+	}
+
+	void AmbientOcclusionBaker::Accumulate(uint32_t sampleCount, JobSystem* jobSystem)
+	{
+		const uint32_t triangleCount = static_cast<uint32_t>(mFrames.size());
+		const uint32_t firstSample = mSampleCount;
+
+		// ﰢ   Ƿ      .
+		if (jobSystem != nullptr)
+		{
+			jobSystem->ParallelFor(triangleCount, GRAIN_SIZE, [this, firstSample, sampleCount](uint32_t begin, uint32_t end)
+				{
+					bakeTriangles(begin, end, firstSample, sampleCount);
+				});
+		}
+		else
+		{
+			bakeTriangles(0, triangleCount, firstSample, sampleCount);
+		}
+
+		mSampleCount += sampleCount;
+	}
+
+	void AmbientOcclusionBaker::GetVertexAmbientAccess(std::vector<float>* outAmbientAccess) const
+	{
+		std::vector<float>& ambientAccess = *outAmbientAccess;
+		std::vector<uint32_t> vertexSharedCount(mVertexCount, 0);
+		ambientAccess.assign(mVertexCount, 0.0f);
+
+		// ﰢ  ϹǷ εҼ   ׻ .
+		const uint32_t triangleCount = static_cast<uint32_t>(mFrames.size());
+		for (uint32_t i = 0; i < triangleCount; ++i)
+		{
+			const float triangleAccess = GetTriangleAmbientAccess(i);
+
+			for (uint32_t j = 0; j < 3; ++j)
+			{
+				uint32_t index = mIndices[i * 3 + j];
+				ambientAccess[index] += triangleAccess;
+				++vertexSharedCount[index];
+			}
+		}
+
+		for (uint32_t i = 0; i < mVertexCount; ++i)
+		{
+			if (vertexSharedCount[i] > 0)
+			{
+				ambientAccess[i] /= vertexSharedCount[i];
+			}
+		}
+	}
+
+	void AmbientOcclusionBaker::bakeTriangles(uint32_t begin, uint32_t end, uint32_t firstSample, uint32_t sampleCount)
+	{
+		Vector3 directions[Bvh::MAX_PACKET_SIZE];
+
+		for (uint32_t i = begin; i < end; ++i)
+		{
+			const TriangleFrame& frame = mFrames[i];
+			uint32_t unoccludedCount = 0;
+
+			//      .
+			for (uint32_t sample = 0; sample < sampleCount; sample += Bvh::MAX_PACKET_SIZE)
+			{
+				const uint32_t rayCount = MathHelper::Min<uint32_t>(sampleCount - sample, Bvh::MAX_PACKET_SIZE);
+
+				for (uint32_t k = 0; k < rayCount; ++k)
+				{
+					const uint32_t sampleIndex = firstSample + sample + k;
+
+					// յ ݱ , cos(theta)   Sobol  ´.
+					float cosTheta = toUnitFloat(sobolFirst(sampleIndex) ^ frame.Scramble[0]);
+					float phi = 2.0f * MathHelper::Pi * toUnitFloat(sobolSecond(sampleIndex) ^ frame.Scramble[1]);
+					float sinTheta = sqrtf(MathHelper::Max(0.0f, 1.0f - cosTheta * cosTheta));
+
+					directions[k] = frame.Tangent * (sinTheta * cosf(phi)) + frame.Bitangent * (sinTheta * sinf(phi)) + frame.Normal * cosTheta;
+				}
+
+				uint32_t unoccludedMask = ~mBvh.OccludedPacket(frame.Origin, directions, rayCount) & ((1u << rayCount) - 1);
+				for (; unoccludedMask != 0; unoccludedMask &= unoccludedMask - 1)
+				{
+					++unoccludedCount;
+				}
+			}
+
+			mUnoccludedCounts[i] += unoccludedCount;
+		}
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <directxtk/SimpleMath.h>
+#include <vector>
+
+#include "Bvh.h"
+#include "JobSystem.h"
+
+namespace common
+{
+	using namespace DirectX::SimpleMath;
+
+	// ﰢ ߽ɿ   ݱ ̸   ֺ ޵ ´.
+	//   (õ, ﰢ ȣ,  ȣ)  Sobol ̹Ƿ
+	//   Accumulate  θ Ƚ   Ʈ  .
+	class AmbientOcclusionBaker
+	{
+	public:
+		enum { ALGORITHM_VERSION = 1 }; //  ̳   ٲٸ ÷   ĳø  Ѵ.
+
+	public:
+		AmbientOcclusionBaker();
+		~AmbientOcclusionBaker() = default;
+
+		void Init(const std::vector<Vector3>& positions, const std::vector<uint32_t>& indices, uint32_t seed = 0);
+		void Reset();
+
+		// ﰢ sampleCount    Ѵ. jobSystem  ȣ 忡 ´.
+		void Accumulate(uint32_t sampleCount, JobSystem* jobSystem = nullptr);
+
+		// ݱ    ֺ ﰢ ޵  Ѵ.
+		void GetVertexAmbientAccess(std::vector<float>* outAmbientAccess) const;
+		inline float GetTriangleAmbientAccess(uint32_t triangleIndex) const;
+		inline uint32_t GetSampleCount() const;
+		inline const Bvh& GetBvh() const;
+
+	private:
+		struct TriangleFrame
+		{
+			Vector3 Origin; // ü  ϵ   ¦   ߽
+			Vector3 Tangent;
+			Vector3 Bitangent;
+			Vector3 Normal;
+			uint32_t Scramble[2]; // ﰢ Sobol   
+		};
+
+		void bakeTriangles(uint32_t begin, uint32_t end, uint32_t firstSample, uint32_t sampleCount);
+
+	private:
+		enum { GRAIN_SIZE = 64 };
+
+		Bvh mBvh;
+		std::vector<TriangleFrame> mFrames;
+		std::vector<uint32_t> mUnoccludedCounts; // ﰢ    
+		std::vector<uint32_t> mIndices;
+		uint32_t mVertexCount;
+		uint32_t mSampleCount;
+	};
+
+	float AmbientOcclusionBaker::GetTriangleAmbientAccess(uint32_t triangleIndex) const
+	{
+		return mSampleCount > 0 ? static_cast<float>(mUnoccludedCounts[triangleIndex]) / mSampleCount : 0.0f;
+	}
+	uint32_t AmbientOcclusionBaker::GetSampleCount() const
+	{
+		return mSampleCount;
+	}
+	const Bvh& AmbientOcclusionBaker::GetBvh() const
+	{
+		return mBvh;
+	}
+}
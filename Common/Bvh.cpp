@@ -0,0 +1,667 @@
+#include <algorithm>
+#include <cassert>
+#include <immintrin.h>
+
+#include "Bvh.h"
+
+namespace common
+{
+	namespace
+	{
+		inline Vector3 minVector(const Vector3& a, const Vector3& b)
+		{
+			return Vector3(a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y, a.z < b.z ? a.z : b.z);
+		}
+		inline Vector3 maxVector(const Vector3& a, const Vector3& b)
+		{
+			return Vector3(a.x > b.x ? a.x : b.x, a.y > b.y ? a.y : b.y, a.z > b.z ? a.z : b.z);
+		}
+		inline float getAxis(const Vector3& v, int axis)
+		{
+			return (&v.x)[axis];
+		}
+		inline float halfSurfaceArea(const Vector3& boundsMin, const Vector3& boundsMax)
+		{
+			Vector3 size = boundsMax - boundsMin;
+			return size.x * size.y + size.y * size.z + size.z * size.x;
+		}
+
+		//  ׽Ʈ, ڽ  Ÿ outEntry .
+		inline bool intersectBox(const BvhNode& node, const Vector3& origin, const Vector3& invDirection, float maxDistance, float* outEntry)
+		{
+			float tx0 = (node.BoundsMin.x - origin.x) * invDirection.x;
+			float tx1 = (node.BoundsMax.x - origin.x) * invDirection.x;
+			float ty0 = (node.BoundsMin.y - origin.y) * invDirection.y;
+			float ty1 = (node.BoundsMax.y - origin.y) * invDirection.y;
+			float tz0 = (node.BoundsMin.z - origin.z) * invDirection.z;
+			float tz1 = (node.BoundsMax.z - origin.z) * invDirection.z;
+
+			float entry = MathHelper::Max(MathHelper::Max(MathHelper::Min(tx0, tx1), MathHelper::Min(ty0, ty1)), MathHelper::Min(tz0, tz1));
+			float exit = MathHelper::Min(MathHelper::Min(MathHelper::Max(tx0, tx1), MathHelper::Max(ty0, ty1)), MathHelper::Max(tz0, tz1));
+
+			*outEntry = entry;
+			return exit >= entry && exit >= 0.0f && entry < maxDistance;
+		}
+
+		// Moller-Trumbore
+		inline bool intersectTriangle(const BvhTriangle& triangle, const Vector3& origin, const Vector3& direction, float maxDistance, float* outDistance, float* outU, float* outV)
+		{
+			const Vector3& e1 = triangle.Edge1;
+			const Vector3& e2 = triangle.Edge2;
+
+			Vector3 p(direction.y * e2.z - direction.z * e2.y, direction.z * e2.x - direction.x * e2.z, direction.x * e2.y - direction.y * e2.x);
+			float det = e1.x * p.x + e1.y * p.y + e1.z * p.z;
+
+			if (det > -1e-12f && det < 1e-12f)
+			{
+				return false;
+			}
+
+			float invDet = 1.0f / det;
+			Vector3 s = origin - triangle.V0;
+			float u = (s.x * p.x + s.y * p.y + s.z * p.z) * invDet;
+
+			if (u < 0.0f || u > 1.0f)
+			{
+				return false;
+			}
+
+			Vector3 q(s.y * e1.z - s.z * e1.y, s.z * e1.x - s.x * e1.z, s.x * e1.y - s.y * e1.x);
+			float v = (direction.x * q.x + direction.y * q.y + direction.z * q.z) * invDet;
+
+			if (v < 0.0f || u + v > 1.0f)
+			{
+				return false;
+			}
+
+			float t = (e2.x * q.x + e2.y * q.y + e2.z * q.z) * invDet;
+
+			if (t < 0.0f || t >= maxDistance)
+			{
+				return false;
+			}
+
+			*outDistance = t;
+			*outU = u;
+			*outV = v;
+			return true;
+		}
+
+#if defined(__AVX__)
+		typedef __m256 PacketVector;
+		enum { PACKET_LANE_COUNT = 8 };
+
+		inline PacketVector packetSplat(float value) { return _mm256_set1_ps(value); }
+		inline PacketVector packetLoad(const float* values) { return _mm256_loadu_ps(values); }
+		inline void packetStore(float* outValues, PacketVector v) { _mm256_storeu_ps(outValues, v); }
+		inline PacketVector packetAdd(PacketVector a, PacketVector b) { return _mm256_add_ps(a, b); }
+		inline PacketVector packetSub(PacketVector a, PacketVector b) { return _mm256_sub_ps(a, b); }
+		inline PacketVector packetMul(PacketVector a, PacketVector b) { return _mm256_mul_ps(a, b); }
+		inline PacketVector packetDiv(PacketVector a, PacketVector b) { return _mm256_div_ps(a, b); }
+		inline PacketVector packetMin(PacketVector a, PacketVector b) { return _mm256_min_ps(a, b); }
+		inline PacketVector packetMax(PacketVector a, PacketVector b) { return _mm256_max_ps(a, b); }
+		inline PacketVector packetAnd(PacketVector a, PacketVector b) { return _mm256_and_ps(a, b); }
+		inline PacketVector packetSelect(PacketVector a, PacketVector b, PacketVector mask) { return _mm256_blendv_ps(a, b, mask); }
+		inline PacketVector packetAbs(PacketVector a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+		inline PacketVector packetGreaterEqual(PacketVector a, PacketVector b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+		inline PacketVector packetGreater(PacketVector a, PacketVector b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+		inline PacketVector packetLess(PacketVector a, PacketVector b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+		inline uint32_t packetMask(PacketVector a) { return static_cast<uint32_t>(_mm256_movemask_ps(a)); }
+#else
+		typedef __m128 PacketVector;
+		enum { PACKET_LANE_COUNT = 4 };
+
+		inline PacketVector packetSplat(float value) { return _mm_set1_ps(value); }
+		inline PacketVector packetLoad(const float* values) { return _mm_loadu_ps(values); }
+		inline void packetStore(float* outValues, PacketVector v) { _mm_storeu_ps(outValues, v); }
+		inline PacketVector packetAdd(PacketVector a, PacketVector b) { return _mm_add_ps(a, b); }
+		inline PacketVector packetSub(PacketVector a, PacketVector b) { return _mm_sub_ps(a, b); }
+		inline PacketVector packetMul(PacketVector a, PacketVector b) { return _mm_mul_ps(a, b); }
+		inline PacketVector packetDiv(PacketVector a, PacketVector b) { return _mm_div_ps(a, b); }
+		inline PacketVector packetMin(PacketVector a, PacketVector b) { return _mm_min_ps(a, b); }
+		inline PacketVector packetMax(PacketVector a, PacketVector b) { return _mm_max_ps(a, b); }
+		inline PacketVector packetAnd(PacketVector a, PacketVector b) { return _mm_and_ps(a, b); }
+		inline PacketVector packetSelect(PacketVector a, PacketVector b, PacketVector mask) { return _mm_or_ps(_mm_andnot_ps(mask, a), _mm_and_ps(mask, b)); }
+		inline PacketVector packetAbs(PacketVector a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+		inline PacketVector packetGreaterEqual(PacketVector a, PacketVector b) { return _mm_cmpge_ps(a, b); }
+		inline PacketVector packetGreater(PacketVector a, PacketVector b) { return _mm_cmpgt_ps(a, b); }
+		inline PacketVector packetLess(PacketVector a, PacketVector b) { return _mm_cmplt_ps(a, b); }
+		inline uint32_t packetMask(PacketVector a) { return static_cast<uint32_t>(_mm_movemask_ps(a)); }
+#endif
+
+		enum { PACKET_GROUP_COUNT = Bvh::MAX_PACKET_SIZE / PACKET_LANE_COUNT };
+		enum { PACKET_LANE_MASK = (1 << PACKET_LANE_COUNT) - 1 };
+
+		//    ,  PACKET_LANE_COUNT ׷  SoA
+		struct RayPacket
+		{
+			PacketVector DirectionX[PACKET_GROUP_COUNT];
+			PacketVector DirectionY[PACKET_GROUP_COUNT];
+			PacketVector DirectionZ[PACKET_GROUP_COUNT];
+			PacketVector InvDirectionX[PACKET_GROUP_COUNT];
+			PacketVector InvDirectionY[PACKET_GROUP_COUNT];
+			PacketVector InvDirectionZ[PACKET_GROUP_COUNT];
+			uint32_t GroupCount;
+		};
+
+		// activeMask  ڽ  ̸ Ʈ ְ,  ̵    Ÿ outEntry .
+		inline uint32_t intersectBoxPacket(const BvhNode& node, const Vector3& origin, const RayPacket& packet, float maxDistance, uint32_t activeMask, float* outEntry)
+		{
+			//  Ƿ ڽ  ̴  ̰ Ѵ.
+			const PacketVector minX = packetSplat(node.BoundsMin.x - origin.x);
+			const PacketVector minY = packetSplat(node.BoundsMin.y - origin.y);
+			const PacketVector minZ = packetSplat(node.BoundsMin.z - origin.z);
+			const PacketVector maxX = packetSplat(node.BoundsMax.x - origin.x);
+			const PacketVector maxY = packetSplat(node.BoundsMax.y - origin.y);
+			const PacketVector maxZ = packetSplat(node.BoundsMax.z - origin.z);
+			const PacketVector zero = packetSplat(0.0f);
+			const PacketVector limit = packetSplat(maxDistance);
+
+			const PacketVector infinity = packetSplat(MathHelper::Infinity);
+			PacketVector nearest = infinity;
+			uint32_t hitMask = 0;
+
+			for (uint32_t group = 0; group < packet.GroupCount; ++group)
+			{
+				const uint32_t shift = group * PACKET_LANE_COUNT;
+
+				PacketVector tx0 = packetMul(minX, packet.InvDirectionX[group]);
+				PacketVector tx1 = packetMul(maxX, packet.InvDirectionX[group]);
+				PacketVector ty0 = packetMul(minY, packet.InvDirectionY[group]);
+				PacketVector ty1 = packetMul(maxY, packet.InvDirectionY[group]);
+				PacketVector tz0 = packetMul(minZ, packet.InvDirectionZ[group]);
+				PacketVector tz1 = packetMul(maxZ, packet.InvDirectionZ[group]);
+
+				PacketVector entry = packetMax(packetMax(packetMin(tx0, tx1), packetMin(ty0, ty1)), packetMin(tz0, tz1));
+				PacketVector exit = packetMin(packetMin(packetMax(tx0, tx1), packetMax(ty0, ty1)), packetMax(tz0, tz1));
+				PacketVector hit = packetAnd(packetAnd(packetGreaterEqual(exit, entry), packetGreaterEqual(exit, zero)), packetLess(entry, limit));
+
+				//  Ÿ ڽ  ϴ  Ƿ Ȱ   б  .
+				nearest = packetMin(nearest, packetSelect(infinity, entry, hit));
+				hitMask |= (packetMask(hit) << shift) & activeMask;
+			}
+
+			float entries[PACKET_LANE_COUNT];
+			packetStore(entries, nearest);
+
+			float nearestEntry = entries[0];
+			for (uint32_t lane = 1; lane < PACKET_LANE_COUNT; ++lane)
+			{
+				nearestEntry = MathHelper::Min(nearestEntry, entries[lane]);
+			}
+
+			*outEntry = nearestEntry;
+			return hitMask;
+		}
+
+		// activeMask  ﰢ  ̸ Ʈ ش.
+		inline uint32_t intersectTrianglePacket(const BvhTriangle& triangle, const Vector3& origin, const RayPacket& packet, float maxDistance, uint32_t activeMask)
+		{
+			const Vector3& e1 = triangle.Edge1;
+			const Vector3& e2 = triangle.Edge2;
+
+			// Moller-Trumbore s = origin - V0, q = s x e1, t * det = e2 . q   ϴ.
+			const Vector3 s = origin - triangle.V0;
+			const Vector3 q(s.y * e1.z - s.z * e1.y, s.z * e1.x - s.x * e1.z, s.x * e1.y - s.y * e1.x);
+
+			const PacketVector e1x = packetSplat(e1.x);
+			const PacketVector e1y = packetSplat(e1.y);
+			const PacketVector e1z = packetSplat(e1.z);
+			const PacketVector e2x = packetSplat(e2.x);
+			const PacketVector e2y = packetSplat(e2.y);
+			const PacketVector e2z = packetSplat(e2.z);
+			const PacketVector sx = packetSplat(s.x);
+			const PacketVector sy = packetSplat(s.y);
+			const PacketVector sz = packetSplat(s.z);
+			const PacketVector qx = packetSplat(q.x);
+			const PacketVector qy = packetSplat(q.y);
+			const PacketVector qz = packetSplat(q.z);
+			const PacketVector tNumerator = packetSplat(e2.x * q.x + e2.y * q.y + e2.z * q.z);
+			const PacketVector zero = packetSplat(0.0f);
+			const PacketVector one = packetSplat(1.0f);
+			const PacketVector epsilon = packetSplat(1e-12f);
+			const PacketVector limit = packetSplat(maxDistance);
+
+			uint32_t hitMask = 0;
+
+			for (uint32_t group = 0; group < packet.GroupCount; ++group)
+			{
+				const uint32_t shift = group * PACKET_LANE_COUNT;
+				const uint32_t groupActive = (activeMask >> shift) & PACKET_LANE_MASK;
+
+				if (groupActive == 0)
+				{
+					continue;
+				}
+
+				const PacketVector dx = packet.DirectionX[group];
+				const PacketVector dy = packet.DirectionY[group];
+				const PacketVector dz = packet.DirectionZ[group];
+
+				// p = d x e2
+				PacketVector px = packetSub(packetMul(dy, e2z), packetMul(dz, e2y));
+				PacketVector py = packetSub(packetMul(dz, e2x), packetMul(dx, e2z));
+				PacketVector pz = packetSub(packetMul(dx, e2y), packetMul(dy, e2x));
+
+				PacketVector det = packetAdd(packetAdd(packetMul(e1x, px), packetMul(e1y, py)), packetMul(e1z, pz));
+				PacketVector invDet = packetDiv(one, det);
+
+				PacketVector u = packetMul(packetAdd(packetAdd(packetMul(sx, px), packetMul(sy, py)), packetMul(sz, pz)), invDet);
+				PacketVector v = packetMul(packetAdd(packetAdd(packetMul(dx, qx), packetMul(dy, qy)), packetMul(dz, qz)), invDet);
+				PacketVector t = packetMul(tNumerator, invDet);
+
+				PacketVector hit = packetGreater(packetAbs(det), epsilon);
+				hit = packetAnd(hit, packetAnd(packetGreaterEqual(u, zero), packetGreaterEqual(v, zero)));
+				hit = packetAnd(hit, packetGreaterEqual(one, packetAdd(u, v)));
+				hit = packetAnd(hit, packetAnd(packetGreaterEqual(t, zero), packetLess(t, limit)));
+
+				hitMask |= (packetMask(hit) & groupActive) << shift;
+			}
+
+			return hitMask;
+		}
+	}
+
+	void Bvh::Build(const std::vector<Vector3>& vertices, const std::vector<uint32_t>& indices)
+	{
+		const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+		mNodes.clear();
+		mTriangles.clear();
+		mTriangleIndices.clear();
+
+		if (triangleCount == 0)
+		{
+			return;
+		}
+
+		std::vector<BuildPrimitive> primitives(triangleCount);
+		for (uint32_t i = 0; i < triangleCount; ++i)
+		{
+			const Vector3& v0 = vertices[indices[i * 3 + 0]];
+			const Vector3& v1 = vertices[indices[i * 3 + 1]];
+			const Vector3& v2 = vertices[indices[i * 3 + 2]];
+
+			BuildPrimitive& primitive = primitives[i];
+			primitive.BoundsMin = minVector(minVector(v0, v1), v2);
+			primitive.BoundsMax = maxVector(maxVector(v0, v1), v2);
+			primitive.Centroid = 0.5f * (primitive.BoundsMin + primitive.BoundsMax);
+			primitive.TriangleIndex = i;
+		}
+
+		//  Ʈ̹Ƿ  ִ 2N - 1.
+		mNodes.reserve(triangleCount * 2);
+		mNodes.push_back(BvhNode());
+		buildRecursive(0, 0, triangleCount, 0, &primitives);
+
+		mTriangles.resize(triangleCount);
+		mTriangleIndices.resize(triangleCount);
+		for (uint32_t i = 0; i < triangleCount; ++i)
+		{
+			uint32_t triangleIndex = primitives[i].TriangleIndex;
+			const Vector3& v0 = vertices[indices[triangleIndex * 3 + 0]];
+			const Vector3& v1 = vertices[indices[triangleIndex * 3 + 1]];
+			const Vector3& v2 = vertices[indices[triangleIndex * 3 + 2]];
+
+			mTriangles[i].V0 = v0;
+			mTriangles[i].Edge1 = v1 - v0;
+			mTriangles[i].Edge2 = v2 - v0;
+			mTriangleIndices[i] = triangleIndex;
+		}
+	}
+
+	void Bvh::Assign(const BvhNode* nodes, uint32_t nodeCount, const BvhTriangle* triangles, const uint32_t* triangleIndices, uint32_t triangleCount)
+	{
+		mNodes.assign(nodes, nodes + nodeCount);
+		mTriangles.assign(triangles, triangles + triangleCount);
+		mTriangleIndices.assign(triangleIndices, triangleIndices + triangleCount);
+	}
+
+	bool Bvh::Intersect(const Vector3& origin, const Vector3& direction, float maxDistance, BvhHit* outHit) const
+	{
+		return traverse<false>(origin, direction, maxDistance, outHit);
+	}
+	bool Bvh::Occluded(const Vector3& origin, const Vector3& direction, float maxDistance) const
+	{
+		return traverse<true>(origin, direction, maxDistance, nullptr);
+	}
+	uint32_t Bvh::OccludedPacket(const Vector3& origin, const Vector3* directions, uint32_t rayCount, float maxDistance) const
+	{
+		assert(rayCount <= MAX_PACKET_SIZE);
+
+		if (mNodes.empty() || rayCount == 0)
+		{
+			return 0;
+		}
+
+		// ׷  ä   ù ̸  ΰ Ȱ Ʈ .
+		float directionX[MAX_PACKET_SIZE];
+		float directionY[MAX_PACKET_SIZE];
+		float directionZ[MAX_PACKET_SIZE];
+		for (uint32_t i = 0; i < MAX_PACKET_SIZE; ++i)
+		{
+			const Vector3& direction = directions[i < rayCount ? i : 0];
+			directionX[i] = direction.x;
+			directionY[i] = direction.y;
+			directionZ[i] = direction.z;
+		}
+
+		RayPacket packet;
+		packet.GroupCount = (rayCount + PACKET_LANE_COUNT - 1) / PACKET_LANE_COUNT;
+
+		const PacketVector one = packetSplat(1.0f);
+		for (uint32_t group = 0; group < packet.GroupCount; ++group)
+		{
+			packet.DirectionX[group] = packetLoad(directionX + group * PACKET_LANE_COUNT);
+			packet.DirectionY[group] = packetLoad(directionY + group * PACKET_LANE_COUNT);
+			packet.DirectionZ[group] = packetLoad(directionZ + group * PACKET_LANE_COUNT);
+			packet.InvDirectionX[group] = packetDiv(one, packet.DirectionX[group]);
+			packet.InvDirectionY[group] = packetDiv(one, packet.DirectionY[group]);
+			packet.InvDirectionZ[group] = packetDiv(one, packet.DirectionZ[group]);
+		}
+
+		const uint32_t rayMask = rayCount < 32 ? (1u << rayCount) - 1 : ~0u;
+		float entry;
+		uint32_t activeMask = intersectBoxPacket(mNodes[0], origin, packet, maxDistance, rayMask, &entry);
+
+		// ÿ  Բ  忡   Ʈ ־ д.
+		uint32_t stack[STACK_SIZE];
+		uint32_t stackMask[STACK_SIZE];
+		uint32_t stackSize = 0;
+		uint32_t nodeIndex = 0;
+		uint32_t occludedMask = 0;
+
+		while (true)
+		{
+			if (activeMask != 0)
+			{
+				const BvhNode& node = mNodes[nodeIndex];
+
+				if (node.TriangleCount > 0)
+				{
+					for (uint32_t i = node.LeftFirst; i < node.LeftFirst + node.TriangleCount && activeMask != 0; ++i)
+					{
+						uint32_t hitMask = intersectTrianglePacket(mTriangles[i], origin, packet, maxDistance, activeMask);
+						occludedMask |= hitMask;
+						activeMask &= ~hitMask;
+					}
+
+					//  ̰    ʿ䰡 .
+					if (occludedMask == rayMask)
+					{
+						return occludedMask;
+					}
+				}
+				else
+				{
+					uint32_t nearChild = node.LeftFirst;
+					uint32_t farChild = node.LeftFirst + 1;
+					float nearEntry;
+					float farEntry;
+					uint32_t nearMask = intersectBoxPacket(mNodes[nearChild], origin, packet, maxDistance, activeMask, &nearEntry);
+					uint32_t farMask = intersectBoxPacket(mNodes[farChild], origin, packet, maxDistance, activeMask, &farEntry);
+
+					//     ڽĺ .
+					if (nearMask != 0 && farMask != 0 && farEntry < nearEntry)
+					{
+						std::swap(nearChild, farChild);
+						std::swap(nearMask, farMask);
+					}
+
+					if (nearMask != 0 && farMask != 0)
+					{
+						assert(stackSize < STACK_SIZE);
+						stackMask[stackSize] = farMask;
+						stack[stackSize++] = farChild;
+						nodeIndex = nearChild;
+						activeMask = nearMask;
+						continue;
+					}
+					if (nearMask != 0 || farMask != 0)
+					{
+						nodeIndex = nearMask != 0 ? nearChild : farChild;
+						activeMask = nearMask | farMask;
+						continue;
+					}
+				}
+			}
+
+			if (stackSize == 0)
+			{
+				return occludedMask;
+			}
+
+			//    ̴ ÿ    ش.
+			--stackSize;
+			nodeIndex = stack[stackSize];
+			activeMask = stackMask[stackSize] & ~occludedMask;
+		}
+	}
+
+	void Bvh::buildRecursive(uint32_t nodeIndex, uint32_t begin, uint32_t end, uint32_t depth, std::vector<BuildPrimitive>* primitives)
+	{
+		std::vector<BuildPrimitive>& prims = *primitives;
+		const uint32_t count = end - begin;
+
+		Vector3 boundsMin = prims[begin].BoundsMin;
+		Vector3 boundsMax = prims[begin].BoundsMax;
+		Vector3 centroidMin = prims[begin].Centroid;
+		Vector3 centroidMax = prims[begin].Centroid;
+		for (uint32_t i = begin + 1; i < end; ++i)
+		{
+			boundsMin = minVector(boundsMin, prims[i].BoundsMin);
+			boundsMax = maxVector(boundsMax, prims[i].BoundsMax);
+			centroidMin = minVector(centroidMin, prims[i].Centroid);
+			centroidMax = maxVector(centroidMax, prims[i].Centroid);
+		}
+
+		mNodes[nodeIndex].BoundsMin = boundsMin;
+		mNodes[nodeIndex].BoundsMax = boundsMax;
+		mNodes[nodeIndex].LeftFirst = begin;
+		mNodes[nodeIndex].TriangleCount = count;
+
+		if (count <= 2 || depth >= MAX_DEPTH)
+		{
+			return;
+		}
+
+		// ึ  ߽ BIN_COUNT   ,  踶 SAH  Ѵ.
+		//  = ȸ  1 + (  *   +   *  ) / θ 
+		float bestCost = MathHelper::Infinity;
+		int bestAxis = -1;
+		int bestSplit = 0;
+
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			const float axisMin = getAxis(centroidMin, axis);
+			const float axisExtent = getAxis(centroidMax, axis) - axisMin;
+
+			if (axisExtent <= 0.0f)
+			{
+				continue;
+			}
+
+			uint32_t binCounts[BIN_COUNT] = {};
+			Vector3 binMin[BIN_COUNT];
+			Vector3 binMax[BIN_COUNT];
+			for (int i = 0; i < BIN_COUNT; ++i)
+			{
+				binMin[i] = Vector3(MathHelper::Infinity, MathHelper::Infinity, MathHelper::Infinity);
+				binMax[i] = Vector3(-MathHelper::Infinity, -MathHelper::Infinity, -MathHelper::Infinity);
+			}
+
+			const float scale = BIN_COUNT / axisExtent;
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				int bin = MathHelper::Min(static_cast<int>((getAxis(prims[i].Centroid, axis) - axisMin) * scale), BIN_COUNT - 1);
+				++binCounts[bin];
+				binMin[bin] = minVector(binMin[bin], prims[i].BoundsMin);
+				binMax[bin] = maxVector(binMax[bin], prims[i].BoundsMax);
+			}
+
+			// ʿ    * 
+			float rightCosts[BIN_COUNT];
+			uint32_t rightCount = 0;
+			Vector3 rightMin = binMin[BIN_COUNT - 1];
+			Vector3 rightMax = binMax[BIN_COUNT - 1];
+			for (int i = BIN_COUNT - 1; i > 0; --i)
+			{
+				rightCount += binCounts[i];
+				rightMin = minVector(rightMin, binMin[i]);
+				rightMax = maxVector(rightMax, binMax[i]);
+				rightCosts[i] = rightCount > 0 ? halfSurfaceArea(rightMin, rightMax) * rightCount : 0.0f;
+			}
+
+			uint32_t leftCount = 0;
+			Vector3 leftMin = binMin[0];
+			Vector3 leftMax = binMax[0];
+			for (int split = 1; split < BIN_COUNT; ++split)
+			{
+				leftCount += binCounts[split - 1];
+				leftMin = minVector(leftMin, binMin[split - 1]);
+				leftMax = maxVector(leftMax, binMax[split - 1]);
+
+				if (leftCount == 0 || leftCount == count)
+				{
+					continue;
+				}
+
+				float cost = halfSurfaceArea(leftMin, leftMax) * leftCount + rightCosts[split];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = split;
+				}
+			}
+		}
+
+		//  ߽  ġ    .
+		if (bestAxis < 0)
+		{
+			return;
+		}
+
+		const float parentArea = halfSurfaceArea(boundsMin, boundsMax);
+		const float splitCost = 1.0f + (parentArea > 0.0f ? bestCost / parentArea : 0.0f);
+		if (splitCost >= static_cast<float>(count) && count <= MAX_LEAF_TRIANGLES)
+		{
+			return;
+		}
+
+		const float axisMin = getAxis(centroidMin, bestAxis);
+		const float scale = BIN_COUNT / (getAxis(centroidMax, bestAxis) - axisMin);
+		auto middle = std::partition(prims.begin() + begin, prims.begin() + end, [=](const BuildPrimitive& primitive)
+			{
+				int bin = MathHelper::Min(static_cast<int>((getAxis(primitive.Centroid, bestAxis) - axisMin) * scale), BIN_COUNT - 1);
+				return bin < bestSplit;
+			});
+		const uint32_t middleIndex = static_cast<uint32_t>(middle - prims.begin());
+
+		// ڽ   ׻ ٿ ҴѴ.
+		const uint32_t leftChild = static_cast<uint32_t>(mNodes.size());
+		mNodes.push_back(BvhNode());
+		mNodes.push_back(BvhNode());
+		mNodes[nodeIndex].LeftFirst = leftChild;
+		mNodes[nodeIndex].TriangleCount = 0;
+
+		buildRecursive(leftChild, begin, middleIndex, depth + 1, primitives);
+		buildRecursive(leftChild + 1, middleIndex, end, depth + 1, primitives);
+	}
+
+	template <bool bAnyHit>
+	bool Bvh::traverse(const Vector3& origin, const Vector3& direction, float maxDistance, BvhHit* outHit) const
+	{
+		if (mNodes.empty())
+		{
+			return false;
+		}
+
+		const Vector3 invDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+
+		float entry;
+		if (!intersectBox(mNodes[0], origin, invDirection, maxDistance, &entry))
+		{
+			return false;
+		}
+
+		uint32_t stack[STACK_SIZE];
+		float stackEntry[STACK_SIZE];
+		uint32_t stackSize = 0;
+		uint32_t nodeIndex = 0;
+		bool bHit = false;
+
+		while (true)
+		{
+			const BvhNode& node = mNodes[nodeIndex];
+
+			if (node.TriangleCount > 0)
+			{
+				for (uint32_t i = node.LeftFirst; i < node.LeftFirst + node.TriangleCount; ++i)
+				{
+					float distance;
+					float u;
+					float v;
+
+					if (intersectTriangle(mTriangles[i], origin, direction, maxDistance, &distance, &u, &v))
+					{
+						if (bAnyHit)
+						{
+							return true;
+						}
+
+						//    ߶  ֵ ִ Ÿ δ.
+						maxDistance = distance;
+						outHit->Distance = distance;
+						outHit->U = u;
+						outHit->V = v;
+						outHit->TriangleIndex = mTriangleIndices[i];
+						bHit = true;
+					}
+				}
+			}
+			else
+			{
+				uint32_t nearChild = node.LeftFirst;
+				uint32_t farChild = node.LeftFirst + 1;
+				float nearEntry;
+				float farEntry;
+				bool bNearHit = intersectBox(mNodes[nearChild], origin, invDirection, maxDistance, &nearEntry);
+				bool bFarHit = intersectBox(mNodes[farChild], origin, invDirection, maxDistance, &farEntry);
+
+				//  ڽ    ڽ ÿ ־ д.
+				if (bNearHit && bFarHit && farEntry < nearEntry)
+				{
+					std::swap(nearChild, farChild);
+				}
+
+				if (bNearHit && bFarHit)
+				{
+					assert(stackSize < STACK_SIZE);
+					stackEntry[stackSize] = MathHelper::Max(nearEntry, farEntry);
+					stack[stackSize++] = farChild;
+					nodeIndex = nearChild;
+					continue;
+				}
+				if (bNearHit || bFarHit)
+				{
+					nodeIndex = bNearHit ? nearChild : farChild;
+					continue;
+				}
+			}
+
+			//      ã ÿ ־    ǳʶڴ.
+			do
+			{
+				if (stackSize == 0)
+				{
+					return bHit;
+				}
+
+				--stackSize;
+			} while (stackEntry[stackSize] >= maxDistance);
+
+			nodeIndex = stack[stackSize];
+		}
+	}
+}
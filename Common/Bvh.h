@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <directxtk/SimpleMath.h>
+#include <vector>
+
+#include "MathHelper.h"
+
+namespace common
+{
+	using namespace DirectX::SimpleMath;
+
+	//  迭 Ǵ BVH 
+	// TriangleCount 0̸  ̰ ڽ mNodes[LeftFirst], mNodes[LeftFirst + 1] پ ִ.
+	// 0 ƴϸ  ̰ ﰢ mTriangles[LeftFirst] TriangleCount.
+	struct BvhNode
+	{
+		Vector3 BoundsMin;
+		uint32_t LeftFirst;
+		Vector3 BoundsMax;
+		uint32_t TriangleCount;
+	};
+
+	//   ̸ Ǯ  ﰢ
+	struct BvhTriangle
+	{
+		Vector3 V0;
+		Vector3 Edge1; // V1 - V0
+		Vector3 Edge2; // V2 - V0
+	};
+
+	struct BvhHit
+	{
+		float Distance;
+		float U; //  ߽ ǥ, V1 
+		float V; //  ߽ ǥ, V2 
+		uint32_t TriangleIndex; // Build ѱ ε   ﰢ ȣ
+	};
+
+	// (bin)  SAH ϴ ﰢ BVH
+	// ﰢ   , ȸ  ڽĺ Ѵ.
+	class Bvh
+	{
+	public:
+		enum { MAX_PACKET_SIZE = 16 };
+		enum { MAX_DEPTH = 63 }; //    ﰢ    .
+
+	public:
+		Bvh() = default;
+		~Bvh() = default;
+
+		void Build(const std::vector<Vector3>& vertices, const std::vector<uint32_t>& indices);
+		// ̸    ﰢ ״ ´. (޽ ĳ )
+		void Assign(const BvhNode* nodes, uint32_t nodeCount, const BvhTriangle* triangles, const uint32_t* triangleIndices, uint32_t triangleCount);
+
+		//    ã´. direction ȭǾ  ʾƵ Ǹ Ÿ direction  .
+		bool Intersect(const Vector3& origin, const Vector3& direction, float maxDistance, BvhHit* outHit) const;
+		//  , ϴ ﰢ ϳ ã ٷ ´.
+		bool Occluded(const Vector3& origin, const Vector3& direction, float maxDistance = MathHelper::Infinity) const;
+		//   ̸ ִ MAX_PACKET_SIZE  SIMD   ȸѴ.
+		//  ̴ directions  Ʈ  ش.
+		uint32_t OccludedPacket(const Vector3& origin, const Vector3* directions, uint32_t rayCount, float maxDistance = MathHelper::Infinity) const;
+
+		inline const std::vector<BvhNode>& GetNodes() const;
+		inline const std::vector<BvhTriangle>& GetTriangles() const;
+		inline const std::vector<uint32_t>& GetTriangleIndices() const;
+
+	private:
+		struct BuildPrimitive
+		{
+			Vector3 BoundsMin;
+			Vector3 BoundsMax;
+			Vector3 Centroid;
+			uint32_t TriangleIndex;
+		};
+
+		void buildRecursive(uint32_t nodeIndex, uint32_t begin, uint32_t end, uint32_t depth, std::vector<BuildPrimitive>* primitives);
+		template <bool bAnyHit>
+		bool traverse(const Vector3& origin, const Vector3& direction, float maxDistance, BvhHit* outHit) const;
+
+	private:
+		enum { BIN_COUNT = 16 };
+		enum { MAX_LEAF_TRIANGLES = 8 }; // SAH   ̺  .
+		enum { STACK_SIZE = MAX_DEPTH + 1 }; // ȸ ÿ 󸶴 ϳ δ.
+
+		std::vector<BvhNode> mNodes; // mNodes[0] Ʈ
+		std::vector<BvhTriangle> mTriangles; //   ĵ ﰢ
+		std::vector<uint32_t> mTriangleIndices; // mTriangles[i]  ﰢ ȣ
+	};
+
+	const std::vector<BvhNode>& Bvh::GetNodes() const
+	{
+		return mNodes;
+	}
+	const std::vector<BvhTriangle>& Bvh::GetTriangles() const
+	{
+		return mTriangles;
+	}
+	const std::vector<uint32_t>& Bvh::GetTriangleIndices() const
+	{
+		return mTriangleIndices;
+	}
+}
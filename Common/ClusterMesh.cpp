@@ -0,0 +1,351 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+
+#include "ClusterMesh.h"
+#include "FrustumCuller.h"
+
+namespace common
+{
+	const float ClusterMesh::DEFAULT_CONE_WEIGHT = 0.5f;
+
+	namespace
+	{
+		//  ̺ а  ( 84) Է ɷ  ִ   .
+		const float MIN_CONE_DOT = 0.1f;
+		const float INVALID_CONE_CUTOFF = 2.0f;
+		//  ﰢ     ä ó   Ŭ͸ δ.
+		const float LIVE_TRIANGLE_WEIGHT = 0.1f;
+
+		struct ClusterBuilder
+		{
+			UINT Id;
+			std::vector<UINT> Vertices;
+			std::vector<UINT> Triangles;
+			Vector3 NormalSum;
+		};
+
+		const Vector3& getPosition(const float* positions, size_t stride, UINT index)
+		{
+			return *reinterpret_cast<const Vector3*>(reinterpret_cast<const BYTE*>(positions) + stride * index);
+		}
+
+		void computeBounds(const ClusterBuilder& builder, const float* positions, size_t stride,
+			const std::vector<Vector3>& triangleNormals, const UINT* indices, MeshCluster* outCluster)
+		{
+			std::vector<XMFLOAT3> points(builder.Vertices.size());
+			for (size_t i = 0; i < builder.Vertices.size(); ++i)
+			{
+				points[i] = getPosition(positions, stride, builder.Vertices[i]);
+			}
+
+			BoundingSphere::CreateFromPoints(outCluster->Sphere, points.size(), points.data(), sizeof(XMFLOAT3));
+			BoundingBox::CreateFromPoints(outCluster->Box, points.size(), points.data(), sizeof(XMFLOAT3));
+
+			outCluster->ConeApex = outCluster->Sphere.Center;
+			outCluster->ConeAxis = Vector3(0.f, 0.f, 0.f);
+			outCluster->ConeCutoff = INVALID_CONE_CUTOFF;
+
+			Vector3 axis = builder.NormalSum;
+			if (axis.LengthSquared() <= 0.f)
+			{
+				return;
+			}
+			axis.Normalize();
+
+			float minDot = 1.f;
+			for (UINT triangle : builder.Triangles)
+			{
+				const Vector3& normal = triangleNormals[triangle];
+				if (normal.LengthSquared() > 0.f)
+				{
+					minDot = std::min<float>(minDot, normal.Dot(axis));
+				}
+			}
+
+			if (minDot <= MIN_CONE_DOT)
+			{
+				return;
+			}
+
+			//  ﰢ  ʿ ̵    ڷ δ.
+			const Vector3 center = outCluster->Sphere.Center;
+			float maxT = 0.f;
+			for (UINT triangle : builder.Triangles)
+			{
+				const Vector3& normal = triangleNormals[triangle];
+				if (normal.LengthSquared() <= 0.f)
+				{
+					continue;
+				}
+
+				// center - axis * t ﰢ    t, ̺ ָ и  ڴ.
+				const Vector3& p0 = getPosition(positions, stride, indices[triangle * 3]);
+				const float t = (center - p0).Dot(normal) / normal.Dot(axis);
+				maxT = std::max<float>(maxT, t);
+			}
+
+			outCluster->ConeApex = center - axis * maxT;
+			outCluster->ConeAxis = axis;
+			outCluster->ConeCutoff = sqrtf(1.f - minDot * minDot);
+		}
+	}
+
+	void ClusterMesh::Build(const float* positions, size_t positionStride, UINT vertexCount,
+		UINT* indices, size_t indexCount, float coneWeight)
+	{
+		mClusters.clear();
+
+		const UINT triangleCount = static_cast<UINT>(indexCount / 3);
+		if (triangleCount == 0)
+		{
+			return;
+		}
+
+		// ﰢ ,  0̸ 0 (D3D ð  ո  ٱ)
+		std::vector<Vector3> triangleNormals(triangleCount);
+		for (UINT i = 0; i < triangleCount; ++i)
+		{
+			const Vector3& p0 = getPosition(positions, positionStride, indices[i * 3 + 0]);
+			const Vector3& p1 = getPosition(positions, positionStride, indices[i * 3 + 1]);
+			const Vector3& p2 = getPosition(positions, positionStride, indices[i * 3 + 2]);
+
+			Vector3 normal = (p1 - p0).Cross(p2 - p0);
+			const float length = normal.Length();
+			triangleNormals[i] = length > 0.f ? normal / length : Vector3(0.f, 0.f, 0.f);
+		}
+
+		//  -> ﰢ   (CSR)
+		std::vector<UINT> adjacencyOffsets(vertexCount + 1, 0);
+		for (size_t i = 0; i < triangleCount * 3; ++i)
+		{
+			++adjacencyOffsets[indices[i] + 1];
+		}
+		for (UINT i = 0; i < vertexCount; ++i)
+		{
+			adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+		}
+
+		std::vector<UINT> adjacency(triangleCount * 3);
+		{
+			std::vector<UINT> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+			for (UINT i = 0; i < triangleCount * 3; ++i)
+			{
+				adjacency[cursor[indices[i]]++] = i / 3;
+			}
+		}
+
+		std::vector<bool> bEmitted(triangleCount, false);
+		std::vector<UINT> vertexCluster(vertexCount, UINT_MAX); //    Ŭ
+		std::vector<UINT> liveTriangleCount(vertexCount); //   ŬͿ   ﰢ 
+		for (UINT i = 0; i < vertexCount; ++i)
+		{
+			liveTriangleCount[i] = adjacencyOffsets[i + 1] - adjacencyOffsets[i];
+		}
+		std::vector<UINT> orderedIndices;
+		orderedIndices.reserve(triangleCount * 3);
+
+		UINT seedCursor = 0;
+		UINT emittedCount = 0;
+		ClusterBuilder builder;
+		builder.Id = 0;
+
+		auto newVertexCount = [&](UINT triangle, UINT clusterId)
+			{
+				UINT count = 0;
+				for (UINT k = 0; k < 3; ++k)
+				{
+					count += vertexCluster[indices[triangle * 3 + k]] != clusterId ? 1 : 0;
+				}
+				return count;
+			};
+
+		auto liveTriangleSum = [&](UINT triangle)
+			{
+				return liveTriangleCount[indices[triangle * 3 + 0]]
+					+ liveTriangleCount[indices[triangle * 3 + 1]]
+					+ liveTriangleCount[indices[triangle * 3 + 2]];
+			};
+
+		auto addTriangle = [&](UINT triangle)
+			{
+				for (UINT k = 0; k < 3; ++k)
+				{
+					const UINT vertex = indices[triangle * 3 + k];
+					--liveTriangleCount[vertex];
+					if (vertexCluster[vertex] != builder.Id)
+					{
+						vertexCluster[vertex] = builder.Id;
+						builder.Vertices.push_back(vertex);
+					}
+				}
+
+				builder.Triangles.push_back(triangle);
+				builder.NormalSum += triangleNormals[triangle];
+				bEmitted[triangle] = true;
+				++emittedCount;
+			};
+
+		while (emittedCount < triangleCount)
+		{
+			builder.Vertices.clear();
+			builder.Triangles.clear();
+			builder.NormalSum = Vector3(0.f, 0.f, 0.f);
+
+			// õ  ŬͿ ´ ﰢ   ̿   ,     ﰢ
+			UINT seed = UINT_MAX;
+			if (!mClusters.empty())
+			{
+				const MeshCluster& prev = mClusters.back();
+				UINT bestLiveSum = UINT_MAX;
+				for (UINT i = prev.IndexStart; i < prev.IndexStart + prev.IndexCount; ++i)
+				{
+					const UINT vertex = orderedIndices[i];
+					for (UINT j = adjacencyOffsets[vertex]; j < adjacencyOffsets[vertex + 1]; ++j)
+					{
+						const UINT triangle = adjacency[j];
+						if (bEmitted[triangle])
+						{
+							continue;
+						}
+
+						const UINT liveSum = liveTriangleSum(triangle);
+						if (liveSum < bestLiveSum)
+						{
+							bestLiveSum = liveSum;
+							seed = triangle;
+						}
+					}
+				}
+			}
+
+			if (seed == UINT_MAX)
+			{
+				while (bEmitted[seedCursor])
+				{
+					++seedCursor;
+				}
+				seed = seedCursor;
+			}
+
+			addTriangle(seed);
+
+			//     ð,   ࿡ ,  ̿  ﰢ ϳ δ.
+			while (builder.Triangles.size() < MAX_TRIANGLES)
+			{
+				Vector3 axis = builder.NormalSum;
+				const float axisLength = axis.Length();
+				axis = axisLength > 0.f ? axis / axisLength : axis;
+
+				UINT best = UINT_MAX;
+				float bestScore = FLT_MAX;
+
+				for (UINT vertex : builder.Vertices)
+				{
+					for (UINT j = adjacencyOffsets[vertex]; j < adjacencyOffsets[vertex + 1]; ++j)
+					{
+						const UINT triangle = adjacency[j];
+						if (bEmitted[triangle])
+						{
+							continue;
+						}
+
+						const UINT extra = newVertexCount(triangle, builder.Id);
+						if (builder.Vertices.size() + extra > MAX_VERTICES)
+						{
+							continue;
+						}
+
+						const UINT liveSum = liveTriangleSum(triangle);
+						const float score = static_cast<float>(extra) + coneWeight * (1.f - triangleNormals[triangle].Dot(axis))
+							+ LIVE_TRIANGLE_WEIGHT * static_cast<float>(liveSum);
+						if (score < bestScore)
+						{
+							bestScore = score;
+							best = triangle;
+						}
+					}
+				}
+
+				if (best == UINT_MAX)
+				{
+					break;
+				}
+
+				addTriangle(best);
+			}
+
+			MeshCluster cluster;
+			cluster.IndexStart = static_cast<UINT>(orderedIndices.size());
+			cluster.IndexCount = static_cast<UINT>(builder.Triangles.size() * 3);
+			cluster.VertexCount = static_cast<UINT>(builder.Vertices.size());
+			computeBounds(builder, positions, positionStride, triangleNormals, indices, &cluster);
+
+			for (UINT triangle : builder.Triangles)
+			{
+				orderedIndices.push_back(indices[triangle * 3 + 0]);
+				orderedIndices.push_back(indices[triangle * 3 + 1]);
+				orderedIndices.push_back(indices[triangle * 3 + 2]);
+			}
+
+			mClusters.push_back(cluster);
+			++builder.Id;
+		}
+
+		std::copy(orderedIndices.begin(), orderedIndices.end(), indices);
+	}
+
+	UINT ClusterMesh::Cull(const FrustumPlanes& planes, const Vector3& eyePosition,
+		std::vector<IndexRange>* outRanges, ClusterCullStatistics* outStatistics) const
+	{
+		ClusterCullStatistics statistics = {};
+		statistics.ClusterCount = static_cast<UINT>(mClusters.size());
+
+		outRanges->clear();
+		UINT visibleTriangleCount = 0;
+
+		for (const MeshCluster& cluster : mClusters)
+		{
+			const UINT clusterTriangleCount = cluster.IndexCount / 3;
+			statistics.TriangleCount += clusterTriangleCount;
+
+			if (planes.Contains(cluster.Box) == DISJOINT)
+			{
+				statistics.FrustumCulledTriangleCount += clusterTriangleCount;
+				continue;
+			}
+
+			Vector3 toApex = cluster.ConeApex - eyePosition;
+			toApex.Normalize();
+			if (toApex.Dot(cluster.ConeAxis) >= cluster.ConeCutoff)
+			{
+				statistics.BackfaceCulledTriangleCount += clusterTriangleCount;
+				continue;
+			}
+
+			++statistics.VisibleClusterCount;
+			visibleTriangleCount += clusterTriangleCount;
+
+			// Ŭʹ ε ۿ   Ƿ ̾  ģ.
+			if (!outRanges->empty() && outRanges->back().Start + outRanges->back().Count == cluster.IndexStart)
+			{
+				outRanges->back().Count += cluster.IndexCount;
+			}
+			else
+			{
+				outRanges->push_back({ cluster.IndexStart, cluster.IndexCount });
+			}
+		}
+
+		statistics.RangeCount = static_cast<UINT>(outRanges->size());
+
+		if (outStatistics != nullptr)
+		{
+			*outStatistics = statistics;
+		}
+
+		return visibleTriangleCount;
+	}
+}
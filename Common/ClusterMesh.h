@@ -0,0 +1,97 @@
+#pragma once
+
+#include <DirectXCollision.h>
+#include <directxtk/SimpleMath.h>
+#include <vector>
+
+namespace common
+{
+	using namespace DirectX;
+	using namespace DirectX::SimpleMath;
+
+	struct FrustumPlanes;
+
+	// ġ ε  [IndexStart, IndexStart + IndexCount)  Ŭ ϳ
+	struct MeshCluster
+	{
+		UINT IndexStart;
+		UINT IndexCount;
+		UINT VertexCount; // ŬͰ ϴ   
+
+		BoundingSphere Sphere;
+		BoundingBox Box;
+
+		// ĸ ø , dot(normalize(ConeApex - eye), ConeAxis) >= ConeCutoff  ﰢ ޸̴.
+		//  ʹ  Ŭʹ ConeCutoff 1 Ŀ  ɸ ʴ´.
+		Vector3 ConeApex;
+		Vector3 ConeAxis;
+		float ConeCutoff;
+	};
+
+	// DrawIndexed   ׸  ִ ε 
+	struct IndexRange
+	{
+		UINT Start;
+		UINT Count;
+	};
+
+	struct ClusterCullStatistics
+	{
+		UINT ClusterCount;
+		UINT VisibleClusterCount;
+		UINT TriangleCount;
+		UINT FrustumCulledTriangleCount;
+		UINT BackfaceCulledTriangleCount;
+		UINT RangeCount; // ̾   ׸ ȣ 
+	};
+
+	// ε ޽  MAX_VERTICES, ﰢ MAX_TRIANGLES  Ŭͷ 
+	// Ŭ͸  /ڽ    CPU  + ĸ ø Ѵ.
+	// ε ۴ Ŭ  ġǹǷ Ƴ Ŭ͸ ״  ׸  ִ.
+	//  ĳ ȭ(MeshOptimizer)  ϸ õ   ŬͰ  .
+	class ClusterMesh
+	{
+	public:
+		enum { MAX_VERTICES = 64 };
+		enum { MAX_TRIANGLES = 124 };
+
+	public:
+		ClusterMesh() = default;
+		~ClusterMesh() = default;
+
+		// positions positionStride  float 3, indices  ڸ Ŭ  ٲ.
+		// coneWeight       ϰ ִ ġ (0̸  )
+		void Build(const float* positions, size_t positionStride, UINT vertexCount,
+			UINT* indices, size_t indexCount, float coneWeight = DEFAULT_CONE_WEIGHT);
+		template <typename Vertex, typename Position>
+		void Build(const Vertex* vertices, UINT vertexCount, UINT* indices, size_t indexCount,
+			Position Vertex::* position, float coneWeight = DEFAULT_CONE_WEIGHT);
+
+		// planes eyePosition ޽    (  ķ Űܼ ѱ)
+		// ̴ Ŭ  ̾ ٿ outRanges , ̴ ﰢ  ȯѴ.
+		UINT Cull(const FrustumPlanes& planes, const Vector3& eyePosition,
+			std::vector<IndexRange>* outRanges, ClusterCullStatistics* outStatistics = nullptr) const;
+
+		inline const std::vector<MeshCluster>& GetClusters() const;
+
+	private:
+		static const float DEFAULT_CONE_WEIGHT;
+
+		std::vector<MeshCluster> mClusters;
+	};
+
+	template <typename Vertex, typename Position>
+	void ClusterMesh::Build(const Vertex* vertices, UINT vertexCount, UINT* indices, size_t indexCount,
+		Position Vertex::* position, float coneWeight)
+	{
+		static_assert(sizeof(Position) == 3 * sizeof(float), "position must be 3 floats");
+
+		const float* positions = vertexCount > 0 ? reinterpret_cast<const float*>(&(vertices[0].*position)) : nullptr;
+		Build(positions, sizeof(Vertex), vertexCount, indices, indexCount, coneWeight);
+	}
+
+	const std::vector<MeshCluster>& ClusterMesh::GetClusters() const
+	{
+		return mClusters;
+	}
+}
@@ -0,0 +1,399 @@
+#include "pch.h"
+
+#include "FrustumCuller.h"
+
+#include <cstring>
+#include <immintrin.h>
+
+namespace common
+{
+	namespace
+	{
+#if defined(__AVX__)
+		typedef __m256 BatchVector;
+#else
+		typedef XMVECTOR BatchVector;
+#endif
+
+		// 4Ʈ ũ ->   ȣ   ,  16 4 κ ϴ  ° 
+		alignas(16) const UINT COMPACT_LANES[32][4] =
+		{
+			{ 0, 0, 0, 0 },
+			{ 0, 0, 0, 0 },
+			{ 1, 0, 0, 0 },
+			{ 0, 1, 0, 0 },
+			{ 2, 0, 0, 0 },
+			{ 0, 2, 0, 0 },
+			{ 1, 2, 0, 0 },
+			{ 0, 1, 2, 0 },
+			{ 3, 0, 0, 0 },
+			{ 0, 3, 0, 0 },
+			{ 1, 3, 0, 0 },
+			{ 0, 1, 3, 0 },
+			{ 2, 3, 0, 0 },
+			{ 0, 2, 3, 0 },
+			{ 1, 2, 3, 0 },
+			{ 0, 1, 2, 3 },
+			{ 0, 0, 0, 0 },
+			{ 4, 0, 0, 0 },
+			{ 5, 0, 0, 0 },
+			{ 4, 5, 0, 0 },
+			{ 6, 0, 0, 0 },
+			{ 4, 6, 0, 0 },
+			{ 5, 6, 0, 0 },
+			{ 4, 5, 6, 0 },
+			{ 7, 0, 0, 0 },
+			{ 4, 7, 0, 0 },
+			{ 5, 7, 0, 0 },
+			{ 4, 5, 7, 0 },
+			{ 6, 7, 0, 0 },
+			{ 4, 6, 7, 0 },
+			{ 5, 6, 7, 0 },
+			{ 4, 5, 6, 7 }
+		};
+		const UINT VISIBLE_COUNTS[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+		// 鸶   ü   
+		struct PlaneSplats
+		{
+			BatchVector X[6];
+			BatchVector Y[6];
+			BatchVector Z[6];
+			BatchVector W[6];
+			BatchVector AbsX[6];
+			BatchVector AbsY[6];
+			BatchVector AbsZ[6];
+		};
+
+		void setPlaneSplats(const FrustumPlanes& planes, PlaneSplats* outSplats)
+		{
+			for (int i = 0; i < 6; ++i)
+			{
+				const Vector4& plane = planes.Planes[i];
+#if defined(__AVX__)
+				const __m256 signMask = _mm256_set1_ps(-0.f);
+				outSplats->X[i] = _mm256_set1_ps(plane.x);
+				outSplats->Y[i] = _mm256_set1_ps(plane.y);
+				outSplats->Z[i] = _mm256_set1_ps(plane.z);
+				outSplats->W[i] = _mm256_set1_ps(plane.w);
+				outSplats->AbsX[i] = _mm256_andnot_ps(signMask, outSplats->X[i]);
+				outSplats->AbsY[i] = _mm256_andnot_ps(signMask, outSplats->Y[i]);
+				outSplats->AbsZ[i] = _mm256_andnot_ps(signMask, outSplats->Z[i]);
+#else
+				outSplats->X[i] = XMVectorReplicate(plane.x);
+				outSplats->Y[i] = XMVectorReplicate(plane.y);
+				outSplats->Z[i] = XMVectorReplicate(plane.z);
+				outSplats->W[i] = XMVectorReplicate(plane.w);
+				outSplats->AbsX[i] = XMVectorAbs(outSplats->X[i]);
+				outSplats->AbsY[i] = XMVectorAbs(outSplats->Y[i]);
+				outSplats->AbsZ[i] = XMVectorAbs(outSplats->Z[i]);
+#endif
+			}
+		}
+
+		// ũⰡ   ڽ     鸶 ̹Ƿ W ̸  д.
+		void addSharedRadius(const Vector3& extents, PlaneSplats* splats)
+		{
+			for (int i = 0; i < 6; ++i)
+			{
+#if defined(__AVX__)
+				const __m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(splats->AbsX[i], _mm256_set1_ps(extents.x)),
+					_mm256_mul_ps(splats->AbsY[i], _mm256_set1_ps(extents.y))), _mm256_mul_ps(splats->AbsZ[i], _mm256_set1_ps(extents.z)));
+				splats->W[i] = _mm256_add_ps(splats->W[i], radius);
+#else
+				const XMVECTOR radius = XMVectorMultiplyAdd(splats->AbsX[i], XMVectorReplicate(extents.x),
+					XMVectorMultiplyAdd(splats->AbsY[i], XMVectorReplicate(extents.y), XMVectorMultiply(splats->AbsZ[i], XMVectorReplicate(extents.z))));
+				splats->W[i] = XMVectorAdd(splats->W[i], radius);
+#endif
+			}
+		}
+
+		// bounds[0..5] ߽ x/y/z, ũ x/y/z 迭, ̴  Ʈ Ѽ ȯѴ.
+		// bSharedExtents ũ 迭  ʰ W    .
+		template <bool bSharedExtents>
+		inline UINT testBatch(const PlaneSplats& planes, const float* const bounds[6], UINT batch)
+		{
+#if defined(__AVX__)
+			const __m256 cx = _mm256_loadu_ps(bounds[0] + batch);
+			const __m256 cy = _mm256_loadu_ps(bounds[1] + batch);
+			const __m256 cz = _mm256_loadu_ps(bounds[2] + batch);
+			const __m256 zero = _mm256_setzero_ps();
+			__m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+			for (int i = 0; i < 6; ++i)
+			{
+				// ߽ ȣ ִ Ÿ +    ڽ    ٱ̴.
+				__m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(planes.X[i], cx), _mm256_mul_ps(planes.Y[i], cy)),
+					_mm256_add_ps(_mm256_mul_ps(planes.Z[i], cz), planes.W[i]));
+				if (!bSharedExtents)
+				{
+					const __m256 ex = _mm256_loadu_ps(bounds[3] + batch);
+					const __m256 ey = _mm256_loadu_ps(bounds[4] + batch);
+					const __m256 ez = _mm256_loadu_ps(bounds[5] + batch);
+					distance = _mm256_add_ps(distance, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(planes.AbsX[i], ex), _mm256_mul_ps(planes.AbsY[i], ey)),
+						_mm256_mul_ps(planes.AbsZ[i], ez)));
+				}
+				visible = _mm256_and_ps(visible, _mm256_cmp_ps(distance, zero, _CMP_GE_OQ));
+			}
+
+			return static_cast<UINT>(_mm256_movemask_ps(visible));
+#else
+			const XMVECTOR zero = XMVectorZero();
+			UINT mask = 0;
+
+			for (UINT half = 0; half < FrustumCuller::BATCH_SIZE; half += 4)
+			{
+				const XMVECTOR cx = _mm_loadu_ps(bounds[0] + batch + half);
+				const XMVECTOR cy = _mm_loadu_ps(bounds[1] + batch + half);
+				const XMVECTOR cz = _mm_loadu_ps(bounds[2] + batch + half);
+				XMVECTOR visible = XMVectorTrueInt();
+
+				for (int i = 0; i < 6; ++i)
+				{
+					XMVECTOR distance = XMVectorMultiplyAdd(planes.X[i], cx,
+						XMVectorMultiplyAdd(planes.Y[i], cy, XMVectorMultiplyAdd(planes.Z[i], cz, planes.W[i])));
+					if (!bSharedExtents)
+					{
+						const XMVECTOR ex = _mm_loadu_ps(bounds[3] + batch + half);
+						const XMVECTOR ey = _mm_loadu_ps(bounds[4] + batch + half);
+						const XMVECTOR ez = _mm_loadu_ps(bounds[5] + batch + half);
+						distance = XMVectorAdd(distance, XMVectorMultiplyAdd(planes.AbsX[i], ex,
+							XMVectorMultiplyAdd(planes.AbsY[i], ey, XMVectorMultiply(planes.AbsZ[i], ez))));
+					}
+					visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, zero));
+				}
+
+				mask |= static_cast<UINT>(_mm_movemask_ps(visible)) << half;
+			}
+
+			return mask;
+#endif
+		}
+
+		// [begin, end) ġ  ˻ؼ ̴ ε .   ġ    .
+		template <bool bSharedExtents>
+		UINT cullBatches(const PlaneSplats& splats, const float* const bounds[6], UINT begin, UINT end, UINT* outIndices)
+		{
+			UINT count = 0;
+
+			for (UINT batch = begin - begin % FrustumCuller::BATCH_SIZE; batch < end; batch += FrustumCuller::BATCH_SIZE)
+			{
+				const UINT mask = testBatch<bSharedExtents>(splats, bounds, batch);
+
+				if (batch >= begin && batch + FrustumCuller::BATCH_SIZE <= end)
+				{
+					// ̴    ε 4 ׻ °   ÷ б  и ش.
+					//     Ⱑ ,  δ  ʴ´. (count <= batch - begin)
+					const __m128i base = _mm_set1_epi32(static_cast<int>(batch));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(outIndices + count), _mm_add_epi32(base, _mm_load_si128(reinterpret_cast<const __m128i*>(COMPACT_LANES[mask & 15]))));
+					count += VISIBLE_COUNTS[mask & 15];
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(outIndices + count), _mm_add_epi32(base, _mm_load_si128(reinterpret_cast<const __m128i*>(COMPACT_LANES[16 + (mask >> 4)]))));
+					count += VISIBLE_COUNTS[mask >> 4];
+				}
+				else
+				{
+					//    ġ    ǳʶڴ.
+					for (UINT lane = 0; lane < FrustumCuller::BATCH_SIZE; ++lane)
+					{
+						UINT index = batch + lane;
+
+						if (index >= begin && index < end && ((mask >> lane) & 1) != 0)
+						{
+							outIndices[count++] = index;
+						}
+					}
+				}
+			}
+
+			return count;
+		}
+	}
+
+	void FrustumPlanes::Set(const Vector4 planes[6])
+	{
+		static const int PLANE_ORDER[8] = { 0, 1, 2, 3, 4, 5, 0, 1 };
+
+		for (int i = 0; i < 6; ++i)
+		{
+			Planes[i] = planes[i];
+		}
+
+		for (int group = 0; group < 2; ++group)
+		{
+			const Vector4& p0 = planes[PLANE_ORDER[group * 4 + 0]];
+			const Vector4& p1 = planes[PLANE_ORDER[group * 4 + 1]];
+			const Vector4& p2 = planes[PLANE_ORDER[group * 4 + 2]];
+			const Vector4& p3 = planes[PLANE_ORDER[group * 4 + 3]];
+
+			NormalX[group] = XMVectorSet(p0.x, p1.x, p2.x, p3.x);
+			NormalY[group] = XMVectorSet(p0.y, p1.y, p2.y, p3.y);
+			NormalZ[group] = XMVectorSet(p0.z, p1.z, p2.z, p3.z);
+			Distance[group] = XMVectorSet(p0.w, p1.w, p2.w, p3.w);
+
+			AbsNormalX[group] = XMVectorAbs(NormalX[group]);
+			AbsNormalY[group] = XMVectorAbs(NormalY[group]);
+			AbsNormalZ[group] = XMVectorAbs(NormalZ[group]);
+		}
+	}
+	ContainmentType FrustumPlanes::Contains(const BoundingBox& box) const
+	{
+		const XMVECTOR cx = XMVectorReplicate(box.Center.x);
+		const XMVECTOR cy = XMVectorReplicate(box.Center.y);
+		const XMVECTOR cz = XMVectorReplicate(box.Center.z);
+		const XMVECTOR ex = XMVectorReplicate(box.Extents.x);
+		const XMVECTOR ey = XMVectorReplicate(box.Extents.y);
+		const XMVECTOR ez = XMVectorReplicate(box.Extents.z);
+		const XMVECTOR zero = XMVectorZero();
+
+		bool bInside = true;
+
+		for (int group = 0; group < 2; ++group)
+		{
+			// ڽ ߽ ȣ ִ Ÿ     ڽ 
+			XMVECTOR distance = XMVectorMultiplyAdd(NormalX[group], cx,
+				XMVectorMultiplyAdd(NormalY[group], cy,
+					XMVectorMultiplyAdd(NormalZ[group], cz, Distance[group])));
+			XMVECTOR radius = XMVectorMultiplyAdd(AbsNormalX[group], ex,
+				XMVectorMultiplyAdd(AbsNormalY[group], ey, XMVectorMultiply(AbsNormalZ[group], ez)));
+
+			//  ϳ ڽ ü ٱʿ   ʴ´.
+			if (!XMVector4GreaterOrEqual(XMVectorAdd(distance, radius), zero))
+			{
+				return DISJOINT;
+			}
+
+			bInside = bInside && XMVector4GreaterOrEqual(XMVectorSubtract(distance, radius), zero);
+		}
+
+		return bInside ? CONTAINS : INTERSECTS;
+	}
+
+	FrustumCuller::FrustumCuller()
+		: mSharedExtents(0.f, 0.f, 0.f)
+		, mbSharedExtents(false)
+		, mCount(0)
+	{
+	}
+
+	void FrustumCuller::Resize(UINT count)
+	{
+		const UINT paddedCount = (count + BATCH_SIZE - 1) / BATCH_SIZE * BATCH_SIZE;
+
+		mCenterX.resize(paddedCount, 0.f);
+		mCenterY.resize(paddedCount, 0.f);
+		mCenterZ.resize(paddedCount, 0.f);
+		if (!mbSharedExtents)
+		{
+			mExtentX.resize(paddedCount, 0.f);
+			mExtentY.resize(paddedCount, 0.f);
+			mExtentZ.resize(paddedCount, 0.f);
+		}
+		mCount = count;
+
+		mChunkIndices.resize(paddedCount);
+		mChunkOffsets.resize((count + PARALLEL_CHUNK_SIZE - 1) / PARALLEL_CHUNK_SIZE + 1);
+	}
+	void FrustumCuller::SetBounds(UINT index, const BoundingBox& worldBox)
+	{
+		assert(index < mCount);
+		assert(!mbSharedExtents);
+
+		mCenterX[index] = worldBox.Center.x;
+		mCenterY[index] = worldBox.Center.y;
+		mCenterZ[index] = worldBox.Center.z;
+		mExtentX[index] = worldBox.Extents.x;
+		mExtentY[index] = worldBox.Extents.y;
+		mExtentZ[index] = worldBox.Extents.z;
+	}
+
+	void FrustumCuller::SetSharedExtents(const Vector3& extents)
+	{
+		mSharedExtents = extents;
+		mbSharedExtents = true;
+
+		std::vector<float>().swap(mExtentX);
+		std::vector<float>().swap(mExtentY);
+		std::vector<float>().swap(mExtentZ);
+	}
+	void FrustumCuller::SetCenter(UINT index, const Vector3& center)
+	{
+		assert(index < mCount);
+
+		mCenterX[index] = center.x;
+		mCenterY[index] = center.y;
+		mCenterZ[index] = center.z;
+	}
+
+	UINT FrustumCuller::Cull(const FrustumPlanes& planes, UINT begin, UINT end, UINT* outIndices) const
+	{
+		end = end < mCount ? end : mCount;
+
+		if (begin >= end)
+		{
+			return 0;
+		}
+
+		PlaneSplats splats;
+		setPlaneSplats(planes, &splats);
+
+		const float* const bounds[6] = { mCenterX.data(), mCenterY.data(), mCenterZ.data(), mExtentX.data(), mExtentY.data(), mExtentZ.data() };
+		if (mbSharedExtents)
+		{
+			addSharedRadius(mSharedExtents, &splats);
+			return cullBatches<true>(splats, bounds, begin, end, outIndices);
+		}
+
+		return cullBatches<false>(splats, bounds, begin, end, outIndices);
+	}
+
+	UINT FrustumCuller::Cull(const FrustumPlanes& planes, UINT* outIndices, JobSystem* jobSystem)
+	{
+		if (jobSystem == nullptr || mCount == 0)
+		{
+			return Cull(planes, 0, mCount, outIndices);
+		}
+
+		const UINT chunkCount = static_cast<UINT>(mChunkOffsets.size()) - 1;
+		const UINT total = cullChunks(planes, jobSystem);
+
+		jobSystem->ParallelFor(chunkCount, 1, [this, outIndices](UINT chunkBegin, UINT chunkEnd)
+			{
+				for (UINT chunk = chunkBegin; chunk < chunkEnd; ++chunk)
+				{
+					const UINT* indices = &mChunkIndices[chunk * PARALLEL_CHUNK_SIZE];
+					UINT count = mChunkOffsets[chunk + 1] - mChunkOffsets[chunk];
+
+					memcpy(outIndices + mChunkOffsets[chunk], indices, count * sizeof(UINT));
+				}
+			});
+
+		return total;
+	}
+
+	UINT FrustumCuller::cullChunks(const FrustumPlanes& planes, JobSystem* jobSystem)
+	{
+		const UINT chunkCount = static_cast<UINT>(mChunkOffsets.size()) - 1;
+
+		// 1. ûũ ø, ̴  
+		jobSystem->ParallelFor(chunkCount, 1, [this, &planes](UINT chunkBegin, UINT chunkEnd)
+			{
+				for (UINT chunk = chunkBegin; chunk < chunkEnd; ++chunk)
+				{
+					UINT begin = chunk * PARALLEL_CHUNK_SIZE;
+					mChunkOffsets[chunk] = Cull(planes, begin, begin + PARALLEL_CHUNK_SIZE, &mChunkIndices[begin]);
+				}
+			});
+
+		// 2. Ÿ  , ûũ  Ƿ  忡 óѴ.
+		UINT total = 0;
+		for (UINT chunk = 0; chunk < chunkCount; ++chunk)
+		{
+			UINT count = mChunkOffsets[chunk];
+			mChunkOffsets[chunk] = total;
+			total += count;
+		}
+		mChunkOffsets[chunkCount] = total;
+
+		return total;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <DirectXCollision.h>
+#include <directxtk/SimpleMath.h>
+#include <vector>
+
+#include "JobSystem.h"
+
+namespace common
+{
+	using namespace DirectX;
+	using namespace DirectX::SimpleMath;
+
+	//    4 SIMD ˻ϱ  SoA Ǯ  
+	// 6  8 ä    ĭ 0, 1  ݺѴ.
+	struct FrustumPlanes
+	{
+	public:
+		//  ϴ ȭ  ޴´. (D3DHelper::ExtractFrustumPlanes)
+		void Set(const Vector4 planes[6]);
+		// ڽ ϳ  6 ÿ ˻Ѵ.
+		ContainmentType Contains(const BoundingBox& box) const;
+
+	public:
+		Vector4 Planes[6];
+
+		XMVECTOR NormalX[2];
+		XMVECTOR NormalY[2];
+		XMVECTOR NormalZ[2];
+		XMVECTOR AbsNormalX[2];
+		XMVECTOR AbsNormalY[2];
+		XMVECTOR AbsNormalZ[2];
+		XMVECTOR Distance[2];
+	};
+
+	// νϽ  AABB ߽ x/y/z, ũ x/y/z 迭  ϰ
+	// BATCH_SIZE     ˻Ѵ. (AVX 8, ƴϸ SSE 4  )
+	//  νϽ ڽ ũⰡ (̵ ϴ νϽ) SetSharedExtents ũ 迭 ְ
+	// 鸶 ڽ  ̸  ξ νϽ ߽ 12Ʈ д´.
+	class FrustumCuller
+	{
+	public:
+		enum { BATCH_SIZE = 8 };
+
+		FrustumCuller();
+		~FrustumCuller() = default;
+
+		// 迭 BATCH_SIZE    ĭ ˻  ܵȴ.
+		void Resize(UINT count);
+		void SetBounds(UINT index, const BoundingBox& worldBox);
+		//   νϽ extents ũ ڽ . ũ 迭 Ƿ SetCenterθ ä.
+		void SetSharedExtents(const Vector3& extents);
+		void SetCenter(UINT index, const Vector3& center);
+
+		// [begin, end)  ̴ νϽ ε    ȯѴ.
+		// outIndices end - begin   ־ Ѵ.
+		UINT Cull(const FrustumPlanes& planes, UINT begin, UINT end, UINT* outIndices) const;
+		// ü νϽ ûũ  øؼ ̴ ε Cull   .
+		// outIndices GetCount()   ־ Ѵ.
+		UINT Cull(const FrustumPlanes& planes, UINT* outIndices, JobSystem* jobSystem);
+		// ̴ νϽ ͸  dest ϰ  ȯѴ.
+		// dest D3D11_MAP_WRITE_DISCARD  ó ⸸ ϴ ޸𸮿 ȴ.
+		template <typename T>
+		UINT CullCopy(const FrustumPlanes& planes, const T* source, T* dest) const;
+		// ûũ  øؼ ̴  ,    ġ   ķ Ѹ.
+		//   CullCopy     ׻ .
+		template <typename T>
+		UINT CullCopy(const FrustumPlanes& planes, const T* source, T* dest, JobSystem* jobSystem);
+
+		inline UINT GetCount() const;
+		//   ø  д   ũ
+		inline size_t GetBoundsByteSize() const;
+
+	private:
+		std::vector<float> mCenterX;
+		std::vector<float> mCenterY;
+		std::vector<float> mCenterZ;
+		std::vector<float> mExtentX;
+		std::vector<float> mExtentY;
+		std::vector<float> mExtentZ;
+		Vector3 mSharedExtents;
+		bool mbSharedExtents;
+		UINT mCount;
+
+		enum { COPY_CHUNK_SIZE = 1024 };
+		enum { PARALLEL_CHUNK_SIZE = 8192 }; // BATCH_SIZE 
+
+		//  ø, Resize    ҴѴ.
+		std::vector<UINT> mChunkIndices; // ûũ ڱ  ġ ̴ ε .
+		std::vector<UINT> mChunkOffsets; // ûũ ̴  ->   ٲ㼭   ġ .
+
+		//  ø 1, 2ܰ, ûũ ε   ġ ä ̴   ȯѴ.
+		UINT cullChunks(const FrustumPlanes& planes, JobSystem* jobSystem);
+	};
+
+	template <typename T>
+	UINT FrustumCuller::CullCopy(const FrustumPlanes& planes, const T* source, T* dest) const
+	{
+		// ε  ̾Ƶΰ ϸ   бⰡ   а  ʴ´.
+		UINT indices[COPY_CHUNK_SIZE];
+		UINT count = 0;
+
+		for (UINT begin = 0; begin < mCount; begin += COPY_CHUNK_SIZE)
+		{
+			UINT end = begin + COPY_CHUNK_SIZE < mCount ? begin + COPY_CHUNK_SIZE : mCount;
+			UINT visibleCount = Cull(planes, begin, end, indices);
+
+			for (UINT i = 0; i < visibleCount; ++i)
+			{
+				dest[count++] = source[indices[i]];
+			}
+		}
+
+		return count;
+	}
+
+	template <typename T>
+	UINT FrustumCuller::CullCopy(const FrustumPlanes& planes, const T* source, T* dest, JobSystem* jobSystem)
+	{
+		if (jobSystem == nullptr || mCount == 0)
+		{
+			return CullCopy(planes, source, dest);
+		}
+
+		const UINT chunkCount = static_cast<UINT>(mChunkOffsets.size()) - 1;
+		const UINT total = cullChunks(planes, jobSystem);
+
+		// 3. ûũ  ġ 
+		jobSystem->ParallelFor(chunkCount, 1, [this, source, dest](UINT chunkBegin, UINT chunkEnd)
+			{
+				for (UINT chunk = chunkBegin; chunk < chunkEnd; ++chunk)
+				{
+					const UINT* indices = &mChunkIndices[chunk * PARALLEL_CHUNK_SIZE];
+					T* chunkDest = dest + mChunkOffsets[chunk];
+					UINT count = mChunkOffsets[chunk + 1] - mChunkOffsets[chunk];
+
+					for (UINT i = 0; i < count; ++i)
+					{
+						chunkDest[i] = source[indices[i]];
+					}
+				}
+			});
+
+		return total;
+	}
+
+	UINT FrustumCuller::GetCount() const
+	{
+		return mCount;
+	}
+
+	size_t FrustumCuller::GetBoundsByteSize() const
+	{
+		return (mCenterX.size() + mCenterY.size() + mCenterZ.size() + mExtentX.size() + mExtentY.size() + mExtentZ.size()) * sizeof(float);
+	}
+}
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <vector>
+
+#include "MathHelper.h"
+
 namespace common
 {
 	using namespace DirectX::SimpleMath;
@@ -27,6 +32,25 @@ namespace common
 			std::vector<unsigned int> Indices;
 		};
 
+		// Ⱑ   Ӽ  ͷ . nullptr Ӽ   ʴ´.
+		// ex) VertexLayout<Basic32, &Basic32::Pos, &Basic32::Normal, nullptr, &Basic32::Tex>
+		template <typename VertexT, Vector3 VertexT::* PositionMember,
+			Vector3 VertexT::* NormalMember = nullptr,
+			Vector3 VertexT::* TangentUMember = nullptr,
+			Vector2 VertexT::* TexCMember = nullptr>
+		struct VertexLayout
+		{
+			using Vertex = VertexT;
+
+			enum { HAS_NORMAL = NormalMember != nullptr };
+			enum { HAS_TANGENT_U = TangentUMember != nullptr };
+			enum { HAS_TEXC = TexCMember != nullptr };
+
+			static inline void Write(Vertex* outVertex, const Vector3& position, const Vector3& normal, const Vector3& tangentU, const Vector2& texC);
+		};
+
+		using MeshDataLayout = VertexLayout<Vertex, &Vertex::Position, &Vertex::Normal, &Vertex::TangentU, &Vertex::TexC>;
+
 	public:
 		static void CreateBox(float width, float height, float depth, MeshData* outMeshData);
 		static void CreateSphere(float radius, UINT sliceCount, UINT stackCount, MeshData* outMeshData);
@@ -35,9 +59,384 @@ namespace common
 		static void CreateGrid(float width, float depth, UINT m, UINT n, MeshData* outMeshData);
 		static void CreateFullscreenQuad(MeshData* outMeshData);
 
+		// ȣڰ  (ε) ۿ ٷ  , Get*Count /ε    ۸ ´.
+		// ε outVertices  0 Ѵ.
+		static void GetBoxCount(UINT* outVertexCount, UINT* outIndexCount);
+		static void GetSphereCount(UINT sliceCount, UINT stackCount, UINT* outVertexCount, UINT* outIndexCount);
+		static void GetGeosphereCount(UINT numSubdivisions, UINT* outVertexCount, UINT* outIndexCount);
+		static void GetCylinderCount(UINT sliceCount, UINT stackCount, UINT* outVertexCount, UINT* outIndexCount);
+		static void GetGridCount(UINT m, UINT n, UINT* outVertexCount, UINT* outIndexCount);
+		static void GetFullscreenQuadCount(UINT* outVertexCount, UINT* outIndexCount);
+
+		template <typename Layout>
+		static void CreateBox(float width, float height, float depth, typename Layout::Vertex* outVertices, UINT* outIndices);
+		template <typename Layout>
+		static void CreateSphere(float radius, UINT sliceCount, UINT stackCount, typename Layout::Vertex* outVertices, UINT* outIndices);
+		template <typename Layout>
+		static void CreateGeosphere(float radius, UINT numSubdivisions, typename Layout::Vertex* outVertices, UINT* outIndices);
+		template <typename Layout>
+		static void CreateCylinder(float bottomRadius, float topRadius, float height, UINT sliceCount, UINT stackCount,
+			typename Layout::Vertex* outVertices, UINT* outIndices);
+		template <typename Layout>
+		static void CreateGrid(float width, float depth, UINT m, UINT n, typename Layout::Vertex* outVertices, UINT* outIndices);
+		template <typename Layout>
+		static void CreateFullscreenQuad(typename Layout::Vertex* outVertices, UINT* outIndices);
+
 	private:
-		static void subdivide(MeshData* meshData);
-		static void buildCylinderTopCap(float bottomRadius, float topRadius, float height, UINT sliceCount, UINT stackCount, MeshData* outMeshData);
-		static void buildCylinderBottomCap(float bottomRadius, float topRadius, float height, UINT sliceCount, UINT stackCount, MeshData* outMeshData);
+		enum { MAX_GEOSPHERE_SUBDIVISIONS = 5 };
+
+		// ̽ʸü  𼭸  𼭸 ؽ÷ Ѵ. ġ     ʴ.
+		static void buildGeosphere(UINT numSubdivisions, std::vector<Vector3>* outPositions, std::vector<UINT>* outIndices);
+		static void subdivide(std::vector<Vector3>* positions, std::vector<UINT>* indices);
+
+		template <typename Layout>
+		static void buildCylinderCap(float radius, float height, float y, UINT sliceCount, UINT baseIndex,
+			bool bTop, typename Layout::Vertex* outVertices, UINT* outIndices);
 	};
-}
\ No newline at end of file
+
+	template <typename VertexT, Vector3 VertexT::* PositionMember, Vector3 VertexT::* NormalMember,
+		Vector3 VertexT::* TangentUMember, Vector2 VertexT::* TexCMember>
+	void GeometryGenerator::VertexLayout<VertexT, PositionMember, NormalMember, TangentUMember, TexCMember>::Write(
+		Vertex* outVertex, const Vector3& position, const Vector3& normal, const Vector3& tangentU, const Vector2& texC)
+	{
+		outVertex->*PositionMember = position;
+
+		if (HAS_NORMAL)
+		{
+			outVertex->*NormalMember = normal;
+		}
+		if (HAS_TANGENT_U)
+		{
+			outVertex->*TangentUMember = tangentU;
+		}
+		if (HAS_TEXC)
+		{
+			outVertex->*TexCMember = texC;
+		}
+	}
+
+	template <typename Layout>
+	void GeometryGenerator::CreateBox(float width, float height, float depth, typename Layout::Vertex* outVertices, UINT* outIndices)
+	{
+		const float w2 = 0.5f * width;
+		const float h2 = 0.5f * height;
+		const float d2 = 0.5f * depth;
+
+		typename Layout::Vertex* v = outVertices;
+
+		// Fill in the front face vertex data.
+		Layout::Write(&v[0], { -w2, -h2, -d2 }, { 0.0f, 0.0f, -1.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f });
+		Layout::Write(&v[1], { -w2, +h2, -d2 }, { 0.0f, 0.0f, -1.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f });
+		Layout::Write(&v[2], { +w2, +h2, -d2 }, { 0.0f, 0.0f, -1.0f }, { 1.0f, 0.0f, 0.0f }, { 1.0f, 0.0f });
+		Layout::Write(&v[3], { +w2, -h2, -d2 }, { 0.0f, 0.0f, -1.0f }, { 1.0f, 0.0f, 0.0f }, { 1.0f, 1.0f });
+
+		// Fill in the back face vertex data.
+		Layout::Write(&v[4], { -w2, -h2, +d2 }, { 0.0f, 0.0f, 1.0f }, { -1.0f, 0.0f, 0.0f }, { 1.0f, 1.0f });
+		Layout::Write(&v[5], { +w2, -h2, +d2 }, { 0.0f, 0.0f, 1.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f });
+		Layout::Write(&v[6], { +w2, +h2, +d2 }, { 0.0f, 0.0f, 1.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f });
+		Layout::Write(&v[7], { -w2, +h2, +d2 }, { 0.0f, 0.0f, 1.0f }, { -1.0f, 0.0f, 0.0f }, { 1.0f, 0.0f });
+
+		// Fill in the top face vertex data.
+		Layout::Write(&v[8], { -w2, +h2, -d2 }, { 0.0f, 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f });
+		Layout::Write(&v[9], { -w2, +h2, +d2 }, { 0.0f, 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f });
+		Layout::Write(&v[10], { +w2, +h2, +d2 }, { 0.0f, 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 1.0f, 0.0f });
+		Layout::Write(&v[11], { +w2, +h2, -d2 }, { 0.0f, 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 1.0f, 1.0f });
+
+		// Fill in the bottom face vertex data.
+		Layout::Write(&v[12], { -w2, -h2, -d2 }, { 0.0f, -1.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, { 1.0f, 1.0f });
+		Layout::Write(&v[13], { +w2, -h2, -d2 }, { 0.0f, -1.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f });
+		Layout::Write(&v[14], { +w2, -h2, +d2 }, { 0.0f, -1.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f });
+		Layout::Write(&v[15], { -w2, -h2, +d2 }, { 0.0f, -1.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, { 1.0f, 0.0f });
+
+		// Fill in the left face vertex data.
+		Layout::Write(&v[16], { -w2, -h2, +d2 }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 0.0f, 1.0f });
+		Layout::Write(&v[17], { -w2, +h2, +d2 }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 0.0f, 0.0f });
+		Layout::Write(&v[18], { -w2, +h2, -d2 }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 1.0f, 0.0f });
+		Layout::Write(&v[19], { -w2, -h2, -d2 }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 1.0f, 1.0f });
+
+		// Fill in the right face vertex data.
+		Layout::Write(&v[20], { +w2, -h2, -d2 }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f });
+		Layout::Write(&v[21], { +w2, +h2, -d2 }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f });
+		Layout::Write(&v[22], { +w2, +h2, +d2 }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f });
+		Layout::Write(&v[23], { +w2, -h2, +d2 }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 1.0f, 1.0f });
+
+		// 鸶  4, ﰢ 2
+		for (UINT face = 0; face < 6; ++face)
+		{
+			UINT* i = &outIndices[face * 6];
+			const UINT base = face * 4;
+
+			i[0] = base + 0; i[1] = base + 1; i[2] = base + 2;
+			i[3] = base + 0; i[4] = base + 2; i[5] = base + 3;
+		}
+	}
+
+	template <typename Layout>
+	void GeometryGenerator::CreateSphere(float radius, UINT sliceCount, UINT stackCount, typename Layout::Vertex* outVertices, UINT* outIndices)
+	{
+		UINT vertexIndex = 0;
+
+		Layout::Write(&outVertices[vertexIndex++], { 0.0f, +radius, 0.0f }, { 0.0f, +1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f });
+
+		const float phiStep = DirectX::XM_PI / stackCount;
+		const float thetaStep = 2.0f * DirectX::XM_PI / sliceCount;
+
+		for (UINT i = 1; i <= stackCount - 1; ++i)
+		{
+			const float phi = i * phiStep;
+			const float sinPhi = sinf(phi);
+			const float cosPhi = cosf(phi);
+
+			for (UINT j = 0; j <= sliceCount; ++j)
+			{
+				const float theta = j * thetaStep;
+				const float sinTheta = sinf(theta);
+				const float cosTheta = cosf(theta);
+
+				// spherical to cartesian
+				const Vector3 normal(sinPhi * cosTheta, cosPhi, sinPhi * sinTheta);
+
+				// Partial derivative of P with respect to theta (sinPhi > 0̹Ƿ  ȭ )
+				const Vector3 tangentU(-sinTheta, 0.0f, cosTheta);
+
+				Layout::Write(&outVertices[vertexIndex++], normal * radius, normal, tangentU,
+					{ theta / DirectX::XM_2PI, phi / DirectX::XM_PI });
+			}
+		}
+
+		Layout::Write(&outVertices[vertexIndex], { 0.0f, -radius, 0.0f }, { 0.0f, -1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f });
+
+		UINT k = 0;
+		for (UINT i = 1; i <= sliceCount; ++i)
+		{
+			outIndices[k++] = 0;
+			outIndices[k++] = i + 1;
+			outIndices[k++] = i;
+		}
+
+		const UINT ringVertexCount = sliceCount + 1;
+		UINT baseIndex = 1;
+		for (UINT i = 0; i < stackCount - 2; ++i)
+		{
+			for (UINT j = 0; j < sliceCount; ++j)
+			{
+				outIndices[k++] = baseIndex + i * ringVertexCount + j;
+				outIndices[k++] = baseIndex + i * ringVertexCount + j + 1;
+				outIndices[k++] = baseIndex + (i + 1) * ringVertexCount + j;
+
+				outIndices[k++] = baseIndex + (i + 1) * ringVertexCount + j;
+				outIndices[k++] = baseIndex + i * ringVertexCount + j + 1;
+				outIndices[k++] = baseIndex + (i + 1) * ringVertexCount + j + 1;
+			}
+		}
+
+		// South pole vertex was added last.
+		const UINT southPoleIndex = vertexIndex;
+
+		// Offset the indices to the index of the first vertex in the last ring.
+		baseIndex = southPoleIndex - ringVertexCount;
+
+		for (UINT i = 0; i < sliceCount; ++i)
+		{
+			outIndices[k++] = southPoleIndex;
+			outIndices[k++] = baseIndex + i;
+			outIndices[k++] = baseIndex + i + 1;
+		}
+	}
+
+	template <typename Layout>
+	void GeometryGenerator::CreateGeosphere(float radius, UINT numSubdivisions, typename Layout::Vertex* outVertices, UINT* outIndices)
+	{
+		std::vector<Vector3> positions;
+		std::vector<UINT> indices;
+		buildGeosphere(numSubdivisions, &positions, &indices);
+
+		for (size_t i = 0; i < positions.size(); ++i)
+		{
+			Vector3 normal = positions[i];
+			normal.Normalize();
+
+			const Vector3 position = normal * radius;
+
+			//  ǥ, theta y ѷ , phi +y  
+			float theta = 0.f;
+			float phi = 0.f;
+			if (Layout::HAS_TANGENT_U || Layout::HAS_TEXC)
+			{
+				theta = MathHelper::AngleFromXY(normal.x, normal.z);
+				phi = acosf(std::min<float>(std::max<float>(normal.y, -1.f), 1.f));
+			}
+
+			Vector3 tangentU;
+			if (Layout::HAS_TANGENT_U)
+			{
+				tangentU = Vector3(-sinf(theta), 0.0f, cosf(theta));
+			}
+
+			Layout::Write(&outVertices[i], position, normal, tangentU, { theta / DirectX::XM_2PI, phi / DirectX::XM_PI });
+		}
+
+		std::copy(indices.begin(), indices.end(), outIndices);
+	}
+
+	template <typename Layout>
+	void GeometryGenerator::CreateCylinder(float bottomRadius, float topRadius, float height, UINT sliceCount, UINT stackCount,
+		typename Layout::Vertex* outVertices, UINT* outIndices)
+	{
+		// stackCount :  ̷  
+		// sliceCount :  ϴ  
+
+		const float stackHeight = height / stackCount;
+		const float radiusStep = (topRadius - bottomRadius) / stackCount;
+		const UINT ringCount = stackCount + 1;
+		const float dr = bottomRadius - topRadius; // ʺ 
+		const float dTheta = 2.0f * DirectX::XM_PI / sliceCount; // 
+
+		UINT vertexIndex = 0;
+		for (UINT i = 0; i < ringCount; ++i)
+		{
+			const float y = -0.5f * height + i * stackHeight; // ּ ̺ 
+			const float r = bottomRadius + i * radiusStep; //   
+
+			for (UINT j = 0; j <= sliceCount; ++j)
+			{
+				const float c = cosf(j * dTheta); // ̽ ŭ cos sin Ѵ.
+				const float s = sinf(j * dTheta);
+
+				const Vector3 tangentU(-s, 0.0f, c);
+
+				Vector3 normal;
+				if (Layout::HAS_NORMAL)
+				{
+					const Vector3 bitangent(dr * c, -height, dr * s);
+					normal = tangentU.Cross(bitangent);
+				}
+
+				Layout::Write(&outVertices[vertexIndex++], { r * c, y, r * s }, normal, tangentU,
+					{ (float)j / sliceCount, 1.0f - (float)i / stackCount });
+			}
+		}
+
+		const UINT ringVertexCount = sliceCount + 1;
+
+		UINT k = 0;
+		for (UINT i = 0; i < stackCount; ++i)
+		{
+			for (UINT j = 0; j < sliceCount; ++j)
+			{
+				outIndices[k++] = i * ringVertexCount + j;
+				outIndices[k++] = (i + 1) * ringVertexCount + j;
+				outIndices[k++] = (i + 1) * ringVertexCount + j + 1;
+
+				outIndices[k++] = i * ringVertexCount + j;
+				outIndices[k++] = (i + 1) * ringVertexCount + j + 1;
+				outIndices[k++] = i * ringVertexCount + j + 1;
+			}
+		}
+
+		buildCylinderCap<Layout>(topRadius, height, 0.5f * height, sliceCount, vertexIndex, true,
+			outVertices, &outIndices[k]);
+
+		vertexIndex += sliceCount + 2;
+		k += sliceCount * 3;
+
+		buildCylinderCap<Layout>(bottomRadius, height, -0.5f * height, sliceCount, vertexIndex, false,
+			outVertices, &outIndices[k]);
+	}
+
+	template <typename Layout>
+	void GeometryGenerator::CreateGrid(float width, float depth, UINT m, UINT n, typename Layout::Vertex* outVertices, UINT* outIndices)
+	{
+		/*
+		o--o--o
+		|  |  |
+		o--o--o
+		|  |  |
+		o--o--o
+		3x3̸ 簢  2x2
+		ﰢ(face)  簢(cell)  * 2
+		*/
+		const float halfWidth = 0.5f * width;
+		const float halfDepth = 0.5f * depth;
+
+		const float dx = width / (n - 1);
+		const float dz = depth / (m - 1);
+
+		const float du = 1.0f / (n - 1);
+		const float dv = 1.0f / (m - 1);
+
+		for (UINT i = 0; i < m; ++i)
+		{
+			const float z = halfDepth - i * dz;
+
+			for (UINT j = 0; j < n; ++j)
+			{
+				const float x = -halfWidth + j * dx;
+
+				Layout::Write(&outVertices[i * n + j], { x, 0.0f, z }, { 0.0f, 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { j * du, i * dv });
+			}
+		}
+
+		UINT k = 0;
+		for (UINT i = 0; i < m - 1; ++i)
+		{
+			for (UINT j = 0; j < n - 1; ++j)
+			{
+				outIndices[k++] = i * n + j;
+				outIndices[k++] = i * n + j + 1;
+				outIndices[k++] = (i + 1) * n + j;
+				outIndices[k++] = (i + 1) * n + j;
+				outIndices[k++] = i * n + j + 1;
+				outIndices[k++] = (i + 1) * n + j + 1;
+			}
+		}
+	}
+
+	template <typename Layout>
+	void GeometryGenerator::CreateFullscreenQuad(typename Layout::Vertex* outVertices, UINT* outIndices)
+	{
+		Layout::Write(&outVertices[0], { -1.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f });
+		Layout::Write(&outVertices[1], { -1.0f, +1.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f });
+		Layout::Write(&outVertices[2], { +1.0f, +1.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 1.0f, 0.0f, 0.0f }, { 1.0f, 0.0f });
+		Layout::Write(&outVertices[3], { +1.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 1.0f, 0.0f, 0.0f }, { 1.0f, 1.0f });
+
+		outIndices[0] = 0;
+		outIndices[1] = 1;
+		outIndices[2] = 2;
+
+		outIndices[3] = 0;
+		outIndices[4] = 2;
+		outIndices[5] = 3;
+	}
+
+	template <typename Layout>
+	void GeometryGenerator::buildCylinderCap(float radius, float height, float y, UINT sliceCount, UINT baseIndex,
+		bool bTop, typename Layout::Vertex* outVertices, UINT* outIndices)
+	{
+		const float dTheta = 2.0f * DirectX::XM_PI / sliceCount;
+		const Vector3 normal(0.0f, bTop ? 1.0f : -1.0f, 0.0f);
+		const Vector3 tangentU(1.0f, 0.0f, 0.0f);
+
+		for (UINT i = 0; i <= sliceCount; ++i)
+		{
+			const float x = radius * cosf(i * dTheta);
+			const float z = radius * sinf(i * dTheta);
+
+			const float u = x / height + 0.5f;
+			const float v = z / height + 0.5f;
+
+			Layout::Write(&outVertices[baseIndex + i], { x, y, z }, normal, tangentU, { u, v });
+		}
+
+		const UINT centerIndex = baseIndex + sliceCount + 1;
+		Layout::Write(&outVertices[centerIndex], { 0.0f, y, 0.0f }, normal, tangentU, { 0.5f, 0.5f });
+
+		//   Ʒ    ݴ.
+		for (UINT i = 0; i < sliceCount; ++i)
+		{
+			outIndices[i * 3 + 0] = centerIndex;
+			outIndices[i * 3 + 1] = bTop ? baseIndex + i + 1 : baseIndex + i;
+			outIndices[i * 3 + 2] = bTop ? baseIndex + i : baseIndex + i + 1;
+		}
+	}
+}
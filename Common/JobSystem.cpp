@@ -0,0 +1,190 @@
+#include "JobSystem.h"
+
+namespace common
+{
+	JobSystem::JobSystem(uint32_t workerCount)
+		: mGeneration(0)
+		, mbQuit(false)
+		, mFunc(nullptr)
+		, mContext(nullptr)
+		, mCount(0)
+		, mGrainSize(1)
+		, mPendingChunks(0)
+		, mActiveWorkers(0)
+		, mStealCount(0)
+	{
+		if (workerCount == 0)
+		{
+			uint32_t hardwareCount = std::thread::hardware_concurrency();
+			workerCount = hardwareCount > 1 ? hardwareCount - 1 : 0;
+		}
+
+		mQueues.reset(new WorkQueue[workerCount + 1]);
+		for (uint32_t i = 0; i <= workerCount; ++i)
+		{
+			mQueues[i].Range.store(0);
+		}
+
+		mWorkers.reserve(workerCount);
+		for (uint32_t i = 0; i < workerCount; ++i)
+		{
+			mWorkers.emplace_back(&JobSystem::workerLoop, this, i + 1);
+		}
+	}
+	JobSystem::~JobSystem()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mbQuit = true;
+		}
+		mWakeCondition.notify_all();
+
+		for (std::thread& worker : mWorkers)
+		{
+			worker.join();
+		}
+	}
+
+	void JobSystem::dispatch(uint32_t count, uint32_t grainSize, RangeFunc func, const void* context)
+	{
+		const uint32_t chunkCount = (count + grainSize - 1) / grainSize;
+		const uint32_t threadCount = GetThreadCount();
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+
+			//  ġ ʰ շ Ŀ ť ǵ帮 ʵ    ٸ.
+			while (mActiveWorkers.load() != 0)
+			{
+				std::this_thread::yield();
+			}
+
+			// ûũ  ŭ    ش.
+			for (uint32_t i = 0; i < threadCount; ++i)
+			{
+				uint32_t begin = static_cast<uint32_t>(static_cast<uint64_t>(chunkCount) * i / threadCount);
+				uint32_t end = static_cast<uint32_t>(static_cast<uint64_t>(chunkCount) * (i + 1) / threadCount);
+				mQueues[i].Range.store(packRange(begin, end));
+			}
+
+			mFunc = func;
+			mContext = context;
+			mCount = count;
+			mGrainSize = grainSize;
+			mPendingChunks.store(chunkCount);
+			mStealCount.store(0);
+			++mGeneration;
+		}
+		mWakeCondition.notify_all();
+
+		runChunks(0, count, grainSize, func, context);
+
+		while (mPendingChunks.load() != 0)
+		{
+			std::this_thread::yield();
+		}
+	}
+	void JobSystem::runChunks(uint32_t queueIndex, uint32_t count, uint32_t grainSize, RangeFunc func, const void* context)
+	{
+		uint32_t chunk;
+
+		while (popChunk(queueIndex, &chunk) || stealChunk(queueIndex, &chunk))
+		{
+			uint32_t begin = chunk * grainSize;
+			uint32_t end = begin + grainSize < count ? begin + grainSize : count;
+			func(context, begin, end);
+
+			mPendingChunks.fetch_sub(1);
+		}
+	}
+	bool JobSystem::popChunk(uint32_t queueIndex, uint32_t* outChunk)
+	{
+		std::atomic<uint64_t>& range = mQueues[queueIndex].Range;
+		uint64_t current = range.load();
+
+		while (true)
+		{
+			uint32_t begin = static_cast<uint32_t>(current);
+			uint32_t end = static_cast<uint32_t>(current >> 32);
+
+			if (begin >= end)
+			{
+				return false;
+			}
+
+			if (range.compare_exchange_weak(current, packRange(begin + 1, end)))
+			{
+				*outChunk = begin;
+				return true;
+			}
+		}
+	}
+	bool JobSystem::stealChunk(uint32_t queueIndex, uint32_t* outChunk)
+	{
+		const uint32_t threadCount = GetThreadCount();
+
+		//   ư     ´.
+		for (uint32_t offset = 1; offset < threadCount; ++offset)
+		{
+			std::atomic<uint64_t>& victim = mQueues[(queueIndex + offset) % threadCount].Range;
+			uint64_t current = victim.load();
+
+			while (true)
+			{
+				uint32_t begin = static_cast<uint32_t>(current);
+				uint32_t end = static_cast<uint32_t>(current >> 32);
+
+				if (begin >= end)
+				{
+					break;
+				}
+
+				uint32_t middle = begin + (end - begin) / 2;
+
+				if (victim.compare_exchange_weak(current, packRange(begin, middle)))
+				{
+					// ù ûũ ٷ ϰ  ڱ ť ִ´.
+					// ڱ ť  ־Ƿ ٸ 尡 ÿ ٲ  .
+					mQueues[queueIndex].Range.store(packRange(middle + 1, end));
+					mStealCount.fetch_add(1);
+					*outChunk = middle;
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+	void JobSystem::workerLoop(uint32_t queueIndex)
+	{
+		uint64_t lastGeneration = 0;
+
+		while (true)
+		{
+			RangeFunc func;
+			const void* context;
+			uint32_t count;
+			uint32_t grainSize;
+
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				mWakeCondition.wait(lock, [this, lastGeneration]() { return mbQuit || mGeneration != lastGeneration; });
+
+				if (mbQuit)
+				{
+					return;
+				}
+
+				lastGeneration = mGeneration;
+				func = mFunc;
+				context = mContext;
+				count = mCount;
+				grainSize = mGrainSize;
+				++mActiveWorkers;
+			}
+
+			runChunks(queueIndex, count, grainSize, func, context);
+			--mActiveWorkers;
+		}
+	}
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace common
+{
+	//  Ŀ  [0, count)  grainSize  ûũ  óϴ ۾ ġ(work-stealing)  ý
+	// ûũ 帶 ӵ  ̸  ְ, ڱ     ٸ      .
+	// ȣ 嵵  ϸ, ġ ѱ   Ҵ  ʴ´.
+	//  ȿ ٽ ParallelFor ȣϴ   ʴ´.
+	class JobSystem
+	{
+	public:
+		explicit JobSystem(uint32_t workerCount = 0); // 0̸ ھ  - 1
+		~JobSystem();
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		// func(uint32_t begin, uint32_t end)
+		template <typename Func>
+		void ParallelFor(uint32_t count, uint32_t grainSize, const Func& func);
+
+		inline uint32_t GetThreadCount() const;
+		//  ParallelFor ٸ  ûũ   Ƚ
+		inline uint32_t GetStealCount() const;
+
+	private:
+		typedef void (*RangeFunc)(const void* context, uint32_t begin, uint32_t end);
+
+		// 庰 ûũ ,  32Ʈ begin,  32Ʈ end
+		//  տ  ġ  ڿ    CAS Ѵ.
+		struct WorkQueue
+		{
+			std::atomic<uint64_t> Range;
+			char Padding[64 - sizeof(std::atomic<uint64_t>)]; //   
+		};
+
+		void dispatch(uint32_t count, uint32_t grainSize, RangeFunc func, const void* context);
+		void runChunks(uint32_t queueIndex, uint32_t count, uint32_t grainSize, RangeFunc func, const void* context);
+		bool popChunk(uint32_t queueIndex, uint32_t* outChunk);
+		bool stealChunk(uint32_t queueIndex, uint32_t* outChunk);
+		void workerLoop(uint32_t queueIndex);
+
+		static inline uint64_t packRange(uint32_t begin, uint32_t end);
+
+	private:
+		std::vector<std::thread> mWorkers;
+		std::unique_ptr<WorkQueue[]> mQueues; // 0 ȣ , 1 Ŀ
+		std::mutex mMutex;
+		std::condition_variable mWakeCondition;
+		uint64_t mGeneration;
+		bool mbQuit;
+
+		//  ġ, mMutex ȣ
+		RangeFunc mFunc;
+		const void* mContext;
+		uint32_t mCount;
+		uint32_t mGrainSize;
+
+		std::atomic<uint32_t> mPendingChunks;
+		std::atomic<uint32_t> mActiveWorkers;
+		std::atomic<uint32_t> mStealCount;
+	};
+
+	template <typename Func>
+	void JobSystem::ParallelFor(uint32_t count, uint32_t grainSize, const Func& func)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		grainSize = grainSize > 0 ? grainSize : 1;
+
+		if (mWorkers.empty() || count <= grainSize)
+		{
+			func(0u, count);
+			return;
+		}
+
+		RangeFunc thunk = [](const void* context, uint32_t begin, uint32_t end)
+			{
+				(*static_cast<const Func*>(context))(begin, end);
+			};
+
+		dispatch(count, grainSize, thunk, &func);
+	}
+
+	uint32_t JobSystem::GetThreadCount() const
+	{
+		return static_cast<uint32_t>(mWorkers.size()) + 1;
+	}
+	uint32_t JobSystem::GetStealCount() const
+	{
+		return mStealCount.load();
+	}
+
+	uint64_t JobSystem::packRange(uint32_t begin, uint32_t end)
+	{
+		return static_cast<uint64_t>(begin) | (static_cast<uint64_t>(end) << 32);
+	}
+}
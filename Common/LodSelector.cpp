@@ -0,0 +1,43 @@
+#include "pch.h"
+
+#include "LodSelector.h"
+
+namespace common
+{
+	const float LodSelector::DEFAULT_PIXEL_ERROR = 1.f;
+
+	LodSelector::LodSelector()
+		: mEyePosition(0.f, 0.f, 0.f)
+		, mPixelsPerUnit(1.f)
+		, mMaxPixelError(DEFAULT_PIXEL_ERROR)
+	{
+	}
+
+	void LodSelector::SetCamera(const Camera& camera, float viewportHeight, float maxPixelError)
+	{
+		mEyePosition = camera.GetPosition();
+		mPixelsPerUnit = viewportHeight / (2.f * tanf(camera.GetFovY() * 0.5f));
+		mMaxPixelError = maxPixelError;
+	}
+
+	UINT LodSelector::Select(const MeshLod* lods, UINT lodCount, const Vector3& worldCenter, float worldRadius, float worldScale) const
+	{
+		//      Ÿ   ũ .
+		const float distance = Vector3::Distance(mEyePosition, worldCenter) - worldRadius;
+		if (distance <= 0.f)
+		{
+			return 0;
+		}
+
+		// Error LOD  ĿǷ ڿ ó Ǵ  ã´.
+		for (UINT i = lodCount; i > 1; --i)
+		{
+			if (GetPixelError(lods[i - 1].Error * worldScale, distance) <= mMaxPixelError)
+			{
+				return i - 1;
+			}
+		}
+
+		return 0;
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <directxtk/SimpleMath.h>
+
+#include "Camera.h"
+#include "MeshSimplifier.h"
+
+namespace common
+{
+	using namespace DirectX::SimpleMath;
+
+	// ȭ   LOD .
+	// Ʈ   e Ÿ d ϴ ȼ  e * H / (2 * tan(fovY / 2) * d)̹Ƿ
+	//    ȼ    ģ LOD .
+	class LodSelector
+	{
+	public:
+		LodSelector();
+		~LodSelector() = default;
+
+		// Ӹ ī޶ ٲ    ȣѴ.
+		void SetCamera(const Camera& camera, float viewportHeight, float maxPixelError = DEFAULT_PIXEL_ERROR);
+
+		// worldScale Ʈ ->  յ ,   ȿ ī޶  ׻ LOD 0̴.
+		UINT Select(const MeshLod* lods, UINT lodCount, const Vector3& worldCenter, float worldRadius, float worldScale = 1.f) const;
+		//    Ÿ distance ϴ ȼ 
+		inline float GetPixelError(float worldError, float distance) const;
+
+		inline const Vector3& GetEyePosition() const;
+
+	private:
+		static const float DEFAULT_PIXEL_ERROR;
+
+		Vector3 mEyePosition;
+		float mPixelsPerUnit; // Ÿ 1   1 ϴ ȼ 
+		float mMaxPixelError;
+	};
+
+	float LodSelector::GetPixelError(float worldError, float distance) const
+	{
+		return worldError * mPixelsPerUnit / distance;
+	}
+
+	const Vector3& LodSelector::GetEyePosition() const
+	{
+		return mEyePosition;
+	}
+}
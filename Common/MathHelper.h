@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cfloat>
+#include <directxtk/SimpleMath.h>
+
 namespace common
 {
 	using namespace DirectX::SimpleMath;
@@ -0,0 +1,400 @@
+#include "pch.h"
+
+#include <fstream>
+
+#include "MeshCache.h"
+#include "MeshOptimizer.h"
+#include "TextMeshParser.h"
+
+namespace common
+{
+	namespace
+	{
+		enum { SECTION_ALIGNMENT = 16 };
+
+		inline UINT64 alignSection(UINT64 offset)
+		{
+			return (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+		}
+
+		// BVH      ְ,  ﰢ  ε  ﰢ  ƾ Ѵ.
+		bool isValidBvhSections(const MeshCache::Header& header)
+		{
+			const MeshCache::SectionRange* sections = header.Sections;
+			const UINT64 triangleCount = header.IndexCount / 3;
+
+			if (sections[MeshCache::SECTION_BVH_NODES].Size != static_cast<UINT64>(header.BvhNodeCount) * sizeof(BvhNode))
+			{
+				return false;
+			}
+
+			if (header.BvhNodeCount == 0)
+			{
+				return sections[MeshCache::SECTION_BVH_TRIANGLES].Size == 0 && sections[MeshCache::SECTION_BVH_TRIANGLE_INDICES].Size == 0;
+			}
+
+			return sections[MeshCache::SECTION_BVH_TRIANGLES].Size == triangleCount * sizeof(BvhTriangle)
+				&& sections[MeshCache::SECTION_BVH_TRIANGLE_INDICES].Size == triangleCount * sizeof(UINT);
+		}
+
+		bool isValidIndices(const UINT* indices, UINT indexCount, UINT vertexCount)
+		{
+			for (UINT i = 0; i < indexCount; ++i)
+			{
+				if (indices[i] >= vertexCount)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		// ڽ θ𺸴 ڿ ־ ϰ(Bvh::Build  ), ̴ ȸ  ̾ Ѵ.
+		bool isValidBvhNodes(const BvhNode* nodes, UINT nodeCount, const UINT* triangleIndices, UINT triangleCount)
+		{
+			std::vector<BYTE> depths(nodeCount, 0);
+
+			for (UINT i = 0; i < nodeCount; ++i)
+			{
+				const BvhNode& node = nodes[i];
+
+				if (node.TriangleCount > 0)
+				{
+					if (node.LeftFirst > triangleCount || node.TriangleCount > triangleCount - node.LeftFirst)
+					{
+						return false;
+					}
+				}
+				else
+				{
+					if (node.LeftFirst <= i || node.LeftFirst >= nodeCount - 1 || depths[i] >= Bvh::MAX_DEPTH)
+					{
+						return false;
+					}
+
+					depths[node.LeftFirst] = depths[i] + 1;
+					depths[node.LeftFirst + 1] = depths[i] + 1;
+				}
+			}
+
+			for (UINT i = 0; i < triangleCount; ++i)
+			{
+				if (triangleIndices[i] >= triangleCount)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		//   false
+		bool getLastWriteTime(const std::string& fileName, UINT64* outTime)
+		{
+			WIN32_FILE_ATTRIBUTE_DATA data;
+
+			if (!GetFileAttributesExA(fileName.c_str(), GetFileExInfoStandard, &data))
+			{
+				return false;
+			}
+
+			*outTime = (static_cast<UINT64>(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+			return true;
+		}
+	}
+
+	MeshCache::MeshCache()
+		: mFile(INVALID_HANDLE_VALUE)
+		, mMapping(NULL)
+		, mData(nullptr)
+		, mSize(0)
+		, mHeader(nullptr)
+	{
+	}
+	MeshCache::~MeshCache()
+	{
+		Close();
+	}
+
+	bool MeshCache::Load(const std::string& textFileName, JobSystem* jobSystem)
+	{
+		const std::string cacheFileName = GetCacheFileName(textFileName);
+
+		UINT64 textTime = 0;
+		UINT64 cacheTime = 0;
+		const bool bHasText = getLastWriteTime(textFileName, &textTime);
+		const bool bHasCache = getLastWriteTime(cacheFileName, &cacheTime);
+
+		// ؽƮ ĳú ο ĳø .
+		if (bHasCache && (!bHasText || cacheTime >= textTime) && Open(cacheFileName))
+		{
+			return true;
+		}
+
+		std::vector<MeshVertex> vertices;
+		std::vector<UINT> indices;
+
+		if (!TextMeshParser::Load(textFileName, &vertices, &indices, jobSystem))
+		{
+			return false;
+		}
+
+		// ĳÿ  ĳÿ ġ  ġ ޽ø ´.   ϸ ǹǷ ε  ù ࿡ .
+		MeshOptimizer::Optimize(vertices.data(), static_cast<UINT>(vertices.size()), indices.data(), indices.size(), &MeshVertex::Pos);
+
+		std::vector<BYTE> image;
+		serialize(vertices, indices, nullptr, 0, nullptr, &image);
+
+		// ĳø  Ѵ.    ġ ޸𸮿  ̹ ״ .
+		if (writeImage(cacheFileName, image) && Open(cacheFileName))
+		{
+			return true;
+		}
+
+		mImage.swap(image);
+		return attach(mImage.data(), mImage.size());
+	}
+	bool MeshCache::Open(const std::string& cacheFileName)
+	{
+		Close();
+
+		mFile = CreateFileA(cacheFileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (mFile == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(mFile, &fileSize) || static_cast<UINT64>(fileSize.QuadPart) < sizeof(Header))
+		{
+			Close();
+			return false;
+		}
+
+		mMapping = CreateFileMappingA(mFile, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mMapping == NULL)
+		{
+			Close();
+			return false;
+		}
+
+		mData = static_cast<const BYTE*>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+		if (mData == nullptr)
+		{
+			Close();
+			return false;
+		}
+
+		if (!attach(mData, static_cast<UINT64>(fileSize.QuadPart)))
+		{
+			Close();
+			return false;
+		}
+
+		return true;
+	}
+	void MeshCache::Close()
+	{
+		// mData mImage ų   .
+		if (mMapping != NULL)
+		{
+			if (mData != nullptr)
+			{
+				UnmapViewOfFile(mData);
+			}
+			CloseHandle(mMapping);
+			mMapping = NULL;
+		}
+		if (mFile != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(mFile);
+			mFile = INVALID_HANDLE_VALUE;
+		}
+
+		mImage.clear();
+		mData = nullptr;
+		mSize = 0;
+		mHeader = nullptr;
+	}
+
+	bool MeshCache::GetBvh(Bvh* outBvh) const
+	{
+		//  ũ  attach ̹ ˻ߴ.
+		if (mHeader->BvhNodeCount == 0)
+		{
+			return false;
+		}
+
+		const UINT triangleCount = mHeader->IndexCount / 3;
+
+		outBvh->Assign(
+			static_cast<const BvhNode*>(getSection(SECTION_BVH_NODES)),
+			mHeader->BvhNodeCount,
+			static_cast<const BvhTriangle*>(getSection(SECTION_BVH_TRIANGLES)),
+			static_cast<const UINT*>(getSection(SECTION_BVH_TRIANGLE_INDICES)),
+			triangleCount);
+
+		return true;
+	}
+
+	bool MeshCache::Write(const std::string& cacheFileName,
+		const std::vector<MeshVertex>& vertices,
+		const std::vector<UINT>& indices,
+		const std::vector<float>* ambientAccess,
+		const AmbientBakeKey* ambientKey,
+		const Bvh* bvh)
+	{
+		std::vector<BYTE> image;
+		serialize(vertices, indices, ambientAccess, ambientKey, bvh, &image);
+
+		return writeImage(cacheFileName, image);
+	}
+	std::string MeshCache::GetCacheFileName(const std::string& textFileName)
+	{
+		size_t dot = textFileName.find_last_of('.');
+		size_t slash = textFileName.find_last_of("/\\");
+
+		// Ȯڰ  ׳ δ.
+		if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+		{
+			return textFileName + ".mesh";
+		}
+
+		return textFileName.substr(0, dot) + ".mesh";
+	}
+
+	bool MeshCache::attach(const BYTE* data, UINT64 size)
+	{
+		if (size < sizeof(Header))
+		{
+			return false;
+		}
+
+		//    ˻Ѵ.   ĳø ٽ 鵵 и ش.
+		const Header* header = reinterpret_cast<const Header*>(data);
+		bool bValid = header->Magic == MAGIC && header->Version == VERSION;
+
+		for (int i = 0; bValid && i < SECTION_COUNT; ++i)
+		{
+			const SectionRange& range = header->Sections[i];
+			bValid = range.Offset % SECTION_ALIGNMENT == 0 && range.Offset <= size && range.Size <= size - range.Offset;
+		}
+
+		bValid = bValid
+			&& header->Sections[SECTION_VERTICES].Size == static_cast<UINT64>(header->VertexCount) * sizeof(MeshVertex)
+			&& header->Sections[SECTION_INDICES].Size == static_cast<UINT64>(header->IndexCount) * sizeof(UINT)
+			&& (header->Sections[SECTION_AMBIENT_ACCESS].Size == 0
+				|| header->Sections[SECTION_AMBIENT_ACCESS].Size == static_cast<UINT64>(header->VertexCount) * sizeof(float))
+			&& header->IndexCount % 3 == 0
+			&& isValidBvhSections(*header);
+
+		// ε BVH , ﰢ 迭  Ű ׸  ȸ   Ƿ  .
+		bValid = bValid
+			&& isValidIndices(reinterpret_cast<const UINT*>(data + header->Sections[SECTION_INDICES].Offset), header->IndexCount, header->VertexCount)
+			&& (header->BvhNodeCount == 0 || isValidBvhNodes(reinterpret_cast<const BvhNode*>(data + header->Sections[SECTION_BVH_NODES].Offset),
+				header->BvhNodeCount,
+				reinterpret_cast<const UINT*>(data + header->Sections[SECTION_BVH_TRIANGLE_INDICES].Offset),
+				header->IndexCount / 3));
+
+		if (!bValid)
+		{
+			return false;
+		}
+
+		mData = data;
+		mSize = size;
+		mHeader = header;
+		return true;
+	}
+	const void* MeshCache::getSection(Section section) const
+	{
+		const SectionRange& range = mHeader->Sections[section];
+		return range.Size > 0 ? mData + range.Offset : nullptr;
+	}
+
+	void MeshCache::serialize(const std::vector<MeshVertex>& vertices,
+		const std::vector<UINT>& indices,
+		const std::vector<float>* ambientAccess,
+		const AmbientBakeKey* ambientKey,
+		const Bvh* bvh,
+		std::vector<BYTE>* outImage)
+	{
+		assert(ambientAccess == nullptr || (ambientAccess->size() == vertices.size() && ambientKey != nullptr));
+
+		Header header = {};
+		header.Magic = MAGIC;
+		header.Version = VERSION;
+		header.VertexCount = static_cast<UINT>(vertices.size());
+		header.IndexCount = static_cast<UINT>(indices.size());
+		if (ambientAccess != nullptr)
+		{
+			header.AmbientKey = *ambientKey;
+		}
+		header.BvhNodeCount = bvh != nullptr ? static_cast<UINT>(bvh->GetNodes().size()) : 0;
+
+		Vector3 boundsMin(+MathHelper::Infinity, +MathHelper::Infinity, +MathHelper::Infinity);
+		Vector3 boundsMax(-MathHelper::Infinity, -MathHelper::Infinity, -MathHelper::Infinity);
+		for (const MeshVertex& vertex : vertices)
+		{
+			boundsMin = Vector3::Min(boundsMin, vertex.Pos);
+			boundsMax = Vector3::Max(boundsMax, vertex.Pos);
+		}
+		header.BoundsMin = vertices.empty() ? Vector3::Zero : boundsMin;
+		header.BoundsMax = vertices.empty() ? Vector3::Zero : boundsMax;
+
+		const void* sectionData[SECTION_COUNT] = {};
+		sectionData[SECTION_VERTICES] = vertices.data();
+		header.Sections[SECTION_VERTICES].Size = vertices.size() * sizeof(MeshVertex);
+		sectionData[SECTION_INDICES] = indices.data();
+		header.Sections[SECTION_INDICES].Size = indices.size() * sizeof(UINT);
+
+		if (ambientAccess != nullptr)
+		{
+			sectionData[SECTION_AMBIENT_ACCESS] = ambientAccess->data();
+			header.Sections[SECTION_AMBIENT_ACCESS].Size = ambientAccess->size() * sizeof(float);
+		}
+
+		if (bvh != nullptr)
+		{
+			sectionData[SECTION_BVH_NODES] = bvh->GetNodes().data();
+			header.Sections[SECTION_BVH_NODES].Size = bvh->GetNodes().size() * sizeof(BvhNode);
+			sectionData[SECTION_BVH_TRIANGLES] = bvh->GetTriangles().data();
+			header.Sections[SECTION_BVH_TRIANGLES].Size = bvh->GetTriangles().size() * sizeof(BvhTriangle);
+			sectionData[SECTION_BVH_TRIANGLE_INDICES] = bvh->GetTriangleIndices().data();
+			header.Sections[SECTION_BVH_TRIANGLE_INDICES].Size = bvh->GetTriangleIndices().size() * sizeof(UINT);
+		}
+
+		UINT64 offset = alignSection(sizeof(Header));
+		for (int i = 0; i < SECTION_COUNT; ++i)
+		{
+			header.Sections[i].Offset = offset;
+			offset = alignSection(offset + header.Sections[i].Size);
+		}
+
+		//     0 ä.
+		std::vector<BYTE>& image = *outImage;
+		image.assign(static_cast<size_t>(offset), 0);
+		memcpy(image.data(), &header, sizeof(Header));
+
+		for (int i = 0; i < SECTION_COUNT; ++i)
+		{
+			if (header.Sections[i].Size > 0)
+			{
+				memcpy(image.data() + header.Sections[i].Offset, sectionData[i], static_cast<size_t>(header.Sections[i].Size));
+			}
+		}
+	}
+	bool MeshCache::writeImage(const std::string& cacheFileName, const std::vector<BYTE>& image)
+	{
+		std::ofstream fout(cacheFileName, std::ios_base::binary | std::ios_base::trunc);
+
+		if (!fout)
+		{
+			return false;
+		}
+
+		fout.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+		return !fout.fail();
+	}
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <DirectXCollision.h>
+#include <directxtk/SimpleMath.h>
+#include <string>
+#include <vector>
+
+#include "Bvh.h"
+#include "TextMeshParser.h"
+
+namespace common
+{
+	using namespace DirectX;
+	using namespace DirectX::SimpleMath;
+
+	// ̳ʸ ޽ ĳ (.mesh)
+	//  ڿ (section) 16Ʈ ķ پ ְ,  ° ޸𸮿    д´.
+	// ؽƮ (.txt) ó    ĳø , ķδ ĳø Ѵ.
+	class MeshCache
+	{
+	public:
+		enum { MAGIC = 0x4853454d }; // "MESH"
+		enum { VERSION = 3 }; // 2: ġ ޽, 3: ֺ  Ű
+
+		enum Section
+		{
+			SECTION_VERTICES,
+			SECTION_INDICES,
+			SECTION_AMBIENT_ACCESS, //  ֺ ޵, 
+			SECTION_BVH_NODES, // 
+			SECTION_BVH_TRIANGLES, // 
+			SECTION_BVH_TRIANGLE_INDICES, // 
+			SECTION_COUNT
+		};
+
+		struct SectionRange
+		{
+			UINT64 Offset;
+			UINT64 Size;
+		};
+
+		// ֺ ޵  ,   ƾ   ٽ   ִ.
+		struct AmbientBakeKey
+		{
+			UINT SampleCount;
+			UINT Seed;
+			UINT Algorithm; // AmbientOcclusionBaker::ALGORITHM_VERSION
+		};
+
+		struct Header
+		{
+			UINT Magic;
+			UINT Version;
+			UINT VertexCount;
+			UINT IndexCount;
+			Vector3 BoundsMin;
+			Vector3 BoundsMax;
+			AmbientBakeKey AmbientKey; // ֺ ޵   0
+			UINT BvhNodeCount;
+			SectionRange Sections[SECTION_COUNT];
+		};
+
+	public:
+		MeshCache();
+		~MeshCache();
+		MeshCache(const MeshCache&) = delete;
+		MeshCache& operator=(const MeshCache&) = delete;
+
+		// textFileName  ĳø Ѵ. ĳð ų, ų, ؽƮ  ؽƮ о ĳø ٽ .
+		// ؽƮ   jobSystem  TextMeshParser ûũ  д´.
+		bool Load(const std::string& textFileName, JobSystem* jobSystem = nullptr);
+		// ĳ ϸ Ѵ.
+		bool Open(const std::string& cacheFileName);
+		void Close();
+
+		// ε ͸ BVH ´. ĳÿ BVH  false
+		bool GetBvh(Bvh* outBvh) const;
+
+		inline bool IsOpen() const;
+		inline UINT GetVertexCount() const;
+		inline UINT GetIndexCount() const;
+		inline const MeshVertex* GetVertices() const;
+		inline const UINT* GetIndices() const;
+		inline BoundingBox GetBounds() const;
+		inline const float* GetAmbientAccess() const; //  nullptr
+		inline const AmbientBakeKey& GetAmbientKey() const;
+
+		// ambientAccess bvh  nullptr, ambientKey ambientAccess   .
+		static bool Write(const std::string& cacheFileName,
+			const std::vector<MeshVertex>& vertices,
+			const std::vector<UINT>& indices,
+			const std::vector<float>* ambientAccess = nullptr,
+			const AmbientBakeKey* ambientKey = nullptr,
+			const Bvh* bvh = nullptr);
+		// skull.txt -> skull.mesh
+		static std::string GetCacheFileName(const std::string& textFileName);
+
+	private:
+		bool attach(const BYTE* data, UINT64 size);
+		const void* getSection(Section section) const;
+
+		static void serialize(const std::vector<MeshVertex>& vertices,
+			const std::vector<UINT>& indices,
+			const std::vector<float>* ambientAccess,
+			const AmbientBakeKey* ambientKey,
+			const Bvh* bvh,
+			std::vector<BYTE>* outImage);
+		static bool writeImage(const std::string& cacheFileName, const std::vector<BYTE>& image);
+
+	private:
+		HANDLE mFile;
+		HANDLE mMapping;
+		const BYTE* mData; //   Ǵ mImage
+		UINT64 mSize;
+		const Header* mHeader;
+		std::vector<BYTE> mImage; // ĳ       ޸ ̹
+	};
+
+	bool MeshCache::IsOpen() const
+	{
+		return mHeader != nullptr;
+	}
+	UINT MeshCache::GetVertexCount() const
+	{
+		return mHeader->VertexCount;
+	}
+	UINT MeshCache::GetIndexCount() const
+	{
+		return mHeader->IndexCount;
+	}
+	const MeshVertex* MeshCache::GetVertices() const
+	{
+		return static_cast<const MeshVertex*>(getSection(SECTION_VERTICES));
+	}
+	const UINT* MeshCache::GetIndices() const
+	{
+		return static_cast<const UINT*>(getSection(SECTION_INDICES));
+	}
+	BoundingBox MeshCache::GetBounds() const
+	{
+		BoundingBox bounds;
+		bounds.Center = 0.5f * (mHeader->BoundsMin + mHeader->BoundsMax);
+		bounds.Extents = 0.5f * (mHeader->BoundsMax - mHeader->BoundsMin);
+		return bounds;
+	}
+	const float* MeshCache::GetAmbientAccess() const
+	{
+		return static_cast<const float*>(getSection(SECTION_AMBIENT_ACCESS));
+	}
+	const MeshCache::AmbientBakeKey& MeshCache::GetAmbientKey() const
+	{
+		return mHeader->AmbientKey;
+	}
+}
@@ -0,0 +1,482 @@
+#include "pch.h"
+
+#include <algorithm>
+
+#include "MeshOptimizer.h"
+
+namespace common
+{
+	using namespace DirectX::SimpleMath;
+
+	namespace
+	{
+		enum { MAX_VALENCE_SCORE = 32 }; // ̺ ū     .
+		enum { INVALID_INDEX = 0xFFFFFFFF };
+
+		// Forsyth, "Linear-Speed Vertex Cache Optimisation"  
+		const float CACHE_DECAY_POWER = 1.5f;
+		const float LAST_TRIANGLE_SCORE = 0.75f;
+		const float VALENCE_BOOST_SCALE = 2.0f;
+		const float VALENCE_BOOST_POWER = 0.5f;
+
+		// ĳ ġ     ̸  д.
+		struct VertexScoreTable
+		{
+			float Cache[MeshOptimizer::VERTEX_CACHE_SIZE];
+			float Valence[MAX_VALENCE_SCORE + 1];
+
+			VertexScoreTable()
+			{
+				for (int i = 0; i < MeshOptimizer::VERTEX_CACHE_SIZE; ++i)
+				{
+					if (i < 3)
+					{
+						//   ﰢ   ﰢ   ʵ   ش.
+						Cache[i] = LAST_TRIANGLE_SCORE;
+					}
+					else
+					{
+						const float scaler = 1.0f / (MeshOptimizer::VERTEX_CACHE_SIZE - 3);
+						Cache[i] = powf(1.0f - (i - 3) * scaler, CACHE_DECAY_POWER);
+					}
+				}
+
+				Valence[0] = 0.0f;
+				for (int i = 1; i <= MAX_VALENCE_SCORE; ++i)
+				{
+					//  ﰢ      ﰢ  ʰ Ѵ.
+					Valence[i] = VALENCE_BOOST_SCALE * powf(static_cast<float>(i), -VALENCE_BOOST_POWER);
+				}
+			}
+
+			inline float GetScore(int cachePosition, UINT remainingValence) const
+			{
+				if (remainingValence == 0)
+				{
+					return 0.0f;
+				}
+
+				const float cacheScore = cachePosition >= 0 ? Cache[cachePosition] : 0.0f;
+				return cacheScore + Valence[std::min<UINT>(remainingValence, MAX_VALENCE_SCORE)];
+			}
+		};
+
+		//    ð ϴ FIFO ĳ,   cacheSize ̽  з.
+		class FifoCache
+		{
+		public:
+			FifoCache(UINT vertexCount, UINT cacheSize)
+				: mTimestamps(vertexCount, 0)
+				, mTime(cacheSize + 1)
+				, mCacheSize(cacheSize)
+			{
+			}
+
+			// ̽ true
+			inline bool Access(UINT vertex)
+			{
+				if (mTime - mTimestamps[vertex] > mCacheSize)
+				{
+					mTimestamps[vertex] = mTime++;
+					return true;
+				}
+				return false;
+			}
+			inline void Flush()
+			{
+				mTime += mCacheSize + 1;
+			}
+
+		private:
+			std::vector<UINT> mTimestamps;
+			UINT mTime;
+			UINT mCacheSize;
+		};
+
+		inline const float* getPosition(const float* positions, size_t positionStride, UINT vertex)
+		{
+			return reinterpret_cast<const float*>(reinterpret_cast<const BYTE*>(positions) + positionStride * vertex);
+		}
+	}
+
+	void MeshOptimizer::OptimizeVertexCache(UINT* indices, size_t indexCount, UINT vertexCount)
+	{
+		static const VertexScoreTable scoreTable;
+
+		const UINT triangleCount = static_cast<UINT>(indexCount / 3);
+		if (triangleCount == 0)
+		{
+			return;
+		}
+
+		//   ﰢ ,  ﰢ      .
+		std::vector<UINT> remainingValence(vertexCount, 0);
+		for (size_t i = 0; i < triangleCount * 3; ++i)
+		{
+			++remainingValence[indices[i]];
+		}
+
+		std::vector<UINT> adjacencyOffsets(vertexCount + 1, 0);
+		for (UINT i = 0; i < vertexCount; ++i)
+		{
+			adjacencyOffsets[i + 1] = adjacencyOffsets[i] + remainingValence[i];
+		}
+
+		std::vector<UINT> adjacency(triangleCount * 3);
+		{
+			std::vector<UINT> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+			for (UINT i = 0; i < triangleCount; ++i)
+			{
+				for (UINT k = 0; k < 3; ++k)
+				{
+					adjacency[fill[indices[i * 3 + k]]++] = i;
+				}
+			}
+		}
+
+		std::vector<float> vertexScores(vertexCount);
+		for (UINT i = 0; i < vertexCount; ++i)
+		{
+			vertexScores[i] = scoreTable.GetScore(-1, remainingValence[i]);
+		}
+
+		std::vector<float> triangleScores(triangleCount);
+		std::vector<char> bEmitted(triangleCount, 0);
+		UINT bestTriangle = 0;
+		for (UINT i = 0; i < triangleCount; ++i)
+		{
+			const UINT* triangle = &indices[i * 3];
+			triangleScores[i] = vertexScores[triangle[0]] + vertexScores[triangle[1]] + vertexScores[triangle[2]];
+
+			if (triangleScores[i] > triangleScores[bestTriangle])
+			{
+				bestTriangle = i;
+			}
+		}
+
+		std::vector<UINT> result(triangleCount * 3);
+		UINT cache[VERTEX_CACHE_SIZE + 3];
+		UINT newCache[VERTEX_CACHE_SIZE + 3];
+		UINT cacheCount = 0;
+		UINT inputCursor = 0;
+
+		for (UINT outTriangle = 0; outTriangle < triangleCount; ++outTriangle)
+		{
+			// ĳ ֺ  ﰢ  Է     ﰢ .
+			if (bestTriangle == INVALID_INDEX)
+			{
+				while (bEmitted[inputCursor])
+				{
+					++inputCursor;
+				}
+				bestTriangle = inputCursor;
+			}
+
+			const UINT* triangle = &indices[bestTriangle * 3];
+			result[outTriangle * 3 + 0] = triangle[0];
+			result[outTriangle * 3 + 1] = triangle[1];
+			result[outTriangle * 3 + 2] = triangle[2];
+			bEmitted[bestTriangle] = 1;
+
+			//  Ͽ  ﰢ .
+			for (UINT k = 0; k < 3; ++k)
+			{
+				const UINT vertex = triangle[k];
+				UINT* neighbors = &adjacency[adjacencyOffsets[vertex]];
+				const UINT count = remainingValence[vertex];
+
+				for (UINT j = 0; j < count; ++j)
+				{
+					if (neighbors[j] == bestTriangle)
+					{
+						std::swap(neighbors[j], neighbors[count - 1]);
+						--remainingValence[vertex];
+						break;
+					}
+				}
+			}
+
+			// ﰢ  LRU ĳ  տ ִ´.
+			UINT newCacheCount = 0;
+			for (UINT k = 0; k < 3; ++k)
+			{
+				const UINT vertex = triangle[k];
+				if (std::find(newCache, newCache + newCacheCount, vertex) == newCache + newCacheCount)
+				{
+					newCache[newCacheCount++] = vertex;
+				}
+			}
+			for (UINT i = 0; i < cacheCount; ++i)
+			{
+				const UINT vertex = cache[i];
+				if (std::find(newCache, newCache + newCacheCount, vertex) == newCache + newCacheCount)
+				{
+					newCache[newCacheCount++] = vertex;
+				}
+			}
+
+			// ĳ ġ ٲ   ȭ  ﰢ  ݿѴ. з  Ѵ.
+			for (UINT i = 0; i < newCacheCount; ++i)
+			{
+				const UINT vertex = newCache[i];
+				const int cachePosition = i < VERTEX_CACHE_SIZE ? static_cast<int>(i) : -1;
+
+				const float score = scoreTable.GetScore(cachePosition, remainingValence[vertex]);
+				const float delta = score - vertexScores[vertex];
+				vertexScores[vertex] = score;
+
+				const UINT* neighbors = &adjacency[adjacencyOffsets[vertex]];
+				for (UINT j = 0; j < remainingValence[vertex]; ++j)
+				{
+					triangleScores[neighbors[j]] += delta;
+				}
+			}
+
+			cacheCount = std::min<UINT>(newCacheCount, VERTEX_CACHE_SIZE);
+			std::copy(newCache, newCache + cacheCount, cache);
+
+			//  ﰢ ĳÿ ִ   ﰢ ߿ .
+			bestTriangle = INVALID_INDEX;
+			float bestScore = -1.0f;
+			for (UINT i = 0; i < cacheCount; ++i)
+			{
+				const UINT vertex = cache[i];
+				const UINT* neighbors = &adjacency[adjacencyOffsets[vertex]];
+
+				for (UINT j = 0; j < remainingValence[vertex]; ++j)
+				{
+					const UINT candidate = neighbors[j];
+					if (triangleScores[candidate] > bestScore)
+					{
+						bestScore = triangleScores[candidate];
+						bestTriangle = candidate;
+					}
+				}
+			}
+		}
+
+		std::copy(result.begin(), result.end(), indices);
+	}
+
+	void MeshOptimizer::OptimizeOverdraw(UINT* indices, size_t indexCount,
+		const float* positions, size_t positionStride, UINT vertexCount, float threshold)
+	{
+		const UINT triangleCount = static_cast<UINT>(indexCount / 3);
+		if (triangleCount == 0)
+		{
+			return;
+		}
+
+		// 1. ĳð   (   ̽)  ϵ 
+		std::vector<UINT> hardClusters;
+		{
+			FifoCache cache(vertexCount, FIFO_CACHE_SIZE);
+
+			for (UINT i = 0; i < triangleCount; ++i)
+			{
+				const UINT misses = (cache.Access(indices[i * 3 + 0]) ? 1 : 0)
+					+ (cache.Access(indices[i * 3 + 1]) ? 1 : 0)
+					+ (cache.Access(indices[i * 3 + 2]) ? 1 : 0);
+
+				if (i == 0 || misses == 3)
+				{
+					hardClusters.push_back(i);
+				}
+			}
+		}
+
+		// 2. ϵ Ŭ ȿ  ACMR Ŭ ACMR * threshold Ʒ    .
+		std::vector<UINT> clusters;
+		{
+			FifoCache cache(vertexCount, FIFO_CACHE_SIZE);
+
+			for (size_t c = 0; c < hardClusters.size(); ++c)
+			{
+				const UINT begin = hardClusters[c];
+				const UINT end = c + 1 < hardClusters.size() ? hardClusters[c + 1] : triangleCount;
+
+				cache.Flush();
+				UINT clusterMisses = 0;
+				for (UINT i = begin; i < end; ++i)
+				{
+					for (UINT k = 0; k < 3; ++k)
+					{
+						clusterMisses += cache.Access(indices[i * 3 + k]) ? 1 : 0;
+					}
+				}
+
+				const float clusterThreshold = threshold * clusterMisses / (end - begin);
+
+				cache.Flush();
+				clusters.push_back(begin);
+				UINT start = begin;
+				UINT misses = 0;
+				for (UINT i = begin; i < end; ++i)
+				{
+					for (UINT k = 0; k < 3; ++k)
+					{
+						misses += cache.Access(indices[i * 3 + k]) ? 1 : 0;
+					}
+
+					if (i + 1 < end && static_cast<float>(misses) / (i + 1 - start) <= clusterThreshold)
+					{
+						clusters.push_back(i + 1);
+						start = i + 1;
+						misses = 0;
+						cache.Flush();
+					}
+				}
+			}
+		}
+
+		// 3. Ŭ͸ ޽ ߽ɿ ٱ ϴ   ٱ(տ  ɼ ū)  ׸.
+		Vector3 meshCentroid = Vector3::Zero;
+		for (UINT i = 0; i < triangleCount * 3; ++i)
+		{
+			const float* p = getPosition(positions, positionStride, indices[i]);
+			meshCentroid += Vector3(p[0], p[1], p[2]);
+		}
+		meshCentroid /= static_cast<float>(triangleCount * 3);
+
+		const UINT clusterCount = static_cast<UINT>(clusters.size());
+		std::vector<float> sortKeys(clusterCount);
+		for (UINT c = 0; c < clusterCount; ++c)
+		{
+			const UINT begin = clusters[c];
+			const UINT end = c + 1 < clusterCount ? clusters[c + 1] : triangleCount;
+
+			Vector3 centroid = Vector3::Zero;
+			Vector3 normal = Vector3::Zero;
+			float area = 0.0f;
+
+			for (UINT i = begin; i < end; ++i)
+			{
+				const float* p0 = getPosition(positions, positionStride, indices[i * 3 + 0]);
+				const float* p1 = getPosition(positions, positionStride, indices[i * 3 + 1]);
+				const float* p2 = getPosition(positions, positionStride, indices[i * 3 + 2]);
+				const Vector3 v0(p0[0], p0[1], p0[2]);
+				const Vector3 v1(p1[0], p1[1], p1[2]);
+				const Vector3 v2(p2[0], p2[1], p2[2]);
+
+				//  ̴   , ̷  ߽ɰ 
+				const Vector3 cross = (v1 - v0).Cross(v2 - v0);
+				const float triangleArea = cross.Length();
+
+				centroid += (v0 + v1 + v2) * (triangleArea / 3.0f);
+				normal += cross;
+				area += triangleArea;
+			}
+
+			const float normalLength = normal.Length();
+			if (area > 0.0f && normalLength > 0.0f)
+			{
+				centroid /= area;
+				sortKeys[c] = (centroid - meshCentroid).Dot(normal / normalLength);
+			}
+			else
+			{
+				sortKeys[c] = 0.0f;
+			}
+		}
+
+		std::vector<UINT> order(clusterCount);
+		for (UINT c = 0; c < clusterCount; ++c)
+		{
+			order[c] = c;
+		}
+		std::stable_sort(order.begin(), order.end(), [&sortKeys](UINT a, UINT b) { return sortKeys[a] > sortKeys[b]; });
+
+		std::vector<UINT> result;
+		result.reserve(triangleCount * 3);
+		for (UINT c : order)
+		{
+			const UINT begin = clusters[c];
+			const UINT end = c + 1 < clusterCount ? clusters[c + 1] : triangleCount;
+			result.insert(result.end(), indices + begin * 3, indices + end * 3);
+		}
+
+		std::copy(result.begin(), result.end(), indices);
+	}
+
+	UINT MeshOptimizer::BuildVertexFetchRemap(const UINT* indices, size_t indexCount, UINT vertexCount, std::vector<UINT>* outRemap)
+	{
+		std::vector<UINT>& remap = *outRemap;
+		remap.assign(vertexCount, INVALID_INDEX);
+
+		UINT next = 0;
+		for (size_t i = 0; i < indexCount; ++i)
+		{
+			if (remap[indices[i]] == INVALID_INDEX)
+			{
+				remap[indices[i]] = next++;
+			}
+		}
+
+		const UINT referencedCount = next;
+		for (UINT i = 0; i < vertexCount; ++i)
+		{
+			if (remap[i] == INVALID_INDEX)
+			{
+				remap[i] = next++;
+			}
+		}
+
+		return referencedCount;
+	}
+
+	VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(const UINT* indices, size_t indexCount, UINT vertexCount,
+		eCacheModel cacheModel, UINT cacheSize)
+	{
+		UINT misses = 0;
+
+		if (cacheModel == CACHE_MODEL_FIFO)
+		{
+			FifoCache cache(vertexCount, cacheSize);
+
+			for (size_t i = 0; i < indexCount; ++i)
+			{
+				misses += cache.Access(indices[i]) ? 1 : 0;
+			}
+		}
+		else
+		{
+			// ϸ   ű LRU
+			std::vector<UINT> cache;
+			cache.reserve(cacheSize + 1);
+
+			for (size_t i = 0; i < indexCount; ++i)
+			{
+				auto found = std::find(cache.begin(), cache.end(), indices[i]);
+
+				if (found == cache.end())
+				{
+					++misses;
+					cache.insert(cache.begin(), indices[i]);
+
+					if (cache.size() > cacheSize)
+					{
+						cache.pop_back();
+					}
+				}
+				else
+				{
+					std::rotate(cache.begin(), found, found + 1);
+				}
+			}
+		}
+
+		std::vector<char> bReferenced(vertexCount, 0);
+		UINT referencedCount = 0;
+		for (size_t i = 0; i < indexCount; ++i)
+		{
+			referencedCount += bReferenced[indices[i]] ? 0 : 1;
+			bReferenced[indices[i]] = 1;
+		}
+
+		VertexCacheStatistics statistics;
+		statistics.TransformedCount = misses;
+		statistics.Acmr = indexCount >= 3 ? static_cast<float>(misses) / (indexCount / 3) : 0.0f;
+		statistics.Atvr = referencedCount > 0 ? static_cast<float>(misses) / referencedCount : 0.0f;
+		return statistics;
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <vector>
+
+namespace common
+{
+	//  ĳ ùķ̼ 
+	// ACMR: ﰢ  ̴   (0.5 ~ 3), ATVR:    (1 )
+	struct VertexCacheStatistics
+	{
+		UINT TransformedCount;
+		float Acmr;
+		float Atvr;
+	};
+
+	// ε ޽ GPU ģȭ ġ
+	// 1. ﰢ : ȯ   ĳ ߷ (Forsyth  )
+	// 2. ﰢ : ĳ ȿ ũ ġ ʴ  Ŭ͸ ٱʺ ׷ θ δ. (Sander et al.)
+	// 3.  : ε ó ϴ   Ű  ġ  δ.
+	// ε [0, vertexCount)  ϸ, º   ȴ.
+	class MeshOptimizer
+	{
+	public:
+		enum { VERTEX_CACHE_SIZE = 32 }; // ȭ  ϴ LRU ĳ ũ
+		enum { FIFO_CACHE_SIZE = 16 }; // м  Ŭ͸    FIFO ĳ ũ
+
+		enum eCacheModel
+		{
+			CACHE_MODEL_FIFO,
+			CACHE_MODEL_LRU
+		};
+
+	public:
+		static void OptimizeVertexCache(UINT* indices, size_t indexCount, UINT vertexCount);
+		// ĳ ȭ  ε Ѵ. threshold ϴ ACMR   (1.05 5%)
+		static void OptimizeOverdraw(UINT* indices, size_t indexCount,
+			const float* positions, size_t positionStride, UINT vertexCount, float threshold);
+		// outRemap[old] = new,  ʴ    ڿ ٴ´.    ȯѴ.
+		static UINT BuildVertexFetchRemap(const UINT* indices, size_t indexCount, UINT vertexCount, std::vector<UINT>* outRemap);
+
+		static VertexCacheStatistics AnalyzeVertexCache(const UINT* indices, size_t indexCount, UINT vertexCount,
+			eCacheModel cacheModel = CACHE_MODEL_FIFO, UINT cacheSize = FIFO_CACHE_SIZE);
+
+		//  ܰ踦  Ѵ. overdrawThreshold 0̸  ܰ踦 ǳʶڴ.
+		// position   ġ  (float 3)
+		template <typename Vertex, typename Position>
+		static void Optimize(Vertex* vertices, UINT vertexCount, UINT* indices, size_t indexCount,
+			Position Vertex::* position, float overdrawThreshold = 0.0f);
+		template <typename Vertex>
+		static void RemapVertices(Vertex* vertices, UINT vertexCount, UINT* indices, size_t indexCount, const std::vector<UINT>& remap);
+	};
+
+	template <typename Vertex, typename Position>
+	void MeshOptimizer::Optimize(Vertex* vertices, UINT vertexCount, UINT* indices, size_t indexCount,
+		Position Vertex::* position, float overdrawThreshold)
+	{
+		static_assert(sizeof(Position) == 3 * sizeof(float), "position must be 3 floats");
+
+		if (vertexCount == 0 || indexCount < 3)
+		{
+			return;
+		}
+
+		OptimizeVertexCache(indices, indexCount, vertexCount);
+
+		if (overdrawThreshold > 0.0f)
+		{
+			const float* positions = reinterpret_cast<const float*>(&(vertices[0].*position));
+			OptimizeOverdraw(indices, indexCount, positions, sizeof(Vertex), vertexCount, overdrawThreshold);
+		}
+
+		std::vector<UINT> remap;
+		BuildVertexFetchRemap(indices, indexCount, vertexCount, &remap);
+		RemapVertices(vertices, vertexCount, indices, indexCount, remap);
+	}
+
+	template <typename Vertex>
+	void MeshOptimizer::RemapVertices(Vertex* vertices, UINT vertexCount, UINT* indices, size_t indexCount, const std::vector<UINT>& remap)
+	{
+		std::vector<Vertex> source(vertices, vertices + vertexCount);
+
+		for (UINT i = 0; i < vertexCount; ++i)
+		{
+			vertices[remap[i]] = source[i];
+		}
+
+		for (size_t i = 0; i < indexCount; ++i)
+		{
+			indices[i] = remap[indices[i]];
+		}
+	}
+}
@@ -0,0 +1,641 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+
+namespace common
+{
+	namespace
+	{
+		//     ġ, Ŭ     .
+		const double BORDER_WEIGHT = 10.0;
+		// LOD  ܰ谡 ﰢ     ϸ ü . (ǥ )
+		const float MIN_LOD_REDUCTION = 0.7f;
+		//   ѵ,   밢 ̿  
+		const float MAX_LOD_ERROR_RATIO = 0.05f;
+		// ܰ   ܰ    °     .
+		const float MAX_LOD_ERROR_GROWTH = 10.f;
+		enum { MIN_LOD_TRIANGLE_COUNT = 12 };
+
+		enum eVertexKind : BYTE
+		{
+			VERTEX_MANIFOLD, //  ̿ε ĥ  ִ.
+			VERTEX_BORDER, //  踦 󼭸 ĥ  ִ.
+			VERTEX_LOCKED // ų پü 𼭸,  ʴ´.
+		};
+
+		// Ī  A,  b,  c ǥ   Q(p) = pAp + 2bp + c, Weight    Ÿ .
+		struct Quadric
+		{
+			double A00, A11, A22;
+			double A01, A02, A12;
+			double B0, B1, B2;
+			double C;
+			double Weight;
+		};
+
+		struct Collapse
+		{
+			UINT From;
+			UINT To;
+			double Cost;
+		};
+
+		void addPlane(Quadric* quadric, const double normal[3], double distance, double weight)
+		{
+			const double a = normal[0];
+			const double b = normal[1];
+			const double c = normal[2];
+
+			quadric->A00 += weight * a * a;
+			quadric->A11 += weight * b * b;
+			quadric->A22 += weight * c * c;
+			quadric->A01 += weight * a * b;
+			quadric->A02 += weight * a * c;
+			quadric->A12 += weight * b * c;
+			quadric->B0 += weight * a * distance;
+			quadric->B1 += weight * b * distance;
+			quadric->B2 += weight * c * distance;
+			quadric->C += weight * distance * distance;
+			quadric->Weight += weight;
+		}
+
+		void addQuadric(Quadric* quadric, const Quadric& other)
+		{
+			quadric->A00 += other.A00;
+			quadric->A11 += other.A11;
+			quadric->A22 += other.A22;
+			quadric->A01 += other.A01;
+			quadric->A02 += other.A02;
+			quadric->A12 += other.A12;
+			quadric->B0 += other.B0;
+			quadric->B1 += other.B1;
+			quadric->B2 += other.B2;
+			quadric->C += other.C;
+			quadric->Weight += other.Weight;
+		}
+
+		double evaluate(const Quadric& quadric, const double p[3])
+		{
+			const double x = p[0];
+			const double y = p[1];
+			const double z = p[2];
+
+			const double result = quadric.A00 * x * x + quadric.A11 * y * y + quadric.A22 * z * z
+				+ 2.0 * (quadric.A01 * x * y + quadric.A02 * x * z + quadric.A12 * y * z)
+				+ 2.0 * (quadric.B0 * x + quadric.B1 * y + quadric.B2 * z)
+				+ quadric.C;
+
+			return result > 0.0 ? result : 0.0;
+		}
+
+		void cross(const double a[3], const double b[3], double out[3])
+		{
+			out[0] = a[1] * b[2] - a[2] * b[1];
+			out[1] = a[2] * b[0] - a[0] * b[2];
+			out[2] = a[0] * b[1] - a[1] * b[0];
+		}
+
+		double dot(const double a[3], const double b[3])
+		{
+			return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+		}
+
+		double normalize(double v[3])
+		{
+			const double length = sqrt(dot(v, v));
+			if (length > 0.0)
+			{
+				v[0] /= length;
+				v[1] /= length;
+				v[2] /= length;
+			}
+			return length;
+		}
+
+		unsigned long long edgeKey(UINT a, UINT b)
+		{
+			return (static_cast<unsigned long long>(a) << 32) | b;
+		}
+
+		class Simplifier
+		{
+		public:
+			Simplifier(const float* positions, size_t positionStride, UINT vertexCount,
+				const float* attributes, size_t attributeStride, const float* attributeWeights, UINT attributeCount)
+				: mPositions(vertexCount * 3)
+				, mAttributes(attributes)
+				, mAttributeStride(attributeStride)
+				, mAttributeCount(attributeCount)
+				, mVertexCount(vertexCount)
+				, mAttributeScale(0.0)
+			{
+				assert(attributeCount <= MeshSimplifier::MAX_ATTRIBUTE_COUNT);
+
+				for (UINT i = 0; i < vertexCount; ++i)
+				{
+					const float* p = reinterpret_cast<const float*>(reinterpret_cast<const BYTE*>(positions) + positionStride * i);
+					mPositions[i * 3 + 0] = p[0];
+					mPositions[i * 3 + 1] = p[1];
+					mPositions[i * 3 + 2] = p[2];
+				}
+
+				for (UINT i = 0; i < attributeCount; ++i)
+				{
+					mAttributeWeights[i] = attributeWeights != nullptr ? attributeWeights[i] : 0.f;
+				}
+			}
+
+			size_t Run(std::vector<UINT>* inoutIndices, size_t targetIndexCount, float maxError, float* outError)
+			{
+				std::vector<UINT>& indices = *inoutIndices;
+
+				classifyVertices(indices);
+				buildQuadrics(indices);
+
+				const double maxCost = static_cast<double>(maxError) * maxError;
+				double resultCost = 0.0;
+
+				std::vector<UINT> adjacencyOffsets;
+				std::vector<UINT> adjacency;
+				std::vector<Collapse> collapses;
+				std::vector<bool> bLocked(mVertexCount);
+				std::vector<UINT> remap(mVertexCount);
+
+				while (indices.size() > targetIndexCount)
+				{
+					buildAdjacency(indices, &adjacencyOffsets, &adjacency);
+
+					// 1. ĺ ر    
+					collapses.clear();
+					for (size_t i = 0; i < indices.size(); i += 3)
+					{
+						for (UINT k = 0; k < 3; ++k)
+						{
+							const UINT a = indices[i + k];
+							const UINT b = indices[i + (k + 1) % 3];
+
+							Collapse best = { a, b, DBL_MAX };
+							pickCheaper(a, b, indices, adjacencyOffsets, adjacency, &best);
+							pickCheaper(b, a, indices, adjacencyOffsets, adjacency, &best);
+
+							if (best.Cost <= maxCost)
+							{
+								collapses.push_back(best);
+							}
+						}
+					}
+
+					if (collapses.empty())
+					{
+						break;
+					}
+
+					std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b)
+						{
+							return a.Cost < b.Cost;
+						});
+
+					// 2.  ġ ʴ ر  ͺ Ѵ.
+					//   1- ᰡ  н ȿ ˻ ﰢ ٲ ʰ Ѵ.
+					std::fill(bLocked.begin(), bLocked.end(), false);
+					for (UINT i = 0; i < mVertexCount; ++i)
+					{
+						remap[i] = i;
+					}
+
+					const size_t triangleCount = indices.size() / 3;
+					const size_t targetTriangleCount = targetIndexCount / 3;
+					size_t removedCount = 0;
+					size_t collapseCount = 0;
+
+					for (const Collapse& collapse : collapses)
+					{
+						if (triangleCount - removedCount <= targetTriangleCount)
+						{
+							break;
+						}
+
+						const UINT from = collapse.From;
+						const UINT to = collapse.To;
+
+						if (bLocked[from] || bLocked[to] || hasFlip(from, to, indices, adjacencyOffsets, adjacency))
+						{
+							continue;
+						}
+
+						for (UINT j = adjacencyOffsets[from]; j < adjacencyOffsets[from + 1]; ++j)
+						{
+							const UINT* triangle = &indices[adjacency[j] * 3];
+							bLocked[triangle[0]] = true;
+							bLocked[triangle[1]] = true;
+							bLocked[triangle[2]] = true;
+							removedCount += (triangle[0] == to || triangle[1] == to || triangle[2] == to) ? 1 : 0;
+						}
+
+						remap[from] = to;
+						addQuadric(&mQuadrics[to], mQuadrics[from]);
+						resultCost = std::max<double>(resultCost, collapse.Cost);
+						++collapseCount;
+					}
+
+					if (collapseCount == 0)
+					{
+						break;
+					}
+
+					// 3. ε ű ȭ ﰢ .
+					size_t writeIndex = 0;
+					for (size_t i = 0; i < indices.size(); i += 3)
+					{
+						const UINT a = remap[indices[i + 0]];
+						const UINT b = remap[indices[i + 1]];
+						const UINT c = remap[indices[i + 2]];
+
+						if (a != b && b != c && c != a)
+						{
+							indices[writeIndex++] = a;
+							indices[writeIndex++] = b;
+							indices[writeIndex++] = c;
+						}
+					}
+					indices.resize(writeIndex);
+				}
+
+				*outError = static_cast<float>(sqrt(resultCost));
+
+				return indices.size();
+			}
+
+		private:
+			const double* position(UINT vertex) const
+			{
+				return &mPositions[vertex * 3];
+			}
+
+			const float* attribute(UINT vertex) const
+			{
+				return reinterpret_cast<const float*>(reinterpret_cast<const BYTE*>(mAttributes) + mAttributeStride * vertex);
+			}
+
+			void classifyVertices(const std::vector<UINT>& indices)
+			{
+				mKinds.assign(mVertexCount, VERTEX_MANIFOLD);
+
+				//  ִ 𼭸 , ݴ   ,    ̸̻ پü
+				std::unordered_map<unsigned long long, UINT> edgeCounts;
+				edgeCounts.reserve(indices.size() * 2);
+				for (size_t i = 0; i < indices.size(); i += 3)
+				{
+					for (UINT k = 0; k < 3; ++k)
+					{
+						++edgeCounts[edgeKey(indices[i + k], indices[i + (k + 1) % 3])];
+					}
+				}
+
+				for (const auto& edge : edgeCounts)
+				{
+					const UINT a = static_cast<UINT>(edge.first >> 32);
+					const UINT b = static_cast<UINT>(edge.first & 0xffffffff);
+
+					if (edge.second > 1)
+					{
+						mKinds[a] = VERTEX_LOCKED;
+						mKinds[b] = VERTEX_LOCKED;
+					}
+					else if (edgeCounts.find(edgeKey(b, a)) == edgeCounts.end())
+					{
+						mKinds[a] = mKinds[a] == VERTEX_LOCKED ? VERTEX_LOCKED : VERTEX_BORDER;
+						mKinds[b] = mKinds[b] == VERTEX_LOCKED ? VERTEX_LOCKED : VERTEX_BORDER;
+					}
+				}
+
+				// ġ   ̸ Ӽ ̹Ƿ ٴ.
+				std::vector<UINT> sorted(mVertexCount);
+				for (UINT i = 0; i < mVertexCount; ++i)
+				{
+					sorted[i] = i;
+				}
+
+				std::sort(sorted.begin(), sorted.end(), [this](UINT a, UINT b)
+					{
+						return memcmp(position(a), position(b), sizeof(double) * 3) < 0;
+					});
+
+				for (UINT i = 1; i < mVertexCount; ++i)
+				{
+					if (memcmp(position(sorted[i - 1]), position(sorted[i]), sizeof(double) * 3) == 0)
+					{
+						mKinds[sorted[i - 1]] = VERTEX_LOCKED;
+						mKinds[sorted[i]] = VERTEX_LOCKED;
+					}
+				}
+
+				// Ӽ Ÿ ޽ ũ⿡ .
+				double minimum[3] = { DBL_MAX, DBL_MAX, DBL_MAX };
+				double maximum[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+				for (size_t i = 0; i < indices.size(); ++i)
+				{
+					const double* p = position(indices[i]);
+					for (UINT k = 0; k < 3; ++k)
+					{
+						minimum[k] = std::min<double>(minimum[k], p[k]);
+						maximum[k] = std::max<double>(maximum[k], p[k]);
+					}
+				}
+
+				const double extent = std::max<double>(maximum[0] - minimum[0], std::max<double>(maximum[1] - minimum[1], maximum[2] - minimum[2]));
+				mAttributeScale = extent > 0.0 ? extent * extent : 0.0;
+			}
+
+			void buildQuadrics(const std::vector<UINT>& indices)
+			{
+				mQuadrics.assign(mVertexCount, Quadric());
+
+				for (size_t i = 0; i < indices.size(); i += 3)
+				{
+					const double* p0 = position(indices[i + 0]);
+					const double* p1 = position(indices[i + 1]);
+					const double* p2 = position(indices[i + 2]);
+
+					const double e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+					const double e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+					double normal[3];
+					cross(e1, e2, normal);
+
+					//  ġ, ȭ ﰢ   ǳʶڴ.
+					const double area = normalize(normal) * 0.5;
+					if (area <= 0.0)
+					{
+						continue;
+					}
+
+					const double distance = -dot(normal, p0);
+					for (UINT k = 0; k < 3; ++k)
+					{
+						addPlane(&mQuadrics[indices[i + k]], normal, distance, area);
+					}
+
+					//  𼭸 ﰢ     ´.
+					for (UINT k = 0; k < 3; ++k)
+					{
+						const UINT a = indices[i + k];
+						const UINT b = indices[i + (k + 1) % 3];
+
+						if (mKinds[a] == VERTEX_MANIFOLD || mKinds[b] == VERTEX_MANIFOLD)
+						{
+							continue;
+						}
+
+						const double* pa = position(a);
+						const double* pb = position(b);
+						const double edge[3] = { pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2] };
+						double edgeNormal[3];
+						cross(edge, normal, edgeNormal);
+
+						const double length = normalize(edgeNormal);
+						if (length <= 0.0)
+						{
+							continue;
+						}
+
+						const double edgeDistance = -dot(edgeNormal, pa);
+						addPlane(&mQuadrics[a], edgeNormal, edgeDistance, BORDER_WEIGHT * length);
+						addPlane(&mQuadrics[b], edgeNormal, edgeDistance, BORDER_WEIGHT * length);
+					}
+				}
+			}
+
+			void buildAdjacency(const std::vector<UINT>& indices, std::vector<UINT>* outOffsets, std::vector<UINT>* outAdjacency) const
+			{
+				std::vector<UINT>& offsets = *outOffsets;
+				std::vector<UINT>& adjacency = *outAdjacency;
+
+				offsets.assign(mVertexCount + 1, 0);
+				for (size_t i = 0; i < indices.size(); ++i)
+				{
+					++offsets[indices[i] + 1];
+				}
+				for (UINT i = 0; i < mVertexCount; ++i)
+				{
+					offsets[i + 1] += offsets[i];
+				}
+
+				adjacency.resize(indices.size());
+				std::vector<UINT> cursor(offsets.begin(), offsets.end() - 1);
+				for (size_t i = 0; i < indices.size(); ++i)
+				{
+					adjacency[cursor[indices[i]]++] = static_cast<UINT>(i / 3);
+				}
+			}
+
+			// from to ű  from ֺ ﰢ  to   
+			UINT countSharedTriangles(UINT from, UINT to, const std::vector<UINT>& indices,
+				const std::vector<UINT>& offsets, const std::vector<UINT>& adjacency) const
+			{
+				UINT count = 0;
+				for (UINT j = offsets[from]; j < offsets[from + 1]; ++j)
+				{
+					const UINT* triangle = &indices[adjacency[j] * 3];
+					count += (triangle[0] == to || triangle[1] == to || triangle[2] == to) ? 1 : 0;
+				}
+				return count;
+			}
+
+			void pickCheaper(UINT from, UINT to, const std::vector<UINT>& indices,
+				const std::vector<UINT>& offsets, const std::vector<UINT>& adjacency, Collapse* inoutBest) const
+			{
+				if (mKinds[from] == VERTEX_LOCKED)
+				{
+					return;
+				}
+
+				//    𼭸(ﰢ ϳ )   θ .
+				if (mKinds[from] == VERTEX_BORDER
+					&& (mKinds[to] == VERTEX_MANIFOLD || countSharedTriangles(from, to, indices, offsets, adjacency) != 1))
+				{
+					return;
+				}
+
+				Quadric combined = mQuadrics[from];
+				addQuadric(&combined, mQuadrics[to]);
+
+				double cost = combined.Weight > 0.0 ? evaluate(combined, position(to)) / combined.Weight : 0.0;
+
+				if (mAttributeCount > 0)
+				{
+					const float* a = attribute(from);
+					const float* b = attribute(to);
+					double attributeError = 0.0;
+
+					for (UINT k = 0; k < mAttributeCount; ++k)
+					{
+						const double difference = (a[k] - b[k]) * mAttributeWeights[k];
+						attributeError += difference * difference;
+					}
+
+					cost += attributeError * mAttributeScale;
+				}
+
+				if (cost < inoutBest->Cost)
+				{
+					inoutBest->From = from;
+					inoutBest->To = to;
+					inoutBest->Cost = cost;
+				}
+			}
+
+			// from to ġ ű  ﰢ ִ
+			bool hasFlip(UINT from, UINT to, const std::vector<UINT>& indices,
+				const std::vector<UINT>& offsets, const std::vector<UINT>& adjacency) const
+			{
+				for (UINT j = offsets[from]; j < offsets[from + 1]; ++j)
+				{
+					const UINT* triangle = &indices[adjacency[j] * 3];
+
+					if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+					{
+						continue;
+					}
+
+					const double* before[3];
+					const double* after[3];
+					for (UINT k = 0; k < 3; ++k)
+					{
+						before[k] = position(triangle[k]);
+						after[k] = triangle[k] == from ? position(to) : before[k];
+					}
+
+					double normalBefore[3];
+					double normalAfter[3];
+					{
+						const double e1[3] = { before[1][0] - before[0][0], before[1][1] - before[0][1], before[1][2] - before[0][2] };
+						const double e2[3] = { before[2][0] - before[0][0], before[2][1] - before[0][1], before[2][2] - before[0][2] };
+						cross(e1, e2, normalBefore);
+					}
+					{
+						const double e1[3] = { after[1][0] - after[0][0], after[1][1] - after[0][1], after[1][2] - after[0][2] };
+						const double e2[3] = { after[2][0] - after[0][0], after[2][1] - after[0][1], after[2][2] - after[0][2] };
+						cross(e1, e2, normalAfter);
+					}
+
+					if (dot(normalBefore, normalAfter) <= 0.0)
+					{
+						return true;
+					}
+				}
+
+				return false;
+			}
+
+		private:
+			std::vector<double> mPositions;
+			const float* mAttributes;
+			size_t mAttributeStride;
+			UINT mAttributeCount;
+			float mAttributeWeights[MeshSimplifier::MAX_ATTRIBUTE_COUNT];
+			UINT mVertexCount;
+			double mAttributeScale;
+
+			std::vector<BYTE> mKinds;
+			std::vector<Quadric> mQuadrics;
+		};
+	}
+
+	size_t MeshSimplifier::Simplify(const UINT* indices, size_t indexCount,
+		const float* positions, size_t positionStride, UINT vertexCount,
+		size_t targetIndexCount, float maxError,
+		std::vector<UINT>* outIndices, float* outError,
+		const float* attributes, size_t attributeStride,
+		const float* attributeWeights, UINT attributeCount)
+	{
+		outIndices->assign(indices, indices + indexCount);
+		*outError = 0.f;
+
+		if (indexCount <= targetIndexCount || vertexCount == 0)
+		{
+			return indexCount;
+		}
+
+		Simplifier simplifier(positions, positionStride, vertexCount,
+			attributes, attributeStride, attributeWeights, attributes != nullptr ? attributeCount : 0);
+
+		return simplifier.Run(outIndices, targetIndexCount, maxError, outError);
+	}
+
+	void MeshSimplifier::BuildLodChain(const UINT* indices, size_t indexCount,
+		const float* positions, size_t positionStride, UINT vertexCount,
+		std::vector<UINT>* outIndices, std::vector<MeshLod>* outLods, UINT lodCount,
+		const float* attributes, size_t attributeStride,
+		const float* attributeWeights, UINT attributeCount)
+	{
+		outIndices->assign(indices, indices + indexCount);
+		outLods->clear();
+		outLods->push_back({ 0, static_cast<UINT>(indexCount), 0.f });
+
+		float boundsMin[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+		float boundsMax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		for (UINT i = 0; i < vertexCount; ++i)
+		{
+			const float* position = reinterpret_cast<const float*>(reinterpret_cast<const BYTE*>(positions) + i * positionStride);
+			for (int k = 0; k < 3; ++k)
+			{
+				boundsMin[k] = std::min<float>(boundsMin[k], position[k]);
+				boundsMax[k] = std::max<float>(boundsMax[k], position[k]);
+			}
+		}
+
+		float extentSquared = 0.f;
+		for (int k = 0; k < 3; ++k)
+		{
+			extentSquared += (boundsMax[k] - boundsMin[k]) * (boundsMax[k] - boundsMin[k]);
+		}
+		const float maxError = vertexCount > 0 ? sqrtf(extentSquared) * MAX_LOD_ERROR_RATIO : 0.f;
+
+		std::vector<UINT> current(indices, indices + indexCount);
+		std::vector<UINT> simplified;
+		float error = 0.f;
+		float previousStepError = 0.f;
+
+		while (outLods->size() < lodCount)
+		{
+			const size_t targetIndexCount = current.size() / 6 * 3;
+			if (targetIndexCount < MIN_LOD_TRIANGLE_COUNT * 3)
+			{
+				break;
+			}
+
+			// ܰ   ѵ  ʵ  ŭ Ѵ.
+			float stepError = 0.f;
+			Simplify(current.data(), current.size(), positions, positionStride, vertexCount,
+				targetIndexCount, maxError - error, &simplified, &stepError,
+				attributes, attributeStride, attributeWeights, attributeCount);
+
+			if (simplified.size() > current.size() * MIN_LOD_REDUCTION)
+			{
+				break;
+			}
+
+			if (previousStepError > 0.f && stepError > previousStepError * MAX_LOD_ERROR_GROWTH)
+			{
+				break;
+			}
+
+			MeshOptimizer::OptimizeVertexCache(simplified.data(), simplified.size(), vertexCount);
+
+			//  ܰ迡 ٽ ٿǷ    ܰ    ʴ´.
+			error += stepError;
+			previousStepError = stepError;
+			outLods->push_back({ static_cast<UINT>(outIndices->size()), static_cast<UINT>(simplified.size()), error });
+			outIndices->insert(outIndices->end(), simplified.begin(), simplified.end());
+
+			current.swap(simplified);
+		}
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+
+namespace common
+{
+	//   ۸  LOD ϳ, ε  [IndexStart, IndexStart + IndexCount) 
+	// Error   Ÿ  ġ (Ʈ  ,   )
+	struct MeshLod
+	{
+		UINT IndexStart;
+		UINT IndexCount;
+		float Error;
+	};
+
+	//  (quadric)  𼭸 ر ܼȭ (Garland & Heckbert)
+	//    ʰ   ġǷ  LOD   ۸ ״ .
+	// Ӽ :
+	// - ġ   ̸ (UV/ )    ʴ´.
+	// -    踦 󼭸 ,      Ų.
+	// - ĥ  Ӽ ̸ ġŭ Ÿ   /UV ũ ٲ ر ڷ ̷.
+	class MeshSimplifier
+	{
+	public:
+		enum { MAX_ATTRIBUTE_COUNT = 16 };
+		enum { DEFAULT_LOD_COUNT = 6 };
+
+	public:
+		// ﰢ targetIndexCount / 3 ϰ ǰų  ر  maxError  .
+		// attributes attributeStride  float attributeCount, attributeWeights Ӽ  1
+		// ޽ ũ   Ÿ  Ѵ. (0.05 ޽ ũ 5%)
+		//  ε  ȯϰ, outError  ر   ū  .
+		static size_t Simplify(const UINT* indices, size_t indexCount,
+			const float* positions, size_t positionStride, UINT vertexCount,
+			size_t targetIndexCount, float maxError,
+			std::vector<UINT>* outIndices, float* outError,
+			const float* attributes = nullptr, size_t attributeStride = 0,
+			const float* attributeWeights = nullptr, UINT attributeCount = 0);
+
+		// LOD 0() ﰢ  ݾ  ü   ε ۿ ̾ δ.
+		//     밢 5%  ʰ,  ܰ谡   ʰų ܰ 
+		//  ܰ躸   Ѱ ٰų lodCount Ǹ .  LOD  ĳ  ٽ ĵȴ.
+		// Error ܰ躰  ϹǷ LOD ȣ Ŀ  ʴ´.
+		static void BuildLodChain(const UINT* indices, size_t indexCount,
+			const float* positions, size_t positionStride, UINT vertexCount,
+			std::vector<UINT>* outIndices, std::vector<MeshLod>* outLods,
+			UINT lodCount = DEFAULT_LOD_COUNT,
+			const float* attributes = nullptr, size_t attributeStride = 0,
+			const float* attributeWeights = nullptr, UINT attributeCount = 0);
+	};
+}
@@ -0,0 +1,465 @@
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <immintrin.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include "JobSystem.h"
+#include "TextMeshParser.h"
+
+namespace common
+{
+	namespace
+	{
+		enum { MAX_SIGNIFICANT_DIGITS = 19 }; // UINT64 ġ ʰ  ڸ
+		enum { MAX_EXPONENT = 9999 };
+		// ڵ ϳ ϴ ּ Ʈ, ڸ  ڸ   ϳ
+		enum { MIN_VERTEX_RECORD_LENGTH = 6 * 2, MIN_TRIANGLE_RECORD_LENGTH = 3 * 2 };
+
+		struct LineChunk
+		{
+			const char* Begin;
+			const char* End;
+			uint32_t First; // ûũ ù  ڵ ȣ
+			uint32_t LineCount;
+		};
+
+		// Ȯ ǥǴ 10 ŵ, float 10^10, double 10^22
+		const float FLOAT_POWERS[] =
+		{
+			1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+		};
+		const double DOUBLE_POWERS[] =
+		{
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+			1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+
+		inline bool isSpace(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+		}
+		inline bool isDigit(char c)
+		{
+			return static_cast<unsigned char>(c - '0') < 10;
+		}
+		inline const char* skipSpace(const char* p, const char* end)
+		{
+			while (p < end && isSpace(*p))
+			{
+				++p;
+			}
+			return p;
+		}
+		inline const char* skipToken(const char* p, const char* end)
+		{
+			p = skipSpace(p, end);
+			while (p < end && !isSpace(*p))
+			{
+				++p;
+			}
+			return p;
+		}
+		// c ã   ġ,  nullptr
+		inline const char* skipPast(const char* p, const char* end, char c)
+		{
+			const char* found = static_cast<const char*>(memchr(p, c, end - p));
+			return found != nullptr ? found + 1 : nullptr;
+		}
+
+		// SSE2 16Ʈ '\n' .
+		//  (-1) Ʈ īͿ  255   SAD ģ.
+		uint32_t countLines(const char* begin, const char* end)
+		{
+			const __m128i newline = _mm_set1_epi8('\n');
+			const __m128i zero = _mm_setzero_si128();
+			const char* p = begin;
+			uint32_t count = 0;
+
+			while (end - p >= 16)
+			{
+				const size_t blockCount = std::min<size_t>((end - p) / 16, 255);
+				__m128i counts = zero;
+
+				for (size_t i = 0; i < blockCount; ++i, p += 16)
+				{
+					__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+					counts = _mm_sub_epi8(counts, _mm_cmpeq_epi8(bytes, newline));
+				}
+
+				__m128i sums = _mm_sad_epu8(counts, zero);
+				count += static_cast<uint32_t>(_mm_cvtsi128_si32(sums) + _mm_extract_epi16(sums, 4));
+			}
+
+			for (; p < end; ++p)
+			{
+				count += *p == '\n' ? 1 : 0;
+			}
+
+			return count;
+		}
+
+		// [begin, end)  迡 chunkSize  . ڵ  ٿ ϳ̶ Ѵ.
+		void splitLines(const char* begin, const char* end, size_t chunkSize, std::vector<LineChunk>* outChunks)
+		{
+			uint32_t first = 0;
+
+			for (const char* p = begin; p < end; )
+			{
+				const char* chunkEnd = end;
+
+				if (static_cast<size_t>(end - p) > chunkSize)
+				{
+					const char* lineEnd = skipPast(p + chunkSize, end, '\n');
+					chunkEnd = lineEnd != nullptr ? lineEnd : end;
+				}
+
+				LineChunk chunk;
+				chunk.Begin = p;
+				chunk.End = chunkEnd;
+				chunk.First = first;
+				chunk.LineCount = countLines(p, chunkEnd);
+				outChunks->push_back(chunk);
+
+				first += chunk.LineCount;
+				p = chunkEnd;
+			}
+		}
+
+		// ڵ recordCount д´.  ڰ ̾ ̴.
+		template <typename ParseRecord>
+		bool parseRecords(const char* begin, const char* end, uint32_t first, uint32_t recordCount, const ParseRecord& parseRecord)
+		{
+			const char* p = begin;
+
+			for (uint32_t i = first; i < first + recordCount; ++i)
+			{
+				p = parseRecord(p, end, i);
+
+				if (p == nullptr)
+				{
+					return false;
+				}
+			}
+
+			return skipSpace(p, end) == end;
+		}
+
+		//  ũ   ûũ  ķ а, ٰ ڵ尡   ó  ٽ д´.
+		template <typename ParseRecord>
+		bool parseList(const char* begin, const char* end, uint32_t recordCount, JobSystem* jobSystem, const ParseRecord& parseRecord)
+		{
+			if (jobSystem != nullptr && static_cast<size_t>(end - begin) > TextMeshParser::PARALLEL_CHUNK_SIZE)
+			{
+				std::vector<LineChunk> chunks;
+				splitLines(begin, end, TextMeshParser::PARALLEL_CHUNK_SIZE, &chunks);
+
+				if (!chunks.empty() && chunks.back().First + chunks.back().LineCount == recordCount)
+				{
+					std::vector<char> results(chunks.size(), 0);
+
+					jobSystem->ParallelFor(static_cast<uint32_t>(chunks.size()), 1, [&](uint32_t chunkBegin, uint32_t chunkEnd)
+						{
+							for (uint32_t i = chunkBegin; i < chunkEnd; ++i)
+							{
+								const LineChunk& chunk = chunks[i];
+								results[i] = parseRecords(chunk.Begin, chunk.End, chunk.First, chunk.LineCount, parseRecord) ? 1 : 0;
+							}
+						});
+
+					if (std::find(results.begin(), results.end(), 0) == results.end())
+					{
+						return true;
+					}
+				}
+			}
+
+			return parseRecords(begin, end, 0, recordCount, parseRecord);
+		}
+	}
+
+	bool TextMeshParser::Load(const std::string& fileName,
+		std::vector<MeshVertex>* outVertices,
+		std::vector<uint32_t>* outIndices,
+		JobSystem* jobSystem)
+	{
+#if defined(_WIN32)
+		HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		bool bResult = false;
+		LARGE_INTEGER fileSize;
+
+		//     Ƿ ũ ȮѴ.
+		if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+		{
+			HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+			if (mapping != NULL)
+			{
+				const char* text = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+
+				if (text != nullptr)
+				{
+					bResult = Parse(text, static_cast<size_t>(fileSize.QuadPart), outVertices, outIndices, jobSystem);
+					UnmapViewOfFile(text);
+				}
+
+				CloseHandle(mapping);
+			}
+		}
+
+		CloseHandle(file);
+		return bResult;
+#else
+		//     д´. Ľ  ۿ Ѵ.
+		std::ifstream fin(fileName, std::ios_base::binary | std::ios_base::ate);
+		if (!fin)
+		{
+			return false;
+		}
+
+		const std::streamoff fileSize = fin.tellg();
+		if (fileSize <= 0)
+		{
+			return false;
+		}
+
+		std::string text(static_cast<size_t>(fileSize), '\0');
+		fin.seekg(0);
+		if (!fin.read(&text[0], fileSize))
+		{
+			return false;
+		}
+
+		return Parse(text.data(), text.size(), outVertices, outIndices, jobSystem);
+#endif
+	}
+	bool TextMeshParser::Parse(const char* text, size_t length,
+		std::vector<MeshVertex>* outVertices,
+		std::vector<uint32_t>* outIndices,
+		JobSystem* jobSystem)
+	{
+		const char* end = text + length;
+		const char* p = text;
+
+		// VertexCount: n
+		// TriangleCount: m
+		uint32_t vcount = 0;
+		uint32_t tcount = 0;
+
+		p = ParseUint(skipToken(p, end), end, &vcount);
+		if (p == nullptr)
+		{
+			return false;
+		}
+
+		p = ParseUint(skipToken(p, end), end, &tcount);
+		if (p == nullptr)
+		{
+			return false;
+		}
+
+		// VertexList (pos, normal)
+		// {
+		//	x y z nx ny nz
+		// }
+		const char* vertexBegin = skipPast(p, end, '{');
+		vertexBegin = vertexBegin != nullptr ? skipPast(vertexBegin, end, '\n') : nullptr;
+		const char* vertexEnd = vertexBegin != nullptr ? static_cast<const char*>(memchr(vertexBegin, '}', end - vertexBegin)) : nullptr;
+		if (vertexEnd == nullptr)
+		{
+			return false;
+		}
+
+		// TriangleList
+		// {
+		//	i0 i1 i2
+		// }
+		const char* indexBegin = skipPast(vertexEnd, end, '{');
+		indexBegin = indexBegin != nullptr ? skipPast(indexBegin, end, '\n') : nullptr;
+		const char* indexEnd = indexBegin != nullptr ? static_cast<const char*>(memchr(indexBegin, '}', end - indexBegin)) : nullptr;
+		if (indexEnd == nullptr)
+		{
+			return false;
+		}
+
+		//   ϰ Ҵϱ   ̷   ִ  .    ڰ   ִ.
+		if (vcount > (static_cast<size_t>(vertexEnd - vertexBegin) + 1) / MIN_VERTEX_RECORD_LENGTH
+			|| tcount > (static_cast<size_t>(indexEnd - indexBegin) + 1) / MIN_TRIANGLE_RECORD_LENGTH)
+		{
+			return false;
+		}
+
+		std::vector<MeshVertex>& vertices = *outVertices;
+		std::vector<uint32_t>& indices = *outIndices;
+		vertices.resize(vcount);
+		indices.resize(static_cast<size_t>(tcount) * 3);
+
+		bool bVertexResult = parseList(vertexBegin, vertexEnd, vcount, jobSystem, [&vertices](const char* p, const char* end, uint32_t i)
+			{
+				MeshVertex& vertex = vertices[i];
+				p = ParseFloat(p, end, &vertex.Pos.x);
+				p = p != nullptr ? ParseFloat(p, end, &vertex.Pos.y) : nullptr;
+				p = p != nullptr ? ParseFloat(p, end, &vertex.Pos.z) : nullptr;
+				p = p != nullptr ? ParseFloat(p, end, &vertex.Normal.x) : nullptr;
+				p = p != nullptr ? ParseFloat(p, end, &vertex.Normal.y) : nullptr;
+				p = p != nullptr ? ParseFloat(p, end, &vertex.Normal.z) : nullptr;
+				vertex.Tex = Vector2(0.0f, 0.0f);
+				return p;
+			});
+		if (!bVertexResult)
+		{
+			return false;
+		}
+
+		bool bIndexResult = parseList(indexBegin, indexEnd, tcount, jobSystem, [&indices, vcount](const char* p, const char* end, uint32_t i)
+			{
+				uint32_t* triangle = &indices[static_cast<size_t>(i) * 3];
+				p = ParseUint(p, end, &triangle[0]);
+				p = p != nullptr ? ParseUint(p, end, &triangle[1]) : nullptr;
+				p = p != nullptr ? ParseUint(p, end, &triangle[2]) : nullptr;
+
+				//    ﰢ   .
+				if (p != nullptr && (triangle[0] >= vcount || triangle[1] >= vcount || triangle[2] >= vcount))
+				{
+					return static_cast<const char*>(nullptr);
+				}
+				return p;
+			});
+
+		return bIndexResult;
+	}
+
+	const char* TextMeshParser::ParseFloat(const char* text, const char* end, float* outValue)
+	{
+		const char* p = skipSpace(text, end);
+		if (p == end)
+		{
+			return nullptr;
+		}
+
+		bool bNegative = false;
+		if (*p == '-' || *p == '+')
+		{
+			bNegative = *p == '-';
+			++p;
+		}
+
+		// ȿ ڴ 19ڸ  ,  10  ű.
+		uint64_t mantissa = 0;
+		int significantDigits = 0;
+		int exponent = 0;
+		bool bHasDigits = false;
+
+		for (; p < end && isDigit(*p); ++p)
+		{
+			bHasDigits = true;
+			if (significantDigits < MAX_SIGNIFICANT_DIGITS)
+			{
+				mantissa = mantissa * 10 + (*p - '0');
+				significantDigits += mantissa != 0 ? 1 : 0;
+			}
+			else
+			{
+				++exponent;
+			}
+		}
+
+		if (p < end && *p == '.')
+		{
+			for (++p; p < end && isDigit(*p); ++p)
+			{
+				bHasDigits = true;
+				if (significantDigits < MAX_SIGNIFICANT_DIGITS)
+				{
+					mantissa = mantissa * 10 + (*p - '0');
+					significantDigits += mantissa != 0 ? 1 : 0;
+					--exponent;
+				}
+			}
+		}
+
+		if (!bHasDigits)
+		{
+			return nullptr;
+		}
+
+		//  ڿ ڰ  'e' ڿ  ʴ´.
+		if (p < end && (*p == 'e' || *p == 'E'))
+		{
+			const char* q = p + 1;
+			bool bNegativeExponent = false;
+
+			if (q < end && (*q == '-' || *q == '+'))
+			{
+				bNegativeExponent = *q == '-';
+				++q;
+			}
+
+			if (q < end && isDigit(*q))
+			{
+				int exponentValue = 0;
+				for (; q < end && isDigit(*q); ++q)
+				{
+					exponentValue = std::min<int>(exponentValue * 10 + (*q - '0'), static_cast<int>(MAX_EXPONENT));
+				}
+
+				exponent += bNegativeExponent ? -exponentValue : exponentValue;
+				p = q;
+			}
+		}
+
+		float value;
+		if (mantissa <= (1u << 24) && exponent >= -10 && exponent <= 10)
+		{
+			//  10 ŵ float ȮϹǷ   / Ȯ ݿøȴ.
+			const float m = static_cast<float>(mantissa);
+			value = exponent < 0 ? m / FLOAT_POWERS[-exponent] : m * FLOAT_POWERS[exponent];
+		}
+		else if (mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22)
+		{
+			// doubleδ Ȯ ݿø float    ̹Ƿ 幰  Ʈ ٸ  ִ.
+			const double m = static_cast<double>(mantissa);
+			value = static_cast<float>(exponent < 0 ? m / DOUBLE_POWERS[-exponent] : m * DOUBLE_POWERS[exponent]);
+		}
+		else
+		{
+			//  Ͽ   ڸ Ȯ ݿø  double ٻѴ.
+			value = static_cast<float>(static_cast<double>(mantissa) * std::pow(10.0, exponent));
+		}
+
+		*outValue = bNegative ? -value : value;
+		return p;
+	}
+	const char* TextMeshParser::ParseUint(const char* text, const char* end, uint32_t* outValue)
+	{
+		const char* p = skipSpace(text, end);
+		if (p == end || !isDigit(*p))
+		{
+			return nullptr;
+		}
+
+		uint64_t value = 0;
+		for (; p < end && isDigit(*p); ++p)
+		{
+			value = value * 10 + (*p - '0');
+
+			if (value > UINT_MAX)
+			{
+				return nullptr;
+			}
+		}
+
+		*outValue = static_cast<uint32_t>(value);
+		return p;
+	}
+}
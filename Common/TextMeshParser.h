@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <directxtk/SimpleMath.h>
+#include <string>
+#include <vector>
+
+namespace common
+{
+	using namespace DirectX;
+	using namespace DirectX::SimpleMath;
+
+	class JobSystem;
+
+	// ĳÿ ؽƮ  Բ  , õ Basic32  ġ    ״ ѱ  ִ.
+	struct MeshVertex
+	{
+		Vector3 Pos;
+		Vector3 Normal;
+		Vector2 Tex;
+	};
+
+	// ؽƮ (.txt) ļ
+	// VertexCount: n / TriangleCount: m / VertexList (pos, normal) { ... } / TriangleList { ... }  д´.
+	//  ° ϰ Ķ Ʈ ġ ʴ   ļ д´.
+	//  PARALLEL_CHUNK_SIZE ũ    ûũ jobSystem  д´.
+	class TextMeshParser
+	{
+	public:
+		enum { PARALLEL_CHUNK_SIZE = 64 * 1024 }; // Ʈ
+
+	public:
+		//  ų    false
+		static bool Load(const std::string& fileName,
+			std::vector<MeshVertex>* outVertices,
+			std::vector<uint32_t>* outIndices,
+			JobSystem* jobSystem = nullptr);
+		static bool Parse(const char* text, size_t length,
+			std::vector<MeshVertex>* outVertices,
+			std::vector<uint32_t>* outIndices,
+			JobSystem* jobSystem = nullptr);
+
+		//  ǳʶٰ  ϳ д´. ϸ nullptr, ϸ   ġ
+		static const char* ParseFloat(const char* text, const char* end, float* outValue);
+		static const char* ParseUint(const char* text, const char* end, uint32_t* outValue);
+	};
+}
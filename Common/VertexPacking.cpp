@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "VertexPacking.h"
+
+namespace common
+{
+	namespace
+	{
+		const float SNORM16_MAX = 32767.0f;
+
+		uint32_t asUint(float value)
+		{
+			uint32_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			return bits;
+		}
+
+		float asFloat(uint32_t bits)
+		{
+			float value;
+			memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		float signNotZero(float value)
+		{
+			return value >= 0.0f ? 1.0f : -1.0f;
+		}
+
+		short toSnorm16(float value)
+		{
+			if (value > SNORM16_MAX) return 32767;
+			if (value < -SNORM16_MAX) return -32767;
+			return static_cast<short>(value);
+		}
+	}
+
+	void VertexPacking::EncodeOctahedral(const Vector3& direction, short outEncoded[2])
+	{
+		const float l1Norm = fabsf(direction.x) + fabsf(direction.y) + fabsf(direction.z);
+
+		//   ޽ó ̰ 0̸ +z д.
+		if (l1Norm <= 0.0f)
+		{
+			outEncoded[0] = 0;
+			outEncoded[1] = 0;
+			return;
+		}
+
+		const float invL1Norm = 1.0f / l1Norm;
+		float u = direction.x * invL1Norm;
+		float v = direction.y * invL1Norm;
+
+		// Ʒ ݱ 밢   ٱ ﰢ ִ´.
+		if (direction.z < 0.0f)
+		{
+			const float foldedU = (1.0f - fabsf(v)) * signNotZero(u);
+			const float foldedV = (1.0f - fabsf(u)) * signNotZero(v);
+			u = foldedU;
+			v = foldedV;
+		}
+
+		const float scaledU = u * SNORM16_MAX;
+		const float scaledV = v * SNORM16_MAX;
+		const float floorU = floorf(scaledU);
+		const float floorV = floorf(scaledV);
+
+		Vector3 normalized = direction;
+		normalized.Normalize();
+
+		float bestDot = -2.0f;
+
+		for (int i = 0; i < 4; ++i)
+		{
+			const short candidate[2] =
+			{
+				toSnorm16(floorU + static_cast<float>(i & 1)),
+				toSnorm16(floorV + static_cast<float>(i >> 1))
+			};
+
+			const float dot = DecodeOctahedral(candidate).Dot(normalized);
+
+			if (dot > bestDot)
+			{
+				bestDot = dot;
+				outEncoded[0] = candidate[0];
+				outEncoded[1] = candidate[1];
+			}
+		}
+	}
+
+	Vector3 VertexPacking::DecodeOctahedral(const short encoded[2])
+	{
+		// R16G16_SNORM Ģ, -32768 -1 ȴ.
+		const float u = std::max<float>(encoded[0] / SNORM16_MAX, -1.0f);
+		const float v = std::max<float>(encoded[1] / SNORM16_MAX, -1.0f);
+
+		Vector3 result(u, v, 1.0f - fabsf(u) - fabsf(v));
+		const float fold = std::max<float>(-result.z, 0.0f);
+		result.x += result.x >= 0.0f ? -fold : fold;
+		result.y += result.y >= 0.0f ? -fold : fold;
+		result.Normalize();
+
+		return result;
+	}
+
+	unsigned short VertexPacking::FloatToHalf(float value)
+	{
+		uint32_t bits = asUint(value);
+		const uint32_t sign = (bits >> 16) & 0x8000;
+		bits &= 0x7fffffff;
+
+		if (bits >= 0x7f800000)
+		{
+			// Ѵ ״, NaN  NaN
+			return static_cast<unsigned short>(sign | (bits > 0x7f800000 ? 0x7e00 : 0x7c00));
+		}
+
+		if (bits >= 0x477ff000)
+		{
+			// 65520 ̻ ݿøϸ half  Ѵ´.
+			return static_cast<unsigned short>(sign | 0x7c00);
+		}
+
+		if (bits < 0x38800000)
+		{
+			// half  , 0.5  FPU ݿø  Ʈ ߶󳽴.
+			const uint32_t rounded = asUint(asFloat(bits) + 0.5f) - 0x3f000000;
+			return static_cast<unsigned short>(sign | rounded);
+		}
+
+		const uint32_t mantissaOdd = (bits >> 13) & 1;
+		bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xfff + mantissaOdd;
+
+		return static_cast<unsigned short>(sign | (bits >> 13));
+	}
+
+	float VertexPacking::HalfToFloat(unsigned short value)
+	{
+		const uint32_t exponentMask = 0x7c00 << 13;
+		uint32_t bits = (value & 0x7fff) << 13;
+		const uint32_t exponent = bits & exponentMask;
+
+		bits += static_cast<uint32_t>(127 - 15) << 23;
+
+		if (exponent == exponentMask)
+		{
+			bits += static_cast<uint32_t>(128 - 16) << 23;
+		}
+		else if (exponent == 0)
+		{
+			bits += 1 << 23;
+			bits = asUint(asFloat(bits) - asFloat(113 << 23));
+		}
+
+		bits |= static_cast<uint32_t>(value & 0x8000) << 16;
+
+		return asFloat(bits);
+	}
+
+	void VertexPacking::QuantizeWeights(const float weights[4], uint8_t outWeights[4])
+	{
+		const float sum = weights[0] + weights[1] + weights[2] + weights[3];
+
+		if (sum <= 0.0f)
+		{
+			memset(outWeights, 0, 4);
+			return;
+		}
+
+		float remainders[4];
+		uint32_t total = 0;
+
+		for (int i = 0; i < 4; ++i)
+		{
+			const float scaled = std::max<float>(weights[i], 0.0f) * 255.0f / sum;
+			const float floored = std::min<float>(floorf(scaled), 255.0f);
+			outWeights[i] = static_cast<uint8_t>(floored);
+			remainders[i] = scaled - floored;
+			total += outWeights[i];
+		}
+
+		// εҼ   255   ū ġ .
+		while (total > 255)
+		{
+			int largest = 0;
+			for (int i = 1; i < 4; ++i)
+			{
+				if (outWeights[i] > outWeights[largest]) largest = i;
+			}
+
+			--outWeights[largest];
+			--total;
+		}
+
+		while (total < 255)
+		{
+			int best = 0;
+			for (int i = 1; i < 4; ++i)
+			{
+				if (remainders[i] > remainders[best]) best = i;
+			}
+
+			++outWeights[best];
+			remainders[best] = -1.0f;
+			++total;
+		}
+	}
+
+#if defined(_WIN32)
+	DXGI_FORMAT VertexPacking::AppendIndices(const uint32_t* indices, size_t indexCount, uint32_t vertexCount,
+		std::vector<uint8_t>* inoutBuffer, uint32_t* outByteOffset)
+	{
+		const bool b16Bit = vertexCount <= MAX_16BIT_INDEX_VERTEX_COUNT;
+		const size_t indexSize = b16Bit ? sizeof(unsigned short) : sizeof(uint32_t);
+
+		std::vector<uint8_t>& buffer = *inoutBuffer;
+		const size_t offset = (buffer.size() + indexSize - 1) / indexSize * indexSize;
+		buffer.resize(offset + indexCount * indexSize, 0);
+		*outByteOffset = static_cast<uint32_t>(offset);
+
+		if (b16Bit)
+		{
+			unsigned short* dest = reinterpret_cast<unsigned short*>(&buffer[offset]);
+
+			for (size_t i = 0; i < indexCount; ++i)
+			{
+				assert(indices[i] < vertexCount);
+				dest[i] = static_cast<unsigned short>(indices[i]);
+			}
+
+			return DXGI_FORMAT_R16_UINT;
+		}
+
+		memcpy(&buffer[offset], indices, indexCount * sizeof(uint32_t));
+
+		return DXGI_FORMAT_R32_UINT;
+	}
+#endif
+}
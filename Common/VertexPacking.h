@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <directxtk/SimpleMath.h>
+
+#if defined(_WIN32)
+#include <dxgiformat.h>
+#endif
+
+namespace common
+{
+	using namespace DirectX;
+	using namespace DirectX::SimpleMath;
+
+	//  Ӽ ȭ
+	// /: ȸü   snorm16 2 (DXGI_FORMAT_R16G16_SNORM)
+	// UV: half 2 (DXGI_FORMAT_R16G16_FLOAT)
+	//  ε/ġ: 8Ʈ 4 (DXGI_FORMAT_R8G8B8A8_UINT / R8G8B8A8_UNORM)
+	// ڵ ̴   Ƿ CPU  ״   ִ.
+	class VertexPacking
+	{
+	public:
+		enum { MAX_16BIT_INDEX_VERTEX_COUNT = 65536 };
+
+	public:
+		// ݿø 4       . ̰ 0̸ +z ڵѴ.
+		static void EncodeOctahedral(const Vector3& direction, short outEncoded[2]);
+		static Vector3 DecodeOctahedral(const short encoded[2]);
+
+		// ݿø   ¦,   Ѵ밡 ȴ.
+		static unsigned short FloatToHalf(float value);
+		static float HalfToFloat(unsigned short value);
+
+		//  Ȯ 255 ǵ  ū  1  ش. ġ  0̸  0
+		static void QuantizeWeights(const float weights[4], uint8_t outWeights[4]);
+
+#if defined(_WIN32)
+		// vertexCount  ϴ ε 16Ʈ 32Ʈ inoutBuffer ڿ δ.
+		//  ε ũ⿡  ĵǰ, outByteOffset ش.
+		static DXGI_FORMAT AppendIndices(const uint32_t* indices, size_t indexCount, uint32_t vertexCount,
+			std::vector<uint8_t>* inoutBuffer, uint32_t* outByteOffset);
+#endif
+	};
+}
@@ -0,0 +1,218 @@
+#include "pch.h"
+
+#include <cstring>
+#include <emmintrin.h>
+
+#include "VertexWelder.h"
+
+namespace common
+{
+	namespace
+	{
+		enum { INVALID_INDEX = 0xFFFFFFFF };
+
+		// float -> int ȯ ġ ʵ  ǥ   ڸ.
+		const float MAX_CELL_COORD = 1073741824.0f; // 2^30
+
+		struct CellKey
+		{
+			int X;
+			int Y;
+			int Z;
+		};
+
+		//   ĭ  ǥ   Ӹ
+		struct CellEntry
+		{
+			CellKey Key;
+			UINT Head;
+		};
+
+		inline const float* getElement(const float* data, size_t stride, UINT index)
+		{
+			return reinterpret_cast<const float*>(reinterpret_cast<const char*>(data) + stride * index);
+		}
+
+		inline UINT hashCell(const CellKey& key)
+		{
+			UINT hash = static_cast<UINT>(key.X) * 73856093u ^ static_cast<UINT>(key.Y) * 19349663u ^ static_cast<UINT>(key.Z) * 83492791u;
+
+			// ̺ ε  Ʈ Ƿ  Ʈ  .
+			hash ^= hash >> 15;
+			hash *= 0x2c1b3c6du;
+			hash ^= hash >> 12;
+
+			return hash;
+		}
+
+		//  Ž ؽ ̺, 뷮 ĭ  2 ̻ 2 ŵ
+		class CellTable
+		{
+		public:
+			explicit CellTable(UINT cellCount)
+				: mMask(0)
+			{
+				UINT capacity = 16;
+				while (capacity < cellCount * 2)
+				{
+					capacity <<= 1;
+				}
+
+				mMask = capacity - 1;
+				mEntries.resize(capacity, CellEntry{ { 0, 0, 0 }, INVALID_INDEX });
+			}
+
+			//   ĭ ָ,  ĭ Head INVALID_INDEX.
+			CellEntry* Find(const CellKey& key)
+			{
+				for (UINT slot = hashCell(key) & mMask; ; slot = (slot + 1) & mMask)
+				{
+					CellEntry& entry = mEntries[slot];
+					if (entry.Head == INVALID_INDEX
+						|| (entry.Key.X == key.X && entry.Key.Y == key.Y && entry.Key.Z == key.Z))
+					{
+						return &entry;
+					}
+				}
+			}
+
+		private:
+			std::vector<CellEntry> mEntries;
+			UINT mMask;
+		};
+
+		bool isAttributeEqual(const WeldAttribute& attribute, UINT lhs, UINT rhs)
+		{
+			const float* a = getElement(attribute.Data, attribute.Stride, lhs);
+			const float* b = getElement(attribute.Data, attribute.Stride, rhs);
+
+			if (attribute.Epsilon <= 0.f)
+			{
+				return memcmp(a, b, sizeof(float) * attribute.ComponentCount) == 0;
+			}
+
+			for (UINT i = 0; i < attribute.ComponentCount; ++i)
+			{
+				if (fabsf(a[i] - b[i]) > attribute.Epsilon)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+	}
+
+	UINT VertexWelder::BuildWeldRemap(const float* positions, size_t positionStride, UINT vertexCount, float positionEpsilon,
+		const WeldAttribute* attributes, UINT attributeCount, std::vector<UINT>* outRemap)
+	{
+		assert(outRemap != nullptr);
+		assert(attributeCount <= MAX_ATTRIBUTE_COUNT);
+
+		outRemap->assign(vertexCount, INVALID_INDEX);
+
+		if (vertexCount == 0)
+		{
+			return 0;
+		}
+
+		const WeldAttribute positionAttribute = { positions, positionStride, 3, positionEpsilon };
+		const bool bExact = positionEpsilon <= 0.f;
+
+		// 1.  ĭ, ĭ ȿ   迡 (ະ Ʈ) SSE   Ѵ.
+		// ĭ   2 * epsilon̹Ƿ epsilon    ḭ̆ų   ̿ ĭ ִ.
+		std::vector<CellKey> cells(vertexCount);
+		std::vector<unsigned char> upperSides(vertexCount, 0);
+		{
+			const __m128 scale = _mm_set1_ps(bExact ? 1.f : 0.5f / positionEpsilon);
+			const __m128 maxCoord = _mm_set1_ps(MAX_CELL_COORD);
+			const __m128 minCoord = _mm_set1_ps(-MAX_CELL_COORD);
+			const __m128 half = _mm_set1_ps(0.5f);
+
+			for (UINT i = 0; i < vertexCount; ++i)
+			{
+				const float* p = getElement(positions, positionStride, i);
+				const __m128 position = _mm_setr_ps(p[0], p[1], p[2], 0.f);
+				__m128i cell;
+
+				if (bExact)
+				{
+					//   ĥ  Ʈ  ü ĭ ǥ .
+					cell = _mm_castps_si128(position);
+				}
+				else
+				{
+					const __m128 scaled = _mm_max_ps(_mm_min_ps(_mm_mul_ps(position, scale), maxCoord), minCoord);
+
+					// cvtt 0  ڸǷ ߸   ũ() 1   .  ũ -1̴.
+					const __m128i truncated = _mm_cvttps_epi32(scaled);
+					const __m128 roundedUp = _mm_cmpgt_ps(_mm_cvtepi32_ps(truncated), scaled);
+					cell = _mm_add_epi32(truncated, _mm_castps_si128(roundedUp));
+
+					const __m128 fraction = _mm_sub_ps(scaled, _mm_cvtepi32_ps(cell));
+					upperSides[i] = static_cast<unsigned char>(_mm_movemask_ps(_mm_cmpge_ps(fraction, half)) & 0x7);
+				}
+
+				int coords[4];
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(coords), cell);
+				cells[i] = { coords[0], coords[1], coords[2] };
+			}
+		}
+
+		// 2.    ǥ ĭ ϰ, ڿ   ֺ ĭ ǥ Ѵ.
+		CellTable table(vertexCount);
+		std::vector<UINT> nextInCell(vertexCount, INVALID_INDEX);
+		const UINT probeCount = bExact ? 1 : 8;
+		UINT weldedCount = 0;
+
+		for (UINT i = 0; i < vertexCount; ++i)
+		{
+			const CellKey& cell = cells[i];
+			const int offsetX = (upperSides[i] & 1) ? 1 : -1;
+			const int offsetY = (upperSides[i] & 2) ? 1 : -1;
+			const int offsetZ = (upperSides[i] & 4) ? 1 : -1;
+			UINT found = INVALID_INDEX;
+
+			// Ʈ 0, 1, 2     ̿ ĭ  ĭ ű. 0 ڱ ĭ̴.
+			for (UINT probe = 0; probe < probeCount && found == INVALID_INDEX; ++probe)
+			{
+				const CellKey key =
+				{
+					cell.X + ((probe & 1) ? offsetX : 0),
+					cell.Y + ((probe & 2) ? offsetY : 0),
+					cell.Z + ((probe & 4) ? offsetZ : 0)
+				};
+
+				for (UINT candidate = table.Find(key)->Head; candidate != INVALID_INDEX; candidate = nextInCell[candidate])
+				{
+					bool bEqual = isAttributeEqual(positionAttribute, candidate, i);
+					for (UINT j = 0; j < attributeCount && bEqual; ++j)
+					{
+						bEqual = isAttributeEqual(attributes[j], candidate, i);
+					}
+
+					if (bEqual)
+					{
+						found = candidate;
+						break;
+					}
+				}
+			}
+
+			if (found != INVALID_INDEX)
+			{
+				(*outRemap)[i] = (*outRemap)[found];
+				continue;
+			}
+
+			CellEntry* entry = table.Find(cell);
+			entry->Key = cell;
+			nextInCell[i] = entry->Head;
+			entry->Head = i;
+
+			(*outRemap)[i] = weldedCount++;
+		}
+
+		return weldedCount;
+	}
+}
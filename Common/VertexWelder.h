@@ -0,0 +1,103 @@
+#pragma once
+
+#include <vector>
+
+namespace common
+{
+	//   ġ ܿ  float Ӽ ϳ
+	// Epsilon 0̸ Ʈ  ƾ ϹǷ  Ӽ( ε ) ״ ѱ  ִ.
+	struct WeldAttribute
+	{
+		const float* Data;
+		size_t Stride;
+		UINT ComponentCount;
+		float Epsilon;
+	};
+
+	// к  , 0̸ Ʈ  ġ
+	struct WeldOptions
+	{
+		float PositionEpsilon = 1e-5f;
+		float NormalEpsilon = 1e-3f;
+		float TexCoordEpsilon = 1e-4f;
+	};
+
+	// Ͱ         ϳ ġ ε ģ.
+	// ġ   2 * epsilon  ĭ ȭ(SSE) ؽϰ,   ̿ ĭ 8ĭ ã
+	//  Ӽ к epsilon ȿ  ù  δ.       .
+	// ε [0, vertexCount)  ϰ,      ä  .
+	class VertexWelder
+	{
+	public:
+		enum { MAX_ATTRIBUTE_COUNT = 8 };
+
+	public:
+		// outRemap[old] = new,    ȯѴ.
+		static UINT BuildWeldRemap(const float* positions, size_t positionStride, UINT vertexCount, float positionEpsilon,
+			const WeldAttribute* attributes, UINT attributeCount, std::vector<UINT>* outRemap);
+
+		// ġ, , UV Ѵ.   UV 󰡹Ƿ  ʴ´.
+		// extraAttributes Ȯ ƾ ϴ ߰ Ӽ (Ű  ε, ġ )
+		template <typename Vertex, typename Position, typename Normal, typename TexCoord>
+		static UINT Weld(Vertex* vertices, UINT vertexCount, UINT* indices, size_t indexCount,
+			Position Vertex::* position, Normal Vertex::* normal, TexCoord Vertex::* texCoord,
+			const WeldOptions& options = WeldOptions(), const WeldAttribute* extraAttributes = nullptr, UINT extraAttributeCount = 0);
+		// remap BuildWeldRemap ,   ȣ    ó  .
+		template <typename Vertex>
+		static void CompactVertices(Vertex* vertices, UINT vertexCount, UINT* indices, size_t indexCount, const std::vector<UINT>& remap);
+	};
+
+	template <typename Vertex, typename Position, typename Normal, typename TexCoord>
+	UINT VertexWelder::Weld(Vertex* vertices, UINT vertexCount, UINT* indices, size_t indexCount,
+		Position Vertex::* position, Normal Vertex::* normal, TexCoord Vertex::* texCoord,
+		const WeldOptions& options, const WeldAttribute* extraAttributes, UINT extraAttributeCount)
+	{
+		static_assert(sizeof(Position) == 3 * sizeof(float), "position must be 3 floats");
+		static_assert(sizeof(Normal) == 3 * sizeof(float), "normal must be 3 floats");
+		static_assert(sizeof(TexCoord) == 2 * sizeof(float), "texCoord must be 2 floats");
+		assert(extraAttributeCount + 2 <= MAX_ATTRIBUTE_COUNT);
+
+		if (vertexCount == 0)
+		{
+			return 0;
+		}
+
+		WeldAttribute attributes[MAX_ATTRIBUTE_COUNT];
+		attributes[0] = { reinterpret_cast<const float*>(&(vertices[0].*normal)), sizeof(Vertex), 3, options.NormalEpsilon };
+		attributes[1] = { reinterpret_cast<const float*>(&(vertices[0].*texCoord)), sizeof(Vertex), 2, options.TexCoordEpsilon };
+		for (UINT i = 0; i < extraAttributeCount; ++i)
+		{
+			attributes[2 + i] = extraAttributes[i];
+		}
+
+		std::vector<UINT> remap;
+		const UINT weldedCount = BuildWeldRemap(reinterpret_cast<const float*>(&(vertices[0].*position)), sizeof(Vertex),
+			vertexCount, options.PositionEpsilon, attributes, 2 + extraAttributeCount, &remap);
+
+		if (weldedCount < vertexCount)
+		{
+			CompactVertices(vertices, vertexCount, indices, indexCount, remap);
+		}
+
+		return weldedCount;
+	}
+
+	template <typename Vertex>
+	void VertexWelder::CompactVertices(Vertex* vertices, UINT vertexCount, UINT* indices, size_t indexCount, const std::vector<UINT>& remap)
+	{
+		//  ȣ ó   ŰǷ տ Űܵ      ʴ´.
+		UINT nextIndex = 0;
+		for (UINT i = 0; i < vertexCount; ++i)
+		{
+			if (remap[i] == nextIndex)
+			{
+				vertices[nextIndex++] = vertices[i];
+			}
+		}
+
+		for (size_t i = 0; i < indexCount; ++i)
+		{
+			indices[i] = remap[indices[i]];
+		}
+	}
+}
@@ -1,11 +1,11 @@
 #include <cassert>
-#include <fstream>
 #include <directxtk/DDSTextureLoader.h>
 
 #include "D3DSample.h"
 #include "MathHelper.h"
 #include "GeometryGenerator.h"
 #include "RenderStates.h"
+#include "TextMeshParser.h"
 
 namespace cubeMap
 {
@@ -544,41 +544,26 @@ namespace cubeMap
 	}
 	void D3DSample::buildSkullGeometryBuffers()
 	{
-		std::ifstream fin("../Resource/Models/skull.txt");
+		std::vector<MeshVertex> meshVertices;
+		std::vector<UINT> indices;
 
-		if (!fin)
+		if (!TextMeshParser::Load("../Resource/Models/skull.txt", &meshVertices, &indices))
 		{
 			MessageBox(0, L"Models/skull.txt not found.", 0, 0);
 			return;
 		}
 
-		UINT vcount = 0;
-		UINT tcount = 0;
-		std::string ignore;
-
-		fin >> ignore >> vcount;
-		fin >> ignore >> tcount;
-		fin >> ignore >> ignore >> ignore >> ignore;
+		UINT vcount = static_cast<UINT>(meshVertices.size());
+		UINT tcount = static_cast<UINT>(indices.size() / 3);
 
 		std::vector<Basic32> vertices(vcount);
 		for (UINT i = 0; i < vcount; ++i)
 		{
-			fin >> vertices[i].Pos.x >> vertices[i].Pos.y >> vertices[i].Pos.z;
-			fin >> vertices[i].Normal.x >> vertices[i].Normal.y >> vertices[i].Normal.z;
+			vertices[i].Pos = meshVertices[i].Pos;
+			vertices[i].Normal = meshVertices[i].Normal;
 		}
 
-		fin >> ignore;
-		fin >> ignore;
-		fin >> ignore;
-
 		mSkullIndexCount = 3 * tcount;
-		std::vector<UINT> indices(mSkullIndexCount);
-		for (UINT i = 0; i < tcount; ++i)
-		{
-			fin >> indices[i * 3 + 0] >> indices[i * 3 + 1] >> indices[i * 3 + 2];
-		}
-
-		fin.close();
 
 		D3D11_BUFFER_DESC vbd;
 		vbd.Usage = D3D11_USAGE_IMMUTABLE;
@@ -1,11 +1,11 @@
 #include <cassert>
 #include <algorithm>
-#include <fstream>
 
 #include "D3DSample.h"
 #include "D3DUtil.h"
 #include "MathHelper.h"
 #include "GeometryGenerator.h"
+#include "TextMeshParser.h"
 
 namespace drawing
 {
@@ -376,63 +376,40 @@ namespace drawing
 
 	void D3DSample::buildShape()
 	{
-		GeometryGenerator::MeshData box;
-		GeometryGenerator::MeshData grid;
-		GeometryGenerator::MeshData sphere;
-		GeometryGenerator::MeshData cylinder;
-
-		GeometryGenerator::CreateBox(1.f, 1.f, 1.f, &box);
-		GeometryGenerator::CreateGrid(20.0f, 30.0f, 60, 40, &grid);
-		GeometryGenerator::CreateSphere(0.5f, 20, 20, &sphere);
-		//geoGen.CreateGeosphere(0.5f, 2, sphere);
-		GeometryGenerator::CreateCylinder(0.5f, 0.3f, 3.0f, 20, 20, &cylinder);
-
-		mVertexOffsets.push_back(0);
-		mVertexOffsets.push_back(box.Vertices.size());
-		mVertexOffsets.push_back(mVertexOffsets.back() + grid.Vertices.size());
-		mVertexOffsets.push_back(mVertexOffsets.back() + sphere.Vertices.size());
-
-		mIndexCounts.push_back(box.Indices.size());
-		mIndexCounts.push_back(grid.Indices.size());
-		mIndexCounts.push_back(sphere.Indices.size());
-		mIndexCounts.push_back(cylinder.Indices.size());
-
-		mIndexOffsets.push_back(0);
-		mIndexOffsets.push_back(box.Indices.size());
-		mIndexOffsets.push_back(mIndexOffsets.back() + grid.Indices.size());
-		mIndexOffsets.push_back(mIndexOffsets.back() + sphere.Indices.size());
-
-		UINT totalVertexCount =
-			box.Vertices.size() +
-			grid.Vertices.size() +
-			sphere.Vertices.size() +
-			cylinder.Vertices.size();
-
-		UINT totalIndexCount =
-			box.Indices.size() +
-			grid.Indices.size() +
-			sphere.Indices.size() +
-			cylinder.Indices.size();
-
-		std::vector<Vertex> vertices;
-		vertices.reserve(totalVertexCount);
-
-		auto pushBack = [&vertices](const GeometryGenerator::MeshData& meshData)
-			{
-				for (const GeometryGenerator::Vertex& geoVertex : meshData.Vertices)
-				{
-					Vertex vertex;
-					vertex.Position = geoVertex.Position;
-					vertex.Color = common::Black;
+		//   ġ Ƿ ġ ä ̾ƿ ۿ ٷ Ѵ.
+		using PositionLayout = GeometryGenerator::VertexLayout<Vertex, &Vertex::Position>;
+
+		UINT vertexCounts[4];
+		UINT indexCounts[4];
+		GeometryGenerator::GetBoxCount(&vertexCounts[0], &indexCounts[0]);
+		GeometryGenerator::GetGridCount(60, 40, &vertexCounts[1], &indexCounts[1]);
+		GeometryGenerator::GetSphereCount(20, 20, &vertexCounts[2], &indexCounts[2]);
+		GeometryGenerator::GetCylinderCount(20, 20, &vertexCounts[3], &indexCounts[3]);
+
+		UINT totalVertexCount = 0;
+		UINT totalIndexCount = 0;
+		for (UINT i = 0; i < 4; ++i)
+		{
+			mVertexOffsets.push_back(totalVertexCount);
+			mIndexOffsets.push_back(totalIndexCount);
+			mIndexCounts.push_back(indexCounts[i]);
+
+			totalVertexCount += vertexCounts[i];
+			totalIndexCount += indexCounts[i];
+		}
 
-					vertices.push_back(vertex);
-				}
-			};
+		std::vector<Vertex> vertices(totalVertexCount);
+		std::vector<UINT> indices(totalIndexCount);
 
-		pushBack(box);
-		pushBack(grid);
-		pushBack(sphere);
-		pushBack(cylinder);
+		GeometryGenerator::CreateBox<PositionLayout>(1.f, 1.f, 1.f, &vertices[mVertexOffsets[0]], &indices[mIndexOffsets[0]]);
+		GeometryGenerator::CreateGrid<PositionLayout>(20.0f, 30.0f, 60, 40, &vertices[mVertexOffsets[1]], &indices[mIndexOffsets[1]]);
+		GeometryGenerator::CreateSphere<PositionLayout>(0.5f, 20, 20, &vertices[mVertexOffsets[2]], &indices[mIndexOffsets[2]]);
+		GeometryGenerator::CreateCylinder<PositionLayout>(0.5f, 0.3f, 3.0f, 20, 20, &vertices[mVertexOffsets[3]], &indices[mIndexOffsets[3]]);
+
+		for (Vertex& vertex : vertices)
+		{
+			vertex.Color = common::Black;
+		}
 
 		D3D11_BUFFER_DESC vbd;
 		vbd.Usage = D3D11_USAGE_IMMUTABLE;
@@ -444,12 +421,6 @@ namespace drawing
 		vinitData.pSysMem = &vertices[0];
 		HR(md3dDevice->CreateBuffer(&vbd, &vinitData, &mShapeVB));
 
-		std::vector<UINT> indices;
-		indices.insert(indices.end(), box.Indices.begin(), box.Indices.end());
-		indices.insert(indices.end(), grid.Indices.begin(), grid.Indices.end());
-		indices.insert(indices.end(), sphere.Indices.begin(), sphere.Indices.end());
-		indices.insert(indices.end(), cylinder.Indices.begin(), cylinder.Indices.end());
-
 		D3D11_BUFFER_DESC ibd;
 		ibd.Usage = D3D11_USAGE_IMMUTABLE;
 		ibd.ByteWidth = sizeof(UINT) * totalIndexCount;
@@ -478,47 +449,27 @@ namespace drawing
 
 	void D3DSample::buildSkull()
 	{
-		std::ifstream fin("../Resource/Models/skull.txt");
+		std::vector<MeshVertex> meshVertices;
+		std::vector<UINT> indices;
 
-		if (!fin)
+		if (!TextMeshParser::Load("../Resource/Models/skull.txt", &meshVertices, &indices))
 		{
 			MessageBox(0, L"Models/skull.txt not found.", 0, 0);
 			return;
 		}
 
-		UINT vcount = 0;
-		UINT tcount = 0;
-		std::string ignore;
-
-		fin >> ignore >> vcount;
-		fin >> ignore >> tcount;
-		fin >> ignore >> ignore >> ignore >> ignore;
-
-		float nx, ny, nz;
+		UINT vcount = static_cast<UINT>(meshVertices.size());
+		UINT tcount = static_cast<UINT>(indices.size() / 3);
 
 		std::vector<Vertex> vertices(vcount);
 		for (UINT i = 0; i < vcount; ++i)
 		{
-			fin >> vertices[i].Position.x >> vertices[i].Position.y >> vertices[i].Position.z;
-
-			vertices[i].Color = common::Black;
+			vertices[i].Position = meshVertices[i].Pos;
 
-			// Normal not used in this demo.
-			fin >> nx >> ny >> nz;
+			vertices[i].Color = common::Black; // Normal not used in this demo.
 		}
 
-		fin >> ignore;
-		fin >> ignore;
-		fin >> ignore;
-
 		mSkullIndexCount = 3 * tcount;
-		std::vector<UINT> indices(mSkullIndexCount);
-		for (UINT i = 0; i < tcount; ++i)
-		{
-			fin >> indices[i * 3 + 0] >> indices[i * 3 + 1] >> indices[i * 3 + 2];
-		}
-
-		fin.close();
 
 		D3D11_BUFFER_DESC vbd;
 		vbd.Usage = D3D11_USAGE_IMMUTABLE;
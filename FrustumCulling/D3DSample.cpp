@@ -1,5 +1,5 @@
 #include <cassert>
-#include <fstream>
+#include <chrono>
 #include <sstream>
 
 #include "D3DSample.h"
@@ -8,6 +8,7 @@
 #include "MathHelper.h"
 #include "RenderStates.h"
 #include "GeometryGenerator.h"
+#include "TextMeshParser.h"
 
 namespace frustumCulling
 {
@@ -68,6 +69,7 @@ namespace frustumCulling
 
 		BoundingBox octreeBox({ 0,0,0 }, { HALF + INTERVAL , HALF + INTERVAL , HALF + INTERVAL });
 		mOctree.Build(octreeBox, 3, mObjects, mSkullBoundingBox);
+		mVisibleIndices.resize(mObjects.size());
 
 		GeometryGenerator::MeshData mesh;
 		GeometryGenerator::CreateBox(1, 1, 1, &mesh);
@@ -146,6 +148,10 @@ namespace frustumCulling
 			mbIsOnCulling = false;
 			mbUseOctree = false;
 		}
+		if (GetAsyncKeyState('B') & 0x0001)
+		{
+			benchmarkOctreeQuery();
+		}
 	}
 	void D3DSample::Render()
 	{
@@ -208,17 +214,16 @@ namespace frustumCulling
 		}
 		else
 		{
-			std::set<Object*> findObjects;
-
-			Matrix view = mCam.GetView();
-			BoundingFrustum Frustum(mCam.GetProj());
+			Vector4 worldPlanes[6];
+			D3DHelper::ExtractFrustumPlanes(worldPlanes, mCam.GetViewProj());
 
-			BoundingFrustum worldFrustum;
-			Frustum.Transform(worldFrustum, view.Invert());
-			mOctree.FindIntersectObject(worldFrustum, &findObjects, mSkullBoundingBox);
+			mOctree.BeginQuery();
+			UINT visibleCount = mOctree.FindIntersectObject(worldPlanes, &mVisibleIndices[0], static_cast<UINT>(mVisibleIndices.size()), &mJobSystem);
 
-			for (const Object* object : findObjects)
+			for (UINT i = 0; i < visibleCount; ++i)
 			{
+				const Object* object = mObjects[mVisibleIndices[i]];
+
 				auto& perObject = mBasic32->GetPerObject();
 				perObject.World = object->World.Transpose();
 				perObject.WorldInvTranspose = MathHelper::InverseTranspose(object->World).Transpose();
@@ -231,7 +236,7 @@ namespace frustumCulling
 
 			std::wostringstream outs;
 			outs.precision(6);
-			outs << L"renderObject" << L"    " << findObjects.size() <<
+			outs << L"renderObject" << L"    " << visibleCount <<
 				L"total Object" << mObjects.size();
 			mTitle = outs.str();
 
@@ -303,24 +308,92 @@ namespace frustumCulling
 
 		mBasic32->UpdateSubresource(md3dContext);
 	}
+	void D3DSample::benchmarkOctreeQuery()
+	{
+		//   ū   std::set ο ε 迭   ð Ѵ.
+		enum { BENCHMARK_COUNT_SQRT_3 = 64 };
+		enum { ITERATION_COUNT = 10 };
+
+		const float HALF = BENCHMARK_COUNT_SQRT_3 * 0.5f * INTERVAL;
+		std::vector<Object> objects(BENCHMARK_COUNT_SQRT_3 * BENCHMARK_COUNT_SQRT_3 * BENCHMARK_COUNT_SQRT_3);
+		std::vector<Object*> objectPointers;
+		objectPointers.reserve(objects.size());
+
+		for (size_t i = 0; i < objects.size(); ++i)
+		{
+			size_t x = i % BENCHMARK_COUNT_SQRT_3;
+			size_t y = (i / BENCHMARK_COUNT_SQRT_3) % BENCHMARK_COUNT_SQRT_3;
+			size_t z = i / (BENCHMARK_COUNT_SQRT_3 * BENCHMARK_COUNT_SQRT_3);
+
+			objects[i].World = Matrix::CreateTranslation(x * INTERVAL - HALF, y * INTERVAL - HALF, z * INTERVAL - HALF);
+			objectPointers.push_back(&objects[i]);
+		}
+
+		using Clock = std::chrono::high_resolution_clock;
+
+		Clock::time_point buildStart = Clock::now();
+		Octree octree;
+		octree.Build(BoundingBox({ 0, 0, 0 }, { HALF + INTERVAL, HALF + INTERVAL, HALF + INTERVAL }), 8, objectPointers, mSkullBoundingBox);
+		double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - buildStart).count();
+
+		BoundingFrustum worldFrustum;
+		BoundingFrustum(mCam.GetProj()).Transform(worldFrustum, mCam.GetView().Invert());
+
+		Vector4 worldPlanes[6];
+		D3DHelper::ExtractFrustumPlanes(worldPlanes, mCam.GetViewProj());
+
+		std::vector<UINT> visibleIndices(objects.size());
+		size_t setCount = 0;
+		UINT serialCount = 0;
+		UINT parallelCount = 0;
+
+		Clock::time_point start = Clock::now();
+		for (int i = 0; i < ITERATION_COUNT; ++i)
+		{
+			std::set<Object*> findObjects;
+			octree.FindIntersectObject(worldFrustum, &findObjects);
+			setCount = findObjects.size();
+		}
+		double setMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / ITERATION_COUNT;
+
+		start = Clock::now();
+		for (int i = 0; i < ITERATION_COUNT; ++i)
+		{
+			octree.BeginQuery();
+			serialCount = octree.FindIntersectObject(worldPlanes, &visibleIndices[0], static_cast<UINT>(visibleIndices.size()));
+		}
+		double serialMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / ITERATION_COUNT;
+
+		start = Clock::now();
+		for (int i = 0; i < ITERATION_COUNT; ++i)
+		{
+			octree.BeginQuery();
+			parallelCount = octree.FindIntersectObject(worldPlanes, &visibleIndices[0], static_cast<UINT>(visibleIndices.size()), &mJobSystem);
+		}
+		double parallelMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / ITERATION_COUNT;
+
+		std::wostringstream outs;
+		outs.precision(4);
+		outs << L"[Octree benchmark] objects " << objects.size() << L", build " << buildMs << L" ms\n"
+			<< L"  std::set   : " << setMs << L" ms, visible " << setCount << L"\n"
+			<< L"  serial     : " << serialMs << L" ms, visible " << serialCount << L"\n"
+			<< L"  parallel(" << mJobSystem.GetThreadCount() << L") : " << parallelMs << L" ms, visible " << parallelCount << L"\n";
+		OutputDebugStringW(outs.str().c_str());
+	}
 	void D3DSample::buildSkullGeometry()
 	{
 		// Ͽ  ε
-		std::ifstream fin("../Resource/Models/skull.txt");
+		std::vector<MeshVertex> meshVertices;
+		std::vector<UINT> indices;
 
-		if (!fin)
+		if (!TextMeshParser::Load("../Resource/Models/skull.txt", &meshVertices, &indices))
 		{
 			MessageBox(0, L"Models/skull.txt not found.", 0, 0);
 			return;
 		}
 
-		UINT vcount = 0;
-		UINT tcount = 0;
-		std::string ignore;
-
-		fin >> ignore >> vcount;
-		fin >> ignore >> tcount;
-		fin >> ignore >> ignore >> ignore >> ignore;
+		UINT vcount = static_cast<UINT>(meshVertices.size());
+		UINT tcount = static_cast<UINT>(indices.size() / 3);
 
 		XMFLOAT3 vMinf3(+MathHelper::Infinity, +MathHelper::Infinity, +MathHelper::Infinity);
 		XMFLOAT3 vMaxf3(-MathHelper::Infinity, -MathHelper::Infinity, -MathHelper::Infinity);
@@ -330,8 +403,8 @@ namespace frustumCulling
 		std::vector<Basic32::Vertex> vertices(vcount);
 		for (UINT i = 0; i < vcount; ++i)
 		{
-			fin >> vertices[i].Pos.x >> vertices[i].Pos.y >> vertices[i].Pos.z;
-			fin >> vertices[i].Normal.x >> vertices[i].Normal.y >> vertices[i].Normal.z;
+			vertices[i].Pos = meshVertices[i].Pos;
+			vertices[i].Normal = meshVertices[i].Normal;
 
 			XMVECTOR P = XMLoadFloat3(&vertices[i].Pos);
 
@@ -343,18 +416,7 @@ namespace frustumCulling
 		XMStoreFloat3(&mSkullBoundingBox.Center, 0.5f * (vMin + vMax));
 		XMStoreFloat3(&mSkullBoundingBox.Extents, 0.5f * (vMax - vMin));
 
-		fin >> ignore;
-		fin >> ignore;
-		fin >> ignore;
-
 		mSkullIndexCount = 3 * tcount;
-		std::vector<UINT> indices(mSkullIndexCount);
-		for (UINT i = 0; i < tcount; ++i)
-		{
-			fin >> indices[i * 3 + 0] >> indices[i * 3 + 1] >> indices[i * 3 + 2];
-		}
-
-		fin.close();
 
 		// ؽ  
 		D3D11_BUFFER_DESC vbd;
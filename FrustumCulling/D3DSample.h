@@ -5,6 +5,7 @@
 
 #include "D3dProcessor.h"
 #include "Camera.h"
+#include "JobSystem.h"
 #include "Octree.h"
 #include "Object.h"
 
@@ -34,6 +35,7 @@ namespace frustumCulling
 	private:
 		void initBasic32();
 		void buildSkullGeometry();
+		void benchmarkOctreeQuery();
 
 	private:
 		// 10, 50   ֱ⿡ 
@@ -55,6 +57,8 @@ namespace frustumCulling
 
 		Octree mOctree;
 		bool mbUseOctree;
+		JobSystem mJobSystem;
+		std::vector<UINT> mVisibleIndices;
 		ID3D11Buffer* mBoxIB;
 		ID3D11Buffer* mBoxVB;
 	};
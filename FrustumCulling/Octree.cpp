@@ -1,199 +1,299 @@
 #include <DirectXColors.h>
 #include <DirectXCollision.h>
+#include <algorithm>
+#include <cstring>
 
 #include "Octree.h"
 #include "Basic32.h"
 
 namespace frustumCulling
 {
-	OctreeNode::OctreeNode()
-	{
-		for (int i = 0; i < 8; ++i)
-			Children[i] = 0;
-
-		Bounds.Center = Vector3(0.0f, 0.0f, 0.0f);
-		Bounds.Extents = Vector3(0.0f, 0.0f, 0.0f);
-
-		IsLeaf = false;
-	}
-	OctreeNode::~OctreeNode()
-	{
-		for (int i = 0; i < 8; ++i)
-			SafeDelete(Children[i]);
-	}
-	void OctreeNode::Subdivide(BoundingBox box[8])
-	{
-		Vector3 halfExtent(
-			0.5f * Bounds.Extents.x,
-			0.5f * Bounds.Extents.y,
-			0.5f * Bounds.Extents.z);
-
-		box[0].Center = Vector3(
-			Bounds.Center.x + halfExtent.x,
-			Bounds.Center.y + halfExtent.y,
-			Bounds.Center.z + halfExtent.z);
-		box[0].Extents = halfExtent;
-
-		box[1].Center = Vector3(
-			Bounds.Center.x - halfExtent.x,
-			Bounds.Center.y + halfExtent.y,
-			Bounds.Center.z + halfExtent.z);
-		box[1].Extents = halfExtent;
-
-		box[2].Center = Vector3(
-			Bounds.Center.x - halfExtent.x,
-			Bounds.Center.y + halfExtent.y,
-			Bounds.Center.z - halfExtent.z);
-		box[2].Extents = halfExtent;
-
-		box[3].Center = Vector3(
-			Bounds.Center.x + halfExtent.x,
-			Bounds.Center.y + halfExtent.y,
-			Bounds.Center.z - halfExtent.z);
-		box[3].Extents = halfExtent;
-
-		// "Bottom" four quadrants.
-		box[4].Center = Vector3(
-			Bounds.Center.x + halfExtent.x,
-			Bounds.Center.y - halfExtent.y,
-			Bounds.Center.z + halfExtent.z);
-		box[4].Extents = halfExtent;
-
-		box[5].Center = Vector3(
-			Bounds.Center.x - halfExtent.x,
-			Bounds.Center.y - halfExtent.y,
-			Bounds.Center.z + halfExtent.z);
-		box[5].Extents = halfExtent;
-
-		box[6].Center = Vector3(
-			Bounds.Center.x - halfExtent.x,
-			Bounds.Center.y - halfExtent.y,
-			Bounds.Center.z - halfExtent.z);
-		box[6].Extents = halfExtent;
-
-		box[7].Center = Vector3(
-			Bounds.Center.x + halfExtent.x,
-			Bounds.Center.y - halfExtent.y,
-			Bounds.Center.z - halfExtent.z);
-		box[7].Extents = halfExtent;
-	}
-
 	Octree::Octree()
-		: mRoot(nullptr)
-	{
-	}
-	Octree::~Octree()
+		: mMaxDepth(0)
+		, mGeneration(0)
 	{
-		SafeDelete(mRoot);
 	}
 
 	void Octree::Build(BoundingBox initBox, size_t depth, const std::vector<Object*>& objects, const BoundingBox& objectBox)
 	{
-		mMaxDepth = depth;
-		mRoot = new OctreeNode();
-		mRoot->Bounds = initBox;
-		mRoot->Depth = 0;
-		mRoot->Objects = objects;
+		mMaxDepth = MathHelper::Min<size_t>(depth, MORTON_BITS);
+		mObjects = objects;
+
+		mNodes.clear();
+		mObjectIndices.resize(objects.size());
+		mObjectBounds.resize(objects.size());
+		mScratchIndices.resize(objects.size());
+		mStamps.assign(objects.size(), 0);
+		mGeneration = 1;
+
+		if (objects.empty())
+		{
+			return;
+		}
+
+		// Ʈ  AABB     Ѵ.
+		for (size_t i = 0; i < objects.size(); ++i)
+		{
+			objectBox.Transform(mObjectBounds[i], objects[i]->World);
+		}
+
+		// AABB ߽ Ʈ ڽ  ȭؼ  ڵ带 .
+		//  32Ʈ  ڵ,  32Ʈ Ʈ ε ־   Ѵ.
+		const float cellCount = static_cast<float>(1 << MORTON_BITS);
+		const Vector3 rootMin = Vector3(initBox.Center) - Vector3(initBox.Extents);
+		const Vector3 rootSize = 2.f * Vector3(initBox.Extents);
+
+		std::vector<UINT64> keys(objects.size());
+		for (size_t i = 0; i < objects.size(); ++i)
+		{
+			const Vector3 center = mObjectBounds[i].Center;
 
-		buildRecursive(mRoot, *this, objects, objectBox);
+			UINT cell[3];
+			const float normalized[3] =
+			{
+				(center.x - rootMin.x) / rootSize.x,
+				(center.y - rootMin.y) / rootSize.y,
+				(center.z - rootMin.z) / rootSize.z
+			};
+
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				float scaled = MathHelper::Clamp(normalized[axis] * cellCount, 0.f, cellCount - 1.f);
+				cell[axis] = static_cast<UINT>(scaled);
+			}
+
+			UINT64 morton = (expandBits(cell[0]) << 2) | (expandBits(cell[1]) << 1) | expandBits(cell[2]);
+			keys[i] = (morton << 32) | static_cast<UINT64>(i);
+		}
+
+		radixSort(&keys);
+
+		for (size_t i = 0; i < keys.size(); ++i)
+		{
+			mObjectIndices[i] = static_cast<UINT>(keys[i] & 0xffffffff);
+		}
+
+		//  ϳ Ʈ ּ   ̻̹Ƿ ˳ϰ Ƶд.
+		mNodes.reserve(objects.size() / LEAF_OBJECT_COUNT * 2 + 1);
+
+		OctreeNode root = {};
+		root.ObjectStart = 0;
+		root.ObjectCount = static_cast<UINT>(objects.size());
+		root.Depth = 0;
+		mNodes.push_back(root);
+
+		buildRecursive(0, keys);
+
+		// ½ũ  ̹Ƿ   ̻ þ ʴ´.
+		mTaskNodes.reserve(mNodes.size());
+		mNextTaskNodes.reserve(mNodes.size());
+		mTaskCounts.reserve(mNodes.size());
 	}
-	void Octree::FindIntersectObject(const BoundingFrustum& worldfrustum, std::set<Object*>* outObjects, const BoundingBox& objectBox)
+	void Octree::FindIntersectObject(const BoundingFrustum& worldfrustum, std::set<Object*>* outObjects)
 	{
-		findIntersectObjectRecursive(mRoot, worldfrustum, outObjects, objectBox);
+		if (mNodes.empty())
+		{
+			return;
+		}
+
+		findIntersectObjectRecursive(0, worldfrustum, outObjects);
 	}
-	void Octree::DebugRender(ID3D11DeviceContext* dc, Basic32* basic32, const Matrix& VP)
+	void Octree::BeginQuery()
 	{
-		debugRenderRecursive(mRoot, dc, basic32, VP);
+		++mGeneration;
+
+		if (mGeneration == 0)
+		{
+			std::fill(mStamps.begin(), mStamps.end(), 0u);
+			mGeneration = 1;
+		}
 	}
-	void Octree::debugRenderRecursive(OctreeNode* node, ID3D11DeviceContext* dc, Basic32* basic32, const Matrix& VP)
+	UINT Octree::FindIntersectObject(const Vector4 worldPlanes[6], UINT* outIndices, UINT capacity, JobSystem* jobSystem)
 	{
-		if (node == nullptr)
+		if (mNodes.empty())
 		{
-			return;
+			return 0;
 		}
-		if (node->Objects.size() == 0)
+
+		FrustumPlanes planes;
+		planes.Set(worldPlanes);
+
+		if (jobSystem == nullptr || jobSystem->GetThreadCount() == 1)
 		{
-			return;
+			return cullRecursive(0, planes, outIndices, capacity, 0);
 		}
 
-		Matrix traslate = Matrix::CreateTranslation(node->Bounds.Center);
-		Matrix scale = Matrix::CreateScale(abs(node->Bounds.Extents.x * 2));
+		//   ˳ϰ Ʈ  ϰ  лȴ.
+		collectTaskNodes(planes, jobSystem->GetThreadCount() * 4);
 
-		auto& perObject = basic32->GetPerObject();
-		perObject.World = (scale * traslate);
-		perObject.WorldViewProj = (perObject.World * VP);
+		const UINT taskCount = static_cast<UINT>(mTaskNodes.size());
+		mTaskCounts.resize(taskCount);
 
-		perObject.World = perObject.World.Transpose();
-		perObject.WorldViewProj = perObject.WorldViewProj.Transpose();
+		// Ʈ Ʈ  ġ Ƿ  ½ũ ڱ  ObjectStart
+		// ũġ ۿ  ǰ,   ٸ Ʈ ǵ帰.
+		jobSystem->ParallelFor(taskCount, 1, [this, &planes](UINT begin, UINT end)
+			{
+				for (UINT task = begin; task < end; ++task)
+				{
+					const UINT taskNode = mTaskNodes[task];
+					const UINT nodeIndex = taskNode & ~TASK_INSIDE_FLAG;
+					const OctreeNode& node = mNodes[nodeIndex];
+					UINT* scratch = &mScratchIndices[node.ObjectStart];
 
-		basic32->UpdateSubresource(dc);
-		dc->DrawIndexed(36, 0, 0);
+					mTaskCounts[task] = (taskNode & TASK_INSIDE_FLAG) != 0
+						? appendRange(node, scratch, node.ObjectCount, 0)
+						: cullRecursive(nodeIndex, planes, scratch, node.ObjectCount, 0);
+				}
+			});
+
+		// ½ũ  ̾ ̹Ƿ      .
+		UINT count = 0;
+		for (UINT task = 0; task < taskCount; ++task)
+		{
+			const OctreeNode& node = mNodes[mTaskNodes[task] & ~TASK_INSIDE_FLAG];
+			UINT copyCount = MathHelper::Min(mTaskCounts[task], capacity - count);
+
+			memcpy(outIndices + count, &mScratchIndices[node.ObjectStart], sizeof(UINT) * copyCount);
+			count += copyCount;
+		}
 
-		for (int i = 0; i < 8; ++i)
+		return count;
+	}
+	void Octree::DebugRender(ID3D11DeviceContext* dc, Basic32* basic32, const Matrix& VP)
+	{
+		// 尡  迭  Ƿ    ׸.
+		for (const OctreeNode& node : mNodes)
 		{
-			debugRenderRecursive(node->Children[i], dc, basic32, VP);
+			if (node.ObjectCount == 0)
+			{
+				continue;
+			}
+
+			Matrix traslate = Matrix::CreateTranslation(node.Bounds.Center);
+			Matrix scale = Matrix::CreateScale(2.f * Vector3(node.Bounds.Extents));
+
+			auto& perObject = basic32->GetPerObject();
+			perObject.World = (scale * traslate);
+			perObject.WorldViewProj = (perObject.World * VP);
+
+			perObject.World = perObject.World.Transpose();
+			perObject.WorldViewProj = perObject.WorldViewProj.Transpose();
+
+			basic32->UpdateSubresource(dc);
+			dc->DrawIndexed(36, 0, 0);
 		}
 	}
 
-	void Octree::buildRecursive(OctreeNode* parent, const Octree& octree, const std::vector<Object*>& objects, const BoundingBox& objectBox)
+	void Octree::buildRecursive(UINT nodeIndex, const std::vector<UINT64>& sortedKeys)
 	{
-		// Ե Ʈ 100 ̸  ̻  ʴ´.
-		if (objects.size() <= 100)
+		const UINT begin = mNodes[nodeIndex].ObjectStart;
+		const UINT end = begin + mNodes[nodeIndex].ObjectCount;
+		const UINT depth = mNodes[nodeIndex].Depth;
+
+		XMVECTOR vmin = XMVectorReplicate(+MathHelper::Infinity);
+		XMVECTOR vmax = XMVectorReplicate(-MathHelper::Infinity);
+
+		// ˻ Ʈ 100 ̰ų ִ ̿ ϸ  ̻  ʴ´.
+		if (end - begin <= LEAF_OBJECT_COUNT || depth >= mMaxDepth)
 		{
-			parent->IsLeaf = true;
-			parent->Objects = objects;
+			for (UINT i = begin; i < end; ++i)
+			{
+				const BoundingBox& box = mObjectBounds[mObjectIndices[i]];
+				XMVECTOR C = XMLoadFloat3(&box.Center);
+				XMVECTOR E = XMLoadFloat3(&box.Extents);
+
+				vmin = XMVectorMin(vmin, C - E);
+				vmax = XMVectorMax(vmax, C + E);
+			}
+
+			OctreeNode& node = mNodes[nodeIndex];
+			node.IsLeaf = true;
+			node.FirstChild = 0;
+			node.ChildCount = 0;
+			BoundingBox::CreateFromPoints(node.Bounds, vmin, vmax);
 			return;
 		}
 
-		parent->IsLeaf = false;
-
-		BoundingBox subbox[8];
-		parent->Subdivide(subbox);
+		// ĵ Ű ̹  3Ʈ ٲ 踦 ã ڽ  .
+		const UINT shift = 32 + 3 * (MORTON_BITS - 1 - depth);
+		UINT childBegin[8];
+		UINT childEnd[8];
+		UINT cursor = begin;
 
-		for (int i = 0; i < 8; ++i)
+		for (UINT octant = 0; octant < 8; ++octant)
 		{
-			//  ڽĿ ٿ ڽ ϳ Ҵش.
-			parent->Children[i] = new OctreeNode();
-			parent->Children[i]->Bounds = subbox[i];
-			parent->Children[i]->Depth = parent->Depth + 1;
-			parent->Children[i]->Objects.reserve(objects.size() / 2);
+			auto last = std::partition_point(sortedKeys.begin() + cursor, sortedKeys.begin() + end,
+				[shift, octant](UINT64 key) { return ((key >> shift) & 7) <= octant; });
 
-			for (const auto& object : objects)
-			{
-				BoundingBox localBoundingBox;
-				subbox[i].Transform(localBoundingBox, object->World.Invert());
+			childBegin[octant] = cursor;
+			childEnd[octant] = static_cast<UINT>(last - sortedKeys.begin());
+			cursor = childEnd[octant];
+		}
 
-				// ħ    Ʈ  ߰ش.
-				if (localBoundingBox.Intersects(objectBox))
-				{
-					parent->Children[i]->Objects.push_back(object);
-				}
+		//   ڽĸ ӵ  ҴѴ.
+		const UINT firstChild = static_cast<UINT>(mNodes.size());
+		UINT childCount = 0;
+
+		for (UINT octant = 0; octant < 8; ++octant)
+		{
+			if (childBegin[octant] == childEnd[octant])
+			{
+				continue;
 			}
-			//  ȣ
-			buildRecursive(parent->Children[i], octree, parent->Children[i]->Objects, objectBox);
+
+			OctreeNode child = {};
+			child.ObjectStart = childBegin[octant];
+			child.ObjectCount = childEnd[octant] - childBegin[octant];
+			child.Depth = depth + 1;
+			mNodes.push_back(child);
+			++childCount;
+		}
+
+		for (UINT i = 0; i < childCount; ++i)
+		{
+			buildRecursive(firstChild + i, sortedKeys);
+
+			const BoundingBox& box = mNodes[firstChild + i].Bounds;
+			XMVECTOR C = XMLoadFloat3(&box.Center);
+			XMVECTOR E = XMLoadFloat3(&box.Extents);
+
+			vmin = XMVectorMin(vmin, C - E);
+			vmax = XMVectorMax(vmax, C + E);
 		}
+
+		OctreeNode& node = mNodes[nodeIndex];
+		node.IsLeaf = false;
+		node.FirstChild = firstChild;
+		node.ChildCount = childCount;
+		BoundingBox::CreateFromPoints(node.Bounds, vmin, vmax);
 	}
-	void Octree::findIntersectObjectRecursive(OctreeNode* node, const BoundingFrustum& worldfrustum, std::set<Object*>* outObjects, const BoundingBox& objectBox)
+	void Octree::findIntersectObjectRecursive(UINT nodeIndex, const BoundingFrustum& worldfrustum, std::set<Object*>* outObjects)
 	{
-		switch (worldfrustum.Contains(node->Bounds))
+		const OctreeNode& node = mNodes[nodeIndex];
+
+		switch (worldfrustum.Contains(node.Bounds))
 		{
 		case CONTAINS:
-			outObjects->insert(node->Objects.begin(), node->Objects.end());
+			//    ڼ Ʈ ϹǷ ״ ִ´.
+			for (UINT i = node.ObjectStart; i < node.ObjectStart + node.ObjectCount; ++i)
+			{
+				outObjects->insert(mObjects[mObjectIndices[i]]);
+			}
 			return;
-		case INTERSECTING:
-			if (!node->IsLeaf)
+		case INTERSECTS:
+			if (!node.IsLeaf)
 			{
 				break;
 			}
 
-			for (auto* object : node->Objects)
+			// ̸   AABB ˻ϹǷ  ʿ .
+			for (UINT i = node.ObjectStart; i < node.ObjectStart + node.ObjectCount; ++i)
 			{
-				BoundingFrustum localFrustum;
-				worldfrustum.Transform(localFrustum, object->World.Invert());
+				const UINT objectIndex = mObjectIndices[i];
 
-				if (localFrustum.Intersects(objectBox))
+				if (worldfrustum.Intersects(mObjectBounds[objectIndex]))
 				{
-					outObjects->insert(object);
+					outObjects->insert(mObjects[objectIndex]);
 				}
 			}
 			return;
@@ -203,9 +303,179 @@ namespace frustumCulling
 			break;
 		}
 
-		for (int i = 0; i < 8; ++i)
+		for (UINT i = 0; i < node.ChildCount; ++i)
+		{
+			findIntersectObjectRecursive(node.FirstChild + i, worldfrustum, outObjects);
+		}
+	}
+
+	UINT Octree::cullRecursive(UINT nodeIndex, const FrustumPlanes& planes, UINT* outIndices, UINT capacity, UINT count)
+	{
+		const OctreeNode& node = mNodes[nodeIndex];
+
+		switch (planes.Contains(node.Bounds))
+		{
+		case CONTAINS:
+			return appendRange(node, outIndices, capacity, count);
+		case DISJOINT:
+			return count;
+		default:
+			break;
+		}
+
+		if (!node.IsLeaf)
+		{
+			for (UINT i = 0; i < node.ChildCount; ++i)
+			{
+				count = cullRecursive(node.FirstChild + i, planes, outIndices, capacity, count);
+			}
+
+			return count;
+		}
+
+		for (UINT i = node.ObjectStart; i < node.ObjectStart + node.ObjectCount && count < capacity; ++i)
+		{
+			const UINT objectIndex = mObjectIndices[i];
+
+			if (mStamps[objectIndex] == mGeneration || planes.Contains(mObjectBounds[objectIndex]) == DISJOINT)
+			{
+				continue;
+			}
+
+			mStamps[objectIndex] = mGeneration;
+			outIndices[count++] = objectIndex;
+		}
+
+		return count;
+	}
+	UINT Octree::appendRange(const OctreeNode& node, UINT* outIndices, UINT capacity, UINT count)
+	{
+		for (UINT i = node.ObjectStart; i < node.ObjectStart + node.ObjectCount && count < capacity; ++i)
+		{
+			const UINT objectIndex = mObjectIndices[i];
+
+			if (mStamps[objectIndex] == mGeneration)
+			{
+				continue;
+			}
+
+			mStamps[objectIndex] = mGeneration;
+			outIndices[count++] = objectIndex;
+		}
+
+		return count;
+	}
+	void Octree::collectTaskNodes(const FrustumPlanes& planes, UINT targetCount)
+	{
+		mTaskNodes.clear();
+
+		switch (planes.Contains(mNodes[0].Bounds))
+		{
+		case DISJOINT:
+			return;
+		case CONTAINS:
+			mTaskNodes.push_back(0 | TASK_INSIDE_FLAG);
+			return;
+		default:
+			mTaskNodes.push_back(0);
+			break;
+		}
+
+		// ½ũ   ҿ ģ 带  ܰ辿 ڽ ģ.
+		// ڽ ObjectStart  ̹Ƿ ģ ڿ ½ũ   Ѵ.
+		while (mTaskNodes.size() < targetCount)
 		{
-			findIntersectObjectRecursive(node->Children[i], worldfrustum, outObjects, objectBox);
+			bool bExpanded = false;
+			mNextTaskNodes.clear();
+
+			for (UINT taskNode : mTaskNodes)
+			{
+				const OctreeNode& node = mNodes[taskNode & ~TASK_INSIDE_FLAG];
+
+				if ((taskNode & TASK_INSIDE_FLAG) != 0 || node.IsLeaf)
+				{
+					mNextTaskNodes.push_back(taskNode);
+					continue;
+				}
+
+				bExpanded = true;
+
+				for (UINT i = 0; i < node.ChildCount; ++i)
+				{
+					const UINT childIndex = node.FirstChild + i;
+
+					switch (planes.Contains(mNodes[childIndex].Bounds))
+					{
+					case DISJOINT:
+						break;
+					case CONTAINS:
+						mNextTaskNodes.push_back(childIndex | TASK_INSIDE_FLAG);
+						break;
+					default:
+						mNextTaskNodes.push_back(childIndex);
+						break;
+					}
+				}
+			}
+
+			mTaskNodes.swap(mNextTaskNodes);
+
+			if (!bExpanded)
+			{
+				break;
+			}
 		}
 	}
+
+	UINT Octree::expandBits(UINT v)
+	{
+		// 10Ʈ   Ʈ ̿ 0    ִ´.
+		v = (v * 0x00010001u) & 0xFF0000FFu;
+		v = (v * 0x00000101u) & 0x0F00F00Fu;
+		v = (v * 0x00000011u) & 0xC30C30C3u;
+		v = (v * 0x00000005u) & 0x49249249u;
+
+		return v;
+	}
+	void Octree::radixSort(std::vector<UINT64>* keys)
+	{
+		//  32Ʈ( ڵ 30Ʈ) 11Ʈ 3 LSD  Ѵ.
+		//  ̶   ȿ Ʈ ε  ȴ.
+		enum { RADIX_BITS = 11, BUCKET_COUNT = 1 << RADIX_BITS };
+
+		std::vector<UINT64> temp(keys->size());
+		std::vector<UINT> histogram(BUCKET_COUNT);
+
+		std::vector<UINT64>* src = keys;
+		std::vector<UINT64>* dst = &temp;
+
+		for (UINT pass = 0; pass < 3; ++pass)
+		{
+			const UINT shift = 32 + pass * RADIX_BITS;
+			std::fill(histogram.begin(), histogram.end(), 0u);
+
+			for (UINT64 key : *src)
+			{
+				++histogram[(key >> shift) & (BUCKET_COUNT - 1)];
+			}
+
+			UINT offset = 0;
+			for (UINT& count : histogram)
+			{
+				UINT current = count;
+				count = offset;
+				offset += current;
+			}
+
+			for (UINT64 key : *src)
+			{
+				(*dst)[histogram[(key >> shift) & (BUCKET_COUNT - 1)]++] = key;
+			}
+
+			std::swap(src, dst);
+		}
+
+		// н  Ȧ̹Ƿ  temp ִ.
+		keys->swap(*src);
+	}
 }
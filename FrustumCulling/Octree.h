@@ -5,6 +5,8 @@
 #include <set>
 
 #include "D3DUtil.h"
+#include "FrustumCuller.h"
+#include "JobSystem.h"
 #include "Object.h"
 
 namespace frustumCulling
@@ -13,18 +15,16 @@ namespace frustumCulling
 	using namespace DirectX;
 	using namespace SimpleMath;
 
+	//   ε Ǵ  Ʈ 
+	// ڽ  Octree::mNodes ȿ , Ʈ Octree::mObjectIndices ȿ  ȴ.
 	struct OctreeNode
 	{
-	public:
-		OctreeNode();
-		~OctreeNode();
-		void Subdivide(BoundingBox box[8]);
-
-	public:
-		BoundingBox Bounds;
-		std::vector<Object*> Objects;
-		OctreeNode* Children[8];
-		size_t Depth;
+		BoundingBox Bounds; //  Ʈ  AABB  δ ڽ
+		UINT FirstChild;
+		UINT ChildCount;
+		UINT ObjectStart; // ڽĵ Ʈ   Ѵ.
+		UINT ObjectCount;
+		UINT Depth;
 		bool IsLeaf;
 	};
 
@@ -33,19 +33,63 @@ namespace frustumCulling
 	{
 	public:
 		Octree();
-		~Octree();
+		~Octree() = default;
 
 		void Build(BoundingBox initBox, size_t maxDepth, const std::vector<Object*>& objects, const BoundingBox& objectBox);
-		void FindIntersectObject(const BoundingFrustum& worldfrustum, std::set<Object*>* outObjects, const BoundingBox& objectBox);
+		void FindIntersectObject(const BoundingFrustum& worldfrustum, std::set<Object*>* outObjects);
+
+		//  ȣ ÷  ǵ ߺ    ȿȭѴ.
+		// BeginQuery    ص  Ʈ   ϵȴ.
+		void BeginQuery();
+		// ̴ Ʈ ε   outIndices    ȯѴ.
+		// jobSystem ѱ Ʈ   ķ óϸ,   .
+		UINT FindIntersectObject(const Vector4 worldPlanes[6], UINT* outIndices, UINT capacity, JobSystem* jobSystem = nullptr);
 		void DebugRender(ID3D11DeviceContext* dc, Basic32* basic32, const Matrix& VP);
 
+		inline const std::vector<OctreeNode>& GetNodes() const;
+		inline const std::vector<UINT>& GetObjectIndices() const;
+		inline const std::vector<BoundingBox>& GetObjectBounds() const;
+
 	private:
-		void buildRecursive(OctreeNode* node, const Octree& octree, const std::vector<Object*>& objects, const BoundingBox& objectBox);
-		void findIntersectObjectRecursive(OctreeNode* node, const BoundingFrustum& worldfrustum, std::set<Object*>* outObjects, const BoundingBox& objectBox);
-		void debugRenderRecursive(OctreeNode* node, ID3D11DeviceContext* dc, Basic32* basic32, const Matrix& VP);
+		void buildRecursive(UINT nodeIndex, const std::vector<UINT64>& sortedKeys);
+		void findIntersectObjectRecursive(UINT nodeIndex, const BoundingFrustum& worldfrustum, std::set<Object*>* outObjects);
+		UINT cullRecursive(UINT nodeIndex, const FrustumPlanes& planes, UINT* outIndices, UINT capacity, UINT count);
+		UINT appendRange(const OctreeNode& node, UINT* outIndices, UINT capacity, UINT count);
+		void collectTaskNodes(const FrustumPlanes& planes, UINT targetCount);
+
+		static UINT expandBits(UINT v);
+		static void radixSort(std::vector<UINT64>* keys);
 
 	private:
-		OctreeNode* mRoot;
+		enum { LEAF_OBJECT_COUNT = 100 };
+		enum { MORTON_BITS = 10 }; //  Ʈ , ִ ̵     .
+
+		std::vector<OctreeNode> mNodes; // mNodes[0] Ʈ
+		std::vector<UINT> mObjectIndices; //  ڵ  ĵ Ʈ ε
+		std::vector<BoundingBox> mObjectBounds; // Ʈ  AABB,     
+		std::vector<Object*> mObjects;
 		size_t mMaxDepth;
+
+		// ǿ ,     ҴѴ.
+		static constexpr UINT TASK_INSIDE_FLAG = 0x80000000u;
+		std::vector<UINT> mStamps;
+		UINT mGeneration;
+		std::vector<UINT> mTaskNodes; // ֻ Ʈ ҿ  Ե  ǥ
+		std::vector<UINT> mNextTaskNodes;
+		std::vector<UINT> mTaskCounts;
+		std::vector<UINT> mScratchIndices; // ½ũ ڱ  ObjectStart ġ .
 	};
-};
\ No newline at end of file
+
+	const std::vector<OctreeNode>& Octree::GetNodes() const
+	{
+		return mNodes;
+	}
+	const std::vector<UINT>& Octree::GetObjectIndices() const
+	{
+		return mObjectIndices;
+	}
+	const std::vector<BoundingBox>& Octree::GetObjectBounds() const
+	{
+		return mObjectBounds;
+	}
+};
@@ -1,18 +1,20 @@
 #include <cassert>
+#include <chrono>
 #include <time.h>
 #include <iostream>
 #include <sstream>
-#include <fstream>
 
 #include "D3DSample.h"
 #include "D3DUtil.h"
 #include "MathHelper.h"
+#include "MeshCache.h"
 
 namespace instancingAndCulling
 {
 	D3DSample::D3DSample(HINSTANCE hInstance, UINT width, UINT height, std::wstring name)
 		: D3DProcessor(hInstance, width, height, name)
 		, mFrustumCullingEnabled(true)
+		, mLodEnabled(true)
 	{
 		srand((unsigned int)time((time_t*)NULL));
 
@@ -86,8 +88,6 @@ namespace instancingAndCulling
 		D3DProcessor::OnResize();
 
 		mCam.SetLens(0.25f * MathHelper::Pi, GetAspectRatio(), 1.0f, 1000.0f);
-
-		BoundingFrustum::CreateFromMatrix(mCamFrustum, mCam.GetProj());
 	}
 
 	void D3DSample::Update(float deltaTime)
@@ -110,58 +110,82 @@ namespace instancingAndCulling
 		if (GetAsyncKeyState('2') & 0x8000)
 			mFrustumCullingEnabled = false;
 
-		mCam.UpdateViewMatrix();
-		mVisibleObjectCount = 0;
+		if (GetAsyncKeyState('3') & 0x8000)
+			mLodEnabled = true;
 
-		if (mFrustumCullingEnabled)
-		{
-			Matrix invView;
-			mCam.GetView().Invert(invView);
+		if (GetAsyncKeyState('4') & 0x8000)
+			mLodEnabled = false;
+
+		if (GetAsyncKeyState('B') & 0x0001)
+			benchmarkInstanceCulling();
 
-			D3D11_MAPPED_SUBRESOURCE mappedData;
-			md3dContext->Map(mInstancedBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedData);
+		mCam.UpdateViewMatrix();
+		mVisibleObjectCount = 0;
+		memset(mLodInstanceStarts, 0, sizeof(mLodInstanceStarts));
+		memset(mLodInstanceCounts, 0, sizeof(mLodInstanceCounts));
 
-			InstancedData* dataView = reinterpret_cast<InstancedData*>(mappedData.pData);
+		Vector4 worldPlanes[6];
+		D3DHelper::ExtractFrustumPlanes(worldPlanes, mCam.GetViewProj());
 
-			for (UINT i = 0; i < mInstancedData.size(); ++i)
-			{
-				const auto& instancedData = mInstancedData[i];
+		FrustumPlanes planes;
+		planes.Set(worldPlanes);
 
-				Matrix invWorld;
-				instancedData.World.Invert(invWorld);
+		D3D11_MAPPED_SUBRESOURCE mappedData;
+		md3dContext->Map(mInstancedBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedData);
 
-				Matrix toLocal = invView * invWorld;
-				BoundingFrustum localspaceFrustum;
-				mCamFrustum.Transform(localspaceFrustum, toLocal);
+		InstancedData* dataView = reinterpret_cast<InstancedData*>(mappedData.pData);
+		const UINT instanceCount = static_cast<UINT>(mInstancedData.size());
 
-				if (localspaceFrustum.Intersects(mSkullBox))
+		if (mLodEnabled)
+		{
+			// LOD   ε ķ   LOD  Ѹ.
+			UINT visibleCount = instanceCount;
+			if (mFrustumCullingEnabled)
+			{
+				visibleCount = mInstanceCuller.Cull(planes, &mVisibleIndices[0], &mJobSystem);
+			}
+			else
+			{
+				for (UINT i = 0; i < instanceCount; ++i)
 				{
-					dataView[mVisibleObjectCount++] = instancedData;
+					mVisibleIndices[i] = i;
 				}
 			}
 
-			md3dContext->Unmap(mInstancedBuffer, 0);
+			mLodSelector.SetCamera(mCam, static_cast<float>(GetHeight()));
+			bucketInstancesByLod(&mVisibleIndices[0], visibleCount, dataView);
+			mVisibleObjectCount = visibleCount;
+		}
+		else if (mFrustumCullingEnabled)
+		{
+			// Ƴ νϽ ε ۿ ٷ .
+			mVisibleObjectCount = mInstanceCuller.CullCopy(planes, &mInstancedData[0], dataView, &mJobSystem);
 		}
 		else
 		{
-			D3D11_MAPPED_SUBRESOURCE mappedData;
-			md3dContext->Map(mInstancedBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedData);
-
-			InstancedData* dataView = reinterpret_cast<InstancedData*>(mappedData.pData);
-
-			for (UINT i = 0; i < mInstancedData.size(); ++i)
+			for (UINT i = 0; i < instanceCount; ++i)
 			{
 				dataView[mVisibleObjectCount++] = mInstancedData[i];
 			}
+		}
+
+		md3dContext->Unmap(mInstancedBuffer, 0);
 
-			md3dContext->Unmap(mInstancedBuffer, 0);
+		if (!mLodEnabled)
+		{
+			mLodInstanceCounts[0] = mVisibleObjectCount;
 		}
 
 		std::wostringstream outs;
 		outs.precision(6);
 		outs << L"Instancing and Culling Demo" <<
 			L"    " << mVisibleObjectCount <<
-			L" objects visible out of " << mInstancedData.size();
+			L" objects visible out of " << mInstancedData.size() <<
+			L"    LOD";
+		for (size_t i = 0; i < mSkullLods.size(); ++i)
+		{
+			outs << L" " << mLodInstanceCounts[i];
+		}
 		mTitle = outs.str();
 	}
 
@@ -213,12 +237,21 @@ namespace instancingAndCulling
 		md3dContext->VSSetShader(mVertexShader, 0, 0);
 		md3dContext->PSSetShader(mPixelShader, 0, 0);
 
-		md3dContext->DrawIndexedInstanced(
-			mSkullIndexCount, // νϽ  
-			mVisibleObjectCount, // νϽ 
-			0, //   offset
-			0, //   offset
-			0); // νϽ  offset
+		// LOD ε  νϽ  ޶ LOD ŭ  ׸.
+		for (size_t i = 0; i < mSkullLods.size(); ++i)
+		{
+			if (mLodInstanceCounts[i] == 0)
+			{
+				continue;
+			}
+
+			md3dContext->DrawIndexedInstanced(
+				mSkullLods[i].IndexCount, // νϽ  
+				mLodInstanceCounts[i], // νϽ 
+				mSkullLods[i].IndexStart, //   offset
+				0, //   offset
+				mLodInstanceStarts[i]); // νϽ  offset
+		}
 
 		HR(mSwapChain->Present(0, 0));
 	}
@@ -326,54 +359,29 @@ namespace instancingAndCulling
 
 	void D3DSample::buildSkullGeometryBuffers()
 	{
-		std::ifstream fin("../Resource/Models/skull.txt");
+		MeshCache mesh;
 
-		if (!fin)
+		if (!mesh.Load("../Resource/Models/skull.txt", &mJobSystem))
 		{
 			MessageBox(0, L"Models/skull.txt not found.", 0, 0);
 			return;
 		}
 
-		UINT vcount = 0;
-		UINT tcount = 0;
-		std::string ignore;
-
-		fin >> ignore >> vcount;
-		fin >> ignore >> tcount;
-		fin >> ignore >> ignore >> ignore >> ignore;
-
-		XMFLOAT3 vMinf3(+MathHelper::Infinity, +MathHelper::Infinity, +MathHelper::Infinity);
-		XMFLOAT3 vMaxf3(-MathHelper::Infinity, -MathHelper::Infinity, -MathHelper::Infinity);
-
-		XMVECTOR vMin = XMLoadFloat3(&vMinf3);
-		XMVECTOR vMax = XMLoadFloat3(&vMaxf3);
-		std::vector<Basic32> vertices(vcount);
-		for (UINT i = 0; i < vcount; ++i)
-		{
-			fin >> vertices[i].Pos.x >> vertices[i].Pos.y >> vertices[i].Pos.z;
-			fin >> vertices[i].Normal.x >> vertices[i].Normal.y >> vertices[i].Normal.z;
-
-			XMVECTOR P = XMLoadFloat3(&vertices[i].Pos);
-
-			vMin = XMVectorMin(vMin, P);
-			vMax = XMVectorMax(vMax, P);
-		}
-
-		XMStoreFloat3(&mSkullBox.Center, 0.5f * (vMin + vMax));
-		XMStoreFloat3(&mSkullBox.Extents, 0.5f * (vMax - vMin));
+		// ĳ  Basic32 ġ  ε ޸𸮸 ״ ۿ ø.
+		static_assert(sizeof(Basic32) == sizeof(MeshVertex), "vertex layout mismatch");
 
-		fin >> ignore;
-		fin >> ignore;
-		fin >> ignore;
+		UINT vcount = mesh.GetVertexCount();
+		mSkullBox = mesh.GetBounds();
 
-		mSkullIndexCount = 3 * tcount;
-		std::vector<UINT> indices(mSkullIndexCount);
-		for (UINT i = 0; i < tcount; ++i)
-		{
-			fin >> indices[i * 3 + 0] >> indices[i * 3 + 1] >> indices[i * 3 + 2];
-		}
+		const MeshVertex* vertices = mesh.GetVertices();
+		BoundingSphere::CreateFromPoints(mSkullSphere, vcount, &vertices[0].Pos, sizeof(MeshVertex));
 
-		fin.close();
+		// ε  LOD ü .   1 ذ ũ 1% Ÿ  .
+		const float normalWeights[3] = { 0.01f, 0.01f, 0.01f };
+		std::vector<UINT> indices;
+		MeshSimplifier::BuildLodChain(mesh.GetIndices(), mesh.GetIndexCount(), &vertices[0].Pos.x, sizeof(MeshVertex), vcount,
+			&indices, &mSkullLods, MeshSimplifier::DEFAULT_LOD_COUNT,
+			&vertices[0].Normal.x, sizeof(MeshVertex), normalWeights, 3);
 
 		D3D11_BUFFER_DESC vbd;
 		vbd.Usage = D3D11_USAGE_IMMUTABLE;
@@ -382,7 +390,7 @@ namespace instancingAndCulling
 		vbd.CPUAccessFlags = 0;
 		vbd.MiscFlags = 0;
 		D3D11_SUBRESOURCE_DATA vinitData;
-		vinitData.pSysMem = &vertices[0];
+		vinitData.pSysMem = mesh.GetVertices();
 		HR(md3dDevice->CreateBuffer(&vbd, &vinitData, &mSkullVB));
 
 		//
@@ -391,7 +399,7 @@ namespace instancingAndCulling
 
 		D3D11_BUFFER_DESC ibd;
 		ibd.Usage = D3D11_USAGE_IMMUTABLE;
-		ibd.ByteWidth = sizeof(UINT) * mSkullIndexCount;
+		ibd.ByteWidth = static_cast<UINT>(sizeof(UINT) * indices.size());
 		ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
 		ibd.CPUAccessFlags = 0;
 		ibd.MiscFlags = 0;
@@ -444,6 +452,23 @@ namespace instancingAndCulling
 			}
 		}
 
+		// νϽ  Ƿ  AABB LOD ÿ      д.
+		// ̵ ϹǷ ڽ ũ   ÷ ߽ɸ д.
+		mInstanceCuller.SetSharedExtents(mSkullBox.Extents);
+		mInstanceCuller.Resize(static_cast<UINT>(mInstancedData.size()));
+		mInstanceSpheres.resize(mInstancedData.size());
+		for (UINT i = 0; i < mInstancedData.size(); ++i)
+		{
+			BoundingBox worldBox;
+			mSkullBox.Transform(worldBox, mInstancedData[i].World);
+			mInstanceCuller.SetCenter(i, worldBox.Center);
+
+			mSkullSphere.Transform(mInstanceSpheres[i], mInstancedData[i].World);
+		}
+
+		mVisibleIndices.resize(mInstancedData.size());
+		mVisibleLods.resize(mInstancedData.size());
+
 		// νϽ̵  ũ⸸ŭ ̸ ۸ Ƽ Ѵ.
 		D3D11_BUFFER_DESC vbd;
 		vbd.Usage = D3D11_USAGE_DYNAMIC;
@@ -458,4 +483,125 @@ namespace instancingAndCulling
 
 		HR(md3dDevice->CreateBuffer(&vbd, &vinitData, &mInstancedBuffer));
 	}
-}
\ No newline at end of file
+	void D3DSample::bucketInstancesByLod(const UINT* visibleIndices, UINT visibleCount, InstancedData* dest)
+	{
+		const UINT lodCount = static_cast<UINT>(mSkullLods.size());
+
+		// 1. νϽ LOD  LOD  .
+		for (UINT i = 0; i < visibleCount; ++i)
+		{
+			const BoundingSphere& sphere = mInstanceSpheres[visibleIndices[i]];
+			const float worldScale = sphere.Radius / mSkullSphere.Radius;
+			const UINT lod = mLodSelector.Select(&mSkullLods[0], lodCount, sphere.Center, sphere.Radius, worldScale);
+
+			mVisibleLods[i] = static_cast<BYTE>(lod);
+			++mLodInstanceCounts[lod];
+		}
+
+		// 2.   LOD  ġ ϰ ø   ä Ѹ.
+		UINT cursor[MeshSimplifier::DEFAULT_LOD_COUNT];
+		UINT start = 0;
+		for (UINT lod = 0; lod < lodCount; ++lod)
+		{
+			mLodInstanceStarts[lod] = start;
+			cursor[lod] = start;
+			start += mLodInstanceCounts[lod];
+		}
+
+		for (UINT i = 0; i < visibleCount; ++i)
+		{
+			dest[cursor[mVisibleLods[i]]++] = mInstancedData[visibleIndices[i]];
+		}
+	}
+	void D3DSample::benchmarkInstanceCulling()
+	{
+		// 1M νϽ  ѷ ΰ ø ð .
+		enum { BENCHMARK_COUNT = 1 << 20 };
+		enum { ITERATION_COUNT = 20 };
+		const float HALF = 500.f;
+
+		std::vector<InstancedData> source(BENCHMARK_COUNT);
+		std::vector<InstancedData> dest(BENCHMARK_COUNT);
+		std::vector<UINT> visibleIndices(BENCHMARK_COUNT);
+		FrustumCuller culler;
+		culler.SetSharedExtents(mSkullBox.Extents);
+		culler.Resize(BENCHMARK_COUNT);
+
+		for (UINT i = 0; i < BENCHMARK_COUNT; ++i)
+		{
+			source[i].World = Matrix::CreateTranslation(MathHelper::RandF(-HALF, HALF), MathHelper::RandF(-HALF, HALF), MathHelper::RandF(-HALF, HALF));
+			source[i].Color = Color(1.f, 1.f, 1.f, 1.f);
+
+			BoundingBox worldBox;
+			mSkullBox.Transform(worldBox, source[i].World);
+			culler.SetCenter(i, worldBox.Center);
+		}
+
+		Vector4 worldPlanes[6];
+		D3DHelper::ExtractFrustumPlanes(worldPlanes, mCam.GetViewProj());
+
+		FrustumPlanes planes;
+		planes.Set(worldPlanes);
+
+		using Clock = std::chrono::high_resolution_clock;
+
+		//  : νϽ    Űܼ ˻
+		Clock::time_point start = Clock::now();
+		BoundingFrustum viewFrustum(mCam.GetProj());
+		Matrix invView = mCam.GetView().Invert();
+		UINT legacyCount = 0;
+		for (UINT i = 0; i < BENCHMARK_COUNT; ++i)
+		{
+			Matrix invWorld;
+			source[i].World.Invert(invWorld);
+
+			BoundingFrustum localspaceFrustum;
+			viewFrustum.Transform(localspaceFrustum, invView * invWorld);
+
+			if (localspaceFrustum.Intersects(mSkullBox))
+			{
+				dest[legacyCount++] = source[i];
+			}
+		}
+		double legacyMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+		UINT indexCount = 0;
+		start = Clock::now();
+		for (int i = 0; i < ITERATION_COUNT; ++i)
+		{
+			indexCount = culler.Cull(planes, 0, BENCHMARK_COUNT, &visibleIndices[0]);
+		}
+		double indexMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / ITERATION_COUNT;
+
+		UINT copyCount = 0;
+		start = Clock::now();
+		for (int i = 0; i < ITERATION_COUNT; ++i)
+		{
+			copyCount = culler.CullCopy(planes, &source[0], &dest[0]);
+		}
+		double copyMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / ITERATION_COUNT;
+
+		UINT parallelCount = 0;
+		start = Clock::now();
+		for (int i = 0; i < ITERATION_COUNT; ++i)
+		{
+			parallelCount = culler.CullCopy(planes, &source[0], &dest[0], &mJobSystem);
+		}
+		double parallelMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / ITERATION_COUNT;
+
+		std::wostringstream outs;
+		outs.precision(4);
+		outs << L"[Instance culling benchmark] instances " << static_cast<UINT>(BENCHMARK_COUNT)
+			<< L", bounds " << culler.GetBoundsByteSize() / (1024 * 1024) << L" MB"
+#if defined(__AVX__)
+			<< L", AVX\n"
+#else
+			<< L", SSE\n"
+#endif
+			<< L"  per-instance frustum : " << legacyMs << L" ms, visible " << legacyCount << L"\n"
+			<< L"  SoA batch (indices)  : " << indexMs << L" ms, visible " << indexCount << L"\n"
+			<< L"  SoA batch (copy)     : " << copyMs << L" ms, visible " << copyCount << L"\n"
+			<< L"  parallel(" << mJobSystem.GetThreadCount() << L")          : " << parallelMs << L" ms, visible " << parallelCount << L"\n";
+		OutputDebugStringW(outs.str().c_str());
+	}
+}
@@ -6,7 +6,10 @@
 
 #include "D3dProcessor.h"
 #include "Camera.h"
+#include "FrustumCuller.h"
 #include "LightHelper.h"
+#include "LodSelector.h"
+#include "MeshSimplifier.h"
 
 namespace instancingAndCulling
 {
@@ -71,6 +74,10 @@ namespace instancingAndCulling
 		void buildSkullGeometryBuffers();
 		void buildInstancedBuffer();
 
+		void benchmarkInstanceCulling();
+		// ̴ νϽ LOD  ε ۿ LOD  .
+		void bucketInstancesByLod(const UINT* visibleIndices, UINT visibleCount, InstancedData* dest);
+
 	private:
 		CBPerObject mCBPerObject;
 		CBPerFrame mCBPerFrame;
@@ -90,14 +97,29 @@ namespace instancingAndCulling
 
 		// Bounding box of the skull.
 		BoundingBox mSkullBox;
-		BoundingFrustum mCamFrustum;
+		BoundingSphere mSkullSphere;
+
+		// ذ LOD ü,  LOD ε mSkullIB ϳ ̾ ִ.
+		std::vector<MeshLod> mSkullLods;
+		LodSelector mLodSelector;
+
+		// νϽ  AABB SoA  ִ ÷
+		FrustumCuller mInstanceCuller;
+		JobSystem mJobSystem;
 
 		UINT mVisibleObjectCount;
+		// LOD νϽ  , LOD i [mLodInstanceStarts[i], mLodInstanceStarts[i] + mLodInstanceCounts[i])
+		UINT mLodInstanceStarts[MeshSimplifier::DEFAULT_LOD_COUNT];
+		UINT mLodInstanceCounts[MeshSimplifier::DEFAULT_LOD_COUNT];
 
 		// Keep a system memory copy of the world matrices for culling.
 		std::vector<InstancedData> mInstancedData;
+		std::vector<BoundingSphere> mInstanceSpheres;
+		std::vector<UINT> mVisibleIndices;
+		std::vector<BYTE> mVisibleLods;
 
 		bool mFrustumCullingEnabled;
+		bool mLodEnabled;
 
 		DirectionLight mDirLights[3];
 		Material mSkullMat;
@@ -105,8 +127,6 @@ namespace instancingAndCulling
 		// Define transformations from local spaces to world space.
 		Matrix mSkullWorld;
 
-		UINT mSkullIndexCount;
-
 		Camera mCam;
 
 		POINT mLastMousePos;
@@ -1,8 +1,8 @@
 #include <cassert>
-#include <fstream>
 
 #include "D3DSample.h"
 #include "D3DUtil.h"
+#include "TextMeshParser.h"
 
 namespace lighting
 {
@@ -561,43 +561,26 @@ namespace lighting
 
 	void D3DSample::buildSkull()
 	{
-		std::ifstream fin("../Resource/Models/skull.txt");
+		std::vector<MeshVertex> meshVertices;
+		std::vector<UINT> indices;
 
-		if (!fin)
+		if (!TextMeshParser::Load("../Resource/Models/skull.txt", &meshVertices, &indices))
 		{
 			MessageBox(0, L"Models/skull.txt not found.", 0, 0);
 			return;
 		}
 
-		UINT vcount = 0;
-		UINT tcount = 0;
-		std::string ignore;
-
-		fin >> ignore >> vcount;
-		fin >> ignore >> tcount;
-		fin >> ignore >> ignore >> ignore >> ignore;
-
-		float nx, ny, nz;
+		UINT vcount = static_cast<UINT>(meshVertices.size());
+		UINT tcount = static_cast<UINT>(indices.size() / 3);
 
 		std::vector<Vertex> vertices(vcount);
 		for (UINT i = 0; i < vcount; ++i)
 		{
-			fin >> vertices[i].Position.x >> vertices[i].Position.y >> vertices[i].Position.z;
-			fin >> vertices[i].Normal.x >> vertices[i].Normal.y >> vertices[i].Normal.z;
+			vertices[i].Position = meshVertices[i].Pos;
+			vertices[i].Normal = meshVertices[i].Normal;
 		}
 
-		fin >> ignore;
-		fin >> ignore;
-		fin >> ignore;
-
 		mSkullModel.IndexCount = 3 * tcount;
-		std::vector<UINT> indices(mSkullModel.IndexCount);
-		for (UINT i = 0; i < tcount; ++i)
-		{
-			fin >> indices[i * 3 + 0] >> indices[i * 3 + 1] >> indices[i * 3 + 2];
-		}
-
-		fin.close();
 
 		D3D11_BUFFER_DESC vbd;
 		vbd.Usage = D3D11_USAGE_IMMUTABLE;
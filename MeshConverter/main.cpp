@@ -0,0 +1,199 @@
+#include <windows.h>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AmbientOcclusionBaker.h"
+#include "Bvh.h"
+#include "JobSystem.h"
+#include "MeshCache.h"
+#include "MeshOptimizer.h"
+#include "TextMeshParser.h"
+
+using namespace common;
+
+namespace
+{
+	struct ConvertOptions
+	{
+		const char* InputFileName = nullptr;
+		const char* OutputFileName = nullptr;
+		UINT AmbientSampleCount = 0; // 0̸ ֺ ޵  ʴ´.
+		UINT AmbientSeed = 0;
+		bool bBuildBvh = false;
+		bool bOptimize = true;
+		float OverdrawThreshold = 0.0f; // 0̸  ġ  ʴ´.
+	};
+
+	void printUsage()
+	{
+		std::cout << "usage: MeshConverter <model.txt> [-o model.mesh] [-ao samples] [-aoseed N] [-bvh] [-overdraw threshold] [-nooptimize]" << std::endl;
+		std::cout << "  -ao          bake per-vertex ambient access with the given sample count" << std::endl;
+		std::cout << "  -aoseed      seed of the ambient occlusion sample pattern (default 0)" << std::endl;
+		std::cout << "  -bvh         store the ray tracing BVH (always stored with -ao)" << std::endl;
+		std::cout << "  -overdraw    also reorder for overdraw, allowing ACMR to grow by threshold (e.g. 1.05)" << std::endl;
+		std::cout << "  -nooptimize  keep the source triangle and vertex order" << std::endl;
+	}
+
+	bool parseOptions(int argc, char* argv[], ConvertOptions* outOptions)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const char* arg = argv[i];
+
+			if (strcmp(arg, "-o") == 0 && i + 1 < argc)
+			{
+				outOptions->OutputFileName = argv[++i];
+			}
+			else if (strcmp(arg, "-ao") == 0 && i + 1 < argc)
+			{
+				outOptions->AmbientSampleCount = static_cast<UINT>(strtoul(argv[++i], nullptr, 10));
+			}
+			else if (strcmp(arg, "-aoseed") == 0 && i + 1 < argc)
+			{
+				outOptions->AmbientSeed = static_cast<UINT>(strtoul(argv[++i], nullptr, 10));
+			}
+			else if (strcmp(arg, "-bvh") == 0)
+			{
+				outOptions->bBuildBvh = true;
+			}
+			else if (strcmp(arg, "-overdraw") == 0 && i + 1 < argc)
+			{
+				outOptions->OverdrawThreshold = static_cast<float>(atof(argv[++i]));
+			}
+			else if (strcmp(arg, "-nooptimize") == 0)
+			{
+				outOptions->bOptimize = false;
+			}
+			else if (arg[0] != '-' && outOptions->InputFileName == nullptr)
+			{
+				outOptions->InputFileName = arg;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		return outOptions->InputFileName != nullptr;
+	}
+}
+
+// ؽƮ  ̳ʸ ޽ ĳ÷ ٲ۴. ֺ ޵ BVH ̸    ִ.
+int main(int argc, char* argv[])
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	ConvertOptions options;
+
+	if (!parseOptions(argc, argv, &options))
+	{
+		printUsage();
+		return 1;
+	}
+
+	const std::string inputFileName = options.InputFileName;
+	const std::string outputFileName = options.OutputFileName != nullptr ? options.OutputFileName : MeshCache::GetCacheFileName(inputFileName);
+
+	JobSystem jobSystem;
+	std::vector<MeshVertex> vertices;
+	std::vector<UINT> indices;
+
+	Clock::time_point start = Clock::now();
+	if (!TextMeshParser::Load(inputFileName, &vertices, &indices, &jobSystem))
+	{
+		std::cout << "failed to load " << inputFileName << std::endl;
+		return 1;
+	}
+	const double textMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+	std::cout << inputFileName << ": " << vertices.size() << " vertices, " << indices.size() / 3 << " triangles, text parse " << textMs << " ms" << std::endl;
+
+	if (options.bOptimize)
+	{
+		const UINT vertexCount = static_cast<UINT>(vertices.size());
+		const VertexCacheStatistics fifoBefore = MeshOptimizer::AnalyzeVertexCache(indices.data(), indices.size(), vertexCount);
+		const VertexCacheStatistics lruBefore = MeshOptimizer::AnalyzeVertexCache(indices.data(), indices.size(), vertexCount,
+			MeshOptimizer::CACHE_MODEL_LRU, MeshOptimizer::VERTEX_CACHE_SIZE);
+
+		start = Clock::now();
+		MeshOptimizer::Optimize(vertices.data(), vertexCount, indices.data(), indices.size(), &MeshVertex::Pos, options.OverdrawThreshold);
+		const double optimizeMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+		const VertexCacheStatistics fifoAfter = MeshOptimizer::AnalyzeVertexCache(indices.data(), indices.size(), vertexCount);
+		const VertexCacheStatistics lruAfter = MeshOptimizer::AnalyzeVertexCache(indices.data(), indices.size(), vertexCount,
+			MeshOptimizer::CACHE_MODEL_LRU, MeshOptimizer::VERTEX_CACHE_SIZE);
+
+		std::cout << "  optimize " << optimizeMs << " ms";
+		if (options.OverdrawThreshold > 0.0f)
+		{
+			std::cout << ", overdraw threshold " << options.OverdrawThreshold;
+		}
+		std::cout << std::endl;
+		std::cout << "    FIFO " << MeshOptimizer::FIFO_CACHE_SIZE << "  ACMR " << fifoBefore.Acmr << " -> " << fifoAfter.Acmr
+			<< ", ATVR " << fifoBefore.Atvr << " -> " << fifoAfter.Atvr << std::endl;
+		std::cout << "    LRU " << MeshOptimizer::VERTEX_CACHE_SIZE << "   ACMR " << lruBefore.Acmr << " -> " << lruAfter.Acmr
+			<< ", ATVR " << lruBefore.Atvr << " -> " << lruAfter.Atvr << std::endl;
+	}
+
+	std::vector<Vector3> positions(vertices.size());
+	for (size_t i = 0; i < vertices.size(); ++i)
+	{
+		positions[i] = vertices[i].Pos;
+	}
+
+	std::vector<float> ambientAccess;
+	AmbientOcclusionBaker baker;
+	Bvh bvh;
+	const Bvh* bvhToWrite = nullptr;
+
+	if (options.AmbientSampleCount > 0)
+	{
+		start = Clock::now();
+		baker.Init(positions, indices, options.AmbientSeed);
+		baker.Accumulate(options.AmbientSampleCount, &jobSystem);
+		baker.GetVertexAmbientAccess(&ambientAccess);
+		bvhToWrite = &baker.GetBvh();
+
+		std::cout << "  ambient occlusion " << options.AmbientSampleCount << " samples, "
+			<< std::chrono::duration<double, std::milli>(Clock::now() - start).count() << " ms" << std::endl;
+	}
+	else if (options.bBuildBvh)
+	{
+		bvh.Build(positions, indices);
+		bvhToWrite = &bvh;
+	}
+
+	const MeshCache::AmbientBakeKey ambientKey = { options.AmbientSampleCount, options.AmbientSeed, AmbientOcclusionBaker::ALGORITHM_VERSION };
+	if (!MeshCache::Write(outputFileName, vertices, indices,
+		options.AmbientSampleCount > 0 ? &ambientAccess : nullptr, &ambientKey, bvhToWrite))
+	{
+		std::cout << "failed to write " << outputFileName << std::endl;
+		return 1;
+	}
+
+	//   ٽ   ε ð ȮѴ.
+	MeshCache cache;
+
+	start = Clock::now();
+	if (!cache.Open(outputFileName))
+	{
+		std::cout << "failed to open " << outputFileName << std::endl;
+		return 1;
+	}
+	const double mapMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+	const bool bIdentical = cache.GetVertexCount() == vertices.size() && cache.GetIndexCount() == indices.size()
+		&& memcmp(cache.GetVertices(), vertices.data(), vertices.size() * sizeof(MeshVertex)) == 0
+		&& memcmp(cache.GetIndices(), indices.data(), indices.size() * sizeof(UINT)) == 0;
+
+	std::cout << "  wrote " << outputFileName << ", map " << mapMs << " ms"
+		<< (cache.GetAmbientAccess() != nullptr ? ", ambient access" : "")
+		<< (bvhToWrite != nullptr ? ", bvh" : "")
+		<< (bIdentical ? ", verified" : ", MISMATCH") << std::endl;
+
+	return bIdentical ? 0 : 2;
+}
@@ -1,4 +1,5 @@
 #include <cstdio>
+#include <windows.h>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include <assimp/Importer.hpp>
@@ -6,6 +7,8 @@
 #include <assimp/LogStream.hpp>
 
 #include "Mesh.h"
+#include "MeshOptimizer.h"
+#include "VertexWelder.h"
 
 namespace {
 	const unsigned int ImportFlags =
@@ -61,6 +64,17 @@ Mesh::Mesh(const aiMesh* mesh)
 		assert(mesh->mFaces[i].mNumIndices == 3);
 		m_faces.push_back({ mesh->mFaces[i].mIndices[0], mesh->mFaces[i].mIndices[1], mesh->mFaces[i].mIndices[2] });
 	}
+
+	// The importer emits a vertex per face corner; merge corners that share position, normal and UV.
+	const size_t importedCount = m_vertices.size();
+	const UINT weldedCount = common::VertexWelder::Weld(m_vertices.data(), static_cast<UINT>(m_vertices.size()),
+		reinterpret_cast<UINT*>(m_faces.data()), m_faces.size() * 3, &Vertex::position, &Vertex::normal, &Vertex::texcoord);
+	m_vertices.resize(weldedCount);
+	std::printf("Welded vertices: %zu -> %u\n", importedCount, weldedCount);
+
+	// Reorder triangles for the post-transform vertex cache and vertices for fetch locality.
+	common::MeshOptimizer::Optimize(m_vertices.data(), static_cast<UINT>(m_vertices.size()),
+		reinterpret_cast<UINT*>(m_faces.data()), m_faces.size() * 3, &Vertex::position);
 }
 
 std::shared_ptr<Mesh> Mesh::fromFile(const std::string& filename)
@@ -1,8 +1,9 @@
 #include <cassert>
-#include <fstream>
 
 #include "D3DSample.h"
 #include "RenderStates.h"
+#include "JobSystem.h"
+#include "MeshCache.h"
 
 namespace picking
 {
@@ -331,54 +332,25 @@ namespace picking
 
 	void D3DSample::buildMeshGeometryBuffers()
 	{
-		std::ifstream fin("../Resource/Models/car.txt");
+		JobSystem jobSystem;
+		MeshCache mesh;
 
-		if (!fin)
+		if (!mesh.Load("../Resource/Models/car.txt", &jobSystem))
 		{
 			MessageBox(0, L"Models/car.txt not found.", 0, 0);
 			return;
 		}
 
-		UINT vcount = 0;
-		UINT tcount = 0;
-		std::string ignore;
+		// ŷ CPU ﰢ ˻ϹǷ ε ͸  д.
+		static_assert(sizeof(Basic32) == sizeof(MeshVertex), "vertex layout mismatch");
 
-		fin >> ignore >> vcount;
-		fin >> ignore >> tcount;
-		fin >> ignore >> ignore >> ignore >> ignore;
+		UINT vcount = mesh.GetVertexCount();
+		mMeshIndexCount = mesh.GetIndexCount();
+		mMeshBox = mesh.GetBounds();
 
-		Vector3 vMinf3(+MathHelper::Infinity, +MathHelper::Infinity, +MathHelper::Infinity);
-		Vector3 vMaxf3(-MathHelper::Infinity, -MathHelper::Infinity, -MathHelper::Infinity);
-
-		Vector3 vMin = vMinf3;
-		Vector3 vMax = vMaxf3;
-		mMeshVertices.resize(vcount);
-		for (UINT i = 0; i < vcount; ++i)
-		{
-			fin >> mMeshVertices[i].Pos.x >> mMeshVertices[i].Pos.y >> mMeshVertices[i].Pos.z;
-			fin >> mMeshVertices[i].Normal.x >> mMeshVertices[i].Normal.y >> mMeshVertices[i].Normal.z;
-
-			Vector3 P = mMeshVertices[i].Pos;
-
-			vMin = XMVectorMin(vMin, P);
-			vMax = XMVectorMax(vMax, P);
-		}
-
-		XMStoreFloat3(&mMeshBox.Center, 0.5f * (vMin + vMax));
-		XMStoreFloat3(&mMeshBox.Extents, 0.5f * (vMax - vMin));
-
-		fin >> ignore;
-		fin >> ignore;
-		fin >> ignore;
-
-		mMeshIndexCount = 3 * tcount;
-		mMeshIndices.resize(mMeshIndexCount);
-		for (UINT i = 0; i < tcount; ++i)
-		{
-			fin >> mMeshIndices[i * 3 + 0] >> mMeshIndices[i * 3 + 1] >> mMeshIndices[i * 3 + 2];
-		}
-
-		fin.close();
+		const Basic32* meshVertices = reinterpret_cast<const Basic32*>(mesh.GetVertices());
+		mMeshVertices.assign(meshVertices, meshVertices + vcount);
+		mMeshIndices.assign(mesh.GetIndices(), mesh.GetIndices() + mMeshIndexCount);
 
 		D3D11_BUFFER_DESC vbd;
 		vbd.Usage = D3D11_USAGE_IMMUTABLE;
@@ -0,0 +1,223 @@
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+
+#include "AnimatedBounds.h"
+
+namespace resourceManager
+{
+	using namespace DirectX::SimpleMath;
+
+	namespace
+	{
+		// v * M AABB, ũ  3x3  ű.
+		MinMaxBox transformBox(const MinMaxBox& box, const Matrix& matrix)
+		{
+			const Vector3 center = Vector3::Transform((box.Min + box.Max) * 0.5f, matrix);
+			const Vector3 extents = (box.Max - box.Min) * 0.5f;
+			const Vector3 transformedExtents(
+				fabsf(matrix._11) * extents.x + fabsf(matrix._21) * extents.y + fabsf(matrix._31) * extents.z,
+				fabsf(matrix._12) * extents.x + fabsf(matrix._22) * extents.y + fabsf(matrix._32) * extents.z,
+				fabsf(matrix._13) * extents.x + fabsf(matrix._23) * extents.y + fabsf(matrix._33) * extents.z);
+
+			MinMaxBox result;
+			result.Min = center - transformedExtents;
+			result.Max = center + transformedExtents;
+
+			return result;
+		}
+
+		// Ǯ  value Ŀ ʴ  ū ĭ
+		uint16_t quantizeFloor(float value, float origin, float step)
+		{
+			if (step <= 0.f)
+			{
+				return 0;
+			}
+
+			int quantized = std::min<int>(std::max<int>(static_cast<int>(floorf((value - origin) / step)), 0), AnimatedBounds::QUANTIZED_MAX);
+			while (quantized > 0 && origin + quantized * step > value)
+			{
+				--quantized;
+			}
+
+			return static_cast<uint16_t>(quantized);
+		}
+
+		// Ǯ  value ۾ ʴ   ĭ
+		uint16_t quantizeCeil(float value, float origin, float step)
+		{
+			if (step <= 0.f)
+			{
+				return 0;
+			}
+
+			int quantized = std::min<int>(std::max<int>(static_cast<int>(ceilf((value - origin) / step)), 0), AnimatedBounds::QUANTIZED_MAX);
+			while (quantized < AnimatedBounds::QUANTIZED_MAX && origin + quantized * step < value)
+			{
+				++quantized;
+			}
+
+			return static_cast<uint16_t>(quantized);
+		}
+	}
+
+	MinMaxBox::MinMaxBox()
+		: Min(FLT_MAX, FLT_MAX, FLT_MAX)
+		, Max(-FLT_MAX, -FLT_MAX, -FLT_MAX)
+	{
+	}
+
+	AnimatedBounds::AnimatedBounds()
+		: mDuration(0.f)
+		, mIntervalTime(0.f)
+		, mIntervalCount(0)
+		, mStep(Vector3::Zero)
+	{
+	}
+
+	void AnimatedBounds::AddBoneBoxes(const vertex::PosNormalTexTanSkinned* vertices, unsigned int vertexCount, unsigned int boneOffset,
+		std::vector<MinMaxBox>* outBoneBoxes)
+	{
+		for (unsigned int i = 0; i < vertexCount; ++i)
+		{
+			const vertex::PosNormalTexTanSkinned& vertex = vertices[i];
+
+			for (int k = 0; k < 4 && vertex.Indices[k] != vertex::PosNormalTexTanSkinned::INVALID_INDEX; ++k)
+			{
+				if (vertex.Weights[k] <= 0.f)
+				{
+					continue;
+				}
+
+				MinMaxBox& box = (*outBoneBoxes)[boneOffset + vertex.Indices[k]];
+				box.Min = Vector3::Min(box.Min, vertex.Pos);
+				box.Max = Vector3::Max(box.Max, vertex.Pos);
+			}
+		}
+	}
+
+	void AnimatedBounds::Build(const AnimationClip& clip, const Skeleton& skeleton, const PaletteLayout& layout,
+		const std::vector<MinMaxBox>& boneBoxes, float sampleRate, AnimatedBounds* outBounds)
+	{
+		assert(boneBoxes.size() == layout.GetBoneCount());
+		assert(sampleRate > 0.f);
+
+		const float duration = std::max<float>(static_cast<float>(clip.Duration), 0.f);
+		const unsigned int intervalCount = std::max<unsigned int>(static_cast<unsigned int>(ceilf(duration * sampleRate)), 1);
+		const unsigned int sampleCount = intervalCount * SUBSTEP_COUNT + 1;
+		const float sampleTime = duration / (intervalCount * SUBSTEP_COUNT);
+
+		//  ϸ øϹǷ Ŀ κ Ű Ž ǳʶڴ.
+		LocalPose pose;
+		pose.Resize(skeleton.GetNodeCount());
+		std::vector<AnimationCursor> cursors(skeleton.GetNodeCount());
+		std::vector<Matrix> toRootMatrices(skeleton.GetNodeCount());
+		std::vector<MinMaxBox> sampleBoxes(sampleCount);
+		MinMaxBox clipBox;
+
+		for (unsigned int i = 0; i < sampleCount; ++i)
+		{
+			clip.SamplePose(skeleton, std::min<float>(i * sampleTime, duration), cursors.data(), &pose);
+			skeleton.ComputeToRootMatrices(pose, toRootMatrices.data());
+
+			sampleBoxes[i] = ComputePoseBox(layout, boneBoxes, toRootMatrices.data());
+			clipBox.Merge(sampleBoxes[i]);
+		}
+
+		outBounds->mDuration = duration;
+		outBounds->mIntervalTime = duration / intervalCount;
+		outBounds->mIntervalCount = intervalCount;
+		outBounds->mClipBox = clipBox;
+		outBounds->mStep = clipBox.IsEmpty() ? Vector3::Zero : (clipBox.Max - clipBox.Min) / static_cast<float>(QUANTIZED_MAX - 1);
+		outBounds->mQuantizedBoxes.assign(static_cast<size_t>(intervalCount) * 6, 0);
+
+		if (clipBox.IsEmpty())
+		{
+			return;
+		}
+
+		const Vector3& origin = clipBox.Min;
+		const Vector3& step = outBounds->mStep;
+		for (unsigned int interval = 0; interval < intervalCount; ++interval)
+		{
+			//     ̿   .
+			MinMaxBox box;
+			for (unsigned int i = interval * SUBSTEP_COUNT; i <= (interval + 1) * SUBSTEP_COUNT; ++i)
+			{
+				box.Merge(sampleBoxes[i]);
+			}
+
+			uint16_t* quantized = &outBounds->mQuantizedBoxes[static_cast<size_t>(interval) * 6];
+			quantized[0] = quantizeFloor(box.Min.x, origin.x, step.x);
+			quantized[1] = quantizeFloor(box.Min.y, origin.y, step.y);
+			quantized[2] = quantizeFloor(box.Min.z, origin.z, step.z);
+			quantized[3] = quantizeCeil(box.Max.x, origin.x, step.x);
+			quantized[4] = quantizeCeil(box.Max.y, origin.y, step.y);
+			quantized[5] = quantizeCeil(box.Max.z, origin.z, step.z);
+		}
+	}
+
+	MinMaxBox AnimatedBounds::ComputePoseBox(const PaletteLayout& layout, const std::vector<MinMaxBox>& boneBoxes,
+		const Matrix* toRootMatrices)
+	{
+		MinMaxBox poseBox;
+
+		for (unsigned int bone = 0; bone < layout.GetBoneCount(); ++bone)
+		{
+			if (boneBoxes[bone].IsEmpty())
+			{
+				continue;
+			}
+
+			const Matrix skinMatrix = layout.OffsetMatrices[bone] * toRootMatrices[layout.NodeIndices[bone]];
+			poseBox.Merge(transformBox(boneBoxes[bone], skinMatrix));
+		}
+
+		return poseBox;
+	}
+
+	DirectX::BoundingBox AnimatedBounds::GetBounds(float timePos) const
+	{
+		return GetBounds(timePos, timePos);
+	}
+
+	DirectX::BoundingBox AnimatedBounds::GetBounds(float beginTime, float endTime) const
+	{
+		assert(beginTime <= endTime);
+
+		if (mClipBox.IsEmpty() || mIntervalTime <= 0.f || endTime - beginTime >= mDuration)
+		{
+			return mClipBox.ToBoundingBox();
+		}
+
+		float wrappedBegin = fmodf(beginTime, mDuration);
+		if (wrappedBegin < 0.f)
+		{
+			wrappedBegin += mDuration;
+		}
+
+		const unsigned int first = std::min<unsigned int>(static_cast<unsigned int>(wrappedBegin / mIntervalTime), mIntervalCount - 1);
+		const unsigned int last = static_cast<unsigned int>((wrappedBegin + (endTime - beginTime)) / mIntervalTime);
+
+		MinMaxBox box;
+		for (unsigned int interval = first; interval <= last; ++interval)
+		{
+			mergeInterval(interval % mIntervalCount, &box);
+		}
+
+		return box.ToBoundingBox();
+	}
+
+	void AnimatedBounds::mergeInterval(unsigned int interval, MinMaxBox* box) const
+	{
+		const uint16_t* quantized = &mQuantizedBoxes[static_cast<size_t>(interval) * 6];
+		const Vector3& origin = mClipBox.Min;
+
+		MinMaxBox intervalBox;
+		intervalBox.Min = Vector3(origin.x + quantized[0] * mStep.x, origin.y + quantized[1] * mStep.y, origin.z + quantized[2] * mStep.z);
+		intervalBox.Max = Vector3(origin.x + quantized[3] * mStep.x, origin.y + quantized[4] * mStep.y, origin.z + quantized[5] * mStep.z);
+		box->Merge(intervalBox);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <DirectXCollision.h>
+
+#include "Animation.h"
+#include "Vertex.h"
+
+namespace resourceManager
+{
+	// ּڰ, ִ  AABB,   Min > Max
+	struct MinMaxBox
+	{
+	public:
+		MinMaxBox();
+
+		inline bool IsEmpty() const;
+		inline void Merge(const MinMaxBox& other);
+		inline DirectX::BoundingBox ToBoundingBox() const;
+
+	public:
+		DirectX::SimpleMath::Vector3 Min;
+		DirectX::SimpleMath::Vector3 Max;
+	};
+
+	// Ŭ ϳ       AABB ̸   Ʈ
+	//   ε  AABB  ķ Ű ģ. Ų   ȯ   ̶
+	// ׻   ȿ Ƿ  Ű ʾƵ   ̴.
+	//  ڴ  SUBSTEP_COUNT      ̰, Ŭ ü  
+	// ּڰ , ִ ø 16Ʈ ȭϹǷ Ǯ  ں ۾ ʴ´.
+	class AnimatedBounds
+	{
+	public:
+		enum { DEFAULT_SAMPLE_RATE = 30, SUBSTEP_COUNT = 4, QUANTIZED_MAX = 65535 };
+
+	public:
+		AnimatedBounds();
+
+		//   ġ ִ  ε  ġ outBoneBoxes[boneOffset +  ε] ģ.
+		// ¸ PaletteLayout::SubsetOffsets[i] boneOffset ҷ ȷƮ  .
+		static void AddBoneBoxes(const vertex::PosNormalTexTanSkinned* vertices, unsigned int vertexCount, unsigned int boneOffset,
+			std::vector<MinMaxBox>* outBoneBoxes);
+		// clip sampleRate(ʴ  )  Ʈ . boneBoxes layout  ŭ
+		static void Build(const AnimationClip& clip, const Skeleton& skeleton, const PaletteLayout& layout,
+			const std::vector<MinMaxBox>& boneBoxes, float sampleRate, AnimatedBounds* outBounds);
+		//  ϳ   AABB, toRootMatrices  ŭ
+		static MinMaxBox ComputePoseBox(const PaletteLayout& layout, const std::vector<MinMaxBox>& boneBoxes,
+			const DirectX::SimpleMath::Matrix* toRootMatrices);
+
+		// timePos   , ð Ŭ ̷ ´.
+		DirectX::BoundingBox GetBounds(float timePos) const;
+		// [beginTime, endTime]   , Ŭ   ó    ̸̻ Ŭ ü ڴ.
+		DirectX::BoundingBox GetBounds(float beginTime, float endTime) const;
+
+		inline const MinMaxBox& GetClipBox() const;
+		inline unsigned int GetIntervalCount() const;
+		inline size_t GetByteSize() const;
+
+	private:
+		void mergeInterval(unsigned int interval, MinMaxBox* box) const;
+
+	private:
+		float mDuration;
+		float mIntervalTime;
+		unsigned int mIntervalCount;
+		MinMaxBox mClipBox;
+		DirectX::SimpleMath::Vector3 mStep; // ȭ  ĭ ũ
+		std::vector<uint16_t> mQuantizedBoxes; //  ּڰ xyz, ִ xyz
+	};
+
+	bool MinMaxBox::IsEmpty() const
+	{
+		return Min.x > Max.x;
+	}
+
+	void MinMaxBox::Merge(const MinMaxBox& other)
+	{
+		Min = DirectX::SimpleMath::Vector3::Min(Min, other.Min);
+		Max = DirectX::SimpleMath::Vector3::Max(Max, other.Max);
+	}
+
+	DirectX::BoundingBox MinMaxBox::ToBoundingBox() const
+	{
+		if (IsEmpty())
+		{
+			return DirectX::BoundingBox(DirectX::SimpleMath::Vector3::Zero, DirectX::SimpleMath::Vector3::Zero);
+		}
+
+		return DirectX::BoundingBox((Min + Max) * 0.5f, (Max - Min) * 0.5f);
+	}
+
+	const MinMaxBox& AnimatedBounds::GetClipBox() const
+	{
+		return mClipBox;
+	}
+
+	unsigned int AnimatedBounds::GetIntervalCount() const
+	{
+		return mIntervalCount;
+	}
+
+	size_t AnimatedBounds::GetByteSize() const
+	{
+		return sizeof(AnimatedBounds) + mQuantizedBoxes.size() * sizeof(uint16_t);
+	}
+}
\ No newline at end of file
@@ -2,32 +2,200 @@
 
 namespace resourceManager
 {
-	DirectX::SimpleMath::Matrix AnimationNode::Evaluate(float progressTime) const
+	namespace
 	{
 		using namespace DirectX::SimpleMath;
 
-		Vector3 position = KeyAnimations[0].Position;
-		Quaternion rotation = KeyAnimations[0].Rotation;
-		Vector3 scaling = KeyAnimations[0].Scaling;
+		// ̿ Ű    11 ϸ nlerp slerp ̰ 0.01 ̶ ȭ   Ѵ.
+		const float NLERP_DOT_THRESHOLD = 0.995f;
+
+		template <typename T>
+		float getRatio(const KeyTrack<T>& track, unsigned int key, float time)
+		{
+			const float begin = track.Times[key];
+			const float length = track.Times[key + 1] - begin;
+			const float ratio = length > 0.f ? (time - begin) / length : 0.f;
+
+			return ratio < 0.f ? 0.f : (ratio > 1.f ? 1.f : ratio);
+		}
 
-		for (auto iter = KeyAnimations.begin(); iter != KeyAnimations.end(); ++iter)
+		Vector3 sampleVector(const KeyTrack<Vector3>& track, float time, unsigned int* cursor, const Vector3& defaultValue)
 		{
-			if (iter->Time > progressTime)
+			if (track.Values.size() < 2)
 			{
-				auto begin = iter - 1;
-				float delta = progressTime - begin->Time;
-				float deltaRatio = delta / (iter->Time - begin->Time);
+				return track.Values.empty() ? defaultValue : track.Values[0];
+			}
 
-				position = Vector3::Lerp(begin->Position, iter->Position, deltaRatio);
-				rotation = Quaternion::Slerp(begin->Rotation, iter->Rotation, deltaRatio);
-				scaling = Vector3::Lerp(begin->Scaling, iter->Scaling, deltaRatio);
+			const unsigned int key = track.FindKey(time, cursor);
+			return Vector3::Lerp(track.Values[key], track.Values[key + 1], getRatio(track, key, time));
+		}
 
-				break;
+		Quaternion sampleRotation(const KeyTrack<Quaternion>& track, float time, unsigned int* cursor)
+		{
+			if (track.Values.size() < 2)
+			{
+				return track.Values.empty() ? Quaternion::Identity : track.Values[0];
 			}
+
+			const unsigned int key = track.FindKey(time, cursor);
+
+			// ε  ݱ  Ƿ ȣ ٽ  ʿ䰡 .
+			return InterpolateRotation(track.Values[key], track.Values[key + 1], getRatio(track, key, time));
+		}
+	}
+
+	DirectX::SimpleMath::Quaternion InterpolateRotation(const DirectX::SimpleMath::Quaternion& begin,
+		const DirectX::SimpleMath::Quaternion& end, float ratio)
+	{
+		if (begin.Dot(end) >= NLERP_DOT_THRESHOLD)
+		{
+			Quaternion result = begin + (end - begin) * ratio;
+			result.Normalize();
+
+			return result;
+		}
+
+		return Quaternion::Slerp(begin, end, ratio);
+	}
+
+	void LocalPose::Resize(unsigned int nodeCount)
+	{
+		Translations.resize(nodeCount);
+		Rotations.resize((nodeCount + ROTATION_ALIGNMENT - 1) / ROTATION_ALIGNMENT * ROTATION_ALIGNMENT, Quaternion::Identity);
+		Scales.resize(nodeCount);
+	}
+
+	void Skeleton::ComputeToRootMatrices(const LocalPose& pose, DirectX::SimpleMath::Matrix* outToRootMatrices) const
+	{
+		assert(pose.GetNodeCount() == GetNodeCount());
+
+		for (unsigned int i = 0; i < GetNodeCount(); ++i)
+		{
+			const Matrix toParent = Matrix::CreateScale(pose.Scales[i])
+				* Matrix::CreateFromQuaternion(pose.Rotations[i])
+				* Matrix::CreateTranslation(pose.Translations[i]);
+
+			const int parentIndex = ParentIndices[i];
+			outToRootMatrices[i] = parentIndex == INVALID_INDEX ? toParent : toParent * outToRootMatrices[parentIndex];
 		}
+	}
+
+	void Skeleton::ComputeDepthOrder(std::vector<unsigned int>* outNodes, std::vector<unsigned int>* outDepthCounts) const
+	{
+		// θ ڽĺ տ Ƿ    ̰ ´.
+		std::vector<unsigned int> depths(GetNodeCount());
+		unsigned int maxDepth = 0;
+		for (unsigned int i = 0; i < GetNodeCount(); ++i)
+		{
+			depths[i] = ParentIndices[i] == INVALID_INDEX ? 0 : depths[ParentIndices[i]] + 1;
+			maxDepth = std::max<unsigned int>(maxDepth, depths[i]);
+		}
+
+		outDepthCounts->assign(maxDepth + 1, 0);
+		for (unsigned int depth : depths)
+		{
+			++(*outDepthCounts)[depth];
+		}
+		for (unsigned int depth = 1; depth <= maxDepth; ++depth)
+		{
+			(*outDepthCounts)[depth] += (*outDepthCounts)[depth - 1];
+		}
+
+		//   ȿ   Ų.
+		outNodes->resize(GetNodeCount());
+		for (unsigned int i = 0; i < GetNodeCount(); ++i)
+		{
+			(*outNodes)[i] = i;
+		}
+		std::stable_sort(outNodes->begin(), outNodes->end(), [&depths](unsigned int lhs, unsigned int rhs) { return depths[lhs] < depths[rhs]; });
+	}
+
+	void PaletteLayout::BuildPalette(const DirectX::SimpleMath::Matrix* toRootMatrices, DirectX::SimpleMath::Matrix* outPalette) const
+	{
+		for (unsigned int i = 0; i < GetBoneCount(); ++i)
+		{
+			outPalette[i] = (OffsetMatrices[i] * toRootMatrices[NodeIndices[i]]).Transpose();
+		}
+	}
+
+	DirectX::SimpleMath::Matrix AnimationNode::Evaluate(float progressTime) const
+	{
+		return Evaluate(progressTime, nullptr);
+	}
+
+	DirectX::SimpleMath::Matrix AnimationNode::Evaluate(float progressTime, AnimationCursor* cursor) const
+	{
+		Vector3 position;
+		Quaternion rotation;
+		Vector3 scaling;
+		Sample(progressTime, cursor, &position, &rotation, &scaling);
 
 		return Matrix::CreateScale(scaling)
 			* Matrix::CreateFromQuaternion(rotation)
 			* Matrix::CreateTranslation(position);
 	}
+
+	void AnimationNode::Sample(float progressTime, AnimationCursor* cursor, DirectX::SimpleMath::Vector3* outTranslation,
+		DirectX::SimpleMath::Quaternion* outRotation, DirectX::SimpleMath::Vector3* outScale) const
+	{
+		*outTranslation = sampleVector(PositionKeys, progressTime, cursor != nullptr ? &cursor->Position : nullptr, Vector3::Zero);
+		*outRotation = sampleRotation(RotationKeys, progressTime, cursor != nullptr ? &cursor->Rotation : nullptr);
+		*outScale = sampleVector(ScalingKeys, progressTime, cursor != nullptr ? &cursor->Scaling : nullptr, Vector3::One);
+	}
+
+	void AnimationClip::Bind(const Skeleton& skeleton)
+	{
+		NodeChannels.assign(skeleton.GetNodeCount(), Skeleton::INVALID_INDEX);
+
+		for (unsigned int i = 0; i < skeleton.GetNodeCount(); ++i)
+		{
+			for (size_t j = 0; j < Channels.size(); ++j)
+			{
+				if (Channels[j].Name == skeleton.NodeNames[i])
+				{
+					NodeChannels[i] = static_cast<int>(j);
+					break;
+				}
+			}
+		}
+	}
+
+	void AnimationClip::SamplePose(const Skeleton& skeleton, float progressTime, AnimationCursor* cursors, LocalPose* outPose) const
+	{
+		assert(NodeChannels.size() == skeleton.GetNodeCount());
+		assert(outPose->GetNodeCount() == skeleton.GetNodeCount());
+
+		for (unsigned int i = 0; i < skeleton.GetNodeCount(); ++i)
+		{
+			sampleNode(skeleton, i, progressTime, cursors, outPose);
+		}
+	}
+
+	void AnimationClip::SamplePose(const Skeleton& skeleton, float progressTime, AnimationCursor* cursors,
+		const unsigned int* nodes, unsigned int nodeCount, LocalPose* outPose) const
+	{
+		assert(NodeChannels.size() == skeleton.GetNodeCount());
+		assert(outPose->GetNodeCount() == skeleton.GetNodeCount());
+
+		for (unsigned int i = 0; i < nodeCount; ++i)
+		{
+			sampleNode(skeleton, nodes[i], progressTime, cursors, outPose);
+		}
+	}
+
+	void AnimationClip::sampleNode(const Skeleton& skeleton, unsigned int node, float progressTime, AnimationCursor* cursors, LocalPose* outPose) const
+	{
+		const int channel = NodeChannels[node];
+
+		if (channel == Skeleton::INVALID_INDEX)
+		{
+			outPose->Translations[node] = skeleton.BindPose.Translations[node];
+			outPose->Rotations[node] = skeleton.BindPose.Rotations[node];
+			outPose->Scales[node] = skeleton.BindPose.Scales[node];
+			return;
+		}
+
+		Channels[channel].Sample(progressTime, cursors != nullptr ? &cursors[node] : nullptr,
+			&outPose->Translations[node], &outPose->Rotations[node], &outPose->Scales[node]);
+	}
 }
\ No newline at end of file
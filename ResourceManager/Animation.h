@@ -1,35 +1,178 @@
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <string>
 #include <vector>
-#include <map>
 
 #include <directxtk/SimpleMath.h>
 
 namespace resourceManager
 {
-	struct KeyAnimation
+	// ä ϳ Ű , ġ, ȸ, ũ Ű  ð  ٸ  ִ.
+	// ð    ־ Ž  ð 迭 ȴ´.
+	template <typename T>
+	struct KeyTrack
 	{
-		float Time;
-		DirectX::SimpleMath::Vector3 Position;
-		DirectX::SimpleMath::Quaternion Rotation;
-		DirectX::SimpleMath::Vector3 Scaling;
+	public:
+		// Times[key] <= time < Times[key + 1] key [0, Ű  - 2] ߶ ȯѴ. Ű 2 ̻̾ Ѵ.
+		// cursor    ״   ,    ŽѴ.
+		inline unsigned int FindKey(float time, unsigned int* cursor) const;
+
+	public:
+		std::vector<float> Times;
+		std::vector<T> Values;
+	};
+
+	// νϽ  ִ 庰  ġ, ܼ Ʈ ٸ Ŭ ᵵ  ´.
+	struct AnimationCursor
+	{
+		unsigned int Position = 0;
+		unsigned int Rotation = 0;
+		unsigned int Scaling = 0;
+	};
+
+	// 庰  ȯ ̵, ȸ, ũ Ʈ    (SoA)
+	// ȸ Ʈ PoseBlender  4 óϵ ROTATION_ALIGNMENT  ø  ĭ ׵ д.
+	struct LocalPose
+	{
+	public:
+		enum { ROTATION_ALIGNMENT = 4 };
+
+	public:
+		void Resize(unsigned int nodeCount);
+		inline unsigned int GetNodeCount() const;
+
+	public:
+		std::vector<DirectX::SimpleMath::Vector3> Translations;
+		std::vector<DirectX::SimpleMath::Quaternion> Rotations;
+		std::vector<DirectX::SimpleMath::Vector3> Scales;
+	};
+
+	//  򰡿 ʿ   迭  , θ ׻ ڽĺ տ ִ.
+	struct Skeleton
+	{
+	public:
+		enum { INVALID_INDEX = -1 };
+
+	public:
+		inline unsigned int GetNodeCount() const;
+		//   θ  Ʈ   . outToRootMatrices  ŭ
+		void ComputeToRootMatrices(const LocalPose& pose, DirectX::SimpleMath::Matrix* outToRootMatrices) const;
+		// 带 (Ʈ 0)  þ´. outDepthCounts[d]  d    տ ׸ŭ  ȴ.
+		void ComputeDepthOrder(std::vector<unsigned int>* outNodes, std::vector<unsigned int>* outDepthCounts) const;
+
+	public:
+		std::vector<std::string> NodeNames;
+		std::vector<int> ParentIndices;
+		LocalPose BindPose; // ä  尡  ε   ȯ
+	};
+
+	//     ̾  Ű ȷƮ ,  i  [SubsetOffsets[i], SubsetOffsets[i + 1]) ִ.
+	struct PaletteLayout
+	{
+	public:
+		inline unsigned int GetBoneCount() const;
+		// 庰 Ʈ  ķ  ۿ ٷ ø ġ ȷƮ(Offset * ToRoot) . outPalette  ŭ
+		void BuildPalette(const DirectX::SimpleMath::Matrix* toRootMatrices, DirectX::SimpleMath::Matrix* outPalette) const;
+
+	public:
+		std::vector<unsigned int> NodeIndices;
+		std::vector<DirectX::SimpleMath::Matrix> OffsetMatrices;
+		std::vector<unsigned int> SubsetOffsets; //   + 1
 	};
 
+	//  ݱ( >= 0) ִ  ȸ ̸ Ѵ.  nlerp, ָ slerp
+	DirectX::SimpleMath::Quaternion InterpolateRotation(const DirectX::SimpleMath::Quaternion& begin,
+		const DirectX::SimpleMath::Quaternion& end, float ratio);
+
 	struct AnimationNode
 	{
 	public:
+		// ù Ű   Ű Ĵ  Ű  Ѵ.
 		DirectX::SimpleMath::Matrix Evaluate(float progressTime) const;
+		// ð  帣  κ Ű Ž  .
+		DirectX::SimpleMath::Matrix Evaluate(float progressTime, AnimationCursor* cursor) const;
+		void Sample(float progressTime, AnimationCursor* cursor, DirectX::SimpleMath::Vector3* outTranslation,
+			DirectX::SimpleMath::Quaternion* outRotation, DirectX::SimpleMath::Vector3* outScale) const;
 
 	public:
 		std::string Name;
-		std::vector<KeyAnimation> KeyAnimations;
+		KeyTrack<DirectX::SimpleMath::Vector3> PositionKeys;
+		KeyTrack<DirectX::SimpleMath::Quaternion> RotationKeys; // ̿ Ű  ݱ  ִ. ( >= 0)
+		KeyTrack<DirectX::SimpleMath::Vector3> ScalingKeys;
 	};
 
 	struct AnimationClip
 	{
+	public:
+		// ̷  ̸ ä ã NodeChannels ä. ε    Ѵ.
+		void Bind(const Skeleton& skeleton);
+		// ä   ε  . cursors nullptr̰ų  ŭ
+		void SamplePose(const Skeleton& skeleton, float progressTime, AnimationCursor* cursors, LocalPose* outPose) const;
+		// nodes  常 øϰ   outPose  ״ д. (ִϸ̼ LOD   ǳʶ )
+		void SamplePose(const Skeleton& skeleton, float progressTime, AnimationCursor* cursors,
+			const unsigned int* nodes, unsigned int nodeCount, LocalPose* outPose) const;
+
+	private:
+		void sampleNode(const Skeleton& skeleton, unsigned int node, float progressTime, AnimationCursor* cursors, LocalPose* outPose) const;
+
+	public:
 		std::string Name;
 		double Duration;
-		std::map<std::string, AnimationNode> AnimationNodes; // ̸ ִϸ̼  
+		std::vector<AnimationNode> Channels;
+		std::vector<int> NodeChannels; // ̷ 庰 ä ε,  Skeleton::INVALID_INDEX
 	};
+
+	template <typename T>
+	unsigned int KeyTrack<T>::FindKey(float time, unsigned int* cursor) const
+	{
+		assert(Times.size() >= 2);
+		const unsigned int lastKey = static_cast<unsigned int>(Times.size()) - 2;
+
+		if (cursor != nullptr)
+		{
+			const unsigned int key = std::min<unsigned int>(*cursor, lastKey);
+
+			if (Times[key] <= time)
+			{
+				if (key == lastKey || time < Times[key + 1])
+				{
+					*cursor = key;
+					return key;
+				}
+				if (key + 1 == lastKey || time < Times[key + 2])
+				{
+					*cursor = key + 1;
+					return key + 1;
+				}
+			}
+		}
+
+		//   Ű  ãƾ   ð ڿ ù    ߸.
+		const auto upper = std::upper_bound(Times.begin() + 1, Times.end() - 1, time);
+		const unsigned int key = static_cast<unsigned int>(upper - Times.begin()) - 1;
+
+		if (cursor != nullptr)
+		{
+			*cursor = key;
+		}
+
+		return key;
+	}
+
+	unsigned int LocalPose::GetNodeCount() const
+	{
+		return static_cast<unsigned int>(Translations.size());
+	}
+
+	unsigned int Skeleton::GetNodeCount() const
+	{
+		return static_cast<unsigned int>(ParentIndices.size());
+	}
+
+	unsigned int PaletteLayout::GetBoneCount() const
+	{
+		return static_cast<unsigned int>(NodeIndices.size());
+	}
 }
\ No newline at end of file
@@ -0,0 +1,572 @@
+#include "AnimationCompression.h"
+
+#include <cmath>
+
+namespace resourceManager
+{
+	namespace
+	{
+		using namespace DirectX::SimpleMath;
+
+		enum
+		{
+			VECTOR_QUANTIZED_MAX = 65535,
+			ROTATION_QUANTIZED_MAX = 32767, // smallest-three д 15Ʈ
+			COMPONENT_COUNT = 3,
+			ERROR_SAMPLES_PER_SECOND = 120
+		};
+
+		//  ū      [-1/sqrt(2), 1/sqrt(2)] ȿ ִ.
+		const float ROTATION_RANGE = 0.70710678f;
+
+		inline float clamp01(float value)
+		{
+			return value < 0.f ? 0.f : (value > 1.f ? 1.f : value);
+		}
+
+		inline uint16_t quantize(float value, float scale, unsigned int maxValue)
+		{
+			const float quantized = value * scale + 0.5f;
+			return static_cast<uint16_t>(quantized <= 0.f ? 0 : (quantized >= maxValue ? maxValue : static_cast<unsigned int>(quantized)));
+		}
+
+		void encodeRotation(Quaternion rotation, uint16_t* outValues)
+		{
+			rotation.Normalize();
+
+			float components[4] = { rotation.x, rotation.y, rotation.z, rotation.w };
+			unsigned int largest = 0;
+			for (unsigned int i = 1; i < 4; ++i)
+			{
+				if (fabsf(components[i]) > fabsf(components[largest]))
+				{
+					largest = i;
+				}
+			}
+
+			// q -q  ȸ̹Ƿ  ū   ǰ  ȣ  ʴ´.
+			const float sign = components[largest] < 0.f ? -1.f : 1.f;
+			const float scale = ROTATION_QUANTIZED_MAX / (2.f * ROTATION_RANGE);
+
+			unsigned int slot = 0;
+			for (unsigned int i = 0; i < 4; ++i)
+			{
+				if (i != largest)
+				{
+					outValues[slot++] = quantize(components[i] * sign + ROTATION_RANGE, scale, ROTATION_QUANTIZED_MAX);
+				}
+			}
+
+			//  ֻ Ʈ    ū  ġ ´.
+			outValues[0] |= static_cast<uint16_t>((largest & 1) << 15);
+			outValues[1] |= static_cast<uint16_t>((largest >> 1) << 15);
+		}
+
+		inline Quaternion composeRotation(float a, float b, float c, unsigned int largest)
+		{
+			const float squared = 1.f - a * a - b * b - c * c;
+			const float d = squared > 0.f ? sqrtf(squared) : 0.f;
+
+			switch (largest)
+			{
+			case 0:
+				return Quaternion(d, a, b, c);
+			case 1:
+				return Quaternion(a, d, b, c);
+			case 2:
+				return Quaternion(a, b, d, c);
+			default:
+				return Quaternion(a, b, c, d);
+			}
+		}
+
+		inline unsigned int getLargestIndex(const uint16_t* values)
+		{
+			return (values[0] >> 15) | ((values[1] >> 15) << 1);
+		}
+
+		inline Quaternion decodeRotation(const uint16_t* values)
+		{
+			const float step = 2.f * ROTATION_RANGE / ROTATION_QUANTIZED_MAX;
+
+			return composeRotation((values[0] & 0x7FFF) * step - ROTATION_RANGE, (values[1] & 0x7FFF) * step - ROTATION_RANGE,
+				values[2] * step - ROTATION_RANGE, getLargestIndex(values));
+		}
+
+		//  Ű  ū  ġ    и  ϰ  ϳ Ѵ.
+		//  ̹  ̶ ȭ ʿ  ٵ  ̸ ȴ. ٸ Ǯ nlerp/slerp Ѵ.
+		//    Լ  Ƿ     ̴.
+		inline Quaternion interpolateRotation(const uint16_t* begin, const uint16_t* end, float ratio)
+		{
+			if (((begin[0] ^ end[0]) | (begin[1] ^ end[1])) & 0x8000)
+			{
+				const Quaternion decodedBegin = decodeRotation(begin);
+				const Quaternion decodedEnd = decodeRotation(end);
+
+				// smallest-three ȣ Ƿ ̿ Ű ݴ ݱ Ǯ  ִ.
+				return InterpolateRotation(decodedBegin, decodedBegin.Dot(decodedEnd) < 0.f ? -decodedEnd : decodedEnd, ratio);
+			}
+
+			const float step = 2.f * ROTATION_RANGE / ROTATION_QUANTIZED_MAX;
+			float components[COMPONENT_COUNT];
+			for (int i = 0; i < COMPONENT_COUNT; ++i)
+			{
+				const float from = static_cast<float>(begin[i] & 0x7FFF);
+				const float to = static_cast<float>(end[i] & 0x7FFF);
+				components[i] = (from + (to - from) * ratio) * step - ROTATION_RANGE;
+			}
+
+			return composeRotation(components[0], components[1], components[2], getLargestIndex(begin));
+		}
+
+		inline Vector3 decodeVector(const CompressedTrack& track, const uint16_t* values)
+		{
+			return Vector3(track.RangeMin.x + values[0] * track.RangeStep.x,
+				track.RangeMin.y + values[1] * track.RangeStep.y,
+				track.RangeMin.z + values[2] * track.RangeStep.z);
+		}
+
+		inline Vector3 interpolateVector(const CompressedTrack& track, const uint16_t* begin, const uint16_t* end, float ratio)
+		{
+			return Vector3::Lerp(decodeVector(track, begin), decodeVector(track, end), ratio);
+		}
+
+		//  ȸ  (),   ϵ acos   ̷ Ѵ.
+		float rotationError(const Quaternion& lhs, const Quaternion& rhs)
+		{
+			const Quaternion aligned = lhs.Dot(rhs) < 0.f ? -rhs : rhs;
+			const Quaternion difference = lhs - aligned;
+			const float chord = sqrtf(difference.Dot(difference));
+
+			return 4.f * asinf(std::min<float>(chord * 0.5f, 1.f));
+		}
+
+		float translationError(const Vector3& lhs, const Vector3& rhs)
+		{
+			return Vector3::Distance(lhs, rhs);
+		}
+
+		float scaleError(const Vector3& lhs, const Vector3& rhs)
+		{
+			return std::max<float>(fabsf(lhs.x - rhs.x), std::max<float>(fabsf(lhs.y - rhs.y), fabsf(lhs.z - rhs.z)));
+		}
+
+		//  Ʈ AnimationNode::Sample   Ѵ.
+		inline Vector3 sampleSource(const KeyTrack<Vector3>& track, unsigned int key, float ratio)
+		{
+			return Vector3::Lerp(track.Values[key], track.Values[key + 1], ratio);
+		}
+
+		inline Quaternion sampleSource(const KeyTrack<Quaternion>& track, unsigned int key, float ratio)
+		{
+			return InterpolateRotation(track.Values[key], track.Values[key + 1], ratio);
+		}
+
+		//  Ʈ time , Ű ϳ̸  ̴.
+		template <typename T>
+		T sampleSource(const KeyTrack<T>& track, float time)
+		{
+			if (track.Values.size() < 2)
+			{
+				return track.Values[0];
+			}
+
+			const unsigned int key = track.FindKey(time, nullptr);
+			const float begin = track.Times[key];
+			const float length = track.Times[key + 1] - begin;
+			const float ratio = length > 0.f ? (time - begin) / length : 0.f;
+
+			return sampleSource(track, key, ratio < 0.f ? 0.f : (ratio > 1.f ? 1.f : ratio));
+		}
+
+		//   ð, 赵  ð Ƿ Ű   Ų   迡 ״ .
+		void getErrorSampleTimes(double duration, std::vector<float>* outTimes)
+		{
+			const unsigned int sampleCount = std::max<unsigned int>(2, static_cast<unsigned int>(duration * ERROR_SAMPLES_PER_SECOND) + 1);
+			outTimes->resize(sampleCount);
+
+			for (unsigned int i = 0; i < sampleCount; ++i)
+			{
+				(*outTimes)[i] = static_cast<float>(duration * i / (sampleCount - 1));
+			}
+		}
+
+		//  Ű .  Ű  ִ ø, ̿ ִ  Ű     ð
+		//    ȭ   Ű  tolerance ȿ ־ Ѵ.  ù Ű  Ű ϳ .
+		// quantizedTimes ȭ Ű ð, keyTimes װ ʷ  ̰  ð times  .
+		//  ð  CompressedClip::SamplePose   ȭ  Ѵ.
+		// decode(key) ȭ Ű , interpolate(begin, end, ratio) ø    ش.
+		template <typename T, typename Decode, typename Interpolate, typename Error>
+		void reduceKeys(const KeyTrack<T>& source, const std::vector<uint16_t>& quantizedTimes, const std::vector<float>& keyTimes,
+			float timeScale, const std::vector<float>& sampleTimes, float tolerance, Decode decode, Interpolate interpolate, Error error,
+			std::vector<unsigned int>* outKeys)
+		{
+			const std::vector<float>& times = source.Times;
+			const std::vector<T>& values = source.Values;
+
+			const unsigned int keyCount = static_cast<unsigned int>(values.size());
+			outKeys->clear();
+			outKeys->push_back(0);
+
+			const T first = decode(0);
+			bool bConstant = true;
+			for (unsigned int i = 0; i < keyCount && bConstant; ++i)
+			{
+				bConstant = error(first, values[i]) <= tolerance;
+			}
+			for (size_t i = 0; i < sampleTimes.size() && bConstant; ++i)
+			{
+				bConstant = error(first, sampleSource(source, sampleTimes[i])) <= tolerance;
+			}
+
+			if (bConstant)
+			{
+				return;
+			}
+
+			auto isSpanValid = [&](unsigned int begin, unsigned int end)
+				{
+					const float length = keyTimes[end] - keyTimes[begin];
+
+					for (unsigned int i = begin + 1; i < end; ++i)
+					{
+						const float ratio = length > 0.f ? clamp01((times[i] - keyTimes[begin]) / length) : 0.f;
+						if (error(interpolate(begin, end, ratio), values[i]) > tolerance)
+						{
+							return false;
+						}
+					}
+
+					// ø    ð: ù  ,   ʵ  ô´.
+					const float quantizedLength = static_cast<float>(quantizedTimes[end] - quantizedTimes[begin]);
+					auto sample = begin > 0 ? std::lower_bound(sampleTimes.begin(), sampleTimes.end(), quantizedTimes[begin],
+						[timeScale](float sampleTime, uint16_t keyTime) { return sampleTime * timeScale < keyTime; }) : sampleTimes.begin();
+					for (; sample != sampleTimes.end(); ++sample)
+					{
+						const float sampleTime = *sample;
+						const float time = sampleTime * timeScale;
+						if (end + 1 < keyCount && time >= quantizedTimes[end])
+						{
+							break;
+						}
+
+						const float ratio = quantizedLength > 0.f ? clamp01((time - quantizedTimes[begin]) / quantizedLength) : 0.f;
+						if (error(interpolate(begin, end, ratio), sampleSource(source, sampleTime)) > tolerance)
+						{
+							return false;
+						}
+					}
+
+					return true;
+				};
+
+			unsigned int begin = 0;
+			while (begin + 1 < keyCount)
+			{
+				unsigned int end = begin + 1;
+				while (end + 1 < keyCount && isSpanValid(begin, end + 1))
+				{
+					++end;
+				}
+
+				outKeys->push_back(end);
+				begin = end;
+			}
+		}
+
+		// Ű ð ȭ  ٽ ʷ  
+		void quantizeTimes(const std::vector<float>& times, float timeScale, std::vector<uint16_t>* outQuantized, std::vector<float>* outKeyTimes)
+		{
+			outQuantized->resize(times.size());
+			outKeyTimes->resize(times.size());
+
+			for (size_t i = 0; i < times.size(); ++i)
+			{
+				(*outQuantized)[i] = quantize(times[i], timeScale, CompressedClip::QUANTIZED_TIME_MAX);
+				(*outKeyTimes)[i] = timeScale > 0.f ? (*outQuantized)[i] / timeScale : 0.f;
+			}
+		}
+
+		unsigned int findKey(const uint16_t* times, unsigned int keyCount, float time, unsigned int* cursor)
+		{
+			const unsigned int lastKey = keyCount - 2;
+
+			if (cursor != nullptr)
+			{
+				const unsigned int key = std::min<unsigned int>(*cursor, lastKey);
+
+				if (times[key] <= time)
+				{
+					if (key == lastKey || time < times[key + 1])
+					{
+						*cursor = key;
+						return key;
+					}
+					if (key + 1 == lastKey || time < times[key + 2])
+					{
+						*cursor = key + 1;
+						return key + 1;
+					}
+				}
+			}
+
+			const uint16_t* upper = std::upper_bound(times + 1, times + keyCount - 1, time,
+				[](float value, uint16_t keyTime) { return value < keyTime; });
+			const unsigned int key = static_cast<unsigned int>(upper - times) - 1;
+
+			if (cursor != nullptr)
+			{
+				*cursor = key;
+			}
+
+			return key;
+		}
+
+		inline float getRatio(const uint16_t* times, unsigned int key, float time)
+		{
+			const float length = static_cast<float>(times[key + 1] - times[key]);
+			return length > 0.f ? clamp01((time - times[key]) / length) : 0.f;
+		}
+
+		template <typename T>
+		size_t getTrackBytes(const KeyTrack<T>& track)
+		{
+			return track.Times.size() * sizeof(float) + track.Values.size() * sizeof(T);
+		}
+
+		void updateError(const LocalPose& source, const LocalPose& compressed, CompressionStats* stats)
+		{
+			for (unsigned int i = 0; i < source.GetNodeCount(); ++i)
+			{
+				stats->MaxTranslationError = std::max<float>(stats->MaxTranslationError, translationError(source.Translations[i], compressed.Translations[i]));
+				stats->MaxRotationError = std::max<float>(stats->MaxRotationError, rotationError(source.Rotations[i], compressed.Rotations[i]));
+				stats->MaxScaleError = std::max<float>(stats->MaxScaleError, scaleError(source.Scales[i], compressed.Scales[i]));
+			}
+		}
+
+		// Ʈ ϳ ϴ   ӽ , äθ ٽ Ҵ ʵ  .
+		struct TrackScratch
+		{
+			std::vector<uint16_t> QuantizedTimes;
+			std::vector<float> KeyTimes;
+			std::vector<Vector3> Vectors;
+			std::vector<uint16_t> QuantizedValues;
+			std::vector<unsigned int> Keys;
+			std::vector<float> SampleTimes;
+		};
+	}
+
+	void CompressedClip::Compress(const AnimationClip& clip, const Skeleton& skeleton, const CompressionSettings& settings,
+		CompressedClip* outClip, CompressionStats* outStats)
+	{
+		assert(outClip != nullptr);
+		assert(clip.NodeChannels.size() == skeleton.GetNodeCount());
+
+		outClip->Name = clip.Name;
+		outClip->Duration = clip.Duration;
+		outClip->NodeChannels = clip.NodeChannels;
+		outClip->Channels.resize(clip.Channels.size());
+		outClip->mTimeScale = clip.Duration > 0.0 ? static_cast<float>(QUANTIZED_TIME_MAX / clip.Duration) : 0.f;
+		outClip->mKeyTimes.clear();
+		outClip->mKeyValues.clear();
+
+		TrackScratch scratch;
+		getErrorSampleTimes(clip.Duration, &scratch.SampleTimes);
+
+		//  Ű ȭ ð   迭  δ.
+		auto appendKeys = [&](CompressedTrack* track)
+			{
+				track->KeyOffset = static_cast<unsigned int>(outClip->mKeyTimes.size());
+				track->KeyCount = static_cast<unsigned int>(scratch.Keys.size());
+
+				for (unsigned int key : scratch.Keys)
+				{
+					outClip->mKeyTimes.push_back(scratch.QuantizedTimes[key]);
+					outClip->mKeyValues.insert(outClip->mKeyValues.end(), &scratch.QuantizedValues[key * COMPONENT_COUNT],
+						&scratch.QuantizedValues[key * COMPONENT_COUNT] + COMPONENT_COUNT);
+				}
+			};
+
+		auto compressVector = [&](const KeyTrack<Vector3>& source, float tolerance, auto error, CompressedTrack* outTrack)
+			{
+				*outTrack = CompressedTrack{ 0, 0, Vector3::Zero, Vector3::Zero };
+				if (source.Values.empty())
+				{
+					return;
+				}
+
+				// Ű  ȭ Ű ð  Ʈ ø ̶ ð ȭص   ʴ´.
+				quantizeTimes(source.Times, outClip->mTimeScale, &scratch.QuantizedTimes, &scratch.KeyTimes);
+				scratch.Vectors.resize(source.Values.size());
+				for (size_t i = 0; i < source.Values.size(); ++i)
+				{
+					scratch.Vectors[i] = sampleSource(source, scratch.KeyTimes[i]);
+				}
+
+				Vector3 minValue = scratch.Vectors[0];
+				Vector3 maxValue = scratch.Vectors[0];
+				for (const Vector3& value : scratch.Vectors)
+				{
+					minValue = Vector3::Min(minValue, value);
+					maxValue = Vector3::Max(maxValue, value);
+				}
+
+				const Vector3 extent = maxValue - minValue;
+				outTrack->RangeMin = minValue;
+				outTrack->RangeStep = extent / static_cast<float>(VECTOR_QUANTIZED_MAX);
+
+				const float* minComponents = &minValue.x;
+				const float* extentComponents = &extent.x;
+				scratch.QuantizedValues.resize(source.Values.size() * COMPONENT_COUNT);
+
+				for (size_t i = 0; i < source.Values.size(); ++i)
+				{
+					uint16_t* quantized = &scratch.QuantizedValues[i * COMPONENT_COUNT];
+					for (int j = 0; j < COMPONENT_COUNT; ++j)
+					{
+						const float scale = extentComponents[j] > 0.f ? VECTOR_QUANTIZED_MAX / extentComponents[j] : 0.f;
+						quantized[j] = quantize((&scratch.Vectors[i].x)[j] - minComponents[j], scale, VECTOR_QUANTIZED_MAX);
+					}
+				}
+
+				const uint16_t* quantized = scratch.QuantizedValues.data();
+				reduceKeys(source, scratch.QuantizedTimes, scratch.KeyTimes, outClip->mTimeScale, scratch.SampleTimes, tolerance,
+					[&](unsigned int key) { return decodeVector(*outTrack, quantized + key * COMPONENT_COUNT); },
+					[&](unsigned int begin, unsigned int end, float ratio)
+					{
+						return interpolateVector(*outTrack, quantized + begin * COMPONENT_COUNT, quantized + end * COMPONENT_COUNT, ratio);
+					},
+					error, &scratch.Keys);
+				appendKeys(outTrack);
+			};
+
+		auto compressRotation = [&](const KeyTrack<Quaternion>& source, CompressedTrack* outTrack)
+			{
+				*outTrack = CompressedTrack{ 0, 0, Vector3::Zero, Vector3::Zero };
+				if (source.Values.empty())
+				{
+					return;
+				}
+
+				quantizeTimes(source.Times, outClip->mTimeScale, &scratch.QuantizedTimes, &scratch.KeyTimes);
+				scratch.QuantizedValues.resize(source.Values.size() * COMPONENT_COUNT);
+				for (size_t i = 0; i < source.Values.size(); ++i)
+				{
+					encodeRotation(sampleSource(source, scratch.KeyTimes[i]), &scratch.QuantizedValues[i * COMPONENT_COUNT]);
+				}
+
+				const uint16_t* quantized = scratch.QuantizedValues.data();
+				reduceKeys(source, scratch.QuantizedTimes, scratch.KeyTimes, outClip->mTimeScale, scratch.SampleTimes, settings.RotationTolerance,
+					[&](unsigned int key) { return decodeRotation(quantized + key * COMPONENT_COUNT); },
+					[&](unsigned int begin, unsigned int end, float ratio)
+					{
+						return interpolateRotation(quantized + begin * COMPONENT_COUNT, quantized + end * COMPONENT_COUNT, ratio);
+					},
+					rotationError, &scratch.Keys);
+				appendKeys(outTrack);
+			};
+
+		for (size_t i = 0; i < clip.Channels.size(); ++i)
+		{
+			const AnimationNode& source = clip.Channels[i];
+			CompressedChannel& channel = outClip->Channels[i];
+
+			compressVector(source.PositionKeys, settings.TranslationTolerance, translationError, &channel.Position);
+			compressRotation(source.RotationKeys, &channel.Rotation);
+			compressVector(source.ScalingKeys, settings.ScaleTolerance, scaleError, &channel.Scaling);
+		}
+
+		outClip->mKeyTimes.shrink_to_fit();
+		outClip->mKeyValues.shrink_to_fit();
+
+		if (outStats == nullptr)
+		{
+			return;
+		}
+
+		*outStats = CompressionStats();
+		for (const AnimationNode& channel : clip.Channels)
+		{
+			outStats->SourceBytes += getTrackBytes(channel.PositionKeys) + getTrackBytes(channel.RotationKeys) + getTrackBytes(channel.ScalingKeys);
+			outStats->SourceKeyCount += channel.PositionKeys.Times.size() + channel.RotationKeys.Times.size() + channel.ScalingKeys.Times.size();
+		}
+		outStats->CompressedBytes = outClip->GetByteSize();
+		outStats->CompressedKeyCount = outClip->mKeyTimes.size();
+
+		// Ű     ð(ʴ ERROR_SAMPLES_PER_SECOND)  ø Ѵ.
+		LocalPose sourcePose;
+		LocalPose compressedPose;
+		sourcePose.Resize(skeleton.GetNodeCount());
+		compressedPose.Resize(skeleton.GetNodeCount());
+
+		for (float time : scratch.SampleTimes)
+		{
+			clip.SamplePose(skeleton, time, nullptr, &sourcePose);
+			outClip->SamplePose(skeleton, time, nullptr, &compressedPose);
+			updateError(sourcePose, compressedPose, outStats);
+		}
+	}
+
+	void CompressedClip::SamplePose(const Skeleton& skeleton, float progressTime, AnimationCursor* cursors, LocalPose* outPose) const
+	{
+		assert(NodeChannels.size() == skeleton.GetNodeCount());
+		assert(outPose->GetNodeCount() == skeleton.GetNodeCount());
+
+		const float time = progressTime * mTimeScale;
+		const uint16_t* keyTimes = mKeyTimes.data();
+		const uint16_t* keyValues = mKeyValues.data();
+
+		auto sampleVector = [&](const CompressedTrack& track, unsigned int* cursor, const Vector3& defaultValue)
+			{
+				if (track.KeyCount < 2)
+				{
+					return track.KeyCount == 0 ? defaultValue : decodeVector(track, keyValues + track.KeyOffset * COMPONENT_COUNT);
+				}
+
+				const uint16_t* times = keyTimes + track.KeyOffset;
+				const unsigned int key = findKey(times, track.KeyCount, time, cursor);
+				const uint16_t* values = keyValues + (track.KeyOffset + key) * COMPONENT_COUNT;
+
+				return interpolateVector(track, values, values + COMPONENT_COUNT, getRatio(times, key, time));
+			};
+
+		auto sampleRotation = [&](const CompressedTrack& track, unsigned int* cursor)
+			{
+				if (track.KeyCount < 2)
+				{
+					return track.KeyCount == 0 ? Quaternion::Identity : decodeRotation(keyValues + track.KeyOffset * COMPONENT_COUNT);
+				}
+
+				const uint16_t* times = keyTimes + track.KeyOffset;
+				const unsigned int key = findKey(times, track.KeyCount, time, cursor);
+				const uint16_t* values = keyValues + (track.KeyOffset + key) * COMPONENT_COUNT;
+
+				return interpolateRotation(values, values + COMPONENT_COUNT, getRatio(times, key, time));
+			};
+
+		for (unsigned int i = 0; i < skeleton.GetNodeCount(); ++i)
+		{
+			const int channelIndex = NodeChannels[i];
+
+			if (channelIndex == Skeleton::INVALID_INDEX)
+			{
+				outPose->Translations[i] = skeleton.BindPose.Translations[i];
+				outPose->Rotations[i] = skeleton.BindPose.Rotations[i];
+				outPose->Scales[i] = skeleton.BindPose.Scales[i];
+				continue;
+			}
+
+			const CompressedChannel& channel = Channels[channelIndex];
+			AnimationCursor* cursor = cursors != nullptr ? &cursors[i] : nullptr;
+
+			outPose->Translations[i] = sampleVector(channel.Position, cursor != nullptr ? &cursor->Position : nullptr, Vector3::Zero);
+			outPose->Rotations[i] = sampleRotation(channel.Rotation, cursor != nullptr ? &cursor->Rotation : nullptr);
+			outPose->Scales[i] = sampleVector(channel.Scaling, cursor != nullptr ? &cursor->Scaling : nullptr, Vector3::One);
+		}
+	}
+
+	size_t CompressedClip::GetByteSize() const
+	{
+		return Channels.size() * sizeof(CompressedChannel) + mKeyTimes.size() * sizeof(uint16_t) + mKeyValues.size() * sizeof(uint16_t);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Animation.h"
+
+namespace resourceManager
+{
+	// Ű   ϴ ִ , ȭ  Ѵ.
+	struct CompressionSettings
+	{
+		float TranslationTolerance = 1e-3f; //   Ÿ
+		float RotationTolerance = 1e-3f; // 
+		float ScaleTolerance = 1e-4f; // к 
+	};
+
+	// Ŭ ϳ  ,   ົ  ð ø  ̴ִ.
+	struct CompressionStats
+	{
+		size_t SourceBytes = 0;
+		size_t CompressedBytes = 0;
+		size_t SourceKeyCount = 0;
+		size_t CompressedKeyCount = 0;
+		float MaxTranslationError = 0.f;
+		float MaxRotationError = 0.f; // 
+		float MaxScaleError = 0.f;
+	};
+
+	//  Ʈ ϳ, Ű ð  CompressedClip  迭 KeyOffset KeyCount.
+	struct CompressedTrack
+	{
+		unsigned int KeyOffset;
+		unsigned int KeyCount; // 0̸ ⺻, 1̸ 
+		DirectX::SimpleMath::Vector3 RangeMin; //  Ʈ .
+		DirectX::SimpleMath::Vector3 RangeStep; // ȭ  ܰ ũ
+	};
+
+	struct CompressedChannel
+	{
+		CompressedTrack Position;
+		CompressedTrack Rotation;
+		CompressedTrack Scaling;
+	};
+
+	// Ű   ȿ ̰  16Ʈ ȭ Ŭ
+	// ð Duration [0, 65535]  16Ʈ, ̵ ũ Ʈ  д 16Ʈ,
+	// ȸ  ū     15Ʈ  smallest-three(48Ʈ) Ѵ.
+	// AnimationClip::SamplePose   øϹǷ ״ ٲ   ִ.
+	class CompressedClip
+	{
+	public:
+		enum { QUANTIZED_TIME_MAX = 65535 };
+
+	public:
+		// clip Bind  ¿ Ѵ. outStats     ũ⸦ ä.
+		static void Compress(const AnimationClip& clip, const Skeleton& skeleton, const CompressionSettings& settings,
+			CompressedClip* outClip, CompressionStats* outStats);
+
+		// ä   ε  . cursors nullptr̰ų  ŭ
+		void SamplePose(const Skeleton& skeleton, float progressTime, AnimationCursor* cursors, LocalPose* outPose) const;
+		size_t GetByteSize() const;
+
+	public:
+		std::string Name;
+		double Duration;
+		std::vector<CompressedChannel> Channels;
+		std::vector<int> NodeChannels;
+
+	private:
+		float mTimeScale; //  -> ȭ ð
+		std::vector<uint16_t> mKeyTimes;
+		std::vector<uint16_t> mKeyValues; // Ű 3, Ϳ ȸ  48Ʈ.
+	};
+}
\ No newline at end of file
@@ -0,0 +1,279 @@
+#include <Windows.h>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <xmmintrin.h>
+
+#include "AnimationScheduler.h"
+#include "JobSystem.h"
+
+namespace resourceManager
+{
+	using namespace DirectX::SimpleMath;
+
+	namespace
+	{
+		using Clock = std::chrono::high_resolution_clock;
+
+		const float DEFAULT_BUDGET_MS = 2.f;
+		const float DEFAULT_MS_PER_NODE = 0.0002f;
+		const float COST_SMOOTHING = 0.1f; // ̹   
+
+		enum { INTERPOLATE_GRAIN_SIZE = 32 };
+
+		// out = from + (to - from) * t,  float 16 4 óѴ.
+		void lerpPalette(const Matrix* from, const Matrix* to, unsigned int boneCount, float t, Matrix* out)
+		{
+			const float* fromFloats = &from->_11;
+			const float* toFloats = &to->_11;
+			float* outFloats = &out->_11;
+			const __m128 weight = _mm_set1_ps(t);
+
+			for (unsigned int i = 0; i < boneCount * 16; i += 4)
+			{
+				const __m128 a = _mm_loadu_ps(fromFloats + i);
+				const __m128 b = _mm_loadu_ps(toFloats + i);
+				_mm_storeu_ps(outFloats + i, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), weight)));
+			}
+		}
+	}
+
+	AnimationScheduler::AnimationScheduler()
+		: mBudgetMs(DEFAULT_BUDGET_MS)
+		, mMsPerNode(DEFAULT_MS_PER_NODE)
+		, mStats()
+	{
+		mLods[0] = { 150.f, 1, CrowdAnimator::MAX_BONE_DEPTH };
+		mLods[1] = { 60.f, 2, CrowdAnimator::MAX_BONE_DEPTH };
+		mLods[2] = { 20.f, 4, 6 };
+		mLods[3] = { 0.f, 8, 3 };
+	}
+
+	void AnimationScheduler::SetBudget(float milliseconds)
+	{
+		mBudgetMs = milliseconds;
+	}
+
+	void AnimationScheduler::SetLod(unsigned int lod, const AnimationLod& animationLod)
+	{
+		assert(lod < LOD_COUNT);
+		assert(animationLod.UpdateInterval > 0);
+		mLods[lod] = animationLod;
+	}
+
+	void AnimationScheduler::SyncInstances(const CrowdAnimator& crowd)
+	{
+		// ũ ڿ ߰ϰų ° ⸸ ϹǷ پ ó ٽ .
+		if (crowd.GetInstanceCount() < mStates.size())
+		{
+			mStates.clear();
+			mFromPalettes.clear();
+			mDisplayPalettes.clear();
+		}
+
+		size_t paletteOffset = mDisplayPalettes.size();
+		for (unsigned int i = static_cast<unsigned int>(mStates.size()); i < crowd.GetInstanceCount(); ++i)
+		{
+			InstanceState state = {};
+			state.PaletteOffset = paletteOffset;
+			state.BoneCount = crowd.GetBoneCount(i);
+			state.Lod = LOD_COUNT - 1;
+			state.Interval = 1;
+			mStates.push_back(state);
+
+			paletteOffset += state.BoneCount;
+		}
+
+		mFromPalettes.resize(paletteOffset, Matrix::Identity);
+		mDisplayPalettes.resize(paletteOffset, Matrix::Identity);
+	}
+
+	void AnimationScheduler::Update(float deltaTime, CrowdAnimator* crowd, common::JobSystem* jobSystem)
+	{
+		assert(mStates.size() == crowd->GetInstanceCount());
+
+		mStats = Stats();
+		crowd->AdvanceTime(deltaTime);
+
+		// 1. ̴ νϽ LOD     νϽ .
+		mCandidates.clear();
+		for (unsigned int i = 0; i < mStates.size(); ++i)
+		{
+			InstanceState& state = mStates[i];
+			state.bUpdatedThisFrame = false;
+			state.bSnapThisFrame = false;
+			state.bInterpolatedThisFrame = false;
+			state.bDeferredThisFrame = false;
+			state.FramesSinceUpdate = std::min<unsigned int>(state.FramesSinceUpdate + 1, UINT_MAX - 1);
+
+			if (!state.bVisible)
+			{
+				state.bWasVisible = false;
+				++mStats.SkippedCount;
+				continue;
+			}
+
+			state.Lod = chooseLod(state.ScreenHeight);
+			++mStats.LodCounts[state.Lod];
+
+			// ó ̰ų ٽ ̸  ȷƮ Ƿ   Ѵ.
+			const bool bMandatory = !state.bEvaluated || !state.bWasVisible;
+			const unsigned int interval = mLods[state.Lod].UpdateInterval;
+			state.bWasVisible = true;
+
+			if (bMandatory || state.FramesSinceUpdate >= std::min<unsigned int>(state.Interval, interval))
+			{
+				mCandidates.push_back({ i, bMandatory, static_cast<float>(state.FramesSinceUpdate) / interval });
+			}
+		}
+
+		// 2. ݵ  ,  и , ȭ鿡 ũ ̴    ä.
+		std::sort(mCandidates.begin(), mCandidates.end(), [this](const Candidate& lhs, const Candidate& rhs)
+			{
+				if (lhs.bMandatory != rhs.bMandatory)
+				{
+					return lhs.bMandatory;
+				}
+				if (lhs.Overdue != rhs.Overdue)
+				{
+					return lhs.Overdue > rhs.Overdue;
+				}
+				if (mStates[lhs.InstanceIndex].ScreenHeight != mStates[rhs.InstanceIndex].ScreenHeight)
+				{
+					return mStates[lhs.InstanceIndex].ScreenHeight > mStates[rhs.InstanceIndex].ScreenHeight;
+				}
+
+				return lhs.InstanceIndex < rhs.InstanceIndex;
+			});
+
+		mRequests.clear();
+		for (const Candidate& candidate : mCandidates)
+		{
+			InstanceState& state = mStates[candidate.InstanceIndex];
+			const AnimationLod& lod = mLods[state.Lod];
+			const unsigned int nodeCount = crowd->GetSampledNodeCount(candidate.InstanceIndex, lod.MaxBoneDepth);
+			const float cost = nodeCount * mMsPerNode;
+
+			// и νϽ  ǥ ȷƮ  ϰų ״  ְ  ӿ  տ .
+			if (!candidate.bMandatory && mBudgetMs > 0.f && mStats.EstimatedMs + cost > mBudgetMs)
+			{
+				state.bDeferredThisFrame = true;
+				continue;
+			}
+
+			mStats.EstimatedMs += cost;
+			mStats.EvaluatedNodeCount += nodeCount;
+
+			//      ̸  ΰ  Ѵ.
+			mRequests.push_back({ candidate.InstanceIndex, (lod.UpdateInterval - 1) * deltaTime, lod.MaxBoneDepth });
+			state.Interval = lod.UpdateInterval;
+			state.FramesSinceUpdate = 1;
+			state.bEvaluated = true;
+			state.bUpdatedThisFrame = true;
+			state.bSnapThisFrame = candidate.bMandatory;
+		}
+
+		// 3.  νϽ ϰ  ϳ  Ѵ.
+		Clock::time_point start = Clock::now();
+		crowd->Evaluate(mRequests.data(), static_cast<unsigned int>(mRequests.size()), jobSystem);
+		mStats.EvaluateMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+		if (mStats.EvaluatedNodeCount > 0)
+		{
+			const float measuredMsPerNode = mStats.EvaluateMs / mStats.EvaluatedNodeCount;
+			mMsPerNode += (measuredMsPerNode - mMsPerNode) * COST_SMOOTHING;
+		}
+
+		// 4. ̴ νϽ ȷƮ Ѵ.
+		start = Clock::now();
+		auto interpolateRange = [this, crowd](UINT begin, UINT end)
+			{
+				for (UINT i = begin; i < end; ++i)
+				{
+					interpolateInstance(i, *crowd);
+				}
+			};
+
+		if (jobSystem != nullptr)
+		{
+			jobSystem->ParallelFor(static_cast<UINT>(mStates.size()), INTERPOLATE_GRAIN_SIZE, interpolateRange);
+		}
+		else
+		{
+			interpolateRange(0, static_cast<UINT>(mStates.size()));
+		}
+		mStats.InterpolateMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+		//  پ LOD ٲ ̷ νϽ  ϹǷ νϽ  θ .
+		mStats.UpdatedCount = static_cast<unsigned int>(mRequests.size());
+		for (const InstanceState& state : mStates)
+		{
+			if (!state.bVisible || state.bUpdatedThisFrame)
+			{
+				continue;
+			}
+
+			if (state.bDeferredThisFrame)
+			{
+				++mStats.DeferredCount;
+			}
+			else if (state.bInterpolatedThisFrame)
+			{
+				++mStats.InterpolatedCount;
+			}
+			else
+			{
+				++mStats.HeldCount;
+			}
+		}
+	}
+
+	unsigned int AnimationScheduler::chooseLod(float screenHeight) const
+	{
+		for (unsigned int lod = 0; lod < LOD_COUNT - 1; ++lod)
+		{
+			if (screenHeight >= mLods[lod].MinScreenHeight)
+			{
+				return lod;
+			}
+		}
+
+		return LOD_COUNT - 1;
+	}
+
+	void AnimationScheduler::interpolateInstance(unsigned int instanceIndex, const CrowdAnimator& crowd)
+	{
+		InstanceState& state = mStates[instanceIndex];
+		if (!state.bVisible)
+		{
+			return;
+		}
+
+		//  ӿ ̹ ǥ ȷƮ Ҵ.
+		if (!state.bUpdatedThisFrame && state.FramesSinceUpdate > state.Interval)
+		{
+			return;
+		}
+
+		const Matrix* target = crowd.GetPalette(instanceIndex);
+		Matrix* display = &mDisplayPalettes[state.PaletteOffset];
+		Matrix* from = &mFromPalettes[state.PaletteOffset];
+		const size_t byteSize = state.BoneCount * sizeof(Matrix);
+
+		if (state.bSnapThisFrame || state.FramesSinceUpdate >= state.Interval)
+		{
+			memcpy(display, target, byteSize);
+			return;
+		}
+
+		if (state.bUpdatedThisFrame)
+		{
+			memcpy(from, display, byteSize);
+		}
+
+		lerpPalette(from, target, state.BoneCount, static_cast<float>(state.FramesSinceUpdate) / state.Interval, display);
+		state.bInterpolatedThisFrame = !state.bUpdatedThisFrame;
+	}
+}
\ No newline at end of file
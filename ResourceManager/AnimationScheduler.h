@@ -0,0 +1,144 @@
+#pragma once
+
+#include <vector>
+
+#include "CrowdAnimator.h"
+
+namespace common
+{
+	class JobSystem;
+}
+
+namespace resourceManager
+{
+	// ִϸ̼ LOD  ܰ, ȭ ̰ MinScreenHeight ̸̻  ܰ踦 .
+	struct AnimationLod
+	{
+		float MinScreenHeight; // ȼ
+		unsigned int UpdateInterval; //  Ӹ  
+		unsigned int MaxBoneDepth; // ̺   ø ʴ´.
+	};
+
+	// CrowdAnimator νϽ ȭ ũ ü ִϸ̼ LOD   ݰ  ̸ ϰ,
+	//   ȿ  ŭ  Ѵ.    - 1    ̸ ,
+	//   ӿ   ȷƮ  ȷƮ  Ѵ.  1̸   򰡿 .
+	//  ʴ νϽ ð 帣 ٽ ̴ ӿ   Ѵ.
+	class AnimationScheduler
+	{
+	public:
+		enum { LOD_COUNT = 4 };
+
+		//     
+		struct Stats
+		{
+			unsigned int UpdatedCount; //   νϽ
+			unsigned int InterpolatedCount; //   ȷƮ  νϽ
+			unsigned int HeldCount; //    ȷƮ ״  ִ νϽ
+			unsigned int DeferredCount; //     Ѿ ̷ νϽ,  ̾  Ѵ.
+			unsigned int SkippedCount; //  ʾ ð  νϽ
+			unsigned int EvaluatedNodeCount;
+			unsigned int LodCounts[LOD_COUNT]; // ̴ νϽ LOD 
+			float EstimatedMs; // 򰡸 ϱ   
+			float EvaluateMs;
+			float InterpolateMs;
+		};
+
+	public:
+		AnimationScheduler();
+
+		// 0 ϸ      νϽ  Ѵ.
+		void SetBudget(float milliseconds);
+		// LOD MinScreenHeight ū ͺ   ̾ Ѵ.
+		void SetLod(unsigned int lod, const AnimationLod& animationLod);
+		// ũ忡 νϽ ߰ϰų   θ.  νϽ ó ̴ ӿ Ѵ.
+		void SyncInstances(const CrowdAnimator& crowd);
+
+		// ̹  ȭ (ȼ) ü, Update  θ.
+		inline void SetScreenHeight(unsigned int instanceIndex, float screenHeight);
+		inline void SetVisible(unsigned int instanceIndex, bool bVisible);
+
+		// ũ ð   νϽ   ̴ νϽ ȷƮ Ѵ.
+		void Update(float deltaTime, CrowdAnimator* crowd, common::JobSystem* jobSystem);
+
+		inline float GetBudget() const;
+		inline const AnimationLod& GetLod(unsigned int lod) const;
+		inline unsigned int GetInstanceLod(unsigned int instanceIndex) const;
+		// ׸  CrowdAnimator::GetPalette  .
+		inline const DirectX::SimpleMath::Matrix* GetPalette(unsigned int instanceIndex) const;
+		inline const Stats& GetStats() const;
+
+	private:
+		struct InstanceState
+		{
+			size_t PaletteOffset;
+			unsigned int BoneCount;
+			float ScreenHeight;
+			unsigned int Lod;
+			unsigned int Interval; //     
+			unsigned int FramesSinceUpdate; //   1
+			bool bVisible;
+			bool bWasVisible;
+			bool bEvaluated; //  ̶ ߴ
+			bool bUpdatedThisFrame;
+			bool bSnapThisFrame; //  ʰ  ȷƮ ٷ ٲ۴.
+			bool bInterpolatedThisFrame; // ̹ ӿ   ߴ ()
+			bool bDeferredThisFrame; // , ̷ νϽ ص DeferredCount .
+		};
+
+		struct Candidate
+		{
+			unsigned int InstanceIndex;
+			bool bMandatory;
+			float Overdue; //    / 
+		};
+
+		unsigned int chooseLod(float screenHeight) const;
+		void interpolateInstance(unsigned int instanceIndex, const CrowdAnimator& crowd);
+
+	private:
+		float mBudgetMs;
+		float mMsPerNode; //    ̵ 
+		AnimationLod mLods[LOD_COUNT];
+		std::vector<InstanceState> mStates;
+		std::vector<Candidate> mCandidates;
+		std::vector<CrowdAnimator::EvaluationRequest> mRequests;
+		std::vector<DirectX::SimpleMath::Matrix> mFromPalettes; //   ȷƮ
+		std::vector<DirectX::SimpleMath::Matrix> mDisplayPalettes;
+		Stats mStats;
+	};
+
+	void AnimationScheduler::SetScreenHeight(unsigned int instanceIndex, float screenHeight)
+	{
+		mStates[instanceIndex].ScreenHeight = screenHeight;
+	}
+
+	void AnimationScheduler::SetVisible(unsigned int instanceIndex, bool bVisible)
+	{
+		mStates[instanceIndex].bVisible = bVisible;
+	}
+
+	float AnimationScheduler::GetBudget() const
+	{
+		return mBudgetMs;
+	}
+
+	const AnimationLod& AnimationScheduler::GetLod(unsigned int lod) const
+	{
+		return mLods[lod];
+	}
+
+	unsigned int AnimationScheduler::GetInstanceLod(unsigned int instanceIndex) const
+	{
+		return mStates[instanceIndex].Lod;
+	}
+
+	const DirectX::SimpleMath::Matrix* AnimationScheduler::GetPalette(unsigned int instanceIndex) const
+	{
+		return &mDisplayPalettes[mStates[instanceIndex].PaletteOffset];
+	}
+
+	const AnimationScheduler::Stats& AnimationScheduler::GetStats() const
+	{
+		return mStats;
+	}
+}
\ No newline at end of file
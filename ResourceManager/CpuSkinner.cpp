@@ -0,0 +1,485 @@
+#include "CpuSkinner.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <immintrin.h>
+
+#include "JobSystem.h"
+
+namespace resourceManager
+{
+	using namespace DirectX::SimpleMath;
+
+	namespace
+	{
+		// ġ ϳ(BATCH_SIZE )  ó ٷ , AVX  SSE    Ѵ.
+#if defined(__AVX__)
+		typedef __m256 BatchVector;
+
+		inline BatchVector setBatch(float value) { return _mm256_set1_ps(value); }
+		inline BatchVector loadBatch(const float* source) { return _mm256_loadu_ps(source); }
+		inline void storeBatch(float* dest, BatchVector value) { _mm256_storeu_ps(dest, value); }
+		inline BatchVector add(BatchVector a, BatchVector b) { return _mm256_add_ps(a, b); }
+		inline BatchVector sub(BatchVector a, BatchVector b) { return _mm256_sub_ps(a, b); }
+		inline BatchVector mul(BatchVector a, BatchVector b) { return _mm256_mul_ps(a, b); }
+		inline BatchVector mulAdd(BatchVector a, BatchVector b, BatchVector c) { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+		inline BatchVector inverseSqrt(BatchVector value)
+		{
+			return _mm256_div_ps(_mm256_set1_ps(1.f), _mm256_sqrt_ps(_mm256_max_ps(value, _mm256_set1_ps(FLT_MIN))));
+		}
+		// sign  θ value ȣ ´.
+		inline BatchVector flipSign(BatchVector value, BatchVector sign) { return _mm256_xor_ps(value, _mm256_and_ps(sign, _mm256_set1_ps(-0.f))); }
+		inline BatchVector gather(const float* base, const int* offsets)
+		{
+#if defined(__AVX2__)
+			return _mm256_i32gather_ps(base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets)), 4);
+#else
+			return _mm256_set_ps(base[offsets[7]], base[offsets[6]], base[offsets[5]], base[offsets[4]],
+				base[offsets[3]], base[offsets[2]], base[offsets[1]], base[offsets[0]]);
+#endif
+		}
+#else
+		struct BatchVector
+		{
+			__m128 Low;
+			__m128 High;
+		};
+
+		inline BatchVector setBatch(float value) { return { _mm_set1_ps(value), _mm_set1_ps(value) }; }
+		inline BatchVector loadBatch(const float* source) { return { _mm_loadu_ps(source), _mm_loadu_ps(source + 4) }; }
+		inline void storeBatch(float* dest, BatchVector value) { _mm_storeu_ps(dest, value.Low); _mm_storeu_ps(dest + 4, value.High); }
+		inline BatchVector add(BatchVector a, BatchVector b) { return { _mm_add_ps(a.Low, b.Low), _mm_add_ps(a.High, b.High) }; }
+		inline BatchVector sub(BatchVector a, BatchVector b) { return { _mm_sub_ps(a.Low, b.Low), _mm_sub_ps(a.High, b.High) }; }
+		inline BatchVector mul(BatchVector a, BatchVector b) { return { _mm_mul_ps(a.Low, b.Low), _mm_mul_ps(a.High, b.High) }; }
+		inline BatchVector mulAdd(BatchVector a, BatchVector b, BatchVector c) { return add(mul(a, b), c); }
+		inline BatchVector inverseSqrt(BatchVector value)
+		{
+			const __m128 one = _mm_set1_ps(1.f);
+			const __m128 minimum = _mm_set1_ps(FLT_MIN);
+			return { _mm_div_ps(one, _mm_sqrt_ps(_mm_max_ps(value.Low, minimum))), _mm_div_ps(one, _mm_sqrt_ps(_mm_max_ps(value.High, minimum))) };
+		}
+		inline BatchVector flipSign(BatchVector value, BatchVector sign)
+		{
+			const __m128 signMask = _mm_set1_ps(-0.f);
+			return { _mm_xor_ps(value.Low, _mm_and_ps(sign.Low, signMask)), _mm_xor_ps(value.High, _mm_and_ps(sign.High, signMask)) };
+		}
+		inline BatchVector gather(const float* base, const int* offsets)
+		{
+			return { _mm_set_ps(base[offsets[3]], base[offsets[2]], base[offsets[1]], base[offsets[0]]),
+				_mm_set_ps(base[offsets[7]], base[offsets[6]], base[offsets[5]], base[offsets[4]]) };
+		}
+#endif
+
+		//   ϳ θ .    ̸  Ѵ.
+		inline BatchVector loadBone(const float* palette, int sharedOffset, const int* offsets)
+		{
+			return sharedOffset >= 0 ? setBatch(palette[sharedOffset]) : gather(palette, offsets);
+		}
+
+		struct BatchVector3
+		{
+			BatchVector X;
+			BatchVector Y;
+			BatchVector Z;
+		};
+
+		inline BatchVector3 cross(const BatchVector3& a, const BatchVector3& b)
+		{
+			return { sub(mul(a.Y, b.Z), mul(a.Z, b.Y)), sub(mul(a.Z, b.X), mul(a.X, b.Z)), sub(mul(a.X, b.Y), mul(a.Y, b.X)) };
+		}
+
+		inline BatchVector3 normalize(const BatchVector3& v)
+		{
+			const BatchVector inverseLength = inverseSqrt(mulAdd(v.X, v.X, mulAdd(v.Y, v.Y, mul(v.Z, v.Z))));
+			return { mul(v.X, inverseLength), mul(v.Y, inverseLength), mul(v.Z, inverseLength) };
+		}
+
+		// ũ⸦  ȸ (  Ծ) ʹϾ, rotate(q, v) == v * m ǵ Ѵ.
+		Quaternion makeRotation(const Matrix& m, float inverseScale)
+		{
+			const float m11 = m._11 * inverseScale, m12 = m._12 * inverseScale, m13 = m._13 * inverseScale;
+			const float m21 = m._21 * inverseScale, m22 = m._22 * inverseScale, m23 = m._23 * inverseScale;
+			const float m31 = m._31 * inverseScale, m32 = m._32 * inverseScale, m33 = m._33 * inverseScale;
+			const float trace = m11 + m22 + m33;
+
+			Quaternion rotation;
+			if (trace > 0.f)
+			{
+				const float s = sqrtf(trace + 1.f) * 2.f;
+				rotation = Quaternion((m23 - m32) / s, (m31 - m13) / s, (m12 - m21) / s, 0.25f * s);
+			}
+			else if (m11 > m22 && m11 > m33)
+			{
+				const float s = sqrtf(1.f + m11 - m22 - m33) * 2.f;
+				rotation = Quaternion(0.25f * s, (m12 + m21) / s, (m31 + m13) / s, (m23 - m32) / s);
+			}
+			else if (m22 > m33)
+			{
+				const float s = sqrtf(1.f + m22 - m11 - m33) * 2.f;
+				rotation = Quaternion((m12 + m21) / s, 0.25f * s, (m23 + m32) / s, (m31 - m13) / s);
+			}
+			else
+			{
+				const float s = sqrtf(1.f + m33 - m11 - m22) * 2.f;
+				rotation = Quaternion((m31 + m13) / s, (m23 + m32) / s, 0.25f * s, (m12 - m21) / s);
+			}
+
+			rotation.Normalize();
+			return rotation;
+		}
+
+		// ȸ q  ̵ t  ʹϾ  κ 0.5 * (t, 0) * q
+		Quaternion makeDual(const Vector3& t, const Quaternion& q)
+		{
+			return Quaternion(0.5f * (t.x * q.w + t.y * q.z - t.z * q.y),
+				0.5f * (-t.x * q.z + t.y * q.w + t.z * q.x),
+				0.5f * (t.x * q.y - t.y * q.x + t.z * q.w),
+				-0.5f * (t.x * q.x + t.y * q.y + t.z * q.z));
+		}
+
+		// ȭ  ʹϾ (r, d)  ִ ̵ 2 * d * conj(r)
+		Vector3 getTranslation(const Quaternion& r, const Quaternion& d)
+		{
+			const Vector3 rv(r.x, r.y, r.z);
+			const Vector3 dv(d.x, d.y, d.z);
+			return 2.f * (r.w * dv - d.w * rv + rv.Cross(dv));
+		}
+
+		//  ʹϾ ȸ v + 2u x (u x v + w v)
+		Vector3 rotate(const Quaternion& q, const Vector3& v)
+		{
+			const Vector3 u(q.x, q.y, q.z);
+			return v + 2.f * u.Cross(u.Cross(v) + q.w * v);
+		}
+
+		inline BatchVector3 rotate(const BatchVector3& u, BatchVector w, const BatchVector3& v)
+		{
+			const BatchVector3 uv = cross(u, v);
+			const BatchVector3 inner = { mulAdd(w, v.X, uv.X), mulAdd(w, v.Y, uv.Y), mulAdd(w, v.Z, uv.Z) };
+			const BatchVector3 outer = cross(u, inner);
+			const BatchVector two = setBatch(2.f);
+
+			return { mulAdd(two, outer.X, v.X), mulAdd(two, outer.Y, v.Y), mulAdd(two, outer.Z, v.Z) };
+		}
+
+		//  迭 ġ  count .
+		inline void storeVectors(const BatchVector3& v, unsigned int count, Vector3* outVectors)
+		{
+			float x[CpuSkinner::BATCH_SIZE];
+			float y[CpuSkinner::BATCH_SIZE];
+			float z[CpuSkinner::BATCH_SIZE];
+			storeBatch(x, v.X);
+			storeBatch(y, v.Y);
+			storeBatch(z, v.Z);
+
+			for (unsigned int lane = 0; lane < count; ++lane)
+			{
+				outVectors[lane] = Vector3(x[lane], y[lane], z[lane]);
+			}
+		}
+	}
+
+	CpuSkinner::CpuSkinner()
+		: mVertexCount(0)
+		, mBoneCount(0)
+	{
+	}
+
+	void CpuSkinner::Prepare(const vertex::PosNormalTexTanSkinned* vertices, const unsigned int* subsetStarts, unsigned int subsetCount,
+		const PaletteLayout& layout)
+	{
+		assert(subsetCount + 1 == layout.SubsetOffsets.size());
+
+		mVertexCount = subsetStarts[subsetCount];
+		mBoneCount = layout.GetBoneCount();
+		mBatches.assign((mVertexCount + BATCH_SIZE - 1) / BATCH_SIZE, VertexBatch());
+
+		//  ΰ   ׵  ġ 0 ä.
+		const int identityOffset = static_cast<int>(mBoneCount * PALETTE_STRIDE);
+		for (VertexBatch& batch : mBatches)
+		{
+			std::fill(&batch.PaletteOffsets[0][0], &batch.PaletteOffsets[0][0] + MAX_INFLUENCE_COUNT * BATCH_SIZE, identityOffset);
+			batch.InfluenceCount = 1;
+		}
+
+		for (unsigned int subset = 0; subset < subsetCount; ++subset)
+		{
+			const unsigned int boneOffset = layout.SubsetOffsets[subset];
+			for (unsigned int i = subsetStarts[subset]; i < subsetStarts[subset + 1]; ++i)
+			{
+				const vertex::PosNormalTexTanSkinned& vertex = vertices[i];
+				VertexBatch& batch = mBatches[i / BATCH_SIZE];
+				const unsigned int lane = i % BATCH_SIZE;
+
+				batch.PositionX[lane] = vertex.Pos.x;
+				batch.PositionY[lane] = vertex.Pos.y;
+				batch.PositionZ[lane] = vertex.Pos.z;
+				batch.NormalX[lane] = vertex.Normal.x;
+				batch.NormalY[lane] = vertex.Normal.y;
+				batch.NormalZ[lane] = vertex.Normal.z;
+
+				unsigned int influence = 0;
+				for (; influence < MAX_INFLUENCE_COUNT && vertex.Indices[influence] != vertex::PosNormalTexTanSkinned::INVALID_INDEX; ++influence)
+				{
+					batch.PaletteOffsets[influence][lane] = static_cast<int>((boneOffset + vertex.Indices[influence]) * PALETTE_STRIDE);
+					batch.Weights[influence][lane] = vertex.Weights[influence];
+				}
+
+				//    ׵  ε  .
+				if (influence == 0)
+				{
+					batch.Weights[0][lane] = 1.f;
+				}
+
+				batch.InfluenceCount = std::max<unsigned int>(batch.InfluenceCount, influence);
+			}
+		}
+
+		//      ġ ü    찡 .
+		for (VertexBatch& batch : mBatches)
+		{
+			for (unsigned int influence = 0; influence < MAX_INFLUENCE_COUNT; ++influence)
+			{
+				const int* offsets = batch.PaletteOffsets[influence];
+				const bool bShared = std::all_of(offsets, offsets + BATCH_SIZE, [offsets](int offset) { return offset == offsets[0]; });
+				batch.SharedOffsets[influence] = bShared ? offsets[0] : -1;
+			}
+		}
+	}
+
+	void CpuSkinner::BuildBonePalette(const Matrix* skinMatrices, unsigned int boneCount, eSkinningMode mode, BonePalette* outPalette)
+	{
+		outPalette->Mode = mode;
+		outPalette->BoneCount = boneCount;
+		outPalette->Floats.resize(static_cast<size_t>(boneCount + 1) * PALETTE_STRIDE);
+
+		for (unsigned int bone = 0; bone <= boneCount; ++bone)
+		{
+			const Matrix& skinMatrix = bone < boneCount ? skinMatrices[bone] : Matrix::Identity;
+			float* floats = &outPalette->Floats[static_cast<size_t>(bone) * PALETTE_STRIDE];
+
+			if (mode == eSkinningMode::LinearBlend)
+			{
+				const float values[PALETTE_STRIDE] =
+				{
+					skinMatrix._11, skinMatrix._12, skinMatrix._13,
+					skinMatrix._21, skinMatrix._22, skinMatrix._23,
+					skinMatrix._31, skinMatrix._32, skinMatrix._33,
+					skinMatrix._41, skinMatrix._42, skinMatrix._43
+				};
+				std::copy(values, values + PALETTE_STRIDE, floats);
+			}
+			else
+			{
+				// ũ յϴٰ  ù  ̷ .
+				const float scale = Vector3(skinMatrix._11, skinMatrix._12, skinMatrix._13).Length();
+				const Quaternion rotation = makeRotation(skinMatrix, scale > 0.f ? 1.f / scale : 0.f);
+				const Quaternion dual = makeDual(Vector3(skinMatrix._41, skinMatrix._42, skinMatrix._43), rotation);
+				const float values[PALETTE_STRIDE] =
+				{
+					rotation.x, rotation.y, rotation.z, rotation.w,
+					dual.x, dual.y, dual.z, dual.w,
+					scale, 0.f, 0.f, 0.f
+				};
+				std::copy(values, values + PALETTE_STRIDE, floats);
+			}
+		}
+	}
+
+	void CpuSkinner::Skin(const BonePalette& palette, common::JobSystem* jobSystem, Vector3* outPositions, Vector3* outNormals) const
+	{
+		const unsigned int batchCount = GetBatchCount();
+
+		if (jobSystem != nullptr)
+		{
+			jobSystem->ParallelFor(batchCount, DEFAULT_GRAIN_SIZE, [&](uint32_t begin, uint32_t end)
+				{
+					SkinBatches(palette, begin, end, outPositions, outNormals);
+				});
+		}
+		else
+		{
+			SkinBatches(palette, 0, batchCount, outPositions, outNormals);
+		}
+	}
+
+	void CpuSkinner::SkinBatches(const BonePalette& palette, unsigned int beginBatch, unsigned int endBatch, Vector3* outPositions,
+		Vector3* outNormals) const
+	{
+		assert(palette.BoneCount == mBoneCount);
+		const float* paletteFloats = palette.Floats.data();
+
+		for (unsigned int batchIndex = beginBatch; batchIndex < endBatch; ++batchIndex)
+		{
+			const VertexBatch& batch = mBatches[batchIndex];
+			const BatchVector3 position = { loadBatch(batch.PositionX), loadBatch(batch.PositionY), loadBatch(batch.PositionZ) };
+			const BatchVector3 normal = { loadBatch(batch.NormalX), loadBatch(batch.NormalY), loadBatch(batch.NormalZ) };
+			BatchVector3 skinnedPosition;
+			BatchVector3 skinnedNormal;
+
+			if (palette.Mode == eSkinningMode::LinearBlend)
+			{
+				// ⸶  12 κ       Ѵ.
+				BatchVector m[PALETTE_STRIDE];
+				for (unsigned int c = 0; c < PALETTE_STRIDE; ++c)
+				{
+					m[c] = setBatch(0.f);
+				}
+
+				for (unsigned int influence = 0; influence < batch.InfluenceCount; ++influence)
+				{
+					const BatchVector weight = loadBatch(batch.Weights[influence]);
+					const int* offsets = batch.PaletteOffsets[influence];
+					const int sharedOffset = batch.SharedOffsets[influence];
+					for (unsigned int c = 0; c < PALETTE_STRIDE; ++c)
+					{
+						m[c] = mulAdd(weight, loadBone(paletteFloats + c, sharedOffset, offsets), m[c]);
+					}
+				}
+
+				skinnedPosition.X = mulAdd(position.X, m[0], mulAdd(position.Y, m[3], mulAdd(position.Z, m[6], m[9])));
+				skinnedPosition.Y = mulAdd(position.X, m[1], mulAdd(position.Y, m[4], mulAdd(position.Z, m[7], m[10])));
+				skinnedPosition.Z = mulAdd(position.X, m[2], mulAdd(position.Y, m[5], mulAdd(position.Z, m[8], m[11])));
+				skinnedNormal.X = mulAdd(normal.X, m[0], mulAdd(normal.Y, m[3], mul(normal.Z, m[6])));
+				skinnedNormal.Y = mulAdd(normal.X, m[1], mulAdd(normal.Y, m[4], mul(normal.Z, m[7])));
+				skinnedNormal.Z = mulAdd(normal.X, m[2], mulAdd(normal.Y, m[5], mul(normal.Z, m[8])));
+			}
+			else
+			{
+				// ù  ȸ ݴ ݱ ִ  ġ ȣ  ª  ´.
+				BatchVector first[9];
+				for (unsigned int c = 0; c < 9; ++c)
+				{
+					first[c] = loadBone(paletteFloats + c, batch.SharedOffsets[0], batch.PaletteOffsets[0]);
+				}
+
+				BatchVector q[8];
+				const BatchVector firstWeight = loadBatch(batch.Weights[0]);
+				for (unsigned int c = 0; c < 8; ++c)
+				{
+					q[c] = mul(firstWeight, first[c]);
+				}
+				BatchVector scale = mul(firstWeight, first[8]);
+
+				for (unsigned int influence = 1; influence < batch.InfluenceCount; ++influence)
+				{
+					const int* offsets = batch.PaletteOffsets[influence];
+					const int sharedOffset = batch.SharedOffsets[influence];
+					BatchVector components[9];
+					for (unsigned int c = 0; c < 9; ++c)
+					{
+						components[c] = loadBone(paletteFloats + c, sharedOffset, offsets);
+					}
+
+					const BatchVector weight = loadBatch(batch.Weights[influence]);
+					const BatchVector hemisphere = mulAdd(components[0], first[0], mulAdd(components[1], first[1],
+						mulAdd(components[2], first[2], mul(components[3], first[3]))));
+					const BatchVector signedWeight = flipSign(weight, hemisphere);
+					for (unsigned int c = 0; c < 8; ++c)
+					{
+						q[c] = mulAdd(signedWeight, components[c], q[c]);
+					}
+					scale = mulAdd(weight, components[8], scale);
+				}
+
+				const BatchVector inverseLength = inverseSqrt(mulAdd(q[0], q[0], mulAdd(q[1], q[1], mulAdd(q[2], q[2], mul(q[3], q[3])))));
+				const BatchVector3 real = { mul(q[0], inverseLength), mul(q[1], inverseLength), mul(q[2], inverseLength) };
+				const BatchVector realW = mul(q[3], inverseLength);
+				const BatchVector3 dual = { mul(q[4], inverseLength), mul(q[5], inverseLength), mul(q[6], inverseLength) };
+				const BatchVector dualW = mul(q[7], inverseLength);
+
+				// t = 2 * (rw * dv - dw * rv + rv x dv)
+				const BatchVector3 realCrossDual = cross(real, dual);
+				const BatchVector two = setBatch(2.f);
+				const BatchVector3 translation =
+				{
+					mul(two, add(sub(mul(realW, dual.X), mul(dualW, real.X)), realCrossDual.X)),
+					mul(two, add(sub(mul(realW, dual.Y), mul(dualW, real.Y)), realCrossDual.Y)),
+					mul(two, add(sub(mul(realW, dual.Z), mul(dualW, real.Z)), realCrossDual.Z))
+				};
+
+				const BatchVector3 scaledPosition = { mul(position.X, scale), mul(position.Y, scale), mul(position.Z, scale) };
+				const BatchVector3 rotatedPosition = rotate(real, realW, scaledPosition);
+				skinnedPosition = { add(rotatedPosition.X, translation.X), add(rotatedPosition.Y, translation.Y), add(rotatedPosition.Z, translation.Z) };
+				skinnedNormal = rotate(real, realW, normal);
+			}
+
+			const unsigned int first = batchIndex * BATCH_SIZE;
+			const unsigned int count = std::min<unsigned int>(BATCH_SIZE, mVertexCount - first);
+			storeVectors(skinnedPosition, count, outPositions + first);
+			if (outNormals != nullptr)
+			{
+				storeVectors(normalize(skinnedNormal), count, outNormals + first);
+			}
+		}
+	}
+
+	void CpuSkinner::SkinVertex(const vertex::PosNormalTexTanSkinned& vertex, unsigned int boneOffset, const BonePalette& palette,
+		Vector3* outPosition, Vector3* outNormal)
+	{
+		//    ׵  ϳ .
+		unsigned int bones[MAX_INFLUENCE_COUNT] = { palette.BoneCount };
+		float weights[MAX_INFLUENCE_COUNT] = { 1.f };
+		unsigned int influenceCount = 0;
+		for (; influenceCount < MAX_INFLUENCE_COUNT && vertex.Indices[influenceCount] != vertex::PosNormalTexTanSkinned::INVALID_INDEX; ++influenceCount)
+		{
+			bones[influenceCount] = boneOffset + vertex.Indices[influenceCount];
+			weights[influenceCount] = vertex.Weights[influenceCount];
+		}
+		influenceCount = std::max<unsigned int>(influenceCount, 1);
+
+		Vector3 normal;
+		if (palette.Mode == eSkinningMode::LinearBlend)
+		{
+			Vector3 position = Vector3::Zero;
+			normal = Vector3::Zero;
+			for (unsigned int i = 0; i < influenceCount; ++i)
+			{
+				const float* m = &palette.Floats[static_cast<size_t>(bones[i]) * PALETTE_STRIDE];
+				const Vector3& p = vertex.Pos;
+				const Vector3& n = vertex.Normal;
+				position += weights[i] * Vector3(p.x * m[0] + p.y * m[3] + p.z * m[6] + m[9],
+					p.x * m[1] + p.y * m[4] + p.z * m[7] + m[10],
+					p.x * m[2] + p.y * m[5] + p.z * m[8] + m[11]);
+				normal += weights[i] * Vector3(n.x * m[0] + n.y * m[3] + n.z * m[6],
+					n.x * m[1] + n.y * m[4] + n.z * m[7],
+					n.x * m[2] + n.y * m[5] + n.z * m[8]);
+			}
+
+			*outPosition = position;
+		}
+		else
+		{
+			const float* first = &palette.Floats[static_cast<size_t>(bones[0]) * PALETTE_STRIDE];
+			const Quaternion firstRotation(first[0], first[1], first[2], first[3]);
+			Quaternion real(0.f, 0.f, 0.f, 0.f);
+			Quaternion dual(0.f, 0.f, 0.f, 0.f);
+			float scale = 0.f;
+
+			for (unsigned int i = 0; i < influenceCount; ++i)
+			{
+				const float* q = &palette.Floats[static_cast<size_t>(bones[i]) * PALETTE_STRIDE];
+				const Quaternion rotation(q[0], q[1], q[2], q[3]);
+				const float signedWeight = rotation.Dot(firstRotation) < 0.f ? -weights[i] : weights[i];
+				real += rotation * signedWeight;
+				dual += Quaternion(q[4], q[5], q[6], q[7]) * signedWeight;
+				scale += weights[i] * q[8];
+			}
+
+			const float inverseLength = 1.f / sqrtf(std::max<float>(real.Dot(real), FLT_MIN));
+			real = real * inverseLength;
+			dual = dual * inverseLength;
+
+			*outPosition = rotate(real, vertex.Pos * scale) + getTranslation(real, dual);
+			normal = rotate(real, vertex.Normal);
+		}
+
+		if (outNormal != nullptr)
+		{
+			normal.Normalize();
+			*outNormal = normal;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <vector>
+
+#include "Animation.h"
+#include "Vertex.h"
+
+namespace common
+{
+	class JobSystem;
+}
+
+namespace resourceManager
+{
+	enum class eSkinningMode
+	{
+		LinearBlend, //  ġ ´. ̴(SkinnedVertexShader.hlsl)  
+		DualQuaternion // ȸ + ̵  ʹϾ   ǰ  ʴ´. յ ũ⸸ ٷ.
+	};
+
+	// PosNormalTexTanSkinned  CPU ŰѴ. (ŷ, 浹, ִϸ̼ , ؽ ִϸ̼ )
+	// Prepare  BATCH_SIZE к Ǯ(SoA)  ȣ ȷƮ ü ȣ ٲ θ,
+	//   ȷƮ ٲ ġ ϳ AVX  , ƴϸ SSE   ŰѴ.
+	//    ġ  ķ óϹǷ   尡  Ѵ.
+	class CpuSkinner
+	{
+	public:
+		enum { BATCH_SIZE = 8, MAX_INFLUENCE_COUNT = 4 };
+		enum { PALETTE_STRIDE = 12 }; //  ϳ float 
+		enum { DEFAULT_GRAIN_SIZE = 16 }; //  ó  ۾ ϳ ġ 
+
+		//  PALETTE_STRIDE float
+		// LinearBlend:  1 ~ 3 xyz ̵ xyz
+		// DualQuaternion: ȸ ʹϾ xyzw,  κ xyzw, յ ũ
+		//       ׵  ϳ  ִ.
+		struct BonePalette
+		{
+			eSkinningMode Mode;
+			unsigned int BoneCount;
+			std::vector<float> Floats;
+		};
+
+	public:
+		CpuSkinner();
+
+		//  i  [subsetStarts[i], subsetStarts[i + 1]) ְ  ȣ layout.SubsetOffsets[i]ʹ.
+		void Prepare(const vertex::PosNormalTexTanSkinned* vertices, const unsigned int* subsetStarts, unsigned int subsetCount, const PaletteLayout& layout);
+
+		// skinMatrices ̾ƿ  ŭ  * Ʈ   (ġ  )
+		static void BuildBonePalette(const DirectX::SimpleMath::Matrix* skinMatrices, unsigned int boneCount, eSkinningMode mode, BonePalette* outPalette);
+
+		//   Ű   . outNormals nullptr̾ ȴ.
+		void Skin(const BonePalette& palette, common::JobSystem* jobSystem, DirectX::SimpleMath::Vector3* outPositions,
+			DirectX::SimpleMath::Vector3* outNormals) const;
+		// ġ [beginBatch, endBatch) ŰѴ.  ü  迭 
+		void SkinBatches(const BonePalette& palette, unsigned int beginBatch, unsigned int endBatch, DirectX::SimpleMath::Vector3* outPositions,
+			DirectX::SimpleMath::Vector3* outNormals) const;
+
+		//  ϳ ϴ  , boneOffset    ȷƮ  ȣ
+		static void SkinVertex(const vertex::PosNormalTexTanSkinned& vertex, unsigned int boneOffset, const BonePalette& palette,
+			DirectX::SimpleMath::Vector3* outPosition, DirectX::SimpleMath::Vector3* outNormal);
+
+		inline unsigned int GetVertexCount() const;
+		inline unsigned int GetBatchCount() const;
+		inline unsigned int GetBoneCount() const;
+
+	private:
+		//  BATCH_SIZE к  ,   ׵  ġ 0
+		struct VertexBatch
+		{
+			float PositionX[BATCH_SIZE];
+			float PositionY[BATCH_SIZE];
+			float PositionZ[BATCH_SIZE];
+			float NormalX[BATCH_SIZE];
+			float NormalY[BATCH_SIZE];
+			float NormalZ[BATCH_SIZE];
+			int PaletteOffsets[MAX_INFLUENCE_COUNT][BATCH_SIZE]; //  ȣ * PALETTE_STRIDE
+			int SharedOffsets[MAX_INFLUENCE_COUNT]; //    ̸  , ƴϸ -1 ( ʰ Ѵ.)
+			float Weights[MAX_INFLUENCE_COUNT][BATCH_SIZE];
+			unsigned int InfluenceCount; // ġ    , Ѵ  ǳʶڴ.
+		};
+
+	private:
+		unsigned int mVertexCount;
+		unsigned int mBoneCount;
+		std::vector<VertexBatch> mBatches;
+	};
+
+	unsigned int CpuSkinner::GetVertexCount() const
+	{
+		return mVertexCount;
+	}
+
+	unsigned int CpuSkinner::GetBatchCount() const
+	{
+		return static_cast<unsigned int>(mBatches.size());
+	}
+
+	unsigned int CpuSkinner::GetBoneCount() const
+	{
+		return mBoneCount;
+	}
+}
\ No newline at end of file
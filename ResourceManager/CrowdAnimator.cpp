@@ -0,0 +1,344 @@
+#include <Windows.h>
+#include <cmath>
+
+#include "CrowdAnimator.h"
+#include "JobSystem.h"
+#include "PoseBlender.h"
+
+namespace resourceManager
+{
+	using namespace DirectX::SimpleMath;
+
+	namespace
+	{
+		// clip nullptr̸ ε , ð Ŭ ̷ ´. nodes nullptr̸  带 øѴ.
+		void sampleClip(const AnimationClip* clip, const Skeleton& skeleton, float timePos, AnimationCursor* cursors,
+			const unsigned int* nodes, unsigned int nodeCount, LocalPose* outPose)
+		{
+			if (clip == nullptr)
+			{
+				*outPose = skeleton.BindPose;
+				return;
+			}
+
+			const float clipTime = clip->Duration > 0.0 ? static_cast<float>(fmod(timePos, clip->Duration)) : 0.f;
+			if (nodes == nullptr)
+			{
+				clip->SamplePose(skeleton, clipTime, cursors, outPose);
+			}
+			else
+			{
+				clip->SamplePose(skeleton, clipTime, cursors, nodes, nodeCount, outPose);
+			}
+		}
+	}
+
+	CrowdAnimator::CrowdAnimator()
+		: mbPoseSharing(false)
+	{
+	}
+
+	unsigned int CrowdAnimator::AddInstance(const Skeleton* skeleton, const PaletteLayout* layout, const AnimationClip* clip, float timePos)
+	{
+		assert(skeleton != nullptr && layout != nullptr);
+
+		const unsigned int instanceIndex = GetInstanceCount();
+		auto depthOrder = mDepthOrders.find(skeleton);
+		if (depthOrder == mDepthOrders.end())
+		{
+			depthOrder = mDepthOrders.insert({ skeleton, DepthOrder() }).first;
+			skeleton->ComputeDepthOrder(&depthOrder->second.Nodes, &depthOrder->second.DepthCounts);
+		}
+
+		mInstances.push_back({ skeleton, layout, clip, timePos, mPalettes.size(), &depthOrder->second, PoseCache::INVALID_ENTRY,
+			nullptr, 0.f, 0.f, 0.f });
+
+		// ̸  ϸ   ø    ε  ´.
+		mPoses.push_back(skeleton->BindPose);
+		mCursors.emplace_back(skeleton->GetNodeCount());
+		mFadeCursors.emplace_back(skeleton->GetNodeCount());
+		mPalettes.resize(mPalettes.size() + layout->GetBoneCount(), Matrix::Identity);
+
+		return instanceIndex;
+	}
+
+	void CrowdAnimator::SetClip(unsigned int instanceIndex, const AnimationClip* clip, float timePos)
+	{
+		Instance& instance = mInstances[instanceIndex];
+		instance.Clip = clip;
+		instance.TimePos = timePos;
+		instance.FadeClip = nullptr;
+
+		// Ŀ Ʈ ״ ֵ   ó    Žϴ  .
+		std::fill(mCursors[instanceIndex].begin(), mCursors[instanceIndex].end(), AnimationCursor());
+	}
+
+	void CrowdAnimator::CrossFade(unsigned int instanceIndex, const AnimationClip* clip, float timePos, float fadeDuration)
+	{
+		if (fadeDuration <= 0.f)
+		{
+			SetClip(instanceIndex, clip, timePos);
+			return;
+		}
+
+		// ̵ ߿ ٽ ٲٸ ̴  Ŭ     Ŭ Ѿ.
+		Instance& instance = mInstances[instanceIndex];
+		instance.FadeClip = instance.Clip;
+		instance.FadeTimePos = instance.TimePos;
+		instance.FadeElapsed = 0.f;
+		instance.FadeDuration = fadeDuration;
+		instance.Clip = clip;
+		instance.TimePos = timePos;
+
+		mCursors[instanceIndex].swap(mFadeCursors[instanceIndex]);
+		std::fill(mCursors[instanceIndex].begin(), mCursors[instanceIndex].end(), AnimationCursor());
+	}
+
+	void CrowdAnimator::Clear()
+	{
+		mInstances.clear();
+		mPoses.clear();
+		mCursors.clear();
+		mFadeCursors.clear();
+		mPalettes.clear();
+		mDepthOrders.clear();
+		mPoseCache.Clear();
+	}
+
+	void CrowdAnimator::SetPoseSharing(float timeQuantum)
+	{
+		//    򰡱 νϽ ڱ ȷƮ δ.
+		for (Instance& instance : mInstances)
+		{
+			instance.CacheEntry = PoseCache::INVALID_ENTRY;
+		}
+
+		mPoseCache.Clear();
+		mbPoseSharing = timeQuantum > 0.f;
+		if (mbPoseSharing)
+		{
+			mPoseCache.SetTimeQuantum(timeQuantum);
+		}
+	}
+
+	void CrowdAnimator::Update(float deltaTime, common::JobSystem* jobSystem)
+	{
+		AdvanceTime(deltaTime);
+
+		if (mbPoseSharing)
+		{
+			mPoseCache.BeginFrame();
+			for (unsigned int i = 0; i < GetInstanceCount(); ++i)
+			{
+				assignCacheEntry(i, 0.f, MAX_BONE_DEPTH);
+			}
+			evaluateCacheEntries(jobSystem);
+		}
+
+		auto updateRange = [this](UINT begin, UINT end)
+			{
+				UpdateScratch* scratch = getThreadScratch();
+				for (UINT i = begin; i < end; ++i)
+				{
+					if (mInstances[i].CacheEntry == PoseCache::INVALID_ENTRY)
+					{
+						evaluateInstance(i, 0.f, MAX_BONE_DEPTH, scratch);
+					}
+				}
+			};
+
+		if (jobSystem != nullptr)
+		{
+			jobSystem->ParallelFor(GetInstanceCount(), GRAIN_SIZE, updateRange);
+		}
+		else
+		{
+			updateRange(0, GetInstanceCount());
+		}
+	}
+
+	void CrowdAnimator::AdvanceTime(float deltaTime)
+	{
+		for (Instance& instance : mInstances)
+		{
+			instance.TimePos += deltaTime;
+
+			if (instance.FadeClip != nullptr)
+			{
+				instance.FadeTimePos += deltaTime;
+				instance.FadeElapsed += deltaTime;
+
+				if (instance.FadeElapsed >= instance.FadeDuration)
+				{
+					instance.FadeClip = nullptr;
+				}
+			}
+		}
+	}
+
+	void CrowdAnimator::Evaluate(const EvaluationRequest* requests, unsigned int requestCount, common::JobSystem* jobSystem)
+	{
+		if (mbPoseSharing)
+		{
+			mPoseCache.BeginFrame();
+			for (unsigned int i = 0; i < requestCount; ++i)
+			{
+				assignCacheEntry(requests[i].InstanceIndex, requests[i].LookAheadTime, requests[i].MaxBoneDepth);
+			}
+			evaluateCacheEntries(jobSystem);
+		}
+
+		auto evaluateRange = [this, requests](UINT begin, UINT end)
+			{
+				UpdateScratch* scratch = getThreadScratch();
+				for (UINT i = begin; i < end; ++i)
+				{
+					const EvaluationRequest& request = requests[i];
+					if (mInstances[request.InstanceIndex].CacheEntry == PoseCache::INVALID_ENTRY)
+					{
+						evaluateInstance(request.InstanceIndex, request.LookAheadTime, request.MaxBoneDepth, scratch);
+					}
+				}
+			};
+
+		if (jobSystem != nullptr)
+		{
+			jobSystem->ParallelFor(requestCount, GRAIN_SIZE, evaluateRange);
+		}
+		else
+		{
+			evaluateRange(0, requestCount);
+		}
+	}
+
+	CrowdAnimator::UpdateScratch* CrowdAnimator::getThreadScratch()
+	{
+		// Ʈ  İ ̵  νϽ ϳ óϴ ȸ Ƿ 帶 ϳ  .
+		thread_local UpdateScratch scratch;
+		return &scratch;
+	}
+
+	void CrowdAnimator::assignCacheEntry(unsigned int instanceIndex, float lookAheadTime, unsigned int maxBoneDepth)
+	{
+		Instance& instance = mInstances[instanceIndex];
+
+		// ũν̵ ߿  Ŭ ð   ƾ ϹǷ   ʴ´.
+		unsigned int entry = PoseCache::INVALID_ENTRY;
+		if (instance.FadeClip == nullptr)
+		{
+			// ̷溸     ̹Ƿ Ű ϳ .
+			const unsigned int keyDepth = maxBoneDepth + 1 >= instance.Depths->DepthCounts.size() ? MAX_BONE_DEPTH : maxBoneDepth;
+			entry = mPoseCache.Acquire(mPoseCache.MakeKey(instance.Skeleton, instance.Layout, instance.Clip, instance.TimePos + lookAheadTime, keyDepth));
+		}
+
+		//  ׸ ٽ Ƶ  0  ʵ  ڿ ´.
+		if (instance.CacheEntry != PoseCache::INVALID_ENTRY)
+		{
+			mPoseCache.Release(instance.CacheEntry);
+		}
+		instance.CacheEntry = entry;
+	}
+
+	void CrowdAnimator::evaluateCacheEntries(common::JobSystem* jobSystem)
+	{
+		auto evaluateRange = [this](UINT begin, UINT end)
+			{
+				UpdateScratch* scratch = getThreadScratch();
+				for (UINT i = begin; i < end; ++i)
+				{
+					evaluateCacheEntry(mPoseCache.GetPendingEntry(i), scratch);
+				}
+			};
+
+		if (jobSystem != nullptr)
+		{
+			jobSystem->ParallelFor(mPoseCache.GetPendingCount(), GRAIN_SIZE, evaluateRange);
+		}
+		else
+		{
+			evaluateRange(0, mPoseCache.GetPendingCount());
+		}
+	}
+
+	void CrowdAnimator::evaluateCacheEntry(unsigned int entry, UpdateScratch* scratch)
+	{
+		const PoseCache::Key& key = mPoseCache.GetKey(entry);
+		const resourceManager::Skeleton& skeleton = *key.Skeleton;
+
+		// ׸ νϽ  ̾  Ƿ   ǳʶ  ε .
+		LocalPose& pose = scratch->CachePose;
+		pose = skeleton.BindPose;
+
+		std::vector<AnimationCursor>& cursors = scratch->CacheCursors;
+		if (cursors.size() < skeleton.GetNodeCount())
+		{
+			cursors.resize(skeleton.GetNodeCount());
+		}
+
+		//  AddInstance ٲǷ  ߿ б⸸ ϴ  ϴ.
+		const DepthOrder& depths = mDepthOrders.find(key.Skeleton)->second;
+		const bool bAllNodes = key.MaxBoneDepth + 1 >= depths.DepthCounts.size();
+		const unsigned int* nodes = bAllNodes ? nullptr : depths.Nodes.data();
+		const unsigned int nodeCount = bAllNodes ? skeleton.GetNodeCount() : depths.DepthCounts[key.MaxBoneDepth];
+
+		sampleClip(key.Clip, skeleton, mPoseCache.GetSampleTime(key), cursors.data(), nodes, nodeCount, &pose);
+
+		std::vector<Matrix>& toRootMatrices = scratch->ToRootMatrices;
+		if (toRootMatrices.size() < skeleton.GetNodeCount())
+		{
+			toRootMatrices.resize(skeleton.GetNodeCount());
+		}
+
+		skeleton.ComputeToRootMatrices(pose, toRootMatrices.data());
+		key.Layout->BuildPalette(toRootMatrices.data(), mPoseCache.GetPalette(entry));
+	}
+
+	void CrowdAnimator::evaluateInstance(unsigned int instanceIndex, float lookAheadTime, unsigned int maxBoneDepth, UpdateScratch* scratch)
+	{
+		const Instance& instance = mInstances[instanceIndex];
+		const resourceManager::Skeleton& skeleton = *instance.Skeleton;
+		LocalPose& pose = mPoses[instanceIndex];
+
+		//   ̷溸     ѱ.
+		const DepthOrder& depths = *instance.Depths;
+		const bool bAllNodes = maxBoneDepth + 1 >= depths.DepthCounts.size();
+		const unsigned int* nodes = bAllNodes ? nullptr : depths.Nodes.data();
+		const unsigned int nodeCount = bAllNodes ? skeleton.GetNodeCount() : depths.DepthCounts[maxBoneDepth];
+
+		sampleClip(instance.Clip, skeleton, instance.TimePos + lookAheadTime, mCursors[instanceIndex].data(), nodes, nodeCount, &pose);
+
+		if (instance.FadeClip != nullptr)
+		{
+			const float fadeWeight = (instance.FadeElapsed + lookAheadTime) / instance.FadeDuration;
+
+			if (fadeWeight < 1.f)
+			{
+				LocalPose& fadePose = scratch->FadePose;
+				if (bAllNodes)
+				{
+					if (fadePose.GetNodeCount() != skeleton.GetNodeCount())
+					{
+						fadePose.Resize(skeleton.GetNodeCount());
+					}
+				}
+				else
+				{
+					// ǳʶ  ڱ ڽŰ  ״ ´.
+					fadePose = pose;
+				}
+
+				sampleClip(instance.FadeClip, skeleton, instance.FadeTimePos + lookAheadTime, mFadeCursors[instanceIndex].data(), nodes, nodeCount, &fadePose);
+				PoseBlender::Lerp(fadePose, pose, fadeWeight, &pose);
+			}
+		}
+
+		std::vector<Matrix>& toRootMatrices = scratch->ToRootMatrices;
+		if (toRootMatrices.size() < skeleton.GetNodeCount())
+		{
+			toRootMatrices.resize(skeleton.GetNodeCount());
+		}
+
+		skeleton.ComputeToRootMatrices(pose, toRootMatrices.data());
+		instance.Layout->BuildPalette(toRootMatrices.data(), &mPalettes[instance.PaletteOffset]);
+	}
+}
\ No newline at end of file
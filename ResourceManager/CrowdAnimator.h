@@ -0,0 +1,180 @@
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include "Animation.h"
+#include "PoseCache.h"
+
+namespace common
+{
+	class JobSystem;
+}
+
+namespace resourceManager
+{
+	// νϽ õ    ý  ϰ  ۿ ø  ȷƮ .
+	// Ŭ ٲ  PoseBlender  Ŭ  Ƣ ʰ Ѿ  ִ.
+	// νϽ SoA  , Ŀ, ȷƮ   ־  ǵ帮 Ƿ νϽ ̰,
+	//     . ۴ AddInstance Ҵϰ Update Ҵ ʴ´.
+	//   Ѹ  , Ŭ, ȭ ð ϴ νϽ PoseCache ȷƮ ϳ  .
+	class CrowdAnimator
+	{
+	public:
+		enum { GRAIN_SIZE = 8 }; //  ϳ ô νϽ 
+		enum { MAX_BONE_DEPTH = 255 }; //  ̸  带 øѴ.
+
+		// νϽ ϳ  ϴ û, AnimationScheduler Ӹ .
+		struct EvaluationRequest
+		{
+			unsigned int InstanceIndex;
+			float LookAheadTime; //  ð ̸ŭ   .
+			unsigned int MaxBoneDepth; // ̺    ø  ȯ ״ .
+		};
+
+	public:
+		CrowdAnimator();
+
+		// skeleton, layout, clip ũ庸   ־ Ѵ. clip nullptr̸ ε 
+		unsigned int AddInstance(const Skeleton* skeleton, const PaletteLayout* layout, const AnimationClip* clip, float timePos);
+		void SetClip(unsigned int instanceIndex, const AnimationClip* clip, float timePos);
+		//   clip fadeDuration   Ѿ.  Ŭ ̵尡    ȴ.
+		void CrossFade(unsigned int instanceIndex, const AnimationClip* clip, float timePos, float fadeDuration);
+		void Clear();
+		// 0 ũ ũν̵  ƴ νϽ  ð   timeQuantum    Ű ȷƮ  .
+		// 0̸ νϽ Ȯ ð Ѵ. ٲٸ   ׸  .
+		void SetPoseSharing(float timeQuantum);
+
+		//  νϽ ð deltaTimeŭ   ȷƮ . jobSystem  ķ óѴ.
+		void Update(float deltaTime, common::JobSystem* jobSystem);
+		//  ״ ΰ  νϽ  ð ũν̵ ุ .
+		void AdvanceTime(float deltaTime);
+		// û νϽ  ȷƮ .  νϽ      ȴ.
+		void Evaluate(const EvaluationRequest* requests, unsigned int requestCount, common::JobSystem* jobSystem);
+
+		inline unsigned int GetInstanceCount() const;
+		inline const AnimationClip* GetClip(unsigned int instanceIndex) const;
+		inline float GetTimePos(unsigned int instanceIndex) const;
+		// ũν̵  ƴϸ nullptr
+		inline const AnimationClip* GetFadeClip(unsigned int instanceIndex) const;
+		inline float GetFadeTimePos(unsigned int instanceIndex) const;
+		// ȷƮ   νϽ   ʴ´.
+		inline const LocalPose& GetPose(unsigned int instanceIndex) const;
+		// ġ ȷƮ,   PaletteLayout::SubsetOffsets ã´.
+		inline const DirectX::SimpleMath::Matrix* GetPalette(unsigned int instanceIndex) const;
+		inline bool IsPoseShared(unsigned int instanceIndex) const;
+		inline const PoseCache& GetPoseCache() const;
+		inline unsigned int GetBoneCount(unsigned int instanceIndex) const;
+		// maxBoneDepth ø  ϴ  
+		inline unsigned int GetSampledNodeCount(unsigned int instanceIndex, unsigned int maxBoneDepth) const;
+
+	private:
+		// ̷ 带   þ ,  ̷  νϽ Ѵ.
+		struct DepthOrder
+		{
+			std::vector<unsigned int> Nodes;
+			std::vector<unsigned int> DepthCounts; //  d   
+		};
+
+		struct Instance
+		{
+			const resourceManager::Skeleton* Skeleton;
+			const PaletteLayout* Layout;
+			const AnimationClip* Clip;
+			float TimePos;
+			size_t PaletteOffset; // mPalettes   ġ
+			const DepthOrder* Depths;
+			unsigned int CacheEntry; //   ȷƮ,  PoseCache::INVALID_ENTRY
+
+			// ũν̵ ̸ FadeClip Clip FadeElapsed / FadeDurationŭ Ѿ ´.
+			const AnimationClip* FadeClip;
+			float FadeTimePos;
+			float FadeElapsed;
+			float FadeDuration;
+		};
+
+		// 帶 ϳ δ ۾ 
+		struct UpdateScratch
+		{
+			std::vector<DirectX::SimpleMath::Matrix> ToRootMatrices;
+			LocalPose FadePose;
+			LocalPose CachePose;
+			std::vector<AnimationCursor> CacheCursors;
+		};
+
+		static UpdateScratch* getThreadScratch();
+		// û ϳ ĳ ׸ ´. ũν̵ ̸ Ǯ  ϰ Ѵ.
+		void assignCacheEntry(unsigned int instanceIndex, float lookAheadTime, unsigned int maxBoneDepth);
+		// ̹ ӿ   ĳ ׸ Ѵ.
+		void evaluateCacheEntries(common::JobSystem* jobSystem);
+		void evaluateCacheEntry(unsigned int entry, UpdateScratch* scratch);
+		void evaluateInstance(unsigned int instanceIndex, float lookAheadTime, unsigned int maxBoneDepth, UpdateScratch* scratch);
+
+	private:
+		std::vector<Instance> mInstances;
+		std::vector<LocalPose> mPoses;
+		std::vector<std::vector<AnimationCursor>> mCursors;
+		std::vector<std::vector<AnimationCursor>> mFadeCursors;
+		std::vector<DirectX::SimpleMath::Matrix> mPalettes;
+		std::map<const Skeleton*, DepthOrder> mDepthOrders;
+		PoseCache mPoseCache;
+		bool mbPoseSharing;
+	};
+
+	unsigned int CrowdAnimator::GetInstanceCount() const
+	{
+		return static_cast<unsigned int>(mInstances.size());
+	}
+
+	const AnimationClip* CrowdAnimator::GetClip(unsigned int instanceIndex) const
+	{
+		return mInstances[instanceIndex].Clip;
+	}
+
+	float CrowdAnimator::GetTimePos(unsigned int instanceIndex) const
+	{
+		return mInstances[instanceIndex].TimePos;
+	}
+
+	const AnimationClip* CrowdAnimator::GetFadeClip(unsigned int instanceIndex) const
+	{
+		return mInstances[instanceIndex].FadeClip;
+	}
+
+	float CrowdAnimator::GetFadeTimePos(unsigned int instanceIndex) const
+	{
+		return mInstances[instanceIndex].FadeTimePos;
+	}
+
+	const LocalPose& CrowdAnimator::GetPose(unsigned int instanceIndex) const
+	{
+		return mPoses[instanceIndex];
+	}
+
+	const DirectX::SimpleMath::Matrix* CrowdAnimator::GetPalette(unsigned int instanceIndex) const
+	{
+		const Instance& instance = mInstances[instanceIndex];
+		return instance.CacheEntry != PoseCache::INVALID_ENTRY ? mPoseCache.GetPalette(instance.CacheEntry) : &mPalettes[instance.PaletteOffset];
+	}
+
+	bool CrowdAnimator::IsPoseShared(unsigned int instanceIndex) const
+	{
+		return mInstances[instanceIndex].CacheEntry != PoseCache::INVALID_ENTRY;
+	}
+
+	const PoseCache& CrowdAnimator::GetPoseCache() const
+	{
+		return mPoseCache;
+	}
+
+	unsigned int CrowdAnimator::GetBoneCount(unsigned int instanceIndex) const
+	{
+		return mInstances[instanceIndex].Layout->GetBoneCount();
+	}
+
+	unsigned int CrowdAnimator::GetSampledNodeCount(unsigned int instanceIndex, unsigned int maxBoneDepth) const
+	{
+		const std::vector<unsigned int>& depthCounts = mInstances[instanceIndex].Depths->DepthCounts;
+		return maxBoneDepth + 1 >= depthCounts.size() ? mInstances[instanceIndex].Skeleton->GetNodeCount() : depthCounts[maxBoneDepth];
+	}
+}
\ No newline at end of file
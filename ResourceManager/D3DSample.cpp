@@ -1,9 +1,13 @@
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <sstream>
 
 #include <imgui.h>
 #include <imgui_impl_win32.h>
 #include <imgui_impl_dx11.h>
 
+#include "AnimationCompression.h"
 #include "Model.h"
 #include "d3dUtil.h"
 #include "D3DSample.h"
@@ -11,9 +15,18 @@
 
 namespace resourceManager
 {
+	namespace
+	{
+		const float CROSS_FADE_DURATION = 0.3f; // C Ű Ŭ ٲ   ð()
+		const float POSE_TIME_QUANTUM = 1.f / 60.f; //   ȿ  Ŭ ϴ νϽ ȷƮ  .
+	}
+
 	D3DSample::D3DSample(HINSTANCE hInstance, UINT width, UINT height, std::wstring name)
 		: D3DProcessor(hInstance, width, height, name)
+		, mVisibleSkinnedCount(0)
 	{
+		//  Ű ߰ νϽ  0ʿ ϹǷ  Ŭ  .
+		mCrowdAnimator.SetPoseSharing(POSE_TIME_QUANTUM);
 	}
 	D3DSample::~D3DSample()
 	{
@@ -92,9 +105,9 @@ namespace resourceManager
 
 			int animIndex = rand() % model->Animations.size();
 			auto findedAnim = std::next(model->Animations.begin(), animIndex);
-			std::string animationName = findedAnim->first;
+			const unsigned int crowdIndex = mCrowdAnimator.AddInstance(&model->Skeleton, &model->Palette, &findedAnim->second, 0.f);
 
-			mSkinnedModelInstances.push_back({ model , Matrix::CreateTranslation(x, y,z), 0, animationName });
+			mSkinnedModelInstances.push_back({ model, Matrix::CreateTranslation(x, y, z), crowdIndex });
 		}
 		if (GetAsyncKeyState('3') & 0x8000)
 		{
@@ -106,16 +119,41 @@ namespace resourceManager
 
 			int animIndex = rand() % model->Animations.size();
 			auto findedAnim = std::next(model->Animations.begin(), animIndex);
-			std::string animationName = findedAnim->first;
+			const unsigned int crowdIndex = mCrowdAnimator.AddInstance(&model->Skeleton, &model->Palette, &findedAnim->second, 0.f);
 
-			mSkinnedModelInstances.push_back({ model , Matrix::CreateTranslation(x, y,z), 0, animationName });
+			mSkinnedModelInstances.push_back({ model, Matrix::CreateTranslation(x, y, z), crowdIndex });
 		}
-		mCam.UpdateViewMatrix();
+		if (GetAsyncKeyState('C') & 0x0001)
+		{
+			//  Ų νϽ ٸ Ŭ  ѱ.
+			for (const SkinnedModelInstance& skinnedModelInstance : mSkinnedModelInstances)
+			{
+				const std::map<std::string, AnimationClip>& animations = skinnedModelInstance.SkinnedModel->Animations;
+				auto findedAnim = std::next(animations.begin(), rand() % animations.size());
 
-		for (auto& skinnedmodelInstance : mSkinnedModelInstances)
+				mCrowdAnimator.CrossFade(skinnedModelInstance.CrowdIndex, &findedAnim->second, 0.f, CROSS_FADE_DURATION);
+			}
+		}
+		if (GetAsyncKeyState('V') & 0x0001)
 		{
-			skinnedmodelInstance.TimePos += deltaTime;
+			printAnimationStats();
 		}
+		if (GetAsyncKeyState('B') & 0x0001)
+		{
+			benchmarkClipCompression();
+		}
+		if (GetAsyncKeyState('K') & 0x0001)
+		{
+			exportVertexAnimation();
+		}
+		mCam.UpdateViewMatrix();
+		mLodSelector.SetCamera(mCam, static_cast<float>(GetHeight()));
+
+		// ̹     øϰ, ̴ νϽ  ȿ  ý  д.
+		// Render ٷ  ȷƮ ø⸸ Ѵ.
+		mAnimationScheduler.SyncInstances(mCrowdAnimator);
+		cullSkinnedInstances(deltaTime);
+		mAnimationScheduler.Update(deltaTime, &mCrowdAnimator, ResourceManager::GetInstance()->GetJobSystem());
 	}
 
 	void D3DSample::Render()
@@ -143,23 +181,97 @@ namespace resourceManager
 			mVSConstantBufferInfo.WorldTransform = modelInstance.WorldMatrix.Transpose();
 			md3dContext->UpdateSubresource(mVSConstnat, 0, 0, &mVSConstantBufferInfo, 0, 0);
 
-			modelInstance.Model->Draw(md3dContext);
+			const UINT lod = modelInstance.Model->SelectLod(mLodSelector, modelInstance.WorldMatrix);
+			modelInstance.Model->Draw(md3dContext, lod);
 		}
 
 		md3dContext->IASetInputLayout(mSkinnedInputLayout);
 		md3dContext->VSSetShader(mSkinnedVertexShader, nullptr, 0);
 
-		for (auto& skinnedmodelInstance : mSkinnedModelInstances)
+		for (UINT i = 0; i < mVisibleSkinnedCount; ++i)
 		{
+			const SkinnedModelInstance& skinnedmodelInstance = mSkinnedModelInstances[mVisibleSkinnedIndices[i]];
 			mVSConstantBufferInfo.WorldTransform = skinnedmodelInstance.WorldMatrix.Transpose();
 			md3dContext->UpdateSubresource(mVSConstnat, 0, 0, &mVSConstantBufferInfo, 0, 0);
 
-			skinnedmodelInstance.SkinnedModel->Draw(md3dContext, skinnedmodelInstance.AnimationName, skinnedmodelInstance.TimePos);
+			skinnedmodelInstance.SkinnedModel->Draw(md3dContext, mAnimationScheduler.GetPalette(skinnedmodelInstance.CrowdIndex));
 		}
 
 		postRender();
 	}
 
+	void D3DSample::cullSkinnedInstances(float deltaTime)
+	{
+		const UINT instanceCount = static_cast<UINT>(mSkinnedModelInstances.size());
+		if (mSkinnedCuller.GetCount() != instanceCount)
+		{
+			mSkinnedCuller.Resize(instanceCount);
+			mVisibleSkinnedIndices.resize(instanceCount);
+		}
+
+		for (UINT i = 0; i < instanceCount; ++i)
+		{
+			const SkinnedModelInstance& instance = mSkinnedModelInstances[i];
+			const SkinnedModel& model = *instance.SkinnedModel;
+			const unsigned int crowdIndex = instance.CrowdIndex;
+
+			// ٷ ð  ̹Ƿ ̹ ӿ   ü ´.
+			const float timePos = mCrowdAnimator.GetTimePos(crowdIndex);
+			DirectX::BoundingBox localBox = model.GetAnimatedBounds(mCrowdAnimator.GetClip(crowdIndex), timePos, timePos + deltaTime);
+
+			// ũν̵ ߿ ̴  Ŭ ڸ ģ.
+			const AnimationClip* fadeClip = mCrowdAnimator.GetFadeClip(crowdIndex);
+			if (fadeClip != nullptr)
+			{
+				const float fadeTimePos = mCrowdAnimator.GetFadeTimePos(crowdIndex);
+				DirectX::BoundingBox::CreateMerged(localBox, localBox, model.GetAnimatedBounds(fadeClip, fadeTimePos, fadeTimePos + deltaTime));
+			}
+
+			DirectX::BoundingBox worldBox;
+			localBox.Transform(worldBox, instance.WorldMatrix);
+			mSkinnedCuller.SetBounds(i, worldBox);
+
+			const float distance = Vector3::Distance(mLodSelector.GetEyePosition(), worldBox.Center);
+			mAnimationScheduler.SetScreenHeight(crowdIndex, mLodSelector.GetPixelError(Vector3(worldBox.Extents).Length() * 2.f, distance));
+			mAnimationScheduler.SetVisible(crowdIndex, false);
+		}
+
+		Vector4 worldPlanes[6];
+		D3DHelper::ExtractFrustumPlanes(worldPlanes, mCam.GetViewProj());
+
+		FrustumPlanes planes;
+		planes.Set(worldPlanes);
+
+		mVisibleSkinnedCount = mSkinnedCuller.Cull(planes, 0, instanceCount, mVisibleSkinnedIndices.data());
+		for (UINT i = 0; i < mVisibleSkinnedCount; ++i)
+		{
+			mAnimationScheduler.SetVisible(mSkinnedModelInstances[mVisibleSkinnedIndices[i]].CrowdIndex, true);
+		}
+	}
+
+	void D3DSample::printAnimationStats() const
+	{
+		const AnimationScheduler::Stats& stats = mAnimationScheduler.GetStats();
+
+		std::wostringstream outs;
+		outs << L"[animation schedule] budget " << mAnimationScheduler.GetBudget() << L" ms\n"
+			<< L"  updated " << stats.UpdatedCount << L", interpolated " << stats.InterpolatedCount << L", held " << stats.HeldCount
+			<< L", deferred " << stats.DeferredCount << L", skipped " << stats.SkippedCount << L"\n"
+			<< L"  lod";
+		for (UINT lod = 0; lod < AnimationScheduler::LOD_COUNT; ++lod)
+		{
+			outs << L" " << stats.LodCounts[lod];
+		}
+		outs << L"\n  nodes " << stats.EvaluatedNodeCount << L", estimated " << stats.EstimatedMs << L" ms, evaluate "
+			<< stats.EvaluateMs << L" ms, interpolate " << stats.InterpolateMs << L" ms\n";
+
+		const PoseCache::Stats& cacheStats = mCrowdAnimator.GetPoseCache().GetStats();
+		outs << L"  shared poses " << cacheStats.EntryCount << L", acquired " << cacheStats.AcquireCount
+			<< L", created " << cacheStats.CreatedCount << L", evicted " << cacheStats.EvictedCount << L"\n";
+
+		OutputDebugStringW(outs.str().c_str());
+	}
+
 	void D3DSample::OnMouseDown(WPARAM btnState, int x, int y)
 	{
 		mLastMousePos.x = x;
@@ -249,21 +361,22 @@ namespace resourceManager
 
 		// init shader and inputLayout
 		{
+			// ȭ , vertex::PosNormalTexTanPacked / PosNormalTexTanSkinnedPacked
 			D3D11_INPUT_ELEMENT_DESC layout[] =
 			{
 				{ "POSITION" , 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-				{ "NORMAL" , 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-				{ "TANGENT" , 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 24, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-				{ "UV" , 0, DXGI_FORMAT_R32G32_FLOAT, 0, 36, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+				{ "NORMAL" , 0, DXGI_FORMAT_R16G16_SNORM, 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+				{ "TANGENT" , 0, DXGI_FORMAT_R16G16_SNORM, 0, 16, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+				{ "UV" , 0, DXGI_FORMAT_R16G16_FLOAT, 0, 20, D3D11_INPUT_PER_VERTEX_DATA, 0 },
 			};
 			D3D11_INPUT_ELEMENT_DESC skinnedlayout[] =
 			{
 				{ "POSITION" , 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-				{ "NORMAL" , 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-				{ "TANGENT" , 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 24, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-				{ "UV" , 0, DXGI_FORMAT_R32G32_FLOAT, 0, 36, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-				{ "INDICES" , 0, DXGI_FORMAT_R32G32B32A32_SINT, 0, 44, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-				{ "WEIGHTS" , 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 60, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+				{ "NORMAL" , 0, DXGI_FORMAT_R16G16_SNORM, 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+				{ "TANGENT" , 0, DXGI_FORMAT_R16G16_SNORM, 0, 16, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+				{ "UV" , 0, DXGI_FORMAT_R16G16_FLOAT, 0, 20, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+				{ "INDICES" , 0, DXGI_FORMAT_R8G8B8A8_UINT, 0, 24, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+				{ "WEIGHTS" , 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, 28, D3D11_INPUT_PER_VERTEX_DATA, 0 },
 			};
 
 			ID3DBlob* vertexShaderBuffer = nullptr;
@@ -374,4 +487,90 @@ namespace resourceManager
 	{
 		mSwapChain->Present(0, 0);
 	}
+
+	void D3DSample::benchmarkClipCompression()
+	{
+		enum { FRAME_COUNT = 1000 };
+
+		using Clock = std::chrono::high_resolution_clock;
+
+		SkinnedModel* model = ResourceManager::GetInstance()->LoadSkinnedModel("models/SkinningTest.fbx");
+		const unsigned int nodeCount = model->Skeleton.GetNodeCount();
+		const CompressionSettings settings;
+
+		LocalPose pose;
+		pose.Resize(nodeCount);
+		std::vector<AnimationCursor> cursors(nodeCount);
+		float sink = 0.f;
+
+		std::wostringstream outs;
+		outs.precision(4);
+		outs << L"[Clip compression benchmark] " << FRAME_COUNT << L" poses per clip\n";
+
+		for (const auto& clipPair : model->Animations)
+		{
+			const AnimationClip& clip = clipPair.second;
+			const float step = static_cast<float>(clip.Duration) / FRAME_COUNT;
+
+			CompressedClip compressed;
+			CompressionStats stats;
+			CompressedClip::Compress(clip, model->Skeleton, settings, &compressed, &stats);
+
+			auto measure = [&](const auto& sampledClip)
+				{
+					std::fill(cursors.begin(), cursors.end(), AnimationCursor());
+
+					const Clock::time_point start = Clock::now();
+					for (int frame = 0; frame < FRAME_COUNT; ++frame)
+					{
+						sampledClip.SamplePose(model->Skeleton, frame * step, cursors.data(), &pose);
+						sink += pose.Rotations[0].x;
+					}
+
+					return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / FRAME_COUNT;
+				};
+
+			const double sourceUs = measure(clip);
+			const double compressedUs = measure(compressed);
+
+			outs << L"  " << clip.Name.c_str() << L": keys " << stats.SourceKeyCount << L" -> " << stats.CompressedKeyCount
+				<< L", bytes " << stats.SourceBytes << L" -> " << stats.CompressedBytes
+				<< L" (" << static_cast<double>(stats.SourceBytes) / stats.CompressedBytes << L"x)\n"
+				<< L"    max error: translation " << stats.MaxTranslationError << L", rotation " << DirectX::XMConvertToDegrees(stats.MaxRotationError)
+				<< L" deg, scale " << stats.MaxScaleError << L"\n"
+				<< L"    sample pose: source " << sourceUs << L" us, compressed " << compressedUs << L" us\n";
+		}
+
+		outs << L"  (sink " << sink << L")\n";
+		OutputDebugStringW(outs.str().c_str());
+	}
+
+	void D3DSample::exportVertexAnimation()
+	{
+		using Clock = std::chrono::high_resolution_clock;
+
+		SkinnedModel* model = ResourceManager::GetInstance()->LoadSkinnedModel("models/SkinningTest.fbx");
+
+		const Clock::time_point start = Clock::now();
+		VertexAnimationTexture texture;
+		const bool bBaked = model->BakeVertexAnimation(static_cast<float>(VertexAnimationTexture::DEFAULT_FRAME_RATE),
+			ResourceManager::GetInstance()->GetJobSystem(), &texture);
+		const double bakeMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+		std::wostringstream outs;
+		if (!bBaked)
+		{
+			outs << L"[Vertex animation] too many frames for one texture\n";
+			OutputDebugStringW(outs.str().c_str());
+			return;
+		}
+
+		// ٽ   .rig VertexAnimationBake -rig ѱ â   ؽó ´.
+		const bool bWritten = texture.Write("models/SkinningTest.vat") && model->WriteRigCache("models/SkinningTest.rig");
+		outs << L"[Vertex animation] " << texture.GetVertexCount() << L" vertices, " << texture.GetClipCount() << L" clips, "
+			<< texture.GetFrameCount() << L" frames, " << texture.GetTextureWidth() << L"x" << texture.GetTextureHeight()
+			<< L", " << texture.GetByteSize() / 1024 << L" KB, bake " << bakeMs << L" ms"
+			<< (bWritten ? L", written models/SkinningTest.vat and .rig\n" : L", write failed\n");
+		OutputDebugStringW(outs.str().c_str());
+	}
 }
\ No newline at end of file
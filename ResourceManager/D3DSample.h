@@ -6,6 +6,10 @@
 #include "D3dProcessor.h"
 
 #include "Camera.h"
+#include "AnimationScheduler.h"
+#include "CrowdAnimator.h"
+#include "FrustumCuller.h"
+#include "LodSelector.h"
 #include "Model.h"
 #include "SkinnedModel.h"
 
@@ -47,6 +51,15 @@ namespace resourceManager
 		void initShaderResource(); // shader, layout, constant buffer
 		void preRender();
 		void postRender();
+		// Ų νϽ ̹    ִϸ̼ ڷ  AABB   øϰ
+		// ȭ ̿ ü ִϸ̼ ٷ ѱ.
+		void cullSkinnedInstances(float deltaTime);
+		// ִϸ̼ ٷ   踦 Ѵ. (V Ű)
+		void printAnimationStats() const;
+		// SkinningTest.fbx Ŭ , ִ ,    ø ð Ѵ. (B Ű)
+		void benchmarkClipCompression();
+		// SkinningTest.fbx  Ŭ ؽ ִϸ̼ ؽó  models/SkinningTest.vat  ũ ð Ѵ. (K Ű)
+		void exportVertexAnimation();
 
 	private:
 		ID3D11VertexShader* mVertexShader;
@@ -65,6 +78,7 @@ namespace resourceManager
 
 		// sceneData
 		Camera mCam;
+		LodSelector mLodSelector;
 
 		ID3D11Buffer* mVSConstnat;
 		ID3D11Buffer* mPSConstnat;
@@ -75,5 +89,10 @@ namespace resourceManager
 
 		std::vector<ModelInstance> mModelInstances;
 		std::vector<SkinnedModelInstance> mSkinnedModelInstances;
+		CrowdAnimator mCrowdAnimator; // Ų νϽ  ð ȷƮ  ִ.
+		AnimationScheduler mAnimationScheduler; // ̴ νϽ LOD  ϰ ׸ ȷƮ Ѵ.
+		FrustumCuller mSkinnedCuller;
+		std::vector<UINT> mVisibleSkinnedIndices;
+		UINT mVisibleSkinnedCount;
 	};
 }
\ No newline at end of file
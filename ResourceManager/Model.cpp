@@ -1,5 +1,6 @@
 #include "Model.h"
 
+#include <algorithm>
 #include <functional>
 #include <cassert>
 #include <filesystem>
@@ -12,7 +13,12 @@
 #include <assimp/postprocess.h>
 
 #include "d3dUtil.h"
+#include "JobSystem.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
 #include "ResourceManager.h"
+#include "VertexPacking.h"
+#include "VertexWelder.h"
 
 namespace resourceManager
 {
@@ -31,9 +37,42 @@ namespace resourceManager
 		return result;
 	}
 
-	Model::Model(ID3D11Device* d3dDevice, const std::string& fileName)
-		: IndexBufferFormat(DXGI_FORMAT_R32_UINT)
-		, VertexStride(sizeof(vertex::PosNormalTexTan))
+	namespace
+	{
+		// PosNormalTexTan Normal, TangentU, Tex  8 float  LOD Ӽ ġ
+		//   1  ũ 1%, UV  1 2% Ÿ .   UV 󰡹Ƿ  ʴ´.
+		const float LOD_ATTRIBUTE_WEIGHTS[] = { 0.01f, 0.01f, 0.01f, 0.f, 0.f, 0.f, 0.02f, 0.02f };
+	}
+
+	void packVertex(const vertex::PosNormalTexTan& source, vertex::PosNormalTexTanPacked* outPacked)
+	{
+		using common::VertexPacking;
+
+		outPacked->Pos = source.Pos;
+		VertexPacking::EncodeOctahedral(source.Normal, outPacked->Normal);
+		VertexPacking::EncodeOctahedral(source.TangentU, outPacked->TangentU);
+		outPacked->Tex[0] = VertexPacking::FloatToHalf(source.Tex.x);
+		outPacked->Tex[1] = VertexPacking::FloatToHalf(source.Tex.y);
+	}
+
+	void reportBufferSize(const std::string& fileName, size_t unpackedSize, size_t packedSize)
+	{
+		const std::string message = fileName + ": VB + IB " + std::to_string(unpackedSize) + " -> " + std::to_string(packedSize)
+			+ " bytes, saved " + std::to_string(unpackedSize - packedSize) + " bytes\n";
+		OutputDebugStringA(message.c_str());
+	}
+
+	void reportWeld(const std::string& fileName, size_t importedCount, size_t weldedCount)
+	{
+		const std::string message = fileName + ": vertices " + std::to_string(importedCount) + " -> " + std::to_string(weldedCount)
+			+ ", welded " + std::to_string(importedCount - weldedCount) + "\n";
+		OutputDebugStringA(message.c_str());
+	}
+
+	Model::Model(ID3D11Device* d3dDevice, const std::string& fileName, common::JobSystem* jobSystem)
+		: VertexStride(sizeof(vertex::PosNormalTexTanPacked))
+		, UnpackedBufferSize(0)
+		, BufferSize(0)
 	{
 		using namespace DirectX::SimpleMath;
 
@@ -52,7 +91,12 @@ namespace resourceManager
 		Vertices.reserve(1024);
 		Indices.reserve(1024);
 
-		std::function<void(aiNode*, Matrix)> nodeRecursive = [this, scene, &nodeRecursive, &id](aiNode* node, Matrix parentToWorldMatrix)
+		// º LOD ü, ε ۸ ä   ִ´.
+		std::vector<std::vector<UINT>> lodIndices;
+		std::vector<std::vector<common::MeshLod>> lodRanges;
+		std::vector<bool> triangleSubsets;
+
+		std::function<void(aiNode*, Matrix)> nodeRecursive = [this, scene, &nodeRecursive, &id, &triangleSubsets](aiNode* node, Matrix parentToWorldMatrix)
 			{
 				Matrix toParentMatrix = convertMatrix(node->mTransformation).Transpose();
 				Matrix toWorld = toParentMatrix * parentToWorldMatrix;
@@ -125,6 +169,8 @@ namespace resourceManager
 						}
 					}
 
+					triangleSubsets.push_back(mesh->mPrimitiveTypes == aiPrimitiveType_TRIANGLE);
+
 					aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
 
 					aiString texturePath;
@@ -203,17 +249,122 @@ namespace resourceManager
 
 		importer.FreeScene();
 
+		// ³  ε  ġ Ƿ , ġ, LOD     óѴ.
+		//      ̰,   ڸ ڿ   .
+		lodIndices.resize(SubsetTable.size());
+		lodRanges.resize(SubsetTable.size());
+
+		auto processSubsets = [this, &triangleSubsets, &lodIndices, &lodRanges](UINT begin, UINT end)
+			{
+				for (UINT i = begin; i < end; ++i)
+				{
+					Subset& subset = SubsetTable[i];
+					if (!triangleSubsets[i] || subset.VertexCount == 0)
+					{
+						continue;
+					}
+
+					vertex::PosNormalTexTan* vertices = &Vertices[subset.VertexStart];
+					UINT* indices = &Indices[subset.FaceStart * 3];
+					const UINT indexCount = subset.FaceCount * 3;
+
+					subset.VertexCount = common::VertexWelder::Weld(vertices, subset.VertexCount, indices, indexCount,
+						&vertex::PosNormalTexTan::Pos, &vertex::PosNormalTexTan::Normal, &vertex::PosNormalTexTan::Tex);
+
+					//  ĳÿ  ġ  ġѴ.
+					common::MeshOptimizer::Optimize(vertices, subset.VertexCount, indices, indexCount, &vertex::PosNormalTexTan::Pos);
+
+					// ġ    LOD   LOD    .
+					common::MeshSimplifier::BuildLodChain(indices, indexCount,
+						&vertices[0].Pos.x, sizeof(vertex::PosNormalTexTan), subset.VertexCount,
+						&lodIndices[i], &lodRanges[i], common::MeshSimplifier::DEFAULT_LOD_COUNT,
+						&vertices[0].Normal.x, sizeof(vertex::PosNormalTexTan), LOD_ATTRIBUTE_WEIGHTS, ARRAYSIZE(LOD_ATTRIBUTE_WEIGHTS));
+				}
+			};
+
+		if (jobSystem != nullptr)
+		{
+			jobSystem->ParallelFor(static_cast<UINT>(SubsetTable.size()), 1, processSubsets);
+		}
+		else
+		{
+			processSubsets(0, static_cast<UINT>(SubsetTable.size()));
+		}
+
+		const size_t importedVertexCount = Vertices.size();
+		UINT vertexStart = 0;
+		for (Subset& subset : SubsetTable)
+		{
+			std::copy(Vertices.begin() + subset.VertexStart, Vertices.begin() + subset.VertexStart + subset.VertexCount, Vertices.begin() + vertexStart);
+			subset.VertexStart = vertexStart;
+			vertexStart += subset.VertexCount;
+		}
+		Vertices.resize(vertexStart);
+		reportWeld(fileName, importedVertexCount, Vertices.size());
+
+		//  ȭϰ, ε    ϸ 16Ʈ ø.
+		std::vector<vertex::PosNormalTexTanPacked> packedVertices(Vertices.size());
+		for (size_t i = 0; i < Vertices.size(); ++i)
+		{
+			packVertex(Vertices[i], &packedVertices[i]);
+		}
+
+		std::vector<BYTE> packedIndices;
+		packedIndices.reserve(Indices.size() * sizeof(UINT) * 2);
+		for (Subset& subset : SubsetTable)
+		{
+			subset.IndexFormat = common::VertexPacking::AppendIndices(&Indices[subset.FaceStart * 3], subset.FaceCount * 3,
+				subset.VertexCount, &packedIndices, &subset.IndexOffset);
+			subset.Lods.push_back({ subset.IndexOffset, subset.FaceCount * 3, 0.f });
+
+			// LOD ε  ڿ   δ.
+			const std::vector<UINT>& chain = lodIndices[subset.Id];
+			const std::vector<common::MeshLod>& ranges = lodRanges[subset.Id];
+			for (size_t i = 1; i < ranges.size(); ++i)
+			{
+				SubsetLod lod;
+				lod.IndexCount = ranges[i].IndexCount;
+				lod.Error = ranges[i].Error;
+				common::VertexPacking::AppendIndices(&chain[ranges[i].IndexStart], ranges[i].IndexCount,
+					subset.VertexCount, &packedIndices, &lod.IndexOffset);
+				subset.Lods.push_back(lod);
+			}
+
+			//  LOD  LOD ܰ躰 ģ. ܰ谡 ڶ   ģ   .
+			if (Lods.size() < subset.Lods.size())
+			{
+				const common::MeshLod coarsest = Lods.empty() ? common::MeshLod{ 0, 0, 0.f } : Lods.back();
+				Lods.resize(subset.Lods.size(), coarsest);
+			}
+			for (size_t i = 0; i < Lods.size(); ++i)
+			{
+				const SubsetLod& lod = subset.Lods[std::min<size_t>(i, subset.Lods.size() - 1)];
+				Lods[i].IndexCount += lod.IndexCount;
+				Lods[i].Error = std::max<float>(Lods[i].Error, lod.Error);
+			}
+		}
+
+		if (!Vertices.empty())
+		{
+			DirectX::BoundingBox::CreateFromPoints(BoundingBox, Vertices.size(), &Vertices[0].Pos, sizeof(vertex::PosNormalTexTan));
+			DirectX::BoundingSphere::CreateFromPoints(BoundingSphere, Vertices.size(), &Vertices[0].Pos, sizeof(vertex::PosNormalTexTan));
+		}
+
+		UnpackedBufferSize = sizeof(vertex::PosNormalTexTan) * Vertices.size() + sizeof(UINT) * Indices.size();
+		BufferSize = sizeof(vertex::PosNormalTexTanPacked) * packedVertices.size() + packedIndices.size();
+		reportBufferSize(fileName, UnpackedBufferSize, BufferSize);
+
 		HRESULT hr;
 
 		D3D11_BUFFER_DESC vbd;
 		vbd.Usage = D3D11_USAGE_IMMUTABLE;
-		vbd.ByteWidth = static_cast<size_t>(sizeof(vertex::PosNormalTexTan) * Vertices.size());
+		vbd.ByteWidth = static_cast<size_t>(sizeof(vertex::PosNormalTexTanPacked) * packedVertices.size());
 		vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
 		vbd.CPUAccessFlags = 0;
 		vbd.MiscFlags = 0;
 
 		D3D11_SUBRESOURCE_DATA initData;
-		initData.pSysMem = &Vertices[0];
+		initData.pSysMem = &packedVertices[0];
 
 		hr = d3dDevice->CreateBuffer(&vbd, &initData, &VB);
 		if (FAILED(hr)) {
@@ -222,12 +373,12 @@ namespace resourceManager
 
 		D3D11_BUFFER_DESC ibd;
 		ibd.Usage = D3D11_USAGE_IMMUTABLE;
-		ibd.ByteWidth = static_cast<size_t>(sizeof(unsigned int) * Indices.size());
+		ibd.ByteWidth = static_cast<size_t>(packedIndices.size());
 		ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
 		ibd.CPUAccessFlags = 0;
 		ibd.MiscFlags = 0;
 
-		initData.pSysMem = &Indices[0];
+		initData.pSysMem = &packedIndices[0];
 
 		hr = d3dDevice->CreateBuffer(&ibd, &initData, &IB);
 		if (FAILED(hr)) {
@@ -254,10 +405,9 @@ namespace resourceManager
 		ReleaseCOM(CB);
 	}
 
-	void Model::Draw(ID3D11DeviceContext* d3dContext)
+	void Model::Draw(ID3D11DeviceContext* d3dContext, UINT lod)
 	{
 		UINT offset = 0;
-		d3dContext->IASetIndexBuffer(IB, IndexBufferFormat, 0);
 		d3dContext->IASetVertexBuffers(0, 1, &VB, &VertexStride, &offset);
 		d3dContext->PSSetConstantBuffers(1, 1, &CB);
 
@@ -274,7 +424,25 @@ namespace resourceManager
 
 			d3dContext->UpdateSubresource(CB, 0, 0, bUseTextures, 0, 0);
 			d3dContext->PSSetShaderResources(0, 4, srv);
-			d3dContext->DrawIndexed(SubsetTable[i].FaceCount * 3, SubsetTable[i].FaceStart * 3, SubsetTable[i].VertexStart);
+			// ¸ ε ũ LOD  ޶ °  ٽ ´.
+			const Subset& subset = SubsetTable[i];
+			const SubsetLod& subsetLod = subset.Lods[std::min<size_t>(lod, subset.Lods.size() - 1)];
+			d3dContext->IASetIndexBuffer(IB, subset.IndexFormat, subsetLod.IndexOffset);
+			d3dContext->DrawIndexed(subsetLod.IndexCount, 0, subset.VertexStart);
 		}
 	}
+
+	UINT Model::SelectLod(const common::LodSelector& selector, const DirectX::SimpleMath::Matrix& worldMatrix) const
+	{
+		if (Lods.size() <= 1)
+		{
+			return 0;
+		}
+
+		DirectX::BoundingSphere worldSphere;
+		BoundingSphere.Transform(worldSphere, worldMatrix);
+		const float worldScale = BoundingSphere.Radius > 0.f ? worldSphere.Radius / BoundingSphere.Radius : 1.f;
+
+		return selector.Select(&Lods[0], static_cast<UINT>(Lods.size()), worldSphere.Center, worldSphere.Radius, worldScale);
+	}
 }
\ No newline at end of file
@@ -8,19 +8,29 @@
 #include <DirectXCollision.h>
 
 #include "LightHelper.h"
+#include "LodSelector.h"
 #include "Vertex.h"
 #include "Subset.h"
 #include "eMaterialTexture.h"
 
+namespace common
+{
+	class JobSystem;
+}
+
 namespace resourceManager
 {
 	class Model
 	{
 	public:
-		Model(ID3D11Device* d3dDevice, const std::string& fileName);
+		// jobSystem  º , ġ, LOD   óѴ.
+		Model(ID3D11Device* d3dDevice, const std::string& fileName, common::JobSystem* jobSystem = nullptr);
 		~Model();
 
-		void Draw(ID3D11DeviceContext* d3dContext);
+		//  LOD  ū lod    ģ LOD ׸.
+		void Draw(ID3D11DeviceContext* d3dContext, UINT lod = 0);
+		//    ȭ   LOD .
+		UINT SelectLod(const common::LodSelector& selector, const DirectX::SimpleMath::Matrix& worldMatrix) const;
 
 	public:
 		// material
@@ -33,9 +43,12 @@ namespace resourceManager
 		std::vector<UINT> Indices;
 		ID3D11Buffer* VB;
 		ID3D11Buffer* IB;
-		DXGI_FORMAT IndexBufferFormat; // ׻ 32Ʈ  
-		UINT VertexStride;
+		UINT VertexStride; // ȭ  ũ
+		size_t UnpackedBufferSize; // float , 32Ʈ ε  VB + IB Ʈ
+		size_t BufferSize; //  VB + IB Ʈ
 		std::vector<Subset> SubsetTable;
+		//  ü LOD ܰ躰 ε  հ   ִ , IndexStart  ʴ´.
+		std::vector<common::MeshLod> Lods;
 
 		// scene data
 		DirectX::BoundingBox BoundingBox;
@@ -0,0 +1,492 @@
+#include "PoseBlender.h"
+
+#include <cfloat>
+#include <immintrin.h>
+
+namespace resourceManager
+{
+	namespace
+	{
+		using namespace DirectX::SimpleMath;
+
+		enum { LANE_COUNT = 4 };
+
+		//  4 ȸ к  
+		struct QuaternionBatch
+		{
+			__m128 X;
+			__m128 Y;
+			__m128 Z;
+			__m128 W;
+		};
+
+		inline QuaternionBatch loadRotations(const Quaternion* rotations)
+		{
+			QuaternionBatch batch =
+			{
+				_mm_loadu_ps(&rotations[0].x),
+				_mm_loadu_ps(&rotations[1].x),
+				_mm_loadu_ps(&rotations[2].x),
+				_mm_loadu_ps(&rotations[3].x)
+			};
+			_MM_TRANSPOSE4_PS(batch.X, batch.Y, batch.Z, batch.W);
+
+			return batch;
+		}
+
+		inline void storeRotations(QuaternionBatch batch, Quaternion* outRotations)
+		{
+			_MM_TRANSPOSE4_PS(batch.X, batch.Y, batch.Z, batch.W);
+			_mm_storeu_ps(&outRotations[0].x, batch.X);
+			_mm_storeu_ps(&outRotations[1].x, batch.Y);
+			_mm_storeu_ps(&outRotations[2].x, batch.Z);
+			_mm_storeu_ps(&outRotations[3].x, batch.W);
+		}
+
+		inline __m128 dot(const QuaternionBatch& a, const QuaternionBatch& b)
+		{
+			return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.X, b.X), _mm_mul_ps(a.Y, b.Y)),
+				_mm_add_ps(_mm_mul_ps(a.Z, b.Z), _mm_mul_ps(a.W, b.W)));
+		}
+
+		// reference   θ ȣ   ݱ .
+		inline QuaternionBatch align(const QuaternionBatch& reference, const QuaternionBatch& batch)
+		{
+			const __m128 sign = _mm_and_ps(dot(reference, batch), _mm_set1_ps(-0.f));
+
+			return { _mm_xor_ps(batch.X, sign), _mm_xor_ps(batch.Y, sign), _mm_xor_ps(batch.Z, sign), _mm_xor_ps(batch.W, sign) };
+		}
+
+		inline void multiplyAdd(const QuaternionBatch& batch, __m128 weight, QuaternionBatch* accumulator)
+		{
+			accumulator->X = _mm_add_ps(accumulator->X, _mm_mul_ps(batch.X, weight));
+			accumulator->Y = _mm_add_ps(accumulator->Y, _mm_mul_ps(batch.Y, weight));
+			accumulator->Z = _mm_add_ps(accumulator->Z, _mm_mul_ps(batch.Z, weight));
+			accumulator->W = _mm_add_ps(accumulator->W, _mm_mul_ps(batch.W, weight));
+		}
+
+		inline QuaternionBatch scale(const QuaternionBatch& batch, __m128 weight)
+		{
+			return { _mm_mul_ps(batch.X, weight), _mm_mul_ps(batch.Y, weight), _mm_mul_ps(batch.Z, weight), _mm_mul_ps(batch.W, weight) };
+		}
+
+		inline QuaternionBatch normalize(const QuaternionBatch& batch)
+		{
+			const __m128 lengthSquared = _mm_max_ps(dot(batch, batch), _mm_set1_ps(FLT_MIN));
+			const __m128 inverseLength = _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(lengthSquared));
+
+			return scale(batch, inverseLength);
+		}
+
+		// ع  a * b
+		inline QuaternionBatch multiply(const QuaternionBatch& a, const QuaternionBatch& b)
+		{
+			return
+			{
+				_mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a.W, b.X), _mm_mul_ps(a.X, b.W)), _mm_mul_ps(a.Y, b.Z)), _mm_mul_ps(a.Z, b.Y)),
+				_mm_add_ps(_mm_sub_ps(_mm_mul_ps(a.W, b.Y), _mm_mul_ps(a.X, b.Z)), _mm_add_ps(_mm_mul_ps(a.Y, b.W), _mm_mul_ps(a.Z, b.X))),
+				_mm_add_ps(_mm_sub_ps(_mm_add_ps(_mm_mul_ps(a.W, b.Z), _mm_mul_ps(a.X, b.Y)), _mm_mul_ps(a.Y, b.X)), _mm_mul_ps(a.Z, b.W)),
+				_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a.W, b.W), _mm_mul_ps(a.X, b.X)), _mm_add_ps(_mm_mul_ps(a.Y, b.Y), _mm_mul_ps(a.Z, b.Z)))
+			};
+		}
+
+		inline QuaternionBatch conjugate(const QuaternionBatch& batch)
+		{
+			const __m128 sign = _mm_set1_ps(-0.f);
+			return { _mm_xor_ps(batch.X, sign), _mm_xor_ps(batch.Y, sign), _mm_xor_ps(batch.Z, sign), batch.W };
+		}
+
+		//  ȸ,  Ŭ   .
+		Quaternion multiply(const Quaternion& a, const Quaternion& b)
+		{
+			return Quaternion(a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+				a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+				a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+				a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z);
+		}
+
+		inline const float* getFloats(const std::vector<Vector3>& stream)
+		{
+			return &stream[0].x;
+		}
+
+		inline float* getFloats(std::vector<Vector3>* stream)
+		{
+			return &(*stream)[0].x;
+		}
+
+		//  first 4 ġ, 迭  Ѵ  0
+		inline __m128 loadJointWeights(const float* jointWeights, float weight, unsigned int first, unsigned int nodeCount)
+		{
+			if (jointWeights == nullptr)
+			{
+				return _mm_set1_ps(weight);
+			}
+
+			if (first + LANE_COUNT <= nodeCount)
+			{
+				return _mm_mul_ps(_mm_loadu_ps(jointWeights + first), _mm_set1_ps(weight));
+			}
+
+			float lanes[LANE_COUNT] = {};
+			for (unsigned int i = first; i < nodeCount; ++i)
+			{
+				lanes[i - first] = jointWeights[i] * weight;
+			}
+
+			return _mm_loadu_ps(lanes);
+		}
+
+		// out[i] = a[i] + b[i] * w()  Vector3 Ʈ   4(float 12) óѴ.
+		//  ġ w0..w3 [w0 w0 w0 w1] [w1 w1 w2 w2] [w2 w3 w3 w3]  Ѵ.
+		template <typename Kernel>
+		void forEachVectorBatch(const float* jointWeights, float weight, unsigned int nodeCount, const Kernel& kernel)
+		{
+			unsigned int joint = 0;
+			for (; joint + LANE_COUNT <= nodeCount; joint += LANE_COUNT)
+			{
+				const __m128 weights = loadJointWeights(jointWeights, weight, joint, nodeCount);
+				const size_t offset = static_cast<size_t>(joint) * 3;
+
+				kernel(offset, _mm_shuffle_ps(weights, weights, _MM_SHUFFLE(1, 0, 0, 0)));
+				kernel(offset + 4, _mm_shuffle_ps(weights, weights, _MM_SHUFFLE(2, 2, 1, 1)));
+				kernel(offset + 8, _mm_shuffle_ps(weights, weights, _MM_SHUFFLE(3, 3, 3, 2)));
+			}
+
+			//   ִ 3(float 9) float 4 δ  Ƿ   óѴ.
+			for (; joint < nodeCount; ++joint)
+			{
+				const float jointWeight = jointWeights != nullptr ? jointWeights[joint] * weight : weight;
+				kernel.Scalar(static_cast<size_t>(joint) * 3, jointWeight);
+			}
+		}
+
+		// ġ    Ʈ ׳ float 迭 .
+		template <typename Kernel>
+		void forEachFloatBatch(unsigned int nodeCount, const Kernel& kernel)
+		{
+			const size_t floatCount = static_cast<size_t>(nodeCount) * 3;
+			size_t i = 0;
+			for (; i + LANE_COUNT <= floatCount; i += LANE_COUNT)
+			{
+				kernel(i);
+			}
+			for (; i < floatCount; ++i)
+			{
+				kernel.Scalar(i);
+			}
+		}
+
+		inline unsigned int getRotationBatchCount(const LocalPose& pose)
+		{
+			assert(pose.Rotations.size() % LANE_COUNT == 0);
+			return static_cast<unsigned int>(pose.Rotations.size()) / LANE_COUNT;
+		}
+	}
+
+	void PoseBlender::Lerp(const LocalPose& a, const LocalPose& b, float weight, LocalPose* outPose)
+	{
+		const LocalPose* poses[2] = { &a, &b };
+		const float weights[2] = { 1.f - weight, weight };
+
+		Blend(poses, weights, 2, outPose);
+	}
+
+	void PoseBlender::Blend(const LocalPose* const* poses, const float* weights, unsigned int poseCount, LocalPose* outPose)
+	{
+		assert(poseCount > 0 && poseCount <= MAX_POSE_COUNT);
+
+		const unsigned int nodeCount = outPose->GetNodeCount();
+		float totalWeight = 0.f;
+		for (unsigned int i = 0; i < poseCount; ++i)
+		{
+			assert(poses[i]->GetNodeCount() == nodeCount);
+			totalWeight += weights[i];
+		}
+
+		if (totalWeight <= 0.f)
+		{
+			if (outPose != poses[0])
+			{
+				*outPose = *poses[0];
+			}
+			return;
+		}
+
+		float normalizedWeights[MAX_POSE_COUNT];
+		__m128 weightSplats[MAX_POSE_COUNT];
+		for (unsigned int i = 0; i < poseCount; ++i)
+		{
+			normalizedWeights[i] = weights[i] / totalWeight;
+			weightSplats[i] = _mm_set1_ps(normalizedWeights[i]);
+		}
+
+		// ̵ ũ: к  
+		const float* sources[MAX_POSE_COUNT];
+		float* destination = nullptr;
+
+		struct WeightedSumKernel
+		{
+			void operator()(size_t i) const
+			{
+				__m128 sum = _mm_mul_ps(_mm_loadu_ps(Sources[0] + i), WeightSplats[0]);
+				for (unsigned int k = 1; k < PoseCount; ++k)
+				{
+					sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(Sources[k] + i), WeightSplats[k]));
+				}
+				_mm_storeu_ps(Destination + i, sum);
+			}
+
+			void Scalar(size_t i) const
+			{
+				float sum = Sources[0][i] * Weights[0];
+				for (unsigned int k = 1; k < PoseCount; ++k)
+				{
+					sum += Sources[k][i] * Weights[k];
+				}
+				Destination[i] = sum;
+			}
+
+			const float* const* Sources;
+			const __m128* WeightSplats;
+			const float* Weights;
+			unsigned int PoseCount;
+			float* Destination;
+		};
+
+		for (int stream = 0; stream < 2; ++stream)
+		{
+			for (unsigned int i = 0; i < poseCount; ++i)
+			{
+				sources[i] = getFloats(stream == 0 ? poses[i]->Translations : poses[i]->Scales);
+			}
+			destination = getFloats(stream == 0 ? &outPose->Translations : &outPose->Scales);
+
+			forEachFloatBatch(nodeCount, WeightedSumKernel{ sources, weightSplats, normalizedWeights, poseCount, destination });
+		}
+
+		// ȸ: ù  ݱ    ȭ
+		const unsigned int batchCount = getRotationBatchCount(*outPose);
+		for (unsigned int batch = 0; batch < batchCount; ++batch)
+		{
+			const size_t first = static_cast<size_t>(batch) * LANE_COUNT;
+			const QuaternionBatch reference = loadRotations(&poses[0]->Rotations[first]);
+			QuaternionBatch sum = scale(reference, weightSplats[0]);
+
+			for (unsigned int k = 1; k < poseCount; ++k)
+			{
+				multiplyAdd(align(reference, loadRotations(&poses[k]->Rotations[first])), weightSplats[k], &sum);
+			}
+
+			storeRotations(normalize(sum), &outPose->Rotations[first]);
+		}
+	}
+
+	void PoseBlender::BlendLayer(const LocalPose& base, const LocalPose& layer, const float* jointWeights, float weight, LocalPose* outPose)
+	{
+		const unsigned int nodeCount = outPose->GetNodeCount();
+		assert(base.GetNodeCount() == nodeCount && layer.GetNodeCount() == nodeCount);
+
+		// out = base + (layer - base) * w
+		struct LerpKernel
+		{
+			void operator()(size_t i, __m128 weights) const
+			{
+				const __m128 from = _mm_loadu_ps(Base + i);
+				_mm_storeu_ps(Destination + i, _mm_add_ps(from, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(Layer + i), from), weights)));
+			}
+
+			void Scalar(size_t joint, float weight) const
+			{
+				for (size_t i = joint; i < joint + 3; ++i)
+				{
+					Destination[i] = Base[i] + (Layer[i] - Base[i]) * weight;
+				}
+			}
+
+			const float* Base;
+			const float* Layer;
+			float* Destination;
+		};
+
+		forEachVectorBatch(jointWeights, weight, nodeCount, LerpKernel{ getFloats(base.Translations), getFloats(layer.Translations), getFloats(&outPose->Translations) });
+		forEachVectorBatch(jointWeights, weight, nodeCount, LerpKernel{ getFloats(base.Scales), getFloats(layer.Scales), getFloats(&outPose->Scales) });
+
+		const __m128 one = _mm_set1_ps(1.f);
+		const unsigned int batchCount = getRotationBatchCount(*outPose);
+		for (unsigned int batch = 0; batch < batchCount; ++batch)
+		{
+			const unsigned int first = batch * LANE_COUNT;
+			const __m128 weights = loadJointWeights(jointWeights, weight, first, nodeCount);
+			const QuaternionBatch from = loadRotations(&base.Rotations[first]);
+			QuaternionBatch sum = scale(from, _mm_sub_ps(one, weights));
+
+			multiplyAdd(align(from, loadRotations(&layer.Rotations[first])), weights, &sum);
+			storeRotations(normalize(sum), &outPose->Rotations[first]);
+		}
+	}
+
+	void PoseBlender::MakeAdditive(const LocalPose& reference, const LocalPose& pose, LocalPose* outDelta)
+	{
+		const unsigned int nodeCount = outDelta->GetNodeCount();
+		assert(reference.GetNodeCount() == nodeCount && pose.GetNodeCount() == nodeCount);
+
+		struct DifferenceKernel
+		{
+			void operator()(size_t i) const
+			{
+				const __m128 from = _mm_loadu_ps(Reference + i);
+				const __m128 to = _mm_loadu_ps(Pose + i);
+				_mm_storeu_ps(Destination + i, bRatio ? _mm_div_ps(to, from) : _mm_sub_ps(to, from));
+			}
+
+			void Scalar(size_t i) const
+			{
+				Destination[i] = bRatio ? Pose[i] / Reference[i] : Pose[i] - Reference[i];
+			}
+
+			const float* Reference;
+			const float* Pose;
+			float* Destination;
+			bool bRatio;
+		};
+
+		forEachFloatBatch(nodeCount, DifferenceKernel{ getFloats(reference.Translations), getFloats(pose.Translations), getFloats(&outDelta->Translations), false });
+		forEachFloatBatch(nodeCount, DifferenceKernel{ getFloats(reference.Scales), getFloats(pose.Scales), getFloats(&outDelta->Scales), true });
+
+		const unsigned int batchCount = getRotationBatchCount(*outDelta);
+		for (unsigned int batch = 0; batch < batchCount; ++batch)
+		{
+			const size_t first = static_cast<size_t>(batch) * LANE_COUNT;
+			const QuaternionBatch from = loadRotations(&reference.Rotations[first]);
+			const QuaternionBatch to = loadRotations(&pose.Rotations[first]);
+
+			storeRotations(multiply(conjugate(from), to), &outDelta->Rotations[first]);
+		}
+	}
+
+	void PoseBlender::ApplyAdditive(const LocalPose& base, const LocalPose& delta, const float* jointWeights, float weight, LocalPose* outPose)
+	{
+		const unsigned int nodeCount = outPose->GetNodeCount();
+		assert(base.GetNodeCount() == nodeCount && delta.GetNodeCount() == nodeCount);
+
+		// ̵ base + delta * w, ũ base * (1 + (delta - 1) * w)
+		struct AddKernel
+		{
+			void operator()(size_t i, __m128 weights) const
+			{
+				const __m128 from = _mm_loadu_ps(Base + i);
+				const __m128 amount = _mm_loadu_ps(Delta + i);
+
+				if (bScale)
+				{
+					const __m128 one = _mm_set1_ps(1.f);
+					_mm_storeu_ps(Destination + i, _mm_mul_ps(from, _mm_add_ps(one, _mm_mul_ps(_mm_sub_ps(amount, one), weights))));
+				}
+				else
+				{
+					_mm_storeu_ps(Destination + i, _mm_add_ps(from, _mm_mul_ps(amount, weights)));
+				}
+			}
+
+			void Scalar(size_t joint, float weight) const
+			{
+				for (size_t i = joint; i < joint + 3; ++i)
+				{
+					Destination[i] = bScale ? Base[i] * (1.f + (Delta[i] - 1.f) * weight) : Base[i] + Delta[i] * weight;
+				}
+			}
+
+			const float* Base;
+			const float* Delta;
+			float* Destination;
+			bool bScale;
+		};
+
+		forEachVectorBatch(jointWeights, weight, nodeCount, AddKernel{ getFloats(base.Translations), getFloats(delta.Translations), getFloats(&outPose->Translations), false });
+		forEachVectorBatch(jointWeights, weight, nodeCount, AddKernel{ getFloats(base.Scales), getFloats(delta.Scales), getFloats(&outPose->Scales), true });
+
+		// ȸ ׵ delta wŭ nlerp  base ڿ Ѵ.
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.f);
+		const QuaternionBatch identity = { zero, zero, zero, one };
+		const unsigned int batchCount = getRotationBatchCount(*outPose);
+		for (unsigned int batch = 0; batch < batchCount; ++batch)
+		{
+			const unsigned int first = batch * LANE_COUNT;
+			const __m128 weights = loadJointWeights(jointWeights, weight, first, nodeCount);
+			QuaternionBatch partial = scale(identity, _mm_sub_ps(one, weights));
+
+			multiplyAdd(align(identity, loadRotations(&delta.Rotations[first])), weights, &partial);
+			storeRotations(multiply(loadRotations(&base.Rotations[first]), normalize(partial)), &outPose->Rotations[first]);
+		}
+	}
+
+	void PoseBlender::MakeAdditiveClip(const AnimationClip& clip, const Skeleton& skeleton, const LocalPose& reference, AnimationClip* outClip)
+	{
+		assert(clip.NodeChannels.size() == skeleton.GetNodeCount());
+		assert(reference.GetNodeCount() == skeleton.GetNodeCount());
+
+		outClip->Name = clip.Name;
+		outClip->Duration = clip.Duration;
+		outClip->Channels.clear();
+		outClip->Channels.reserve(skeleton.GetNodeCount());
+
+		for (unsigned int i = 0; i < skeleton.GetNodeCount(); ++i)
+		{
+			const int channelIndex = clip.NodeChannels[i];
+			AnimationNode channel;
+
+			if (channelIndex == Skeleton::INVALID_INDEX)
+			{
+				// Ű ϳ Ʈ  øȴ.
+				channel.Name = skeleton.NodeNames[i];
+				channel.PositionKeys.Times.push_back(0.f);
+				channel.PositionKeys.Values.push_back(Vector3::Zero);
+				channel.RotationKeys.Times.push_back(0.f);
+				channel.RotationKeys.Values.push_back(Quaternion::Identity);
+				channel.ScalingKeys.Times.push_back(0.f);
+				channel.ScalingKeys.Values.push_back(Vector3::One);
+				outClip->Channels.push_back(std::move(channel));
+				continue;
+			}
+
+			channel = clip.Channels[channelIndex];
+
+			const Quaternion inverseRotation(-reference.Rotations[i].x, -reference.Rotations[i].y, -reference.Rotations[i].z, reference.Rotations[i].w);
+			for (Vector3& position : channel.PositionKeys.Values)
+			{
+				position -= reference.Translations[i];
+			}
+			// տ  ȸ ϹǷ ̿ Ű  ״ΰ ݱ ĵ ȴ.
+			for (Quaternion& rotation : channel.RotationKeys.Values)
+			{
+				rotation = multiply(inverseRotation, rotation);
+			}
+			for (Vector3& scaling : channel.ScalingKeys.Values)
+			{
+				const Vector3& referenceScale = reference.Scales[i];
+				scaling = Vector3(scaling.x / referenceScale.x, scaling.y / referenceScale.y, scaling.z / referenceScale.z);
+			}
+
+			outClip->Channels.push_back(std::move(channel));
+		}
+
+		outClip->Bind(skeleton);
+	}
+
+	void PoseBlender::BuildSubtreeMask(const Skeleton& skeleton, unsigned int rootNode, std::vector<float>* outJointWeights)
+	{
+		outJointWeights->assign(skeleton.GetNodeCount(), 0.f);
+
+		// θ ڽĺ տ Ƿ    ȴ.
+		for (unsigned int i = rootNode; i < skeleton.GetNodeCount(); ++i)
+		{
+			const int parentIndex = skeleton.ParentIndices[i];
+			if (i == rootNode || (parentIndex != Skeleton::INVALID_INDEX && (*outJointWeights)[parentIndex] > 0.f))
+			{
+				(*outJointWeights)[i] = 1.f;
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+
+#include "Animation.h"
+
+namespace resourceManager
+{
+	// SoA  (̵, ȸ, ũ Ʈ) SSE ´.
+	// ̵ ũ Ʈ float 迭  4, ȸ  4 к ġ   óѴ.
+	// ȸ ù   ݱ     ȭϴ nlerp.
+	//  Լ ̸ ũ⸦    ⸸ ϰ Ҵ ,  Է° Ƶ ȴ.
+	// jointWeights 庰 0 ~ 1 ũ(ü )̰ nullptr̸  尡 1̴.
+	class PoseBlender
+	{
+	public:
+		enum { MAX_POSE_COUNT = 8 };
+
+	public:
+		// weight b  
+		static void Lerp(const LocalPose& a, const LocalPose& b, float weight, LocalPose* outPose);
+		// ġ  1 ǵ ȭؼ . poseCount MAX_POSE_COUNT 
+		static void Blend(const LocalPose* const* poses, const float* weights, unsigned int poseCount, LocalPose* outPose);
+		// base 帶 weight * jointWeights[i]ŭ layer  ´.
+		static void BlendLayer(const LocalPose& base, const LocalPose& layer, const float* jointWeights, float weight, LocalPose* outPose);
+
+		// reference pose (̵ , ȸ conj(ref) * pose, ũ ) .
+		static void MakeAdditive(const LocalPose& reference, const LocalPose& pose, LocalPose* outDelta);
+		// base delta 帶 weight * jointWeights[i]ŭ Ѵ. ȸ base * nlerp(I, delta)
+		static void ApplyAdditive(const LocalPose& base, const LocalPose& delta, const float* jointWeights, float weight, LocalPose* outPose);
+
+		// clip  Ű reference   ̷ ٲ  Ŭ . ä   ׵ ä ִ´.
+		//  reference clip ù ̳ ε .  skeleton ε ִ.
+		static void MakeAdditiveClip(const AnimationClip& clip, const Skeleton& skeleton, const LocalPose& reference, AnimationClip* outClip);
+		// rootNode  ڼ 1,  0 ũ
+		static void BuildSubtreeMask(const Skeleton& skeleton, unsigned int rootNode, std::vector<float>* outJointWeights);
+	};
+}
\ No newline at end of file
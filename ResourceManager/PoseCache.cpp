@@ -0,0 +1,144 @@
+#include <cassert>
+#include <cmath>
+#include <functional>
+
+#include "PoseCache.h"
+
+namespace resourceManager
+{
+	using namespace DirectX::SimpleMath;
+
+	namespace
+	{
+		const float DEFAULT_TIME_QUANTUM = 1.f / 60.f;
+
+		size_t combineHash(size_t seed, size_t value)
+		{
+			return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+		}
+	}
+
+	size_t PoseCache::KeyHash::operator()(const Key& key) const
+	{
+		size_t hash = std::hash<const void*>()(key.Layout);
+		hash = combineHash(hash, std::hash<const void*>()(key.Clip));
+		hash = combineHash(hash, std::hash<int>()(key.TimeStep));
+		hash = combineHash(hash, std::hash<unsigned int>()(key.MaxBoneDepth));
+
+		return hash;
+	}
+
+	PoseCache::PoseCache()
+		: mTimeQuantum(DEFAULT_TIME_QUANTUM)
+		, mStats()
+	{
+	}
+
+	void PoseCache::SetTimeQuantum(float seconds)
+	{
+		assert(seconds > 0.f);
+
+		//  ٲ  Ű ٸ ð ŰǷ ׸  .
+		if (seconds != mTimeQuantum)
+		{
+			Clear();
+			mTimeQuantum = seconds;
+		}
+	}
+
+	PoseCache::Key PoseCache::MakeKey(const Skeleton* skeleton, const PaletteLayout* layout, const AnimationClip* clip, float timePos,
+		unsigned int maxBoneDepth) const
+	{
+		Key key = { skeleton, layout, clip, 0, maxBoneDepth };
+
+		if (clip != nullptr && clip->Duration > 0.0)
+		{
+			//   ȭؾ     νϽ  ׸ .
+			//  ð    ð    ۱ Ƿ      .
+			// ݿø ð Ŭ   ó  ƢǷ ׶ .
+			const float clipTime = static_cast<float>(fmod(timePos, clip->Duration));
+			key.TimeStep = static_cast<int>(floorf(clipTime / mTimeQuantum + 0.5f));
+			if (key.TimeStep * mTimeQuantum >= clip->Duration)
+			{
+				key.TimeStep = static_cast<int>(floorf(clipTime / mTimeQuantum));
+			}
+		}
+
+		return key;
+	}
+
+	void PoseCache::BeginFrame()
+	{
+		mStats.AcquireCount = 0;
+		mStats.CreatedCount = 0;
+		mStats.EvictedCount = 0;
+		mPendingEntries.clear();
+
+		for (unsigned int entry = 0; entry < mEntries.size(); ++entry)
+		{
+			Entry& cacheEntry = mEntries[entry];
+			if (cacheEntry.RefCount == 0 && cacheEntry.EntryKey.Layout != nullptr)
+			{
+				// ȷƮ ۴  ׸ ٽ   д.
+				mEntryMap.erase(cacheEntry.EntryKey);
+				cacheEntry.EntryKey.Layout = nullptr;
+				mFreeEntries.push_back(entry);
+				++mStats.EvictedCount;
+			}
+		}
+
+		mStats.EntryCount = static_cast<unsigned int>(mEntryMap.size());
+	}
+
+	unsigned int PoseCache::Acquire(const Key& key)
+	{
+		assert(key.Layout != nullptr);
+		++mStats.AcquireCount;
+
+		auto found = mEntryMap.find(key);
+		if (found != mEntryMap.end())
+		{
+			++mEntries[found->second].RefCount;
+			return found->second;
+		}
+
+		unsigned int entry;
+		if (!mFreeEntries.empty())
+		{
+			entry = mFreeEntries.back();
+			mFreeEntries.pop_back();
+		}
+		else
+		{
+			entry = static_cast<unsigned int>(mEntries.size());
+			mEntries.emplace_back();
+		}
+
+		Entry& cacheEntry = mEntries[entry];
+		cacheEntry.EntryKey = key;
+		cacheEntry.RefCount = 1;
+		cacheEntry.Palette.resize(key.Layout->GetBoneCount());
+
+		mEntryMap.insert({ key, entry });
+		mPendingEntries.push_back(entry);
+		++mStats.CreatedCount;
+		mStats.EntryCount = static_cast<unsigned int>(mEntryMap.size());
+
+		return entry;
+	}
+
+	void PoseCache::Release(unsigned int entry)
+	{
+		assert(mEntries[entry].RefCount > 0);
+		--mEntries[entry].RefCount;
+	}
+
+	void PoseCache::Clear()
+	{
+		mEntries.clear();
+		mFreeEntries.clear();
+		mPendingEntries.clear();
+		mEntryMap.clear();
+		mStats = Stats();
+	}
+}
\ No newline at end of file
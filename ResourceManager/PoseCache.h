@@ -0,0 +1,128 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "Animation.h"
+
+namespace resourceManager
+{
+	//    Ŭ  ð ϸ ȷƮ Ƿ (, Ŭ, ȭ ð) ϳ   .
+	// νϽ ׸ Acquireϰ ٸ ð Ѿ Releaseϸ, ƹ  ʴ ׸  BeginFrame .
+	// ׸ ⸸ ϰ 򰡴  ʴ´. ̹ ӿ   ׸ GetPendingEntry ޾ CrowdAnimator ä.
+	class PoseCache
+	{
+	public:
+		enum { INVALID_ENTRY = 0xFFFFFFFF };
+
+		struct Key
+		{
+			const resourceManager::Skeleton* Skeleton;
+			const PaletteLayout* Layout;
+			const AnimationClip* Clip;
+			int TimeStep; // Ŭ ̷  ð / ȭ 
+			unsigned int MaxBoneDepth;
+
+			inline bool operator==(const Key& other) const;
+		};
+
+		struct Stats
+		{
+			unsigned int EntryCount; //   ִ ׸
+			unsigned int AcquireCount;
+			unsigned int CreatedCount; // ̹ ӿ   ؾ ϴ ׸
+			unsigned int EvictedCount; // ̹ BeginFrame  ׸
+		};
+
+	public:
+		PoseCache();
+
+		// ȭ (),  ȿ ִ ð   .
+		void SetTimeQuantum(float seconds);
+		// clip nullptr̸ ε  Ű
+		Key MakeKey(const Skeleton* skeleton, const PaletteLayout* layout, const AnimationClip* clip, float timePos, unsigned int maxBoneDepth) const;
+
+		//    ׸  踦 . Ӹ Acquire    θ.
+		void BeginFrame();
+		// key ׸  ϳ ø ȣ ش.      Ͽ ִ´.
+		unsigned int Acquire(const Key& key);
+		void Release(unsigned int entry);
+		void Clear();
+
+		inline float GetTimeQuantum() const;
+		inline float GetSampleTime(const Key& key) const;
+		inline unsigned int GetPendingCount() const;
+		inline unsigned int GetPendingEntry(unsigned int pendingIndex) const;
+		inline const Key& GetKey(unsigned int entry) const;
+		inline const DirectX::SimpleMath::Matrix* GetPalette(unsigned int entry) const;
+		inline DirectX::SimpleMath::Matrix* GetPalette(unsigned int entry);
+		inline const Stats& GetStats() const;
+
+	private:
+		struct KeyHash
+		{
+			size_t operator()(const Key& key) const;
+		};
+
+		struct Entry
+		{
+			Key EntryKey;
+			unsigned int RefCount;
+			std::vector<DirectX::SimpleMath::Matrix> Palette;
+		};
+
+	private:
+		float mTimeQuantum;
+		std::vector<Entry> mEntries;
+		std::vector<unsigned int> mFreeEntries;
+		std::vector<unsigned int> mPendingEntries;
+		std::unordered_map<Key, unsigned int, KeyHash> mEntryMap;
+		Stats mStats;
+	};
+
+	bool PoseCache::Key::operator==(const Key& other) const
+	{
+		return Skeleton == other.Skeleton && Layout == other.Layout && Clip == other.Clip
+			&& TimeStep == other.TimeStep && MaxBoneDepth == other.MaxBoneDepth;
+	}
+
+	float PoseCache::GetTimeQuantum() const
+	{
+		return mTimeQuantum;
+	}
+
+	float PoseCache::GetSampleTime(const Key& key) const
+	{
+		return key.TimeStep * mTimeQuantum;
+	}
+
+	unsigned int PoseCache::GetPendingCount() const
+	{
+		return static_cast<unsigned int>(mPendingEntries.size());
+	}
+
+	unsigned int PoseCache::GetPendingEntry(unsigned int pendingIndex) const
+	{
+		return mPendingEntries[pendingIndex];
+	}
+
+	const PoseCache::Key& PoseCache::GetKey(unsigned int entry) const
+	{
+		return mEntries[entry].EntryKey;
+	}
+
+	const DirectX::SimpleMath::Matrix* PoseCache::GetPalette(unsigned int entry) const
+	{
+		return mEntries[entry].Palette.data();
+	}
+
+	DirectX::SimpleMath::Matrix* PoseCache::GetPalette(unsigned int entry)
+	{
+		return mEntries[entry].Palette.data();
+	}
+
+	const PoseCache::Stats& PoseCache::GetStats() const
+	{
+		return mStats;
+	}
+}
\ No newline at end of file
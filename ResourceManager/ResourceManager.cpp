@@ -52,6 +52,11 @@ namespace resourceManager
 		md3dContext = d3dContext;
 	}
 
+	common::JobSystem* ResourceManager::GetJobSystem()
+	{
+		return &mJobSystem;
+	}
+
 	Model* ResourceManager::LoadModel(const std::string& fileName)
 	{
 		auto find = mModels.find(fileName);
@@ -61,7 +66,7 @@ namespace resourceManager
 			return find->second;
 		}
 
-		Model* model = new Model(md3dDevice, fileName);
+		Model* model = new Model(md3dDevice, fileName, &mJobSystem);
 
 		mModels.insert({ fileName, model });
 
@@ -82,7 +87,7 @@ namespace resourceManager
 			return find->second;
 		}
 
-		SkinnedModel* model = new SkinnedModel(md3dDevice, fileName);
+		SkinnedModel* model = new SkinnedModel(md3dDevice, fileName, &mJobSystem);
 
 		mSkinnedModels.insert({ fileName, model });
 
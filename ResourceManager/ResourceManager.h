@@ -6,6 +6,8 @@
 #include <d3d11.h>
 #include <directxtk/SimpleMath.h>
 
+#include "JobSystem.h"
+
 namespace resourceManager
 {
 	class Model;
@@ -19,6 +21,8 @@ namespace resourceManager
 		static void DeleteInstance();
 
 		void Init(ID3D11Device* d3dDevice, ID3D11DeviceContext* d3dContext);
+		// Ʈ ó Ӹ ϴ ũ ִϸ̼    ý
+		common::JobSystem* GetJobSystem();
 
 		Model* LoadModel(const std::string& fileName);
 		Model* LoadModel(const std::wstring& fileName);
@@ -40,5 +44,7 @@ namespace resourceManager
 		std::map<std::string, ID3D11ShaderResourceView*> mSRVs;
 		std::map<std::string, Model*> mModels;
 		std::map<std::string, SkinnedModel*> mSkinnedModels;
+
+		common::JobSystem mJobSystem;
 	};
 }
\ No newline at end of file
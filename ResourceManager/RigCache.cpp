@@ -0,0 +1,341 @@
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+
+#include "RigCache.h"
+
+namespace resourceManager
+{
+	using namespace DirectX::SimpleMath;
+
+	namespace
+	{
+		struct FileHeader
+		{
+			uint32_t Magic;
+			uint32_t Version;
+			uint32_t NodeCount;
+			uint32_t BoneCount;
+			uint32_t SubsetCount;
+			uint32_t VertexCount;
+			uint32_t ClipCount;
+		};
+
+		//  ϰ Ҵϱ    ũ  Ÿ.
+		struct FileReader
+		{
+			std::ifstream* File;
+			uint64_t Remaining;
+
+			template <typename T>
+			bool ReadArray(T* outValues, size_t count)
+			{
+				if (count > Remaining / sizeof(T))
+				{
+					return false;
+				}
+
+				Remaining -= count * sizeof(T);
+				return count == 0 || static_cast<bool>(File->read(reinterpret_cast<char*>(outValues), count * sizeof(T)));
+			}
+
+			template <typename T>
+			bool Read(T* outValue)
+			{
+				return ReadArray(outValue, 1);
+			}
+
+			template <typename T>
+			bool ReadVector(size_t count, std::vector<T>* outValues)
+			{
+				if (count > Remaining / sizeof(T))
+				{
+					return false;
+				}
+
+				outValues->resize(count);
+				return ReadArray(outValues->data(), count);
+			}
+
+			bool ReadString(std::string* outString)
+			{
+				uint32_t length;
+				if (!Read(&length) || length > RigCache::MAX_NAME_LENGTH || length > Remaining)
+				{
+					return false;
+				}
+
+				outString->resize(length);
+				return ReadArray(&(*outString)[0], length);
+			}
+		};
+
+		template <typename T>
+		void writeArray(std::ofstream* file, const T* values, size_t count)
+		{
+			file->write(reinterpret_cast<const char*>(values), count * sizeof(T));
+		}
+
+		void writeString(std::ofstream* file, const std::string& string)
+		{
+			const uint32_t length = static_cast<uint32_t>(std::min<size_t>(string.size(), RigCache::MAX_NAME_LENGTH));
+			writeArray(file, &length, 1);
+			writeArray(file, string.data(), length);
+		}
+
+		template <typename T>
+		void writeTrack(std::ofstream* file, const KeyTrack<T>& track)
+		{
+			const uint32_t keyCount = static_cast<uint32_t>(track.Times.size());
+			writeArray(file, &keyCount, 1);
+			writeArray(file, track.Times.data(), keyCount);
+			writeArray(file, track.Values.data(), keyCount);
+		}
+
+		// FindKey  ŽϹǷ Ű ð پ  ȴ.
+		template <typename T>
+		bool readTrack(FileReader* reader, KeyTrack<T>* outTrack)
+		{
+			uint32_t keyCount;
+			if (!reader->Read(&keyCount) || !reader->ReadVector(keyCount, &outTrack->Times) || !reader->ReadVector(keyCount, &outTrack->Values))
+			{
+				return false;
+			}
+
+			for (uint32_t i = 1; i < keyCount; ++i)
+			{
+				if (!(outTrack->Times[i - 1] <= outTrack->Times[i]))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		// offsets 0   ʰ last  Ѵ.
+		bool isRangeTable(const std::vector<unsigned int>& offsets, unsigned int last)
+		{
+			if (offsets.empty() || offsets.front() != 0 || offsets.back() != last)
+			{
+				return false;
+			}
+
+			for (size_t i = 1; i < offsets.size(); ++i)
+			{
+				if (offsets[i - 1] > offsets[i])
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+	}
+
+	bool RigCache::Write(const std::string& fileName, const VertexAnimationTexture::SkinnedMeshSource& source,
+		const std::vector<const AnimationClip*>& clips)
+	{
+		std::ofstream file(fileName, std::ios::binary);
+		if (!file)
+		{
+			return false;
+		}
+
+		const resourceManager::Skeleton& skeleton = *source.Skeleton;
+		const PaletteLayout& layout = *source.Layout;
+		const unsigned int vertexCount = source.SubsetStarts[source.SubsetCount];
+
+		FileHeader header = {};
+		header.Magic = MAGIC;
+		header.Version = VERSION;
+		header.NodeCount = skeleton.GetNodeCount();
+		header.BoneCount = layout.GetBoneCount();
+		header.SubsetCount = source.SubsetCount;
+		header.VertexCount = vertexCount;
+		header.ClipCount = static_cast<uint32_t>(clips.size());
+		writeArray(&file, &header, 1);
+
+		// ̷, ȸ Ʈ ķ ø ĭ   ŭ .
+		for (unsigned int i = 0; i < skeleton.GetNodeCount(); ++i)
+		{
+			writeString(&file, skeleton.NodeNames[i]);
+		}
+		writeArray(&file, skeleton.ParentIndices.data(), header.NodeCount);
+		writeArray(&file, skeleton.BindPose.Translations.data(), header.NodeCount);
+		writeArray(&file, skeleton.BindPose.Rotations.data(), header.NodeCount);
+		writeArray(&file, skeleton.BindPose.Scales.data(), header.NodeCount);
+
+		// ȷƮ  º  
+		writeArray(&file, layout.NodeIndices.data(), header.BoneCount);
+		writeArray(&file, layout.OffsetMatrices.data(), header.BoneCount);
+		writeArray(&file, layout.SubsetOffsets.data(), header.SubsetCount + 1);
+		writeArray(&file, source.SubsetStarts, header.SubsetCount + 1);
+		writeArray(&file, source.Vertices, vertexCount);
+
+		for (const AnimationClip* clip : clips)
+		{
+			writeString(&file, clip->Name);
+			writeArray(&file, &clip->Duration, 1);
+
+			const uint32_t channelCount = static_cast<uint32_t>(clip->Channels.size());
+			writeArray(&file, &channelCount, 1);
+			for (const AnimationNode& channel : clip->Channels)
+			{
+				writeString(&file, channel.Name);
+				writeTrack(&file, channel.PositionKeys);
+				writeTrack(&file, channel.RotationKeys);
+				writeTrack(&file, channel.ScalingKeys);
+			}
+		}
+
+		return static_cast<bool>(file);
+	}
+
+	bool RigCache::Read(const std::string& fileName)
+	{
+		std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+		if (!file)
+		{
+			return false;
+		}
+
+		FileReader reader = { &file, static_cast<uint64_t>(file.tellg()) };
+		file.seekg(0);
+
+		FileHeader header;
+		if (!reader.Read(&header) || header.Magic != MAGIC || header.Version != VERSION
+			|| header.SubsetCount == 0 || header.SubsetCount > reader.Remaining / sizeof(uint32_t))
+		{
+			return false;
+		}
+
+		resourceManager::Skeleton skeleton;
+		skeleton.NodeNames.resize(std::min<uint64_t>(header.NodeCount, reader.Remaining / sizeof(uint32_t)));
+		if (skeleton.NodeNames.size() != header.NodeCount)
+		{
+			return false;
+		}
+
+		for (std::string& name : skeleton.NodeNames)
+		{
+			if (!reader.ReadString(&name))
+			{
+				return false;
+			}
+		}
+
+		skeleton.BindPose.Resize(header.NodeCount);
+		if (!reader.ReadVector(header.NodeCount, &skeleton.ParentIndices)
+			|| !reader.ReadArray(skeleton.BindPose.Translations.data(), header.NodeCount)
+			|| !reader.ReadArray(skeleton.BindPose.Rotations.data(), header.NodeCount)
+			|| !reader.ReadArray(skeleton.BindPose.Scales.data(), header.NodeCount))
+		{
+			return false;
+		}
+
+		// θ ׻ ڽĺ տ ־ Ѵ. (Skeleton::ComputeToRootMatrices)
+		for (uint32_t i = 0; i < header.NodeCount; ++i)
+		{
+			const int parentIndex = skeleton.ParentIndices[i];
+			if (parentIndex != resourceManager::Skeleton::INVALID_INDEX && (parentIndex < 0 || static_cast<uint32_t>(parentIndex) >= i))
+			{
+				return false;
+			}
+		}
+
+		PaletteLayout layout;
+		std::vector<unsigned int> subsetStarts;
+		std::vector<vertex::PosNormalTexTanSkinned> vertices;
+		if (!reader.ReadVector(header.BoneCount, &layout.NodeIndices)
+			|| !reader.ReadVector(header.BoneCount, &layout.OffsetMatrices)
+			|| !reader.ReadVector(header.SubsetCount + 1, &layout.SubsetOffsets)
+			|| !reader.ReadVector(header.SubsetCount + 1, &subsetStarts)
+			|| !reader.ReadVector(header.VertexCount, &vertices)
+			|| !isRangeTable(layout.SubsetOffsets, header.BoneCount)
+			|| !isRangeTable(subsetStarts, header.VertexCount))
+		{
+			return false;
+		}
+
+		for (unsigned int nodeIndex : layout.NodeIndices)
+		{
+			if (nodeIndex >= header.NodeCount)
+			{
+				return false;
+			}
+		}
+
+		//   ȣ ڱ    ̾ Ⱑ ȷƮ   ʴ´.
+		for (uint32_t subset = 0; subset < header.SubsetCount; ++subset)
+		{
+			const int boneCount = static_cast<int>(layout.SubsetOffsets[subset + 1] - layout.SubsetOffsets[subset]);
+			for (unsigned int i = subsetStarts[subset]; i < subsetStarts[subset + 1]; ++i)
+			{
+				for (int index : vertices[i].Indices)
+				{
+					if (index != vertex::PosNormalTexTanSkinned::INVALID_INDEX && (index < 0 || index >= boneCount))
+					{
+						return false;
+					}
+				}
+			}
+		}
+
+		std::vector<AnimationClip> clips(std::min<uint64_t>(header.ClipCount, reader.Remaining / sizeof(uint32_t)));
+		if (clips.size() != header.ClipCount)
+		{
+			return false;
+		}
+
+		for (AnimationClip& clip : clips)
+		{
+			uint32_t channelCount;
+			if (!reader.ReadString(&clip.Name) || !reader.Read(&clip.Duration) || !reader.Read(&channelCount)
+				|| channelCount > reader.Remaining / sizeof(uint32_t))
+			{
+				return false;
+			}
+
+			clip.Channels.resize(channelCount);
+			for (AnimationNode& channel : clip.Channels)
+			{
+				if (!reader.ReadString(&channel.Name) || !readTrack(&reader, &channel.PositionKeys)
+					|| !readTrack(&reader, &channel.RotationKeys) || !readTrack(&reader, &channel.ScalingKeys))
+				{
+					return false;
+				}
+			}
+
+			clip.Bind(skeleton);
+		}
+
+		mSkeleton = std::move(skeleton);
+		mLayout = std::move(layout);
+		mVertices = std::move(vertices);
+		mSubsetStarts = std::move(subsetStarts);
+		mClips = std::move(clips);
+
+		return true;
+	}
+
+	VertexAnimationTexture::SkinnedMeshSource RigCache::GetSource() const
+	{
+		assert(!mSubsetStarts.empty());
+		const VertexAnimationTexture::SkinnedMeshSource source = { &mSkeleton, &mLayout, mVertices.data(), mSubsetStarts.data(),
+			static_cast<unsigned int>(mSubsetStarts.size() - 1) };
+		return source;
+	}
+
+	std::vector<const AnimationClip*> RigCache::GetClips() const
+	{
+		std::vector<const AnimationClip*> clips;
+		clips.reserve(mClips.size());
+		for (const AnimationClip& clip : mClips)
+		{
+			clips.push_back(&clip);
+		}
+
+		return clips;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Animation.h"
+#include "Vertex.h"
+#include "VertexAnimationTexture.h"
+
+namespace resourceManager
+{
+	// ؽ ִϸ̼ ؽó   ʿ ̷, ȷƮ , Ų , Ŭ ״   (.rig)
+	// FBX  assimp Direct3D ʿ SkinnedModel Ƿ Direct3D 尡    ΰ,
+	// 帮 (VertexAnimationBake -rig)  ϸ о  Ŭ ´. б  D3D  Ѵ.
+	class RigCache
+	{
+	public:
+		enum { MAGIC = 0x20474952 }; // "RIG "
+		enum { VERSION = 1 };
+		enum { MAX_NAME_LENGTH = 1024 };
+
+	public:
+		static bool Write(const std::string& fileName, const VertexAnimationTexture::SkinnedMeshSource& source,
+			const std::vector<const AnimationClip*>& clips);
+		//   ũ⸦ Ѱų ε   false,  Ŭ ̷濡 ٽ εѴ.
+		bool Read(const std::string& fileName);
+
+		VertexAnimationTexture::SkinnedMeshSource GetSource() const;
+		std::vector<const AnimationClip*> GetClips() const;
+		inline const resourceManager::Skeleton& GetSkeleton() const;
+		inline const PaletteLayout& GetLayout() const;
+		inline const std::vector<vertex::PosNormalTexTanSkinned>& GetVertices() const;
+
+	private:
+		resourceManager::Skeleton mSkeleton;
+		PaletteLayout mLayout;
+		std::vector<vertex::PosNormalTexTanSkinned> mVertices;
+		std::vector<unsigned int> mSubsetStarts; //   + 1
+		std::vector<AnimationClip> mClips;
+	};
+
+	const resourceManager::Skeleton& RigCache::GetSkeleton() const
+	{
+		return mSkeleton;
+	}
+
+	const PaletteLayout& RigCache::GetLayout() const
+	{
+		return mLayout;
+	}
+
+	const std::vector<vertex::PosNormalTexTanSkinned>& RigCache::GetVertices() const
+	{
+		return mVertices;
+	}
+}
\ No newline at end of file
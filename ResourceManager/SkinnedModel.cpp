@@ -1,5 +1,6 @@
 #include "SkinnedModel.h"
 
+#include <algorithm>
 #include <functional>
 #include <cassert>
 #include <filesystem>
@@ -14,15 +15,48 @@
 
 #include "d3dUtil.h"
 #include "ResourceManager.h"
+#include "JobSystem.h"
 #include "MathHelper.h"
+#include "MeshOptimizer.h"
+#include "RigCache.h"
+#include "VertexPacking.h"
+#include "VertexWelder.h"
 
 namespace resourceManager
 {
 	extern DirectX::SimpleMath::Matrix convertMatrix(const aiMatrix4x4& aiMatrix);
+	extern void reportBufferSize(const std::string& fileName, size_t unpackedSize, size_t packedSize);
+	extern void reportWeld(const std::string& fileName, size_t importedCount, size_t weldedCount);
 
-	SkinnedModel::SkinnedModel(ID3D11Device* d3dDevice, const std::string& fileName)
-		: IndexBufferFormat(DXGI_FORMAT_R32_UINT)
-		, VertexStride(sizeof(vertex::PosNormalTexTanSkinned))
+	void packSkinnedVertex(const vertex::PosNormalTexTanSkinned& source, vertex::PosNormalTexTanSkinnedPacked* outPacked)
+	{
+		using common::VertexPacking;
+
+		outPacked->Pos = source.Pos;
+		VertexPacking::EncodeOctahedral(source.Normal, outPacked->Normal);
+		VertexPacking::EncodeOctahedral(source.TangentU, outPacked->TangentU);
+		outPacked->Tex[0] = VertexPacking::FloatToHalf(source.Tex.x);
+		outPacked->Tex[1] = VertexPacking::FloatToHalf(source.Tex.y);
+
+		//   ġ 0 ΰ, ̴ INVALID_INDEX .
+		float weights[4];
+		for (int i = 0; i < 4; ++i)
+		{
+			const int index = source.Indices[i];
+			const bool bValid = index != vertex::PosNormalTexTanSkinned::INVALID_INDEX;
+			assert(!bValid || index < vertex::PosNormalTexTanSkinnedPacked::INVALID_INDEX);
+
+			outPacked->Indices[i] = static_cast<unsigned char>(bValid ? index : vertex::PosNormalTexTanSkinnedPacked::INVALID_INDEX);
+			weights[i] = bValid ? source.Weights[i] : 0.f;
+		}
+
+		VertexPacking::QuantizeWeights(weights, outPacked->Weights);
+	}
+
+	SkinnedModel::SkinnedModel(ID3D11Device* d3dDevice, const std::string& fileName, common::JobSystem* jobSystem)
+		: VertexStride(sizeof(vertex::PosNormalTexTanSkinnedPacked))
+		, UnpackedBufferSize(0)
+		, BufferSize(0)
 	{
 		using namespace DirectX::SimpleMath;
 
@@ -43,7 +77,9 @@ namespace resourceManager
 
 		NodeInorderTraversal.reserve(128);
 
-		std::function<void(aiNode*, int)> nodeRecursive = [this, scene, &nodeRecursive, &id](aiNode* node, size_t parentIndex)
+		std::vector<bool> triangleSubsets;
+
+		std::function<void(aiNode*, int)> nodeRecursive = [this, scene, &nodeRecursive, &id, &triangleSubsets](aiNode* node, size_t parentIndex)
 			{
 				//    
 				SkinnedNode skinnedNode;
@@ -143,6 +179,9 @@ namespace resourceManager
 						}
 					}
 
+					//  ġ   ڿ  Űܾ mVertexId Ű  Ƿ  ġ ȸ ڿ Ѵ.
+					triangleSubsets.push_back(mesh->mPrimitiveTypes == aiPrimitiveType_TRIANGLE);
+
 					SubsetTable.push_back(subset);
 
 					// (Ѹ, ؽó) 
@@ -223,6 +262,55 @@ namespace resourceManager
 
 		nodeRecursive(scene->mRootNode, (size_t)SkinnedNode::INVALID_INDEX);
 
+		//    , ġϰ   ڸ .  ε ġ ƾ ģ.
+		auto processSubsets = [this, &triangleSubsets](UINT begin, UINT end)
+			{
+				for (UINT i = begin; i < end; ++i)
+				{
+					SkinnedSubset& subset = SubsetTable[i];
+					if (!triangleSubsets[i] || subset.VertexCount == 0)
+					{
+						continue;
+					}
+
+					vertex::PosNormalTexTanSkinned* vertices = &Vertices[subset.VertexStart];
+					UINT* indices = &Indices[subset.FaceStart * 3];
+					const UINT indexCount = subset.FaceCount * 3;
+
+					const common::WeldAttribute skinAttributes[] =
+					{
+						{ reinterpret_cast<const float*>(&vertices[0].Indices[0]), sizeof(vertex::PosNormalTexTanSkinned), 4, 0.f },
+						{ &vertices[0].Weights[0], sizeof(vertex::PosNormalTexTanSkinned), 4, 0.f }
+					};
+
+					subset.VertexCount = common::VertexWelder::Weld(vertices, subset.VertexCount, indices, indexCount,
+						&vertex::PosNormalTexTanSkinned::Pos, &vertex::PosNormalTexTanSkinned::Normal, &vertex::PosNormalTexTanSkinned::Tex,
+						common::WeldOptions(), skinAttributes, ARRAYSIZE(skinAttributes));
+
+					common::MeshOptimizer::Optimize(vertices, subset.VertexCount, indices, indexCount, &vertex::PosNormalTexTanSkinned::Pos);
+				}
+			};
+
+		if (jobSystem != nullptr)
+		{
+			jobSystem->ParallelFor(static_cast<UINT>(SubsetTable.size()), 1, processSubsets);
+		}
+		else
+		{
+			processSubsets(0, static_cast<UINT>(SubsetTable.size()));
+		}
+
+		const size_t importedVertexCount = Vertices.size();
+		UINT vertexStart = 0;
+		for (SkinnedSubset& subset : SubsetTable)
+		{
+			std::copy(Vertices.begin() + subset.VertexStart, Vertices.begin() + subset.VertexStart + subset.VertexCount, Vertices.begin() + vertexStart);
+			subset.VertexStart = vertexStart;
+			vertexStart += subset.VertexCount;
+		}
+		Vertices.resize(vertexStart);
+		reportWeld(fileName, importedVertexCount, Vertices.size());
+
 		//   ε 
 		std::map<std::string, size_t> nodeNameIndexMap;
 
@@ -242,6 +330,60 @@ namespace resourceManager
 			}
 		}
 
+		//    ̾  ȷƮ , ũ尡 νϽ ȷƮ     .
+		Palette.SubsetOffsets.reserve(SubsetTable.size() + 1);
+		for (const auto& subset : SubsetTable)
+		{
+			Palette.SubsetOffsets.push_back(Palette.GetBoneCount());
+			for (const auto& skinnedBone : subset.Bones)
+			{
+				Palette.NodeIndices.push_back(static_cast<unsigned int>(skinnedBone.NodeIndex));
+				Palette.OffsetMatrices.push_back(skinnedBone.OffsetMatrix);
+			}
+		}
+		Palette.SubsetOffsets.push_back(Palette.GetBoneCount());
+
+		// ø ε  ڿ, Ŭ ڸ       
+		DirectX::BoundingBox::CreateFromPoints(BoundingBox, Vertices.size(), &Vertices[0].Pos, sizeof(vertex::PosNormalTexTanSkinned));
+		DirectX::BoundingSphere::CreateFromPoints(BoundingSphere, Vertices.size(), &Vertices[0].Pos, sizeof(vertex::PosNormalTexTanSkinned));
+
+		std::vector<MinMaxBox> boneBoxes(Palette.GetBoneCount());
+		for (size_t i = 0; i < SubsetTable.size(); ++i)
+		{
+			const SkinnedSubset& subset = SubsetTable[i];
+			AnimatedBounds::AddBoneBoxes(&Vertices[subset.VertexStart], subset.VertexCount, Palette.SubsetOffsets[i], &boneBoxes);
+		}
+
+		//  򰡿 ̷,   ̵, ȸ, ũ  д.
+		const unsigned int nodeCount = static_cast<unsigned int>(NodeInorderTraversal.size());
+		Skeleton.NodeNames.reserve(nodeCount);
+		Skeleton.ParentIndices.reserve(nodeCount);
+		Skeleton.BindPose.Resize(nodeCount);
+		for (unsigned int i = 0; i < nodeCount; ++i)
+		{
+			SkinnedNode& skinnedNode = NodeInorderTraversal[i];
+			Skeleton.NodeNames.push_back(skinnedNode.Name);
+			Skeleton.ParentIndices.push_back(skinnedNode.ParentIndex == (size_t)SkinnedNode::INVALID_INDEX
+				? resourceManager::Skeleton::INVALID_INDEX : static_cast<int>(skinnedNode.ParentIndex));
+
+			Vector3 scale = Vector3::One;
+			Quaternion rotation = Quaternion::Identity;
+			Vector3 translation = Vector3::Zero;
+			Matrix toParent = skinnedNode.ToParentMatrix;
+			if (toParent.Decompose(scale, rotation, translation))
+			{
+				Skeleton.BindPose.Translations[i] = translation;
+				Skeleton.BindPose.Rotations[i] = rotation;
+				Skeleton.BindPose.Scales[i] = scale;
+			}
+			else
+			{
+				Skeleton.BindPose.Translations[i] = toParent.Translation();
+				Skeleton.BindPose.Rotations[i] = Quaternion::Identity;
+				Skeleton.BindPose.Scales[i] = Vector3::One;
+			}
+		}
+
 		// ִϸ̼ ε
 		for (unsigned int i = 0; i < scene->mNumAnimations; ++i)
 		{
@@ -249,7 +391,8 @@ namespace resourceManager
 
 			AnimationClip animClip;
 			auto totalFrame = currentAnimation->mDuration;
-			auto framePerSeconds = 1 / (currentAnimation->mTicksPerSecond);
+			// ʴ ƽ 0̸ Ͽ   ̶ assimp ʴ 25 .
+			auto framePerSeconds = 1 / (currentAnimation->mTicksPerSecond != 0 ? currentAnimation->mTicksPerSecond : 25.0);
 			animClip.Duration = totalFrame * framePerSeconds;
 			animClip.Name = currentAnimation->mName.C_Str();
 
@@ -260,47 +403,110 @@ namespace resourceManager
 				AnimationNode animationNode;
 				animationNode.Name = currentChennel->mNodeName.C_Str();
 
+				// äθ Ű  ð ٸǷ Ʈ  ä.
+				KeyTrack<Vector3>& positionKeys = animationNode.PositionKeys;
+				positionKeys.Times.reserve(currentChennel->mNumPositionKeys);
+				positionKeys.Values.reserve(currentChennel->mNumPositionKeys);
 				for (unsigned int k = 0; k < currentChennel->mNumPositionKeys; ++k)
 				{
-					KeyAnimation keyAnimation;
-
-					keyAnimation.Time = currentChennel->mPositionKeys[k].mTime * framePerSeconds;
+					const aiVectorKey& key = currentChennel->mPositionKeys[k];
+					positionKeys.Times.push_back(static_cast<float>(key.mTime * framePerSeconds));
+					positionKeys.Values.push_back({ key.mValue.x, key.mValue.y, key.mValue.z });
+				}
 
-					keyAnimation.Position.x = currentChennel->mPositionKeys[k].mValue.x;
-					keyAnimation.Position.y = currentChennel->mPositionKeys[k].mValue.y;
-					keyAnimation.Position.z = currentChennel->mPositionKeys[k].mValue.z;
+				KeyTrack<Quaternion>& rotationKeys = animationNode.RotationKeys;
+				rotationKeys.Times.reserve(currentChennel->mNumRotationKeys);
+				rotationKeys.Values.reserve(currentChennel->mNumRotationKeys);
+				for (unsigned int k = 0; k < currentChennel->mNumRotationKeys; ++k)
+				{
+					const aiQuatKey& key = currentChennel->mRotationKeys[k];
+					Quaternion rotation(key.mValue.x, key.mValue.y, key.mValue.z, key.mValue.w);
 
-					keyAnimation.Rotation.x = currentChennel->mRotationKeys[k].mValue.x;
-					keyAnimation.Rotation.y = currentChennel->mRotationKeys[k].mValue.y;
-					keyAnimation.Rotation.z = currentChennel->mRotationKeys[k].mValue.z;
-					keyAnimation.Rotation.w = currentChennel->mRotationKeys[k].mValue.w;
+					// q -q  ȸ̹Ƿ  Ű  ݱ  θ   ȣ  ʾƵ ȴ.
+					if (!rotationKeys.Values.empty() && rotationKeys.Values.back().Dot(rotation) < 0.f)
+					{
+						rotation = -rotation;
+					}
 
-					keyAnimation.Scaling.x = currentChennel->mScalingKeys[k].mValue.x;
-					keyAnimation.Scaling.y = currentChennel->mScalingKeys[k].mValue.y;
-					keyAnimation.Scaling.z = currentChennel->mScalingKeys[k].mValue.z;
+					rotationKeys.Times.push_back(static_cast<float>(key.mTime * framePerSeconds));
+					rotationKeys.Values.push_back(rotation);
+				}
 
-					animationNode.KeyAnimations.push_back(keyAnimation);
+				KeyTrack<Vector3>& scalingKeys = animationNode.ScalingKeys;
+				scalingKeys.Times.reserve(currentChennel->mNumScalingKeys);
+				scalingKeys.Values.reserve(currentChennel->mNumScalingKeys);
+				for (unsigned int k = 0; k < currentChennel->mNumScalingKeys; ++k)
+				{
+					const aiVectorKey& key = currentChennel->mScalingKeys[k];
+					scalingKeys.Times.push_back(static_cast<float>(key.mTime * framePerSeconds));
+					scalingKeys.Values.push_back({ key.mValue.x, key.mValue.y, key.mValue.z });
 				}
 
-				animClip.AnimationNodes.insert({ animationNode.Name, animationNode });
+				animClip.Channels.push_back(std::move(animationNode));
 			}
 
-			Animations.insert({ animClip.Name, animClip });
+			// 帶 ä ε ̸ ã ξ ׸  ̸ ã ʴ´.
+			animClip.Bind(Skeleton);
+			Animations.insert({ animClip.Name, std::move(animClip) });
+		}
+
+		// Ŭ ִϸ̼  Ʈ ´. Ŭ ̶  ý   óѴ.
+		std::vector<std::pair<const AnimationClip*, AnimatedBounds*>> boundsJobs;
+		boundsJobs.reserve(Animations.size());
+		for (const auto& animation : Animations)
+		{
+			boundsJobs.push_back({ &animation.second, &AnimationBounds[animation.first] });
+		}
+
+		auto buildBounds = [this, &boundsJobs, &boneBoxes](UINT begin, UINT end)
+			{
+				for (UINT i = begin; i < end; ++i)
+				{
+					AnimatedBounds::Build(*boundsJobs[i].first, Skeleton, Palette, boneBoxes, AnimatedBounds::DEFAULT_SAMPLE_RATE, boundsJobs[i].second);
+				}
+			};
+
+		if (jobSystem != nullptr)
+		{
+			jobSystem->ParallelFor(static_cast<UINT>(boundsJobs.size()), 1, buildBounds);
+		}
+		else
+		{
+			buildBounds(0, static_cast<UINT>(boundsJobs.size()));
 		}
 
 		importer.FreeScene();
 
+		//  ȭϰ, ε    ϸ 16Ʈ ø.
+		std::vector<vertex::PosNormalTexTanSkinnedPacked> packedVertices(Vertices.size());
+		for (size_t i = 0; i < Vertices.size(); ++i)
+		{
+			packSkinnedVertex(Vertices[i], &packedVertices[i]);
+		}
+
+		std::vector<BYTE> packedIndices;
+		packedIndices.reserve(Indices.size() * sizeof(UINT));
+		for (SkinnedSubset& subset : SubsetTable)
+		{
+			subset.IndexFormat = common::VertexPacking::AppendIndices(&Indices[subset.FaceStart * 3], subset.FaceCount * 3,
+				subset.VertexCount, &packedIndices, &subset.IndexOffset);
+		}
+
+		UnpackedBufferSize = sizeof(vertex::PosNormalTexTanSkinned) * Vertices.size() + sizeof(UINT) * Indices.size();
+		BufferSize = sizeof(vertex::PosNormalTexTanSkinnedPacked) * packedVertices.size() + packedIndices.size();
+		reportBufferSize(fileName, UnpackedBufferSize, BufferSize);
+
 		HRESULT hr;
 
 		D3D11_BUFFER_DESC vbd;
 		vbd.Usage = D3D11_USAGE_IMMUTABLE;
-		vbd.ByteWidth = static_cast<size_t>(sizeof(vertex::PosNormalTexTanSkinned) * Vertices.size());
+		vbd.ByteWidth = static_cast<size_t>(sizeof(vertex::PosNormalTexTanSkinnedPacked) * packedVertices.size());
 		vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
 		vbd.CPUAccessFlags = 0;
 		vbd.MiscFlags = 0;
 
 		D3D11_SUBRESOURCE_DATA initData;
-		initData.pSysMem = &Vertices[0];
+		initData.pSysMem = &packedVertices[0];
 
 		hr = d3dDevice->CreateBuffer(&vbd, &initData, &VB);
 		if (FAILED(hr)) {
@@ -309,12 +515,12 @@ namespace resourceManager
 
 		D3D11_BUFFER_DESC ibd;
 		ibd.Usage = D3D11_USAGE_IMMUTABLE;
-		ibd.ByteWidth = static_cast<size_t>(sizeof(unsigned int) * Indices.size());
+		ibd.ByteWidth = static_cast<size_t>(packedIndices.size());
 		ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
 		ibd.CPUAccessFlags = 0;
 		ibd.MiscFlags = 0;
 
-		initData.pSysMem = &Indices[0];
+		initData.pSysMem = &packedIndices[0];
 
 		hr = d3dDevice->CreateBuffer(&ibd, &initData, &IB);
 		if (FAILED(hr)) {
@@ -354,63 +560,47 @@ namespace resourceManager
 		ReleaseCOM(MaterialCB);
 	}
 
-	void SkinnedModel::Draw(ID3D11DeviceContext* d3dContext, const std::string& clipName, float timePos)
+	void SkinnedModel::Draw(ID3D11DeviceContext* d3dContext, const std::string& clipName, float timePos, std::vector<AnimationCursor>* cursors)
+	{
+		const AnimationClip* animClip = FindAnimation(clipName);
+		assert(animClip != nullptr);
+
+		//  Ӹ   ϰ,  ȷƮ  ø.
+		const unsigned int nodeCount = Skeleton.GetNodeCount();
+		if (cursors != nullptr)
+		{
+			cursors->resize(nodeCount);
+		}
+		mPose.Resize(nodeCount);
+		mToRootMatrices.resize(nodeCount);
+		mPalette.resize(Palette.GetBoneCount());
+
+		EvaluatePose(*animClip, timePos, cursors != nullptr ? cursors->data() : nullptr, &mPose, mToRootMatrices.data());
+		Palette.BuildPalette(mToRootMatrices.data(), mPalette.data());
+
+		Draw(d3dContext, mPalette.data());
+	}
+
+	void SkinnedModel::Draw(ID3D11DeviceContext* d3dContext, const DirectX::SimpleMath::Matrix* palette)
 	{
 		using namespace DirectX::SimpleMath;
 		// ε
 		UINT offset = 0;
-		d3dContext->IASetIndexBuffer(IB, IndexBufferFormat, 0);
 		d3dContext->IASetVertexBuffers(0, 1, &VB, &VertexStride, &offset);
 		d3dContext->VSSetConstantBuffers(1, 1, &BoneCB);
 		d3dContext->PSSetConstantBuffers(1, 1, &MaterialCB);
 
-		auto findedAnim = Animations.find(clipName);
-		assert(findedAnim != Animations.end());
-
-		const AnimationClip& animClip = findedAnim->second;
+		//  ۴ ׻ MAX_BONE_COUNT ° øǷ   Ű ´.
+		std::array<Matrix, MAX_BONE_COUNT> matrixPalette;
 
 		for (size_t i = 0; i < SubsetTable.size(); ++i)
 		{
-			//   Ʈ 
-			for (const SkinnedBone& bone : SubsetTable[i].Bones)
-			{
-				auto find = animClip.AnimationNodes.find(bone.Name);
-
-				if (find != animClip.AnimationNodes.end())
-				{
-					const AnimationNode& animNode = find->second;
-
-					NodeInorderTraversal[bone.NodeIndex].ToParentMatrix = animNode.Evaluate(fmod(timePos, animClip.Duration));
-				}
-			}
-
-			//   Ʈ 
-			NodeInorderTraversal[0].ToRootMatrix = NodeInorderTraversal[0].ToParentMatrix;
-			for (size_t j = 1; j < NodeInorderTraversal.size(); ++j)
-			{
-				SkinnedNode& curNode = NodeInorderTraversal[j];
-				const SkinnedNode& parentNode = NodeInorderTraversal[curNode.ParentIndex];
-
-				curNode.ToRootMatrix = curNode.ToParentMatrix * parentNode.ToRootMatrix;
-			}
-
-			//  ȷƮ  ,   ݿ
-
-			// Ŀ Ź ͸ Ҵϴ 
-			std::array<Matrix, MAX_BONE_COUNT> matrixPalette;
-			auto paletteIter = matrixPalette.begin();
-
-			for (const SkinnedBone& bone : SubsetTable[i].Bones)
-			{
-				const Matrix& boneToRoot = NodeInorderTraversal[bone.NodeIndex].ToRootMatrix;
-
-				//  Ʈ    ٷ  ְ ϰ,
-				//  (ִϸ̼) +  θ Ʈ(忡 ġ)ϴ 帧 ´.
-				*paletteIter++ = (bone.OffsetMatrix * boneToRoot).Transpose();
-			}
-
-			if (!SubsetTable[i].Bones.empty())
+			const unsigned int boneBegin = Palette.SubsetOffsets[i];
+			const unsigned int boneEnd = Palette.SubsetOffsets[i + 1];
+			if (boneBegin < boneEnd)
 			{
+				assert(boneEnd - boneBegin <= MAX_BONE_COUNT);
+				std::copy(palette + boneBegin, palette + boneEnd, matrixPalette.begin());
 				d3dContext->UpdateSubresource(BoneCB, 0, 0, &matrixPalette[0], 0, 0);
 			}
 
@@ -427,7 +617,90 @@ namespace resourceManager
 
 			d3dContext->UpdateSubresource(MaterialCB, 0, 0, &bUseTextures[0], 0, 0);
 			d3dContext->PSSetShaderResources(0, TEXTURE_SIZE, &srv[0]);
-			d3dContext->DrawIndexed(SubsetTable[i].FaceCount * 3, SubsetTable[i].FaceStart * 3, SubsetTable[i].VertexStart);
+			d3dContext->IASetIndexBuffer(IB, SubsetTable[i].IndexFormat, SubsetTable[i].IndexOffset);
+			d3dContext->DrawIndexed(SubsetTable[i].FaceCount * 3, 0, SubsetTable[i].VertexStart);
+		}
+	}
+
+	const AnimationClip* SkinnedModel::FindAnimation(const std::string& clipName) const
+	{
+		auto find = Animations.find(clipName);
+
+		return find != Animations.end() ? &find->second : nullptr;
+	}
+
+	const AnimatedBounds* SkinnedModel::FindAnimationBounds(const std::string& clipName) const
+	{
+		auto find = AnimationBounds.find(clipName);
+
+		return find != AnimationBounds.end() ? &find->second : nullptr;
+	}
+
+	DirectX::BoundingBox SkinnedModel::GetAnimatedBounds(const AnimationClip* clip, float beginTime, float endTime) const
+	{
+		const AnimatedBounds* bounds = clip != nullptr ? FindAnimationBounds(clip->Name) : nullptr;
+
+		return bounds != nullptr ? bounds->GetBounds(beginTime, endTime) : BoundingBox;
+	}
+
+	void SkinnedModel::EvaluatePose(const AnimationClip& clip, float timePos, AnimationCursor* cursors,
+		LocalPose* pose, DirectX::SimpleMath::Matrix* outToRootMatrices) const
+	{
+		const float clipTime = clip.Duration > 0.0 ? static_cast<float>(fmod(timePos, clip.Duration)) : 0.f;
+
+		clip.SamplePose(Skeleton, clipTime, cursors, pose);
+		Skeleton.ComputeToRootMatrices(*pose, outToRootMatrices);
+	}
+
+	void SkinnedModel::BuildPalette(size_t subsetIndex, const DirectX::SimpleMath::Matrix* toRootMatrices, DirectX::SimpleMath::Matrix* outPalette) const
+	{
+		const std::vector<SkinnedBone>& bones = SubsetTable[subsetIndex].Bones;
+		assert(bones.size() <= MAX_BONE_COUNT);
+
+		for (size_t i = 0; i < bones.size(); ++i)
+		{
+			//  Ʈ    ٷ  ְ ϰ,
+			//  (ִϸ̼) +  θ Ʈ(忡 ġ)ϴ 帧 ´.
+			outPalette[i] = (bones[i].OffsetMatrix * toRootMatrices[bones[i].NodeIndex]).Transpose();
 		}
 	}
+
+	bool SkinnedModel::BakeVertexAnimation(float frameRate, common::JobSystem* jobSystem, VertexAnimationTexture* outTexture) const
+	{
+		std::vector<unsigned int> subsetStarts;
+		std::vector<const AnimationClip*> clips;
+		const VertexAnimationTexture::SkinnedMeshSource source = makeMeshSource(&subsetStarts, &clips);
+
+		return VertexAnimationTexture::Bake(source, clips, frameRate, jobSystem, outTexture);
+	}
+
+	bool SkinnedModel::WriteRigCache(const std::string& fileName) const
+	{
+		std::vector<unsigned int> subsetStarts;
+		std::vector<const AnimationClip*> clips;
+		const VertexAnimationTexture::SkinnedMeshSource source = makeMeshSource(&subsetStarts, &clips);
+
+		return RigCache::Write(fileName, source, clips);
+	}
+
+	VertexAnimationTexture::SkinnedMeshSource SkinnedModel::makeMeshSource(std::vector<unsigned int>* outSubsetStarts,
+		std::vector<const AnimationClip*>* outClips) const
+	{
+		//   Vertices SubsetTable  ̾ ִ.
+		outSubsetStarts->reserve(SubsetTable.size() + 1);
+		for (const SkinnedSubset& subset : SubsetTable)
+		{
+			outSubsetStarts->push_back(subset.VertexStart);
+		}
+		outSubsetStarts->push_back(static_cast<unsigned int>(Vertices.size()));
+
+		for (const auto& animation : Animations)
+		{
+			outClips->push_back(&animation.second);
+		}
+
+		const VertexAnimationTexture::SkinnedMeshSource source = { &Skeleton, &Palette, Vertices.data(), outSubsetStarts->data(),
+			static_cast<unsigned int>(SubsetTable.size()) };
+		return source;
+	}
 }
\ No newline at end of file
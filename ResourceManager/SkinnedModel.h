@@ -1,17 +1,25 @@
 #pragma once
 
 #include <array>
+#include <map>
 #include <vector>
 #include <string>
 
 #include <d3d11.h>
 #include <directxtk/SimpleMath.h>
 
+#include "AnimatedBounds.h"
 #include "Animation.h"
 #include "Subset.h"
 #include "eMaterialTexture.h"
 #include "LightHelper.h"
 #include "Vertex.h"
+#include "VertexAnimationTexture.h"
+
+namespace common
+{
+	class JobSystem;
+}
 
 namespace resourceManager
 {
@@ -39,7 +47,8 @@ namespace resourceManager
 		SkinnedSubset() :
 			Id(-1),
 			VertexStart(0), VertexCount(0),
-			FaceStart(0), FaceCount(0)
+			FaceStart(0), FaceCount(0),
+			IndexFormat(DXGI_FORMAT_R32_UINT), IndexOffset(0)
 		{
 		}
 
@@ -48,6 +57,8 @@ namespace resourceManager
 		unsigned int VertexCount;
 		unsigned int FaceStart;
 		unsigned int FaceCount;
+		DXGI_FORMAT IndexFormat; //   65536 ϸ 16Ʈ
+		unsigned int IndexOffset; // ε   Ʈ 
 		std::vector<SkinnedBone> Bones;
 	};
 
@@ -58,19 +69,40 @@ namespace resourceManager
 	class SkinnedModel
 	{
 	public:
-		SkinnedModel(ID3D11Device* d3dDevice, const std::string& fileName);
+		// jobSystem  º  ġ  óѴ.
+		SkinnedModel(ID3D11Device* d3dDevice, const std::string& fileName, common::JobSystem* jobSystem = nullptr);
 		~SkinnedModel();
 
 		// ùٸ Ϸ   Ʈ
 		//  ȸϸ鼭  ̺ ޽ 
 		// ޽    û ð     Ʈ ؼ óѴ.
-		void Draw(ID3D11DeviceContext* d3dContext, const std::string& clipName, float timePos);
+		// cursors  ŭ ÷ νϽ  ġ ̾ .  Ź  ŽѴ.
+		void Draw(ID3D11DeviceContext* d3dContext, const std::string& clipName, float timePos, std::vector<AnimationCursor>* cursors = nullptr);
+		// ̸  ȷƮ(CrowdAnimator::GetPalette , Palette   ŭ) ׸.
+		void Draw(ID3D11DeviceContext* d3dContext, const DirectX::SimpleMath::Matrix* palette);
+
+		const AnimationClip* FindAnimation(const std::string& clipName) const;
+		const AnimatedBounds* FindAnimationBounds(const std::string& clipName) const;
+		// clip [beginTime, endTime]  ϴ   , clip nullptr̸ ε  
+		DirectX::BoundingBox GetAnimatedBounds(const AnimationClip* clip, float beginTime, float endTime) const;
+		//  νϽ     庰 Ʈ   .  ǵ帮 ʴ´.
+		// cursors nullptr̰ų  ŭ, pose outToRootMatrices  ŭ
+		void EvaluatePose(const AnimationClip& clip, float timePos, AnimationCursor* cursors,
+			LocalPose* pose, DirectX::SimpleMath::Matrix* outToRootMatrices) const;
+		//   ȷƮ,  ۿ ٷ ø ġ д. outPalette   ŭ
+		void BuildPalette(size_t subsetIndex, const DirectX::SimpleMath::Matrix* toRootMatrices, DirectX::SimpleMath::Matrix* outPalette) const;
+		//  Ŭ ̸  ؽ ִϸ̼ ؽó ´.   Vertices  VB IB ״ .
+		bool BakeVertexAnimation(float frameRate, common::JobSystem* jobSystem, VertexAnimationTexture* outTexture) const;
+		// 帮 (VertexAnimationBake -rig) е BakeVertexAnimation  Է .rig .
+		bool WriteRigCache(const std::string& fileName) const;
 
 	public:
 		enum { MAX_BONE_COUNT = 128 };
 
 		// node
 		std::vector<SkinnedNode> NodeInorderTraversal; //  ȸ  
+		resourceManager::Skeleton Skeleton; //   NodeInorderTraversal .
+		PaletteLayout Palette; //   SubsetTable  ̾  
 
 		// material
 		std::vector<common::Material> Materials;
@@ -82,8 +114,9 @@ namespace resourceManager
 		std::vector<UINT> Indices;
 		ID3D11Buffer* VB;
 		ID3D11Buffer* IB;
-		DXGI_FORMAT IndexBufferFormat; // ׻ 32Ʈ  
-		UINT VertexStride;
+		UINT VertexStride; // ȭ  ũ
+		size_t UnpackedBufferSize; // float , 32Ʈ ε  VB + IB Ʈ
+		size_t BufferSize; //  VB + IB Ʈ
 		std::vector<SkinnedSubset> SubsetTable;
 		ID3D11Buffer* BoneCB;
 
@@ -93,13 +126,24 @@ namespace resourceManager
 
 		// animation 
 		std::map<std::string, AnimationClip> Animations;
+		std::map<std::string, AnimatedBounds> AnimationBounds; // Ŭ ̸ ִϸ̼  Ʈ
+
+	private:
+		//  Է, outSubsetStarts outClips  ִ ȸ .
+		VertexAnimationTexture::SkinnedMeshSource makeMeshSource(std::vector<unsigned int>* outSubsetStarts,
+			std::vector<const AnimationClip*>* outClips) const;
+
+	private:
+		// Draw   , Ӹ ٽ Ҵ ʵ  ִ´.
+		LocalPose mPose;
+		std::vector<DirectX::SimpleMath::Matrix> mToRootMatrices;
+		std::vector<DirectX::SimpleMath::Matrix> mPalette;
 	};
 
 	struct SkinnedModelInstance
 	{
 		SkinnedModel* SkinnedModel;
 		DirectX::SimpleMath::Matrix WorldMatrix;
-		float TimePos;
-		std::string AnimationName;
+		unsigned int CrowdIndex; // CrowdAnimator  ȣ
 	};
 }
\ No newline at end of file
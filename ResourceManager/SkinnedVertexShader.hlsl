@@ -1,10 +1,10 @@
 struct VS_INPUT
 {
 	float3 position : POSITION;
-	float3 normal : NORMAL;
-	float3 tangent : TANGENT;
+	float2 normal : NORMAL; // octahedral
+	float2 tangent : TANGENT;
 	float2 UV : UV;
-	int4 Indices : INDICES;
+	uint4 Indices : INDICES; // 255 = unused slot
 	float4 Weights : WEIGHTS;
 };
 
@@ -31,6 +31,15 @@ cbuffer cbBonePalette : register(b1)
 	matrix boneMat[128];
 }
 
+// same as VertexPacking::DecodeOctahedral
+float3 decodeOctahedral(float2 encoded)
+{
+	float3 n = float3(encoded, 1.f - abs(encoded.x) - abs(encoded.y));
+	float fold = saturate(-n.z);
+	n.xy += n.xy >= 0.f ? -fold : fold;
+	return normalize(n);
+}
+
 VS_OUTPUT main(VS_INPUT Input)
 { 
 	VS_OUTPUT Output;
@@ -38,7 +47,7 @@ VS_OUTPUT main(VS_INPUT Input)
 	matrix combindedMatrix = mul(Input.Weights.x, boneMat[Input.Indices.x]);;
 	for (int i = 1; i < 4; ++i)
 	{
-		if (Input.Indices[i] == -1)
+		if (Input.Indices[i] == 255)
 		{
 			break;
 		}
@@ -56,10 +65,10 @@ VS_OUTPUT main(VS_INPUT Input)
 	float3 viewDir = worldPosition.xyz - worldCameraPosition.xyz;
 	Output.viewDir = normalize(viewDir);
 
-	float3 worldNormal = mul(Input.normal, (float3x3)combindedMatrix);
+	float3 worldNormal = mul(decodeOctahedral(Input.normal), (float3x3)combindedMatrix);
 	Output.N = normalize(worldNormal);
 	
-	float3 worldTangent = mul(Input.tangent, (float3x3)combindedMatrix);
+	float3 worldTangent = mul(decodeOctahedral(Input.tangent), (float3x3)combindedMatrix);
 	Output.T = normalize(worldTangent);
 	
 	Output.B = cross(worldNormal, worldTangent);
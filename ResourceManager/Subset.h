@@ -1,13 +1,25 @@
 #pragma once
 
+#include <d3d11.h>
+#include <vector>
+
 namespace resourceManager
 {
+	//  LOD ϳ ε ,  LOD   ״ .
+	struct SubsetLod
+	{
+		unsigned int IndexOffset; // ε   Ʈ 
+		unsigned int IndexCount;
+		float Error; //   Ÿ  ġ ( )
+	};
+
 	struct Subset
 	{
 		Subset() :
 			Id(-1),
 			VertexStart(0), VertexCount(0),
-			FaceStart(0), FaceCount(0)
+			FaceStart(0), FaceCount(0),
+			IndexFormat(DXGI_FORMAT_R32_UINT), IndexOffset(0)
 		{
 		}
 
@@ -16,5 +28,8 @@ namespace resourceManager
 		unsigned int VertexCount;
 		unsigned int FaceStart;
 		unsigned int FaceCount;
+		DXGI_FORMAT IndexFormat; //   65536 ϸ 16Ʈ
+		unsigned int IndexOffset; // ε   Ʈ 
+		std::vector<SubsetLod> Lods; // Lods[0] , ﰢ ƴ   ϳ
 	};
 }
\ No newline at end of file
@@ -30,4 +30,27 @@ namespace vertex
 		int Indices[4] = { INVALID_INDEX, INVALID_INDEX, INVALID_INDEX, INVALID_INDEX };
 		float Weights[4] = { 0.f };
 	};
+
+	// GPU ø ȭ , ڵ ̴ Ѵ.
+	// Normal, TangentU: ȸü snorm16, Tex: half
+	struct PosNormalTexTanPacked
+	{
+		DirectX::SimpleMath::Vector3 Pos;
+		short Normal[2];
+		short TangentU[2];
+		unsigned short Tex[2];
+	};
+
+	// Indices: 8Ʈ  ε, Weights:  255 unorm8
+	struct PosNormalTexTanSkinnedPacked
+	{
+		enum { INVALID_INDEX = 0xFF };
+
+		DirectX::SimpleMath::Vector3 Pos;
+		short Normal[2];
+		short TangentU[2];
+		unsigned short Tex[2];
+		unsigned char Indices[4];
+		unsigned char Weights[4];
+	};
 };
\ No newline at end of file
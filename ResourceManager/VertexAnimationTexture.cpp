@@ -0,0 +1,393 @@
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include "CpuSkinner.h"
+#include "JobSystem.h"
+#include "VertexAnimationTexture.h"
+#include "VertexPacking.h"
+
+namespace resourceManager
+{
+	using namespace DirectX::SimpleMath;
+
+	namespace
+	{
+		struct FileHeader
+		{
+			uint32_t Magic;
+			uint32_t Version;
+			uint32_t VertexCount;
+			uint32_t TextureWidth;
+			uint32_t TextureHeight;
+			uint32_t RowsPerFrame;
+			uint32_t FrameCount;
+			uint32_t ClipCount;
+			float BoundsMin[3];
+			float BoundsSize[3];
+		};
+
+		struct FileClip
+		{
+			char Name[VertexAnimationTexture::MAX_CLIP_NAME_LENGTH + 1];
+			uint32_t FirstFrame;
+			uint32_t FrameCount;
+			float FrameRate;
+			float Duration;
+		};
+
+		// ̴ decodeOctahedral  , Է [-1, 1]
+		Vector3 decodeOctahedral(float x, float y)
+		{
+			Vector3 normal(x, y, 1.f - fabsf(x) - fabsf(y));
+			const float fold = std::min<float>(std::max<float>(-normal.z, 0.f), 1.f);
+			normal.x += normal.x >= 0.f ? -fold : fold;
+			normal.y += normal.y >= 0.f ? -fold : fold;
+			normal.Normalize();
+
+			return normal;
+		}
+
+		uint16_t encodeNormalized(float value, float origin, float size)
+		{
+			return common::VertexPacking::FloatToHalf(size > 0.f ? (value - origin) / size : 0.f);
+		}
+	}
+
+	VertexAnimationTexture::VertexAnimationTexture()
+		: mConstants()
+		, mVertexCount(0)
+		, mTextureHeight(0)
+		, mFrameCount(0)
+	{
+	}
+
+	bool VertexAnimationTexture::Bake(const SkinnedMeshSource& source, const std::vector<const AnimationClip*>& clips, float frameRate,
+		common::JobSystem* jobSystem, VertexAnimationTexture* outTexture)
+	{
+		assert(source.Skeleton != nullptr && source.Layout != nullptr);
+		assert(source.SubsetCount + 1 == source.Layout->SubsetOffsets.size());
+		assert(frameRate > 0.f);
+
+		const Skeleton& skeleton = *source.Skeleton;
+		const PaletteLayout& layout = *source.Layout;
+		const unsigned int vertexCount = source.SubsetStarts[source.SubsetCount];
+
+		// 1. Ŭ [0, ]     ´.   ־     ִ.
+		std::vector<ClipRange> clipRanges;
+		std::vector<std::pair<const AnimationClip*, float>> frameTimes;
+		for (const AnimationClip* clip : clips)
+		{
+			ClipRange range;
+			range.Name = clip->Name.substr(0, MAX_CLIP_NAME_LENGTH);
+			range.Duration = std::max<float>(static_cast<float>(clip->Duration), 0.f);
+			range.FirstFrame = static_cast<unsigned int>(frameTimes.size());
+			range.FrameCount = range.Duration > 0.f ? static_cast<unsigned int>(ceilf(range.Duration * frameRate)) + 1 : 1;
+			range.FrameRate = range.Duration > 0.f ? (range.FrameCount - 1) / range.Duration : 0.f;
+
+			for (unsigned int frame = 0; frame < range.FrameCount; ++frame)
+			{
+				const float time = range.FrameRate > 0.f ? std::min<float>(frame / range.FrameRate, range.Duration) : 0.f;
+				frameTimes.push_back({ clip, time });
+			}
+
+			clipRanges.push_back(std::move(range));
+		}
+
+		const unsigned int frameCount = static_cast<unsigned int>(frameTimes.size());
+		const unsigned int textureWidth = std::min<unsigned int>(std::max<unsigned int>(vertexCount, 1), MAX_TEXTURE_WIDTH);
+		const unsigned int rowsPerFrame = std::max<unsigned int>((vertexCount + textureWidth - 1) / textureWidth, 1);
+		if (static_cast<size_t>(frameCount) * rowsPerFrame > MAX_TEXTURE_HEIGHT)
+		{
+			return false;
+		}
+
+		// 2. Ӹ     float ŰѴ. ӳ ̶  óѴ.
+		std::vector<Vector3> positions(static_cast<size_t>(frameCount) * vertexCount);
+		std::vector<Vector3> normals(positions.size());
+
+		CpuSkinner skinner;
+		skinner.Prepare(source.Vertices, source.SubsetStarts, source.SubsetCount, layout);
+
+		auto skinFrames = [&](uint32_t begin, uint32_t end)
+			{
+				LocalPose pose;
+				pose.Resize(skeleton.GetNodeCount());
+				std::vector<AnimationCursor> cursors(skeleton.GetNodeCount());
+				std::vector<Matrix> toRootMatrices(skeleton.GetNodeCount());
+				std::vector<Matrix> skinMatrices(layout.GetBoneCount());
+				CpuSkinner::BonePalette palette;
+
+				for (uint32_t frame = begin; frame < end; ++frame)
+				{
+					frameTimes[frame].first->SamplePose(skeleton, frameTimes[frame].second, cursors.data(), &pose);
+					skeleton.ComputeToRootMatrices(pose, toRootMatrices.data());
+					for (unsigned int bone = 0; bone < layout.GetBoneCount(); ++bone)
+					{
+						skinMatrices[bone] = layout.OffsetMatrices[bone] * toRootMatrices[layout.NodeIndices[bone]];
+					}
+
+					// ӳ ̹   Ƿ  ȿ   ŰѴ.
+					const size_t frameOffset = static_cast<size_t>(frame) * vertexCount;
+					CpuSkinner::BuildBonePalette(skinMatrices.data(), layout.GetBoneCount(), eSkinningMode::LinearBlend, &palette);
+					skinner.SkinBatches(palette, 0, skinner.GetBatchCount(), positions.data() + frameOffset, normals.data() + frameOffset);
+				}
+			};
+
+		if (jobSystem != nullptr)
+		{
+			jobSystem->ParallelFor(frameCount, 1, skinFrames);
+		}
+		else
+		{
+			skinFrames(0, frameCount);
+		}
+
+		// 3.    ڷ ġ [0, 1]  half е  .
+		Vector3 boundsMin(FLT_MAX, FLT_MAX, FLT_MAX);
+		Vector3 boundsMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+		for (const Vector3& position : positions)
+		{
+			boundsMin = Vector3::Min(boundsMin, position);
+			boundsMax = Vector3::Max(boundsMax, position);
+		}
+
+		if (positions.empty())
+		{
+			boundsMin = Vector3::Zero;
+			boundsMax = Vector3::Zero;
+		}
+
+		const Vector3 boundsSize = boundsMax - boundsMin;
+		const size_t texelCount = static_cast<size_t>(textureWidth) * frameCount * rowsPerFrame;
+
+		outTexture->mConstants = ShaderConstants();
+		outTexture->mConstants.BoundsMin = Vector4(boundsMin.x, boundsMin.y, boundsMin.z, 0.f);
+		outTexture->mConstants.BoundsSize = Vector4(boundsSize.x, boundsSize.y, boundsSize.z, 0.f);
+		outTexture->mConstants.TextureWidth = textureWidth;
+		outTexture->mConstants.RowsPerFrame = rowsPerFrame;
+		outTexture->mVertexCount = vertexCount;
+		outTexture->mTextureHeight = frameCount * rowsPerFrame;
+		outTexture->mFrameCount = frameCount;
+		outTexture->mClips = std::move(clipRanges);
+		outTexture->mPositionTexels.assign(texelCount * 4, 0);
+		outTexture->mNormalTexels.assign(texelCount * 2, 0);
+
+		const uint16_t one = common::VertexPacking::FloatToHalf(1.f);
+		for (unsigned int frame = 0; frame < frameCount; ++frame)
+		{
+			for (unsigned int i = 0; i < vertexCount; ++i)
+			{
+				const size_t texel = outTexture->getTexelIndex(i, frame);
+				const Vector3& position = positions[static_cast<size_t>(frame) * vertexCount + i];
+				uint16_t* positionTexel = &outTexture->mPositionTexels[texel * 4];
+				positionTexel[0] = encodeNormalized(position.x, boundsMin.x, boundsSize.x);
+				positionTexel[1] = encodeNormalized(position.y, boundsMin.y, boundsSize.y);
+				positionTexel[2] = encodeNormalized(position.z, boundsMin.z, boundsSize.z);
+				positionTexel[3] = one;
+
+				// ȸü ǥ VertexPacking ݿø      snorm16 half ű.
+				short encoded[2];
+				common::VertexPacking::EncodeOctahedral(normals[static_cast<size_t>(frame) * vertexCount + i], encoded);
+				uint16_t* normalTexel = &outTexture->mNormalTexels[texel * 2];
+				normalTexel[0] = common::VertexPacking::FloatToHalf(encoded[0] / 32767.f);
+				normalTexel[1] = common::VertexPacking::FloatToHalf(encoded[1] / 32767.f);
+			}
+		}
+
+		return true;
+	}
+
+	bool VertexAnimationTexture::Write(const std::string& fileName) const
+	{
+		std::ofstream file(fileName, std::ios::binary);
+		if (!file)
+		{
+			return false;
+		}
+
+		FileHeader header = {};
+		header.Magic = MAGIC;
+		header.Version = VERSION;
+		header.VertexCount = mVertexCount;
+		header.TextureWidth = mConstants.TextureWidth;
+		header.TextureHeight = mTextureHeight;
+		header.RowsPerFrame = mConstants.RowsPerFrame;
+		header.FrameCount = mFrameCount;
+		header.ClipCount = static_cast<uint32_t>(mClips.size());
+		for (int i = 0; i < 3; ++i)
+		{
+			header.BoundsMin[i] = (&mConstants.BoundsMin.x)[i];
+			header.BoundsSize[i] = (&mConstants.BoundsSize.x)[i];
+		}
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+		for (const ClipRange& clip : mClips)
+		{
+			FileClip fileClip = {};
+			strncpy(fileClip.Name, clip.Name.c_str(), MAX_CLIP_NAME_LENGTH);
+			fileClip.FirstFrame = clip.FirstFrame;
+			fileClip.FrameCount = clip.FrameCount;
+			fileClip.FrameRate = clip.FrameRate;
+			fileClip.Duration = clip.Duration;
+			file.write(reinterpret_cast<const char*>(&fileClip), sizeof(fileClip));
+		}
+
+		file.write(reinterpret_cast<const char*>(mPositionTexels.data()), mPositionTexels.size() * sizeof(uint16_t));
+		file.write(reinterpret_cast<const char*>(mNormalTexels.data()), mNormalTexels.size() * sizeof(uint16_t));
+
+		return static_cast<bool>(file);
+	}
+
+	bool VertexAnimationTexture::Read(const std::string& fileName)
+	{
+		std::ifstream file(fileName, std::ios::binary);
+		if (!file)
+		{
+			return false;
+		}
+
+		FileHeader header;
+		if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.Magic != MAGIC || header.Version != VERSION
+			|| header.TextureWidth == 0 || header.TextureHeight != header.FrameCount * header.RowsPerFrame
+			|| header.TextureHeight > MAX_TEXTURE_HEIGHT)
+		{
+			return false;
+		}
+
+		std::vector<ClipRange> clips(header.ClipCount);
+		for (ClipRange& clip : clips)
+		{
+			FileClip fileClip;
+			if (!file.read(reinterpret_cast<char*>(&fileClip), sizeof(fileClip)))
+			{
+				return false;
+			}
+
+			fileClip.Name[MAX_CLIP_NAME_LENGTH] = '\0';
+			clip.Name = fileClip.Name;
+			clip.FirstFrame = fileClip.FirstFrame;
+			clip.FrameCount = fileClip.FrameCount;
+			clip.FrameRate = fileClip.FrameRate;
+			clip.Duration = fileClip.Duration;
+
+			if (clip.FrameCount == 0 || clip.FirstFrame + clip.FrameCount > header.FrameCount)
+			{
+				return false;
+			}
+		}
+
+		const size_t texelCount = static_cast<size_t>(header.TextureWidth) * header.TextureHeight;
+		std::vector<uint16_t> positionTexels(texelCount * 4);
+		std::vector<uint16_t> normalTexels(texelCount * 2);
+		if (!file.read(reinterpret_cast<char*>(positionTexels.data()), positionTexels.size() * sizeof(uint16_t))
+			|| !file.read(reinterpret_cast<char*>(normalTexels.data()), normalTexels.size() * sizeof(uint16_t)))
+		{
+			return false;
+		}
+
+		mConstants = ShaderConstants();
+		mConstants.BoundsMin = Vector4(header.BoundsMin[0], header.BoundsMin[1], header.BoundsMin[2], 0.f);
+		mConstants.BoundsSize = Vector4(header.BoundsSize[0], header.BoundsSize[1], header.BoundsSize[2], 0.f);
+		mConstants.TextureWidth = header.TextureWidth;
+		mConstants.RowsPerFrame = header.RowsPerFrame;
+		mVertexCount = header.VertexCount;
+		mTextureHeight = header.TextureHeight;
+		mFrameCount = header.FrameCount;
+		mClips = std::move(clips);
+		mPositionTexels = std::move(positionTexels);
+		mNormalTexels = std::move(normalTexels);
+
+		return true;
+	}
+
+	Vector4 VertexAnimationTexture::MakeInstanceClip(unsigned int clipIndex, float timePos) const
+	{
+		const ClipRange& clip = mClips[clipIndex];
+		return Vector4(static_cast<float>(clip.FirstFrame), static_cast<float>(clip.FrameCount), clip.FrameRate, timePos);
+	}
+
+	Vector3 VertexAnimationTexture::DecodePosition(unsigned int vertexIndex, unsigned int frame) const
+	{
+		const uint16_t* texel = &mPositionTexels[getTexelIndex(vertexIndex, frame) * 4];
+		const Vector3 normalized(common::VertexPacking::HalfToFloat(texel[0]), common::VertexPacking::HalfToFloat(texel[1]),
+			common::VertexPacking::HalfToFloat(texel[2]));
+
+		return Vector3(mConstants.BoundsMin) + normalized * Vector3(mConstants.BoundsSize);
+	}
+
+	Vector3 VertexAnimationTexture::DecodeNormal(unsigned int vertexIndex, unsigned int frame) const
+	{
+		const uint16_t* texel = &mNormalTexels[getTexelIndex(vertexIndex, frame) * 2];
+		return decodeOctahedral(common::VertexPacking::HalfToFloat(texel[0]), common::VertexPacking::HalfToFloat(texel[1]));
+	}
+
+	Vector3 VertexAnimationTexture::SamplePosition(unsigned int vertexIndex, const Vector4& instanceClip) const
+	{
+		unsigned int frame0;
+		unsigned int frame1;
+		float weight;
+		getFramePair(instanceClip, &frame0, &frame1, &weight);
+
+		return Vector3::Lerp(DecodePosition(vertexIndex, frame0), DecodePosition(vertexIndex, frame1), weight);
+	}
+
+	Vector3 VertexAnimationTexture::SampleNormal(unsigned int vertexIndex, const Vector4& instanceClip) const
+	{
+		unsigned int frame0;
+		unsigned int frame1;
+		float weight;
+		getFramePair(instanceClip, &frame0, &frame1, &weight);
+
+		Vector3 normal = Vector3::Lerp(DecodeNormal(vertexIndex, frame0), DecodeNormal(vertexIndex, frame1), weight);
+		normal.Normalize();
+
+		return normal;
+	}
+
+	int VertexAnimationTexture::FindClip(const std::string& name) const
+	{
+		for (size_t i = 0; i < mClips.size(); ++i)
+		{
+			if (mClips[i].Name == name)
+			{
+				return static_cast<int>(i);
+			}
+		}
+
+		return -1;
+	}
+
+	void VertexAnimationTexture::getFramePair(const Vector4& instanceClip, unsigned int* outFrame0, unsigned int* outFrame1, float* outWeight) const
+	{
+		const unsigned int firstFrame = static_cast<unsigned int>(instanceClip.x);
+		const unsigned int frameCount = static_cast<unsigned int>(instanceClip.y);
+		const float frameRate = instanceClip.z;
+
+		if (frameCount < 2 || frameRate <= 0.f)
+		{
+			*outFrame0 = firstFrame;
+			*outFrame1 = firstFrame;
+			*outWeight = 0.f;
+			return;
+		}
+
+		//  Ŭ̶ ð ̷ ,    ӱ Ѵ.
+		const float duration = (frameCount - 1) / frameRate;
+		float clipTime = fmodf(instanceClip.w, duration);
+		if (clipTime < 0.f)
+		{
+			clipTime += duration;
+		}
+
+		const float frame = clipTime * frameRate;
+		const unsigned int frame0 = std::min<unsigned int>(static_cast<unsigned int>(frame), frameCount - 2);
+
+		*outFrame0 = firstFrame + frame0;
+		*outFrame1 = firstFrame + frame0 + 1;
+		*outWeight = std::min<float>(std::max<float>(frame - frame0, 0.f), 1.f);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Animation.h"
+#include "Vertex.h"
+
+namespace common
+{
+	class JobSystem;
+}
+
+namespace resourceManager
+{
+	// Ų ޽ Ŭ CPU Ű Ӹ  ġ  half ؽó   (.vat)
+	//    ȷƮ  νϽ Ŭ   ð Ѱ VertexAnimationVertexShader.hlsl ׸.
+	// ؽó  ٿ TextureWidth    ϳ RowsPerFrame Ѵ. Ŭ   ̾ δ.
+	// ġ: RGBA16F, xyz ü  ڷ ȭ , w 1
+	// : RG16F, ȸü  (VertexPacking::EncodeOctahedral  )
+	//  б D3D  ϹǷ 帮   ִ.
+	class VertexAnimationTexture
+	{
+	public:
+		enum { MAGIC = 0x20544156 }; // "VAT "
+		enum { VERSION = 1 };
+		enum { MAX_TEXTURE_WIDTH = 4096, MAX_TEXTURE_HEIGHT = 16384 }; // D3D11 ؽó Ѱ 
+		enum { DEFAULT_FRAME_RATE = 30, MAX_CLIP_NAME_LENGTH = 63 };
+
+		// Ų ޽  ,  i  [SubsetStarts[i], SubsetStarts[i + 1]) ְ  ȣ PaletteLayout::SubsetOffsets[i]ʹ.
+		struct SkinnedMeshSource
+		{
+			const resourceManager::Skeleton* Skeleton;
+			const PaletteLayout* Layout;
+			const vertex::PosNormalTexTanSkinned* Vertices;
+			const unsigned int* SubsetStarts; //   + 1
+			unsigned int SubsetCount;
+		};
+
+		// Ŭ ϳ ϴ  ,  [0, Duration]     Duration̴.
+		struct ClipRange
+		{
+			std::string Name;
+			unsigned int FirstFrame;
+			unsigned int FrameCount;
+			float FrameRate; //  / , ̰ 0 Ŭ 0
+			float Duration;
+		};
+
+		// ̴ cbVertexAnimation  ġ
+		struct ShaderConstants
+		{
+			DirectX::SimpleMath::Vector4 BoundsMin; // xyz
+			DirectX::SimpleMath::Vector4 BoundsSize; // xyz, ġ = BoundsMin + ؼ xyz * BoundsSize
+			unsigned int TextureWidth;
+			unsigned int RowsPerFrame;
+			unsigned int VertexOffset; // ¸ DrawIndexed BaseVertexLocation, SV_VertexID  ʴ´.
+			unsigned int Padding;
+		};
+
+	public:
+		VertexAnimationTexture();
+
+		// clips frameRate ø ´. ؽó ̰ MAX_TEXTURE_HEIGHT  false
+		// jobSystem    ŰѴ.
+		static bool Bake(const SkinnedMeshSource& source, const std::vector<const AnimationClip*>& clips, float frameRate,
+			common::JobSystem* jobSystem, VertexAnimationTexture* outTexture);
+
+		bool Write(const std::string& fileName) const;
+		bool Read(const std::string& fileName);
+
+		// νϽ  INSTANCE_CLIP ִ  (ù ,  ,  / ,  ð)
+		DirectX::SimpleMath::Vector4 MakeInstanceClip(unsigned int clipIndex, float timePos) const;
+		// ̴   Ѵ. frame ü  ȣ
+		DirectX::SimpleMath::Vector3 DecodePosition(unsigned int vertexIndex, unsigned int frame) const;
+		DirectX::SimpleMath::Vector3 DecodeNormal(unsigned int vertexIndex, unsigned int frame) const;
+		// ̴ó    Ѵ.
+		DirectX::SimpleMath::Vector3 SamplePosition(unsigned int vertexIndex, const DirectX::SimpleMath::Vector4& instanceClip) const;
+		DirectX::SimpleMath::Vector3 SampleNormal(unsigned int vertexIndex, const DirectX::SimpleMath::Vector4& instanceClip) const;
+
+		//  ̸  -1
+		int FindClip(const std::string& name) const;
+
+		inline const ShaderConstants& GetShaderConstants() const;
+		inline unsigned int GetVertexCount() const;
+		inline unsigned int GetTextureWidth() const;
+		inline unsigned int GetTextureHeight() const;
+		inline unsigned int GetFrameCount() const;
+		inline unsigned int GetClipCount() const;
+		inline const ClipRange& GetClip(unsigned int clipIndex) const;
+		//  켱, ؼ half 4 (DXGI_FORMAT_R16G16B16A16_FLOAT)
+		inline const std::vector<uint16_t>& GetPositionTexels() const;
+		//  켱, ؼ half 2 (DXGI_FORMAT_R16G16_FLOAT)
+		inline const std::vector<uint16_t>& GetNormalTexels() const;
+		inline size_t GetByteSize() const;
+
+	private:
+		inline size_t getTexelIndex(unsigned int vertexIndex, unsigned int frame) const;
+		// ̴ sampleFrames    ȣ  Ѵ.
+		void getFramePair(const DirectX::SimpleMath::Vector4& instanceClip, unsigned int* outFrame0, unsigned int* outFrame1, float* outWeight) const;
+
+	private:
+		ShaderConstants mConstants;
+		unsigned int mVertexCount;
+		unsigned int mTextureHeight;
+		unsigned int mFrameCount;
+		std::vector<ClipRange> mClips;
+		std::vector<uint16_t> mPositionTexels;
+		std::vector<uint16_t> mNormalTexels;
+	};
+
+	const VertexAnimationTexture::ShaderConstants& VertexAnimationTexture::GetShaderConstants() const
+	{
+		return mConstants;
+	}
+
+	unsigned int VertexAnimationTexture::GetVertexCount() const
+	{
+		return mVertexCount;
+	}
+
+	unsigned int VertexAnimationTexture::GetTextureWidth() const
+	{
+		return mConstants.TextureWidth;
+	}
+
+	unsigned int VertexAnimationTexture::GetTextureHeight() const
+	{
+		return mTextureHeight;
+	}
+
+	unsigned int VertexAnimationTexture::GetFrameCount() const
+	{
+		return mFrameCount;
+	}
+
+	unsigned int VertexAnimationTexture::GetClipCount() const
+	{
+		return static_cast<unsigned int>(mClips.size());
+	}
+
+	const VertexAnimationTexture::ClipRange& VertexAnimationTexture::GetClip(unsigned int clipIndex) const
+	{
+		return mClips[clipIndex];
+	}
+
+	const std::vector<uint16_t>& VertexAnimationTexture::GetPositionTexels() const
+	{
+		return mPositionTexels;
+	}
+
+	const std::vector<uint16_t>& VertexAnimationTexture::GetNormalTexels() const
+	{
+		return mNormalTexels;
+	}
+
+	size_t VertexAnimationTexture::GetByteSize() const
+	{
+		return (mPositionTexels.size() + mNormalTexels.size()) * sizeof(uint16_t);
+	}
+
+	size_t VertexAnimationTexture::getTexelIndex(unsigned int vertexIndex, unsigned int frame) const
+	{
+		const size_t row = static_cast<size_t>(frame) * mConstants.RowsPerFrame + vertexIndex / mConstants.TextureWidth;
+		return row * mConstants.TextureWidth + vertexIndex % mConstants.TextureWidth;
+	}
+}
\ No newline at end of file
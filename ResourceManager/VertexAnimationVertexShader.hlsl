@@ -0,0 +1,118 @@
+struct VS_INPUT
+{
+	uint vertexID : SV_VertexID;
+	float2 tangent : TANGENT; // octahedral, bind pose
+	float2 UV : UV;
+	// per instance
+	float4 world0 : WORLD0;
+	float4 world1 : WORLD1;
+	float4 world2 : WORLD2;
+	float4 world3 : WORLD3;
+	float4 clip : INSTANCE_CLIP; // first frame, frame count, frames per second, time
+};
+
+struct VS_OUTPUT
+{
+	float4 position : SV_POSITION;
+	float2 UV : TEXCOORD0;
+	float3 viewDir : TEXCOORD1;
+	float3 T : TEXCOORD2;
+	float3 B : TEXCOORD3;
+	float3 N : TEXCOORD4;
+};
+
+cbuffer ConstantBuffer : register(b0)
+{
+	matrix worldMat; // unused, world comes from the instance
+	matrix viewMat;
+	matrix projectionMat;
+	float4 worldCameraPosition;
+};
+
+// same layout as VertexAnimationTexture::ShaderConstants
+cbuffer cbVertexAnimation : register(b1)
+{
+	float4 boundsMin;
+	float4 boundsSize;
+	uint textureWidth;
+	uint rowsPerFrame;
+	uint vertexOffset; // BaseVertexLocation of the draw, SV_VertexID does not include it
+	uint padding;
+}
+
+Texture2D<float4> positionTexture : register(t0); // RGBA16F, normalized to the bounds
+Texture2D<float2> normalTexture : register(t1); // RG16F, octahedral
+
+// same as VertexPacking::DecodeOctahedral
+float3 decodeOctahedral(float2 encoded)
+{
+	float3 n = float3(encoded, 1.f - abs(encoded.x) - abs(encoded.y));
+	float fold = saturate(-n.z);
+	n.xy += n.xy >= 0.f ? -fold : fold;
+	return normalize(n);
+}
+
+int3 getTexel(uint vertexIndex, uint frame)
+{
+	return int3(vertexIndex % textureWidth, frame * rowsPerFrame + vertexIndex / textureWidth, 0);
+}
+
+// same as VertexAnimationTexture::getFramePair, clips loop
+void sampleFrames(float4 clip, out uint frame0, out uint frame1, out float weight)
+{
+	uint frameCount = (uint)clip.y;
+	frame0 = (uint)clip.x;
+	frame1 = frame0;
+	weight = 0.f;
+
+	if (frameCount >= 2 && clip.z > 0.f)
+	{
+		float duration = (frameCount - 1) / clip.z;
+		float clipTime = clip.w - floor(clip.w / duration) * duration;
+		float frame = clipTime * clip.z;
+		uint localFrame = min((uint)frame, frameCount - 2);
+
+		frame0 += localFrame;
+		frame1 = frame0 + 1;
+		weight = saturate(frame - localFrame);
+	}
+}
+
+VS_OUTPUT main(VS_INPUT Input)
+{
+	VS_OUTPUT Output;
+
+	uint vertexIndex = Input.vertexID + vertexOffset;
+	uint frame0;
+	uint frame1;
+	float weight;
+	sampleFrames(Input.clip, frame0, frame1, weight);
+
+	float3 position0 = positionTexture.Load(getTexel(vertexIndex, frame0)).xyz;
+	float3 position1 = positionTexture.Load(getTexel(vertexIndex, frame1)).xyz;
+	float3 position = boundsMin.xyz + lerp(position0, position1, weight) * boundsSize.xyz;
+
+	float2 normal0 = normalTexture.Load(getTexel(vertexIndex, frame0));
+	float2 normal1 = normalTexture.Load(getTexel(vertexIndex, frame1));
+	float3 normal = normalize(lerp(decodeOctahedral(normal0), decodeOctahedral(normal1), weight));
+
+	matrix instanceWorld = matrix(Input.world0, Input.world1, Input.world2, Input.world3);
+	float4 worldPosition = mul(float4(position, 1.f), instanceWorld);
+
+	Output.position = mul(worldPosition, viewMat);
+	Output.position = mul(Output.position, projectionMat);
+	Output.UV = Input.UV;
+	Output.viewDir = normalize(worldPosition.xyz - worldCameraPosition.xyz);
+
+	float3 worldNormal = normalize(mul(normal, (float3x3)instanceWorld));
+	Output.N = worldNormal;
+
+	// the baked texture has no tangent, so orthogonalize the bind pose tangent against the animated normal
+	float3 worldTangent = mul(decodeOctahedral(Input.tangent), (float3x3)instanceWorld);
+	worldTangent = worldTangent - dot(worldTangent, worldNormal) * worldNormal;
+	Output.T = normalize(worldTangent);
+
+	Output.B = cross(worldNormal, Output.T);
+
+	return Output;
+}
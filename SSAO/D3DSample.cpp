@@ -1,9 +1,10 @@
 #include <cassert>
-#include <fstream>
 
 #include "D3DSample.h"
 #include "D3DUtil.h"
 #include "MathHelper.h"
+#include "JobSystem.h"
+#include "MeshCache.h"
 #include "GeometryGenerator.h"
 #include "RenderStates.h"
 #include "Ssao.h"
@@ -805,41 +806,20 @@ namespace ssao
 	}
 	void D3DSample::buildSkullGeometryBuffers()
 	{
-		std::ifstream fin("../Resource/Models/skull.txt");
+		JobSystem jobSystem;
+		MeshCache mesh;
 
-		if (!fin)
+		if (!mesh.Load("../Resource/Models/skull.txt", &jobSystem))
 		{
 			MessageBox(0, L"Models/skull.txt not found.", 0, 0);
 			return;
 		}
 
-		UINT vcount = 0;
-		UINT tcount = 0;
-		std::string ignore;
+		// ĳ  Basic32 ġ  ε ޸𸮸 ״ ۿ ø.
+		static_assert(sizeof(Basic32) == sizeof(MeshVertex), "vertex layout mismatch");
 
-		fin >> ignore >> vcount;
-		fin >> ignore >> tcount;
-		fin >> ignore >> ignore >> ignore >> ignore;
-
-		std::vector<Basic32> vertices(vcount);
-		for (UINT i = 0; i < vcount; ++i)
-		{
-			fin >> vertices[i].Pos.x >> vertices[i].Pos.y >> vertices[i].Pos.z;
-			fin >> vertices[i].Normal.x >> vertices[i].Normal.y >> vertices[i].Normal.z;
-		}
-
-		fin >> ignore;
-		fin >> ignore;
-		fin >> ignore;
-
-		mSkullIndexCount = 3 * tcount;
-		std::vector<UINT> indices(mSkullIndexCount);
-		for (UINT i = 0; i < tcount; ++i)
-		{
-			fin >> indices[i * 3 + 0] >> indices[i * 3 + 1] >> indices[i * 3 + 2];
-		}
-
-		fin.close();
+		UINT vcount = mesh.GetVertexCount();
+		mSkullIndexCount = mesh.GetIndexCount();
 
 		ID3D11Buffer* buffer = nullptr;
 
@@ -850,7 +830,7 @@ namespace ssao
 		vbd.CPUAccessFlags = 0;
 		vbd.MiscFlags = 0;
 		D3D11_SUBRESOURCE_DATA vinitData;
-		vinitData.pSysMem = &vertices[0];
+		vinitData.pSysMem = mesh.GetVertices();
 		HR(md3dDevice->CreateBuffer(&vbd, &vinitData, &buffer));
 		mBuffers.insert({ "skullVB", buffer });
 
@@ -861,7 +841,7 @@ namespace ssao
 		ibd.CPUAccessFlags = 0;
 		ibd.MiscFlags = 0;
 		D3D11_SUBRESOURCE_DATA iinitData;
-		iinitData.pSysMem = &indices[0];
+		iinitData.pSysMem = mesh.GetIndices();
 		HR(md3dDevice->CreateBuffer(&ibd, &iinitData, &buffer));
 		mBuffers.insert({ "skullIB", buffer });
 	}
@@ -1,10 +1,11 @@
 #include <cassert>
-#include <fstream>
 
 #include "D3DSample.h"
 #include "D3DUtil.h"
 #include "Basic32.h"
 #include "MathHelper.h"
+#include "JobSystem.h"
+#include "MeshCache.h"
 #include "GeometryGenerator.h"
 #include "RenderStates.h"
 #include "ShadowMap.h"
@@ -810,41 +811,20 @@ namespace shadows
 
 	void D3DSample::buildSkullGeometryBuffers()
 	{
-		std::ifstream fin("../Resource/Models/skull.txt");
+		JobSystem jobSystem;
+		MeshCache mesh;
 
-		if (!fin)
+		if (!mesh.Load("../Resource/Models/skull.txt", &jobSystem))
 		{
 			MessageBox(0, L"Models/skull.txt not found.", 0, 0);
 			return;
 		}
 
-		UINT vcount = 0;
-		UINT tcount = 0;
-		std::string ignore;
+		// ĳ  Basic32::Vertex ġ  ε ޸𸮸 ״ ۿ ø.
+		static_assert(sizeof(Basic32::Vertex) == sizeof(MeshVertex), "vertex layout mismatch");
 
-		fin >> ignore >> vcount;
-		fin >> ignore >> tcount;
-		fin >> ignore >> ignore >> ignore >> ignore;
-
-		std::vector<Basic32::Vertex> vertices(vcount);
-		for (UINT i = 0; i < vcount; ++i)
-		{
-			fin >> vertices[i].Pos.x >> vertices[i].Pos.y >> vertices[i].Pos.z;
-			fin >> vertices[i].Normal.x >> vertices[i].Normal.y >> vertices[i].Normal.z;
-		}
-
-		fin >> ignore;
-		fin >> ignore;
-		fin >> ignore;
-
-		mSkullIndexCount = 3 * tcount;
-		std::vector<UINT> indices(mSkullIndexCount);
-		for (UINT i = 0; i < tcount; ++i)
-		{
-			fin >> indices[i * 3 + 0] >> indices[i * 3 + 1] >> indices[i * 3 + 2];
-		}
-
-		fin.close();
+		UINT vcount = mesh.GetVertexCount();
+		mSkullIndexCount = mesh.GetIndexCount();
 
 		D3D11_BUFFER_DESC vbd;
 		vbd.Usage = D3D11_USAGE_IMMUTABLE;
@@ -853,7 +833,7 @@ namespace shadows
 		vbd.CPUAccessFlags = 0;
 		vbd.MiscFlags = 0;
 		D3D11_SUBRESOURCE_DATA vinitData;
-		vinitData.pSysMem = &vertices[0];
+		vinitData.pSysMem = mesh.GetVertices();
 		HR(md3dDevice->CreateBuffer(&vbd, &vinitData, &mSkullVB));
 
 		//
@@ -867,7 +847,7 @@ namespace shadows
 		ibd.CPUAccessFlags = 0;
 		ibd.MiscFlags = 0;
 		D3D11_SUBRESOURCE_DATA iinitData;
-		iinitData.pSysMem = &indices[0];
+		iinitData.pSysMem = mesh.GetIndices();
 		HR(md3dDevice->CreateBuffer(&ibd, &iinitData, &mSkullIB));
 	}
 
@@ -0,0 +1,22 @@
+#pragma once
+
+//  忡  Ѵ. (CMakeLists.txt)
+// directxtk/SimpleMath.h Windows dxgi1_2.h ޴ RECT, UINT, __cdecl ٸ ÷  ʰ ׳ .
+// _In_  SAL ּ DirectXMath 䱸ϴ sal.h ä.
+#if !defined(_WIN32)
+
+typedef unsigned int UINT;
+
+typedef struct tagRECT
+{
+	long left;
+	long top;
+	long right;
+	long bottom;
+} RECT;
+
+#if !defined(__cdecl)
+#define __cdecl
+#endif
+
+#endif
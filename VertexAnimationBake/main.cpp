@@ -0,0 +1,209 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "JobSystem.h"
+#include "Benchmark/SyntheticRig.h"
+#include "ResourceManager/RigCache.h"
+#include "ResourceManager/VertexAnimationTexture.h"
+
+using namespace common;
+using namespace resourceManager;
+
+namespace
+{
+	struct BakeOptions
+	{
+		const char* OutputFileName = "synthetic.vat";
+		const char* RigFileName = nullptr; //  ռ   Direct3D 尡  .rig ´.
+		uint32_t NodeCount = 64;
+		uint32_t ClipCount = 3;
+		uint32_t VerticesPerBone = 16;
+		uint32_t ThreadCount = 0; // 0̸ ھ 
+		uint32_t Seed = 13;
+		float FrameRate = static_cast<float>(VertexAnimationTexture::DEFAULT_FRAME_RATE);
+		bool bVerify = false;
+	};
+
+	void printUsage()
+	{
+		std::cout << "usage: VertexAnimationBake [-rig input.rig] [-o output.vat] [-nodes N] [-clips N] [-vertices N] [-fps F] [-threads N] [-seed N] [-verify]" << std::endl;
+		std::cout << "  bakes the synthetic rig used by the benchmarks unless -rig is given" << std::endl;
+		std::cout << "  -rig       skeleton, mesh and clips the Direct3D build exported with SkinnedModel::WriteRigCache" << std::endl;
+		std::cout << "  -vertices  vertices per bone of the synthetic rig" << std::endl;
+		std::cout << "  -verify    rebake on one thread and read the file back, both must be bit-identical" << std::endl;
+	}
+
+	bool parseOptions(int argc, char* argv[], BakeOptions* outOptions)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const char* arg = argv[i];
+			const bool bHasValue = i + 1 < argc;
+
+			if (strcmp(arg, "-o") == 0 && bHasValue)
+			{
+				outOptions->OutputFileName = argv[++i];
+			}
+			else if (strcmp(arg, "-rig") == 0 && bHasValue)
+			{
+				outOptions->RigFileName = argv[++i];
+			}
+			else if (strcmp(arg, "-nodes") == 0 && bHasValue)
+			{
+				outOptions->NodeCount = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+			}
+			else if (strcmp(arg, "-clips") == 0 && bHasValue)
+			{
+				outOptions->ClipCount = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+			}
+			else if (strcmp(arg, "-vertices") == 0 && bHasValue)
+			{
+				outOptions->VerticesPerBone = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+			}
+			else if (strcmp(arg, "-fps") == 0 && bHasValue)
+			{
+				outOptions->FrameRate = static_cast<float>(atof(argv[++i]));
+			}
+			else if (strcmp(arg, "-threads") == 0 && bHasValue)
+			{
+				outOptions->ThreadCount = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+			}
+			else if (strcmp(arg, "-seed") == 0 && bHasValue)
+			{
+				outOptions->Seed = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+			}
+			else if (strcmp(arg, "-verify") == 0)
+			{
+				outOptions->bVerify = true;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		return outOptions->NodeCount > 0 && outOptions->ClipCount > 0 && outOptions->VerticesPerBone > 0 && outOptions->FrameRate > 0.f;
+	}
+
+	// ؼ, ̴ , Ŭ   ƾ  ؽó.
+	bool isTextureEqual(const VertexAnimationTexture& lhs, const VertexAnimationTexture& rhs)
+	{
+		if (lhs.GetPositionTexels() != rhs.GetPositionTexels() || lhs.GetNormalTexels() != rhs.GetNormalTexels()
+			|| lhs.GetClipCount() != rhs.GetClipCount() || lhs.GetTextureHeight() != rhs.GetTextureHeight()
+			|| memcmp(&lhs.GetShaderConstants(), &rhs.GetShaderConstants(), sizeof(VertexAnimationTexture::ShaderConstants)) != 0)
+		{
+			return false;
+		}
+
+		for (uint32_t i = 0; i < lhs.GetClipCount(); ++i)
+		{
+			const VertexAnimationTexture::ClipRange& lhsClip = lhs.GetClip(i);
+			const VertexAnimationTexture::ClipRange& rhsClip = rhs.GetClip(i);
+			if (lhsClip.Name != rhsClip.Name || lhsClip.FirstFrame != rhsClip.FirstFrame || lhsClip.FrameCount != rhsClip.FrameCount
+				|| lhsClip.FrameRate != rhsClip.FrameRate || lhsClip.Duration != rhsClip.Duration)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+// â Direct3D  ؽ ִϸ̼ ؽó ´. Է -rig  .rig ̳ ġũ  ռ ״.
+//  ڵ: 0 , 1  Ǵ  , 2 -verify ġ
+int main(int argc, char* argv[])
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	BakeOptions options;
+
+	if (!parseOptions(argc, argv, &options))
+	{
+		printUsage();
+		return 1;
+	}
+
+	Skeleton skeleton;
+	std::vector<AnimationClip> clips;
+	PaletteLayout layout;
+	std::vector<vertex::PosNormalTexTanSkinned> vertices;
+	std::vector<unsigned int> subsetStarts;
+	RigCache rig;
+
+	VertexAnimationTexture::SkinnedMeshSource source;
+	std::vector<const AnimationClip*> clipPointers;
+	if (options.RigFileName != nullptr)
+	{
+		if (!rig.Read(options.RigFileName))
+		{
+			std::cout << "failed to read " << options.RigFileName << std::endl;
+			return 1;
+		}
+
+		source = rig.GetSource();
+		clipPointers = rig.GetClips();
+	}
+	else
+	{
+		benchmark::SyntheticRig::Build(options.NodeCount, options.ClipCount, options.Seed, &skeleton, &clips);
+		benchmark::SyntheticRig::BuildPaletteLayout(skeleton, &layout);
+		benchmark::SyntheticRig::BuildSkinnedVertices(skeleton, layout, options.VerticesPerBone, options.Seed, &vertices, &subsetStarts);
+
+		for (const AnimationClip& clip : clips)
+		{
+			clipPointers.push_back(&clip);
+		}
+
+		source = { &skeleton, &layout, vertices.data(), subsetStarts.data(), static_cast<unsigned int>(subsetStarts.size() - 1) };
+	}
+
+	JobSystem jobSystem(options.ThreadCount > 0 ? options.ThreadCount - 1 : 0);
+	JobSystem* jobSystemPtr = jobSystem.GetThreadCount() > 1 ? &jobSystem : nullptr;
+
+	const Clock::time_point start = Clock::now();
+	VertexAnimationTexture texture;
+	if (!VertexAnimationTexture::Bake(source, clipPointers, options.FrameRate, jobSystemPtr, &texture))
+	{
+		std::cout << "too many frames for one texture" << std::endl;
+		return 1;
+	}
+	const double bakeMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+	std::cout << (options.RigFileName != nullptr ? options.RigFileName : "synthetic rig") << ": " << source.Skeleton->GetNodeCount() << " nodes, " << texture.GetVertexCount() << " vertices, " << texture.GetClipCount()
+		<< " clips, " << texture.GetFrameCount() << " frames, " << texture.GetTextureWidth() << "x" << texture.GetTextureHeight() << ", "
+		<< texture.GetByteSize() / 1024 << " KB, " << jobSystem.GetThreadCount() << " threads, bake " << bakeMs << " ms" << std::endl;
+
+	if (!texture.Write(options.OutputFileName))
+	{
+		std::cout << "failed to write " << options.OutputFileName << std::endl;
+		return 1;
+	}
+
+	if (options.bVerify)
+	{
+		VertexAnimationTexture reference;
+		VertexAnimationTexture::Bake(source, clipPointers, options.FrameRate, nullptr, &reference);
+
+		VertexAnimationTexture loaded;
+		const bool bLoaded = loaded.Read(options.OutputFileName);
+
+		const bool bRebakeEqual = isTextureEqual(texture, reference);
+		const bool bFileEqual = bLoaded && isTextureEqual(texture, loaded);
+
+		std::cout << "  verify 1 thread: " << (bRebakeEqual ? "identical" : "MISMATCH") << ", read back: "
+			<< (bFileEqual ? "identical" : "MISMATCH") << std::endl;
+
+		if (!bRebakeEqual || !bFileEqual)
+		{
+			return 2;
+		}
+	}
+
+	return 0;
+}